@@ -12,7 +12,7 @@ public:
     {
         auto go = createGameObject("Camera");
         //go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0,0,-10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0,0,-10) );
         //go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
         go->addComponent<Components::VRCamera>(Components::ScreenDisplay::LeftEye, Graphics::MSAASamples::Four);
         go->addComponent<Components::VRFPSCamera>();
@@ -27,7 +27,7 @@ public:
         go2->addComponent<Components::MeshRenderer>(Core::MeshGenerator::CreateCube(0.5f, Color::BLUE), ASSETS.getColorMaterial());
 
         auto go3 = createGameObject("Sound");
-        go3->getComponent<Components::Transform>()->position = Math::Vec3(50, 0, 0);
+        go3->getComponent<Components::Transform>()->setPosition( Math::Vec3(50, 0, 0) );
         go3->addComponent<Components::AudioSource>(ASSETS.getAudioClip("/audio/doki.wav"));
         go3->addComponent<Components::MeshRenderer>(Core::MeshGenerator::CreateCube(0.5f, Color::RED), ASSETS.getColorMaterial());
 
@@ -0,0 +1,91 @@
+#pragma once
+/**********************************************************************
+    class: MPSCQueue (mpsc_queue.hpp)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Unbounded lock-free multiple producer / single consumer queue
+    (D. Vyukov's node based queue). Producers only need one atomic
+    exchange per push, the consumer never blocks producers. Meant to
+    hand results from jobs back to the main thread.
+    @Considerations:
+      - Pop might return false for a short moment while a producer is
+        in the middle of a push. The item will show up on the next pop.
+**********************************************************************/
+
+#include <atomic>
+
+namespace Common {
+
+    //**********************************************************************
+    template <typename T>
+    class MPSCQueue
+    {
+        struct Node
+        {
+            Node() = default;
+            Node(T&& item) : item( std::move( item ) ) {}
+
+            std::atomic<Node*>  next{ nullptr };
+            T                   item;
+        };
+
+    public:
+        MPSCQueue() : m_head( &m_stub ), m_tail( &m_stub ) {}
+        ~MPSCQueue()
+        {
+            T item;
+            while ( pop( item ) ) {}
+            if (m_tail != &m_stub)
+                delete m_tail;
+        }
+
+        //----------------------------------------------------------------------
+        // Adds an item at the end of the queue. Can be called from any thread.
+        //----------------------------------------------------------------------
+        void push(T item)
+        {
+            Node* node = new Node( std::move( item ) );
+            Node* prev = m_head.exchange( node, std::memory_order_acq_rel );
+            prev->next.store( node, std::memory_order_release );
+        }
+
+        //----------------------------------------------------------------------
+        // Removes the first item. May only be called by the consumer thread.
+        // @Return:
+        //  True if an item was removed and written to "item".
+        //----------------------------------------------------------------------
+        bool pop(T& item)
+        {
+            Node* tail = m_tail;
+            Node* next = tail->next.load( std::memory_order_acquire );
+            if (next == nullptr)
+                return false;
+
+            // "next" becomes the new stub, its item is moved out and the old stub is freed
+            item = std::move( next->item );
+            m_tail = next;
+            if (tail != &m_stub)
+                delete tail;
+
+            return true;
+        }
+
+        //----------------------------------------------------------------------
+        // May only be called by the consumer thread.
+        //----------------------------------------------------------------------
+        bool empty() const { return m_tail->next.load( std::memory_order_acquire ) == nullptr; }
+
+    private:
+        std::atomic<Node*>  m_head;     // Last pushed node, producers swap in here
+        Node*               m_tail;     // Current stub, only touched by the consumer
+        Node                m_stub;
+
+        MPSCQueue(const MPSCQueue& other)               = delete;
+        MPSCQueue& operator = (const MPSCQueue& other)  = delete;
+        MPSCQueue(MPSCQueue&& other)                    = delete;
+        MPSCQueue& operator = (MPSCQueue&& other)       = delete;
+    };
+
+} // end namespaces
@@ -0,0 +1,80 @@
+#pragma once
+/**********************************************************************
+    class: None (radix_sort.hpp)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    LSD radix sort for items with a 64-Bit integer key.
+**********************************************************************/
+
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace Common {
+
+    //**********************************************************************
+    // Sorts the given items in ascending order of their key. Processes
+    // 8 Bits per pass, passes where all keys share the same digit are
+    // skipped. The sort is stable.
+    // @Params:
+    // "items": The items to sort. Also contains the result.
+    // "temp": Scratch memory, must be able to hold "count" items.
+    // "count": Amount of items.
+    // "getKey": Functor returning the U64 key of an item.
+    //**********************************************************************
+    template <typename T, typename KeyFunc>
+    void RadixSort64(T* items, T* temp, Size count, KeyFunc getKey)
+    {
+        static_assert( std::is_trivially_copyable<T>::value, "Items are moved with memcpy." );
+
+        if (count < 2)
+            return;
+
+        const I32 NUM_PASSES = 8;
+        const I32 NUM_BUCKETS = 256;
+
+        // Build the histograms for every pass at once
+        U32 histograms[NUM_PASSES][NUM_BUCKETS] = {};
+        for (Size i = 0; i < count; ++i)
+        {
+            U64 key = getKey( items[i] );
+            for (I32 pass = 0; pass < NUM_PASSES; ++pass)
+                histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+        }
+
+        T* src = items;
+        T* dst = temp;
+        for (I32 pass = 0; pass < NUM_PASSES; ++pass)
+        {
+            U32* histogram = histograms[pass];
+
+            // All keys have the same digit, so this pass would not change anything
+            U64 firstDigit = (getKey( src[0] ) >> (pass * 8)) & 0xFF;
+            if (histogram[firstDigit] == count)
+                continue;
+
+            // Convert counts into start positions
+            U32 offset = 0;
+            for (I32 bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+            {
+                U32 bucketCount = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += bucketCount;
+            }
+
+            for (Size i = 0; i < count; ++i)
+            {
+                U64 digit = (getKey( src[i] ) >> (pass * 8)) & 0xFF;
+                dst[histogram[digit]++] = src[i];
+            }
+
+            std::swap( src, dst );
+        }
+
+        if (src != items)
+            memcpy( items, src, count * sizeof(T) );
+    }
+
+} // End namespaces
@@ -0,0 +1,196 @@
+#include "frustum_culler.h"
+/**********************************************************************
+    class: FrustumCuller (frustum_culler.cpp)
+
+    author: S. Hau
+    date: October 17, 2026
+**********************************************************************/
+
+#include "OS/Threading/parallel.hpp"
+
+namespace Math
+{
+    //----------------------------------------------------------------------
+    #define CULL_BLOCKS_PER_JOB     256 // Minimum amount of four box blocks per job
+
+    //----------------------------------------------------------------------
+    void TransformBounds( const AABB& bounds, const DirectX::XMMATRIX& worldMatrix, Vec3& center, Vec3& extent )
+    {
+        using namespace DirectX;
+
+        // Transform center and extents, which gives the world space box enclosing the transformed box
+        XMVECTOR min = XMLoadFloat3( &bounds.getMin() );
+        XMVECTOR max = XMLoadFloat3( &bounds.getMax() );
+        XMVECTOR localCenter = XMVectorScale( XMVectorAdd( min, max ), 0.5f );
+        XMVECTOR localExtent = XMVectorScale( XMVectorSubtract( max, min ), 0.5f );
+
+        XMVECTOR worldCenter = XMVector3Transform( localCenter, worldMatrix );
+        XMVECTOR worldExtent = XMVectorAbs( XMVectorMultiply( XMVectorSplatX( localExtent ), worldMatrix.r[0] ) );
+        worldExtent = XMVectorAdd( worldExtent, XMVectorAbs( XMVectorMultiply( XMVectorSplatY( localExtent ), worldMatrix.r[1] ) ) );
+        worldExtent = XMVectorAdd( worldExtent, XMVectorAbs( XMVectorMultiply( XMVectorSplatZ( localExtent ), worldMatrix.r[2] ) ) );
+
+        XMStoreFloat3( &center, worldCenter );
+        XMStoreFloat3( &extent, worldExtent );
+    }
+
+    //----------------------------------------------------------------------
+    U32 CullFrustums( const Vec3& center, const Vec3& extent, const FrustumPlanes* frustums, U32 numFrustums )
+    {
+        ASSERT( numFrustums <= 32 );
+
+        U32 mask = 0;
+        for (U32 f = 0; f < numFrustums; f++)
+        {
+            bool isVisible = true;
+            for (I32 p = 0; p < 6; p++)
+            {
+                const Vec4& plane = frustums[f][p];
+
+                // Same order of operations as FrustumCuller::cullScalar()
+                F32 distance = center.x * plane.x + plane.w;
+                distance = center.y * plane.y + distance;
+                distance = center.z * plane.z + distance;
+
+                F32 radius = extent.x * std::abs( plane.x );
+                radius = extent.y * std::abs( plane.y ) + radius;
+                radius = extent.z * std::abs( plane.z ) + radius;
+
+                if (distance + radius < 0.0f)
+                {
+                    isVisible = false;
+                    break;
+                }
+            }
+
+            if (isVisible)
+                mask |= (1u << f);
+        }
+
+        return mask;
+    }
+
+    //----------------------------------------------------------------------
+    void FrustumCuller::clear()
+    {
+        m_centerX.clear(); m_centerY.clear(); m_centerZ.clear();
+        m_extentX.clear(); m_extentY.clear(); m_extentZ.clear();
+        m_count = 0;
+    }
+
+    //----------------------------------------------------------------------
+    U32 FrustumCuller::add( const AABB& bounds, const DirectX::XMMATRIX& worldMatrix )
+    {
+        Vec3 worldCenter, worldExtent;
+        TransformBounds( bounds, worldMatrix, worldCenter, worldExtent );
+
+        // Keep the arrays padded to a multiple of four, the padding is culled as well but never queried
+        if (m_count % 4 == 0)
+        {
+            Size paddedSize = m_count + 4;
+            m_centerX.resize( paddedSize, 0.0f ); m_centerY.resize( paddedSize, 0.0f ); m_centerZ.resize( paddedSize, 0.0f );
+            m_extentX.resize( paddedSize, 0.0f ); m_extentY.resize( paddedSize, 0.0f ); m_extentZ.resize( paddedSize, 0.0f );
+        }
+
+        m_centerX[m_count] = worldCenter.x;
+        m_centerY[m_count] = worldCenter.y;
+        m_centerZ[m_count] = worldCenter.z;
+        m_extentX[m_count] = worldExtent.x;
+        m_extentY[m_count] = worldExtent.y;
+        m_extentZ[m_count] = worldExtent.z;
+
+        return m_count++;
+    }
+
+    //----------------------------------------------------------------------
+    void FrustumCuller::cull( const FrustumPlanes& planes, ArrayList<U8>& visible, OS::ThreadPool* threadPool ) const
+    {
+#ifdef _XM_NO_INTRINSICS_
+        cullScalar( planes, visible );
+#else
+        using namespace DirectX;
+
+        visible.resize( m_centerX.size() );
+
+        // Splat every plane component once
+        XMVECTOR planeX[6], planeY[6], planeZ[6], planeW[6];
+        XMVECTOR absPlaneX[6], absPlaneY[6], absPlaneZ[6];
+        for (I32 p = 0; p < 6; p++)
+        {
+            planeX[p] = XMVectorReplicate( planes[p].x );
+            planeY[p] = XMVectorReplicate( planes[p].y );
+            planeZ[p] = XMVectorReplicate( planes[p].z );
+            planeW[p] = XMVectorReplicate( planes[p].w );
+            absPlaneX[p] = XMVectorAbs( planeX[p] );
+            absPlaneY[p] = XMVectorAbs( planeY[p] );
+            absPlaneZ[p] = XMVectorAbs( planeZ[p] );
+        }
+
+        const XMVECTOR zero = XMVectorZero();
+        I64 numBlocks = static_cast<I64>( m_centerX.size() / 4 );
+        OS::ParallelForRange( threadPool, 0, numBlocks, [&](I64 firstBlock, I64 lastBlock) {
+            for (Size i = firstBlock * 4; i < lastBlock * 4; i += 4)
+            {
+                XMVECTOR cx = XMLoadFloat4( reinterpret_cast<const XMFLOAT4*>( &m_centerX[i] ) );
+                XMVECTOR cy = XMLoadFloat4( reinterpret_cast<const XMFLOAT4*>( &m_centerY[i] ) );
+                XMVECTOR cz = XMLoadFloat4( reinterpret_cast<const XMFLOAT4*>( &m_centerZ[i] ) );
+                XMVECTOR ex = XMLoadFloat4( reinterpret_cast<const XMFLOAT4*>( &m_extentX[i] ) );
+                XMVECTOR ey = XMLoadFloat4( reinterpret_cast<const XMFLOAT4*>( &m_extentY[i] ) );
+                XMVECTOR ez = XMLoadFloat4( reinterpret_cast<const XMFLOAT4*>( &m_extentZ[i] ) );
+
+                // A box is outside if it is completely behind any plane:
+                // dot(n, center) + d + dot(|n|, extent) < 0
+                XMVECTOR outside = XMVectorFalseInt();
+                for (I32 p = 0; p < 6; p++)
+                {
+                    XMVECTOR distance = XMVectorMultiplyAdd( cx, planeX[p], planeW[p] );
+                    distance = XMVectorMultiplyAdd( cy, planeY[p], distance );
+                    distance = XMVectorMultiplyAdd( cz, planeZ[p], distance );
+
+                    XMVECTOR radius = XMVectorMultiply( ex, absPlaneX[p] );
+                    radius = XMVectorMultiplyAdd( ey, absPlaneY[p], radius );
+                    radius = XMVectorMultiplyAdd( ez, absPlaneZ[p], radius );
+
+                    outside = XMVectorOrInt( outside, XMVectorLess( XMVectorAdd( distance, radius ), zero ) );
+                }
+
+                XMUINT4 mask;
+                XMStoreUInt4( &mask, outside );
+                visible[i + 0] = mask.x == 0;
+                visible[i + 1] = mask.y == 0;
+                visible[i + 2] = mask.z == 0;
+                visible[i + 3] = mask.w == 0;
+            }
+        }, CULL_BLOCKS_PER_JOB );
+#endif
+    }
+
+    //----------------------------------------------------------------------
+    void FrustumCuller::cullScalar( const FrustumPlanes& planes, ArrayList<U8>& visible ) const
+    {
+        visible.resize( m_centerX.size() );
+
+        for (Size i = 0; i < m_centerX.size(); i++)
+        {
+            bool isVisible = true;
+            for (I32 p = 0; p < 6; p++)
+            {
+                // Same order of operations as the simd path, so both give identical results
+                F32 distance = m_centerX[i] * planes[p].x + planes[p].w;
+                distance = m_centerY[i] * planes[p].y + distance;
+                distance = m_centerZ[i] * planes[p].z + distance;
+
+                F32 radius = m_extentX[i] * std::abs( planes[p].x );
+                radius = m_extentY[i] * std::abs( planes[p].y ) + radius;
+                radius = m_extentZ[i] * std::abs( planes[p].z ) + radius;
+
+                if (distance + radius < 0.0f)
+                {
+                    isVisible = false;
+                    break;
+                }
+            }
+            visible[i] = isVisible;
+        }
+    }
+
+}
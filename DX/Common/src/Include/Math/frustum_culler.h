@@ -0,0 +1,102 @@
+#pragma once
+/**********************************************************************
+    class: FrustumCuller (frustum_culler.h)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Culls many bounding boxes against a frustum at once. The boxes are
+    transformed into world space once and stored as structure of arrays,
+    so four of them are tested in one go against each plane.
+**********************************************************************/
+
+#include "aabb.h"
+
+namespace OS { class ThreadPool; }
+
+namespace Math
+{
+    //----------------------------------------------------------------------
+    // Normalized planes as produced by the camera (xyz = normal pointing
+    // inside, w = distance). Order does not matter.
+    //----------------------------------------------------------------------
+    using FrustumPlanes = std::array<Math::Vec4, 6>;
+
+    //----------------------------------------------------------------------
+    // Transforms local bounds and returns the world space box enclosing
+    // them as center + half extents.
+    //----------------------------------------------------------------------
+    void TransformBounds(const AABB& bounds, const DirectX::XMMATRIX& worldMatrix, Vec3& center, Vec3& extent);
+
+    //----------------------------------------------------------------------
+    // Tests one world space box against several frustums at once.
+    // @Return:
+    //  Bit i is set, if the box is inside or intersects frustums[i].
+    //  Identical to the result of FrustumCuller for every single frustum.
+    //----------------------------------------------------------------------
+    U32 CullFrustums(const Vec3& center, const Vec3& extent, const FrustumPlanes* frustums, U32 numFrustums);
+
+    //**********************************************************************
+    class FrustumCuller
+    {
+    public:
+        FrustumCuller() = default;
+        ~FrustumCuller() = default;
+
+        //----------------------------------------------------------------------
+        // Removes all boxes.
+        //----------------------------------------------------------------------
+        void clear();
+
+        //----------------------------------------------------------------------
+        // Adds a box which will be part of the next cull() call.
+        // @Params:
+        //  "bounds": Local space bounds.
+        //  "worldMatrix": Transforms the bounds into world space.
+        // @Return:
+        //  Index of the box, used to query the visibility afterwards.
+        //----------------------------------------------------------------------
+        U32 add(const AABB& bounds, const DirectX::XMMATRIX& worldMatrix);
+
+        //----------------------------------------------------------------------
+        // Tests every added box against the given planes, four boxes at a time.
+        // @Params:
+        //  "threadPool": If not null, large amounts of boxes are split across
+        //                the workers of this pool.
+        //----------------------------------------------------------------------
+        void cull(const FrustumPlanes& planes, OS::ThreadPool* threadPool = nullptr) { cull( planes, m_visible, threadPool ); }
+
+        //----------------------------------------------------------------------
+        // Same as cull(), but writes the result into "visible" instead of this
+        // culler. Entry i is non zero if box i is visible. Several frustums
+        // can be culled at the same time this way.
+        //----------------------------------------------------------------------
+        void cull(const FrustumPlanes& planes, ArrayList<U8>& visible, OS::ThreadPool* threadPool = nullptr) const;
+
+        //----------------------------------------------------------------------
+        // Same as cull(), but tests one box after another. Used as a fallback
+        // and to verify the simd path. Results are identical, as long as
+        // DirectXMath does not use fused multiply-add instructions.
+        //----------------------------------------------------------------------
+        void cullScalar(const FrustumPlanes& planes) { cullScalar( planes, m_visible ); }
+        void cullScalar(const FrustumPlanes& planes, ArrayList<U8>& visible) const;
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  True, if the box with the given index was inside or intersected
+        //  the frustum during the last cull() call.
+        //----------------------------------------------------------------------
+        bool isVisible(U32 index) const { return m_visible[index] != 0; }
+
+        //----------------------------------------------------------------------
+        U32 size() const { return m_count; }
+
+    private:
+        // World space boxes as center + half extents. Always padded to a multiple of four.
+        ArrayList<F32>  m_centerX, m_centerY, m_centerZ;
+        ArrayList<F32>  m_extentX, m_extentY, m_extentZ;
+        ArrayList<U8>   m_visible;
+        U32             m_count = 0;
+    };
+
+}
@@ -0,0 +1,515 @@
+#pragma once
+/**********************************************************************
+    class: LooseOctree (loose_octree.h)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Dynamic spatial index over world space boxes. Every node covers
+    twice the size of its cell (looseness of two), so an item is stored
+    in exactly one node which only depends on its center and size.
+    Moving an item therefore mostly just updates its box.
+    @Considerations:
+      - Items outside of the root cell are kept in the root, which is
+        visited by every query without testing its bounds.
+      - Queries are const and may run concurrently. Modifications must
+        not run at the same time as any query.
+      - Items are tested with the same test as the FrustumCuller.
+**********************************************************************/
+
+#include "frustum_culler.h"
+
+namespace Math
+{
+    //----------------------------------------------------------------------
+    #define LOOSE_OCTREE_MAX_DEPTH              16
+    #define LOOSE_OCTREE_DEFAULT_HALF_SIZE      8192.0f
+    #define LOOSE_OCTREE_DEFAULT_DEPTH          12
+
+    //**********************************************************************
+    template <typename T>
+    class LooseOctree
+    {
+        static constexpr I32 INVALID = -1;
+
+    public:
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "center":   Center of the root cell.
+        //  "halfSize": Half size of the root cell.
+        //  "maxDepth": Depth of the smallest cells, at most LOOSE_OCTREE_MAX_DEPTH.
+        //----------------------------------------------------------------------
+        LooseOctree(const Vec3& center = Vec3( 0.0f, 0.0f, 0.0f ), F32 halfSize = LOOSE_OCTREE_DEFAULT_HALF_SIZE, U32 maxDepth = LOOSE_OCTREE_DEFAULT_DEPTH);
+        ~LooseOctree() = default;
+
+        //----------------------------------------------------------------------
+        // Adds a world space box (center + half extents).
+        // @Return:
+        //  Handle of the item, stays the same until removed.
+        //----------------------------------------------------------------------
+        U32 insert(const Vec3& center, const Vec3& extent, const T& item);
+
+        //----------------------------------------------------------------------
+        // Moves an item to a new box. Only switches the node if the item
+        // does not fit into its current one anymore.
+        //----------------------------------------------------------------------
+        void update(U32 handle, const Vec3& center, const Vec3& extent);
+
+        //----------------------------------------------------------------------
+        void remove(U32 handle);
+        void clear();
+
+        //----------------------------------------------------------------------
+        const T&    get(U32 handle)     const { ASSERT( m_items[handle].node != INVALID ); return m_items[handle].value; }
+        U32         size()              const { return m_count; }
+        U32         getNodeCount()      const { return static_cast<U32>( m_nodes.size() - m_freeNodes.size() ); }
+
+        //----------------------------------------------------------------------
+        // Calls "callback(const T&)" for every item visible by the frustum.
+        //----------------------------------------------------------------------
+        template <typename F>
+        void queryFrustum(const FrustumPlanes& planes, F&& callback) const;
+
+        //----------------------------------------------------------------------
+        // Tests all items against several frustums in one traversal.
+        // @Params:
+        //  "callback": Called as callback(const T&, U32 mask) for every item
+        //              visible by at least one frustum. Bit i: Visible by frustums[i].
+        //----------------------------------------------------------------------
+        template <typename F>
+        void queryFrustums(const FrustumPlanes* frustums, U32 numFrustums, F&& callback) const;
+
+        //----------------------------------------------------------------------
+        // Calls "callback(const T&)" for every item overlapping the given box.
+        //----------------------------------------------------------------------
+        template <typename F>
+        void queryBox(const Vec3& center, const Vec3& extent, F&& callback) const;
+
+        //----------------------------------------------------------------------
+        // Calls "callback(const T&, const AABB&)" for every item whose box is hit by
+        // the ray. TRay must provide "bool intersects(const AABB&) const".
+        //----------------------------------------------------------------------
+        template <typename TRay, typename F>
+        void queryRay(const TRay& ray, F&& callback) const;
+
+    private:
+        struct Node
+        {
+            Vec3            center;
+            F32             halfSize;
+            I32             parent;
+            I32             children[8];
+            U32             depth;
+            ArrayList<U32>  items;
+        };
+
+        struct Item
+        {
+            T       value;
+            Vec3    center;
+            Vec3    extent;
+            I32     node    = INVALID;  // INVALID if the handle is free
+            U32     slot    = 0;        // Index into the item list of the node
+        };
+
+        // Node and frustum bits left to test. Bits in "insideMask" contain the node completely.
+        struct StackEntry
+        {
+            I32 node;
+            U32 testMask;
+            U32 insideMask;
+        };
+        using Stack = std::array<StackEntry, 8 * LOOSE_OCTREE_MAX_DEPTH + 1>;
+
+        ArrayList<Node> m_nodes;
+        ArrayList<I32>  m_freeNodes;
+        ArrayList<Item> m_items;
+        ArrayList<U32>  m_freeItems;
+        U32             m_count = 0;
+        Vec3            m_rootCenter;
+        F32             m_rootHalfSize;
+        U32             m_maxDepth;
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Depth of the smallest cell whose loose bounds can hold the extent. 0 if it only fits into the root.
+        //----------------------------------------------------------------------
+        U32  _GetTargetDepth(const Vec3& center, const Vec3& extent) const;
+        I32  _FindOrCreateNode(const Vec3& center, U32 depth);
+        I32  _AllocateNode(I32 parent, const Vec3& center, F32 halfSize, U32 depth);
+        void _AddToNode(U32 handle, I32 node);
+        void _RemoveFromNode(U32 handle);
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  False if the box is outside. "inside" is true if the box is completely inside.
+        //----------------------------------------------------------------------
+        static bool _ClassifyBox(const Vec3& center, F32 extent, const FrustumPlanes& planes, bool& inside);
+    };
+
+    //**********************************************************************
+    // IMPLEMENTATION
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    LooseOctree<T>::LooseOctree( const Vec3& center, F32 halfSize, U32 maxDepth )
+        : m_rootCenter( center ), m_rootHalfSize( halfSize ), m_maxDepth( maxDepth )
+    {
+        ASSERT( maxDepth <= LOOSE_OCTREE_MAX_DEPTH );
+        _AllocateNode( INVALID, m_rootCenter, m_rootHalfSize, 0 );
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    U32 LooseOctree<T>::insert( const Vec3& center, const Vec3& extent, const T& item )
+    {
+        U32 handle;
+        if ( not m_freeItems.empty() )
+        {
+            handle = m_freeItems.back();
+            m_freeItems.pop_back();
+        }
+        else
+        {
+            handle = static_cast<U32>( m_items.size() );
+            m_items.emplace_back();
+        }
+
+        Item& newItem = m_items[handle];
+        newItem.value  = item;
+        newItem.center = center;
+        newItem.extent = extent;
+
+        _AddToNode( handle, _FindOrCreateNode( center, _GetTargetDepth( center, extent ) ) );
+        m_count++;
+
+        return handle;
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    void LooseOctree<T>::update( U32 handle, const Vec3& center, const Vec3& extent )
+    {
+        Item& item = m_items[handle];
+        ASSERT( item.node != INVALID );
+
+        item.center = center;
+        item.extent = extent;
+
+        // Still fits if the target depth is the same and the center stays within the cell
+        const Node& node = m_nodes[item.node];
+        U32 depth = _GetTargetDepth( center, extent );
+        if (depth == node.depth)
+        {
+            bool insideCell = depth == 0 || ( std::abs( center.x - node.center.x ) <= node.halfSize
+                                           && std::abs( center.y - node.center.y ) <= node.halfSize
+                                           && std::abs( center.z - node.center.z ) <= node.halfSize );
+            if (insideCell)
+                return;
+        }
+
+        _RemoveFromNode( handle );
+        _AddToNode( handle, _FindOrCreateNode( center, depth ) );
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    void LooseOctree<T>::remove( U32 handle )
+    {
+        ASSERT( m_items[handle].node != INVALID );
+
+        _RemoveFromNode( handle );
+        m_items[handle].node  = INVALID;
+        m_items[handle].value = T();
+        m_freeItems.push_back( handle );
+        m_count--;
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    void LooseOctree<T>::clear()
+    {
+        m_nodes.clear();
+        m_freeNodes.clear();
+        m_items.clear();
+        m_freeItems.clear();
+        m_count = 0;
+        _AllocateNode( INVALID, m_rootCenter, m_rootHalfSize, 0 );
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    template <typename F>
+    void LooseOctree<T>::queryFrustum( const FrustumPlanes& planes, F&& callback ) const
+    {
+        queryFrustums( &planes, 1, [&callback](const T& item, U32) { callback( item ); } );
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    template <typename F>
+    void LooseOctree<T>::queryFrustums( const FrustumPlanes* frustums, U32 numFrustums, F&& callback ) const
+    {
+        ASSERT( numFrustums > 0 && numFrustums <= 32 );
+        U32 allFrustums = (numFrustums == 32) ? ~0u : ((1u << numFrustums) - 1);
+
+        Stack stack;
+        I32 stackSize = 0;
+        stack[stackSize++] = { 0, allFrustums, 0 };
+
+        while (stackSize > 0)
+        {
+            StackEntry entry = stack[--stackSize];
+            const Node& node = m_nodes[entry.node];
+
+            // The root also holds the items outside of its cell, so it is never culled
+            if (entry.node != 0)
+            {
+                U32 testMask = entry.testMask;
+                for (U32 f = 0; f < numFrustums; f++)
+                {
+                    if ( not (testMask & (1u << f)) )
+                        continue;
+
+                    bool inside;
+                    if ( not _ClassifyBox( node.center, node.halfSize * 2.0f, frustums[f], inside ) )
+                        entry.testMask &= ~(1u << f);
+                    else if (inside)
+                    {
+                        entry.testMask   &= ~(1u << f);
+                        entry.insideMask |= (1u << f);
+                    }
+                }
+
+                if ((entry.testMask | entry.insideMask) == 0)
+                    continue;
+            }
+
+            for (U32 handle : node.items)
+            {
+                const Item& item = m_items[handle];
+
+                U32 mask = entry.insideMask;
+                for (U32 f = 0; f < numFrustums; f++)
+                    if (entry.testMask & (1u << f))
+                        mask |= CullFrustums( item.center, item.extent, &frustums[f], 1 ) << f;
+
+                if (mask != 0)
+                    callback( item.value, mask );
+            }
+
+            // Reverse order, so children are visited in index order
+            for (I32 c = 7; c >= 0; c--)
+                if (node.children[c] != INVALID)
+                    stack[stackSize++] = { node.children[c], entry.testMask, entry.insideMask };
+        }
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    template <typename F>
+    void LooseOctree<T>::queryBox( const Vec3& center, const Vec3& extent, F&& callback ) const
+    {
+        auto overlaps = [&](const Vec3& otherCenter, const Vec3& otherExtent) {
+            return std::abs( center.x - otherCenter.x ) <= extent.x + otherExtent.x
+                && std::abs( center.y - otherCenter.y ) <= extent.y + otherExtent.y
+                && std::abs( center.z - otherCenter.z ) <= extent.z + otherExtent.z;
+        };
+
+        Stack stack;
+        I32 stackSize = 0;
+        stack[stackSize++] = { 0, 0, 0 };
+
+        while (stackSize > 0)
+        {
+            const Node& node = m_nodes[stack[--stackSize].node];
+
+            if ( node.depth > 0 && not overlaps( node.center, Vec3( node.halfSize * 2.0f ) ) )
+                continue;
+
+            for (U32 handle : node.items)
+                if ( overlaps( m_items[handle].center, m_items[handle].extent ) )
+                    callback( m_items[handle].value );
+
+            for (I32 c = 7; c >= 0; c--)
+                if (node.children[c] != INVALID)
+                    stack[stackSize++] = { node.children[c], 0, 0 };
+        }
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    template <typename TRay, typename F>
+    void LooseOctree<T>::queryRay( const TRay& ray, F&& callback ) const
+    {
+        Stack stack;
+        I32 stackSize = 0;
+        stack[stackSize++] = { 0, 0, 0 };
+
+        while (stackSize > 0)
+        {
+            const Node& node = m_nodes[stack[--stackSize].node];
+
+            Vec3 looseExtent( node.halfSize * 2.0f );
+            if ( node.depth > 0 && not ray.intersects( AABB( node.center - looseExtent, node.center + looseExtent ) ) )
+                continue;
+
+            for (U32 handle : node.items)
+            {
+                const Item& item = m_items[handle];
+                AABB bounds( item.center - item.extent, item.center + item.extent );
+                if ( ray.intersects( bounds ) )
+                    callback( item.value, bounds );
+            }
+
+            for (I32 c = 7; c >= 0; c--)
+                if (node.children[c] != INVALID)
+                    stack[stackSize++] = { node.children[c], 0, 0 };
+        }
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    U32 LooseOctree<T>::_GetTargetDepth( const Vec3& center, const Vec3& extent ) const
+    {
+        // Items outside of the root cell stay in the root
+        if ( std::abs( center.x - m_rootCenter.x ) > m_rootHalfSize
+          || std::abs( center.y - m_rootCenter.y ) > m_rootHalfSize
+          || std::abs( center.z - m_rootCenter.z ) > m_rootHalfSize )
+            return 0;
+
+        // The loose bounds of a cell extend by its half size on every side
+        F32 maxExtent = std::max( extent.x, std::max( extent.y, extent.z ) );
+        U32 depth = 0;
+        F32 halfSize = m_rootHalfSize * 0.5f;
+        while (depth < m_maxDepth && maxExtent <= halfSize)
+        {
+            depth++;
+            halfSize *= 0.5f;
+        }
+
+        return depth;
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    I32 LooseOctree<T>::_FindOrCreateNode( const Vec3& center, U32 depth )
+    {
+        I32 node = 0;
+        for (U32 d = 0; d < depth; d++)
+        {
+            Vec3 nodeCenter = m_nodes[node].center;
+            F32 childHalfSize = m_nodes[node].halfSize * 0.5f;
+
+            I32 octant = 0;
+            Vec3 childCenter = nodeCenter;
+            if (center.x >= nodeCenter.x) { octant |= 1; childCenter.x += childHalfSize; } else { childCenter.x -= childHalfSize; }
+            if (center.y >= nodeCenter.y) { octant |= 2; childCenter.y += childHalfSize; } else { childCenter.y -= childHalfSize; }
+            if (center.z >= nodeCenter.z) { octant |= 4; childCenter.z += childHalfSize; } else { childCenter.z -= childHalfSize; }
+
+            I32 child = m_nodes[node].children[octant];
+            if (child == INVALID)
+            {
+                child = _AllocateNode( node, childCenter, childHalfSize, d + 1 );
+                m_nodes[node].children[octant] = child;
+            }
+            node = child;
+        }
+
+        return node;
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    I32 LooseOctree<T>::_AllocateNode( I32 parent, const Vec3& center, F32 halfSize, U32 depth )
+    {
+        I32 index;
+        if ( not m_freeNodes.empty() )
+        {
+            index = m_freeNodes.back();
+            m_freeNodes.pop_back();
+        }
+        else
+        {
+            index = static_cast<I32>( m_nodes.size() );
+            m_nodes.emplace_back();
+        }
+
+        // Item list of a reused node keeps its memory
+        Node& node = m_nodes[index];
+        node.center     = center;
+        node.halfSize   = halfSize;
+        node.parent     = parent;
+        node.depth      = depth;
+        node.items.clear();
+        std::fill( std::begin( node.children ), std::end( node.children ), INVALID );
+
+        return index;
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    void LooseOctree<T>::_AddToNode( U32 handle, I32 node )
+    {
+        m_items[handle].node = node;
+        m_items[handle].slot = static_cast<U32>( m_nodes[node].items.size() );
+        m_nodes[node].items.push_back( handle );
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    void LooseOctree<T>::_RemoveFromNode( U32 handle )
+    {
+        Item& item = m_items[handle];
+        auto& items = m_nodes[item.node].items;
+
+        // Swap with the last item of the node
+        U32 last = items.back();
+        items[item.slot] = last;
+        m_items[last].slot = item.slot;
+        items.pop_back();
+
+        // Free empty leaves up to the first node which is still in use
+        I32 node = item.node;
+        while (node != 0 && m_nodes[node].items.empty())
+        {
+            const Node& n = m_nodes[node];
+            bool isLeaf = std::all_of( std::begin( n.children ), std::end( n.children ), [](I32 child) { return child == INVALID; } );
+            if ( not isLeaf )
+                break;
+
+            I32 parent = n.parent;
+            for (I32& child : m_nodes[parent].children)
+                if (child == node)
+                    child = INVALID;
+
+            m_freeNodes.push_back( node );
+            node = parent;
+        }
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    bool LooseOctree<T>::_ClassifyBox( const Vec3& center, F32 extent, const FrustumPlanes& planes, bool& inside )
+    {
+        inside = true;
+        for (const Vec4& plane : planes)
+        {
+            F32 distance = center.x * plane.x + center.y * plane.y + center.z * plane.z + plane.w;
+            F32 radius = extent * (std::abs( plane.x ) + std::abs( plane.y ) + std::abs( plane.z ));
+
+            if (distance + radius < 0.0f)
+                return false;
+            if (distance - radius < 0.0f)
+                inside = false;
+        }
+
+        return true;
+    }
+
+} // end namespaces
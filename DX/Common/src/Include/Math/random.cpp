@@ -10,6 +10,6 @@ namespace Math
 {
 
     //---------------------------------------------------------------------------
-    std::default_random_engine Random::engine{ std::random_device{}() };
+    thread_local std::default_random_engine Random::engine{ std::random_device{}() };
 
 }
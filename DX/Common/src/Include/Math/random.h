@@ -19,7 +19,7 @@ namespace Math
     class Random
     {
     private:
-        static std::default_random_engine engine; 
+        static thread_local std::default_random_engine engine; 
 
     public:
         // Returns an random Integer between [min,max].
@@ -0,0 +1,278 @@
+#include "concurrent_pool_allocator.h"
+/**********************************************************************
+    class: ConcurrentPoolAllocator
+
+    author: S. Hau
+    date: October 17, 2026
+**********************************************************************/
+
+#include "pool_allocator.h" // POOL_ALLOCATOR_DEFAULT_ALIGNMENT
+#include <mutex>
+
+namespace Memory
+{
+    //----------------------------------------------------------------------
+    // Live allocators and the thread slots not in use. A slot is the index
+    // of the magazine a thread uses in every ConcurrentPoolAllocator.
+    //----------------------------------------------------------------------
+    struct ThreadSlotRegistry
+    {
+        std::mutex                              mutex;
+        std::vector<ConcurrentPoolAllocator*>   allocators;
+        std::vector<U32>                        freeSlots;
+        U32                                     nextSlot = 0;
+    };
+
+    // Function local, so allocators with static storage duration can register themselves
+    static ThreadSlotRegistry& GetRegistry() { static ThreadSlotRegistry registry; return registry; }
+
+    //----------------------------------------------------------------------
+    // Each thread gets an unique slot on its first allocation. When the
+    // thread exits, its magazines are flushed and the slot is recycled.
+    //----------------------------------------------------------------------
+    struct ThreadSlot
+    {
+        U32 index = ~0u;
+        ~ThreadSlot() { if (index != ~0u) ConcurrentPoolAllocator::_ReleaseThreadSlot( index ); }
+    };
+    static thread_local ThreadSlot t_threadSlot;
+
+    //----------------------------------------------------------------------
+    static inline U64 PackHead(U64 tag, U32 indexPlusOne) { return (tag << 32) | indexPlusOne; }
+    static inline U32 HeadIndex(U64 head) { return static_cast<U32>( head & 0xFFFFFFFF ); }
+    static inline U64 HeadTag(U64 head) { return head >> 32; }
+
+    //----------------------------------------------------------------------
+    ConcurrentPoolAllocator::ConcurrentPoolAllocator( Size bytesPerChunk, Size amountOfChunks, _IParentAllocator* parentAllocator )
+        : _IAllocator( bytesPerChunk * amountOfChunks, parentAllocator ),
+          m_bytesPerChunk( bytesPerChunk ), m_amountOfChunks( amountOfChunks )
+    {
+        ASSERT( m_amountOfChunks > 0 && m_amountOfChunks < 0xFFFFFFFF && m_bytesPerChunk >= sizeof(U32) );
+
+        // Chunks start at an aligned address and are spaced by the chunk size
+        m_chunkAlignment = POOL_ALLOCATOR_DEFAULT_ALIGNMENT;
+        while (m_bytesPerChunk % m_chunkAlignment != 0)
+            m_chunkAlignment /= 2;
+
+        m_data = reinterpret_cast<Byte*>( m_parentAllocator->allocateRaw( m_amountOfBytes, POOL_ALLOCATOR_DEFAULT_ALIGNMENT ) );
+        ASSERT( m_data != nullptr );
+
+        // Each chunk stores the (index + 1) of its following chunk, the last one stores zero
+        for (U32 i = 0; i < (m_amountOfChunks - 1); i++)
+            _NextIndex( _ToChunk( i ) ) = i + 2;
+        _NextIndex( _ToChunk( static_cast<U32>( m_amountOfChunks - 1 ) ) ) = 0;
+
+        m_head.store( PackHead( 0, 1 ) );
+
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock( registry.mutex );
+        registry.allocators.push_back( this );
+    }
+
+    //----------------------------------------------------------------------
+    ConcurrentPoolAllocator::~ConcurrentPoolAllocator()
+    {
+        {
+            auto& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock( registry.mutex );
+            registry.allocators.erase( std::find( registry.allocators.begin(), registry.allocators.end(), this ) );
+        }
+
+        m_head.store( 0 );
+    }
+
+    //----------------------------------------------------------------------
+    void* ConcurrentPoolAllocator::allocateRaw( Size amountOfBytes, Size alignment )
+    {
+        ASSERT( amountOfBytes <= m_bytesPerChunk );
+        if (alignment > m_chunkAlignment)
+            _WarnBadAlignment( alignment );
+
+        Byte* chunk = nullptr;
+
+        Magazine* magazine = _GetMagazine();
+        if (magazine != nullptr)
+        {
+            // Refill half a magazine, so a following deallocation does not flush immediately
+            if (magazine->count == 0)
+                magazine->count = _PopBatch( magazine->chunks, CONCURRENT_POOL_ALLOCATOR_MAGAZINE_SIZE / 2 );
+
+            if (magazine->count > 0)
+                chunk = magazine->chunks[--magazine->count];
+        }
+        else
+        {
+            _PopBatch( &chunk, 1 );
+        }
+
+        if (chunk == nullptr)
+        {
+            _OutOfMemory();
+            return nullptr;
+        }
+
+        _PrepareChunk( chunk );
+        return chunk;
+    }
+
+    //----------------------------------------------------------------------
+    void ConcurrentPoolAllocator::deallocate( void* data )
+    {
+        Byte* chunk = reinterpret_cast<Byte*>( data );
+        ASSERT( _InMemoryRange( chunk ) && ( (chunk - m_data) % m_bytesPerChunk == 0 ) );
+
+        Magazine* magazine = _GetMagazine();
+        if (magazine != nullptr)
+        {
+            // Flush the older half back to the global list when full
+            if (magazine->count == CONCURRENT_POOL_ALLOCATOR_MAGAZINE_SIZE)
+            {
+                const U32 half = CONCURRENT_POOL_ALLOCATOR_MAGAZINE_SIZE / 2;
+                _PushBatch( magazine->chunks, half );
+                memmove( magazine->chunks, magazine->chunks + half, half * sizeof(Byte*) );
+                magazine->count = half;
+            }
+
+            magazine->chunks[magazine->count++] = chunk;
+        }
+        else
+        {
+            _PushBatch( &chunk, 1 );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void ConcurrentPoolAllocator::flushThreadCache()
+    {
+        Magazine* magazine = _GetMagazine();
+        if (magazine != nullptr)
+            _FlushMagazine( *magazine );
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    ConcurrentPoolAllocator::Magazine* ConcurrentPoolAllocator::_GetMagazine()
+    {
+        if (t_threadSlot.index == ~0u)
+            t_threadSlot.index = _AcquireThreadSlot();
+
+        if (t_threadSlot.index >= CONCURRENT_POOL_ALLOCATOR_MAX_THREADS)
+            return nullptr;
+
+        return &m_magazines[t_threadSlot.index];
+    }
+
+    //----------------------------------------------------------------------
+    void ConcurrentPoolAllocator::_FlushMagazine( Magazine& magazine )
+    {
+        if (magazine.count > 0)
+        {
+            _PushBatch( magazine.chunks, magazine.count );
+            magazine.count = 0;
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void ConcurrentPoolAllocator::_WarnBadAlignment( Size alignment )
+    {
+        LOG( "ConcurrentPoolAllocator: Bad alignment detected: Required Alignment is "
+             "(" + TS(alignment) + "), but chunks are only aligned to (" + TS(m_chunkAlignment) + "). Performance may be degraded." );
+    }
+
+    //----------------------------------------------------------------------
+    U32 ConcurrentPoolAllocator::_AcquireThreadSlot()
+    {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock( registry.mutex );
+        if ( registry.freeSlots.empty() )
+            return registry.nextSlot++;
+
+        U32 slot = registry.freeSlots.back();
+        registry.freeSlots.pop_back();
+        return slot;
+    }
+
+    //----------------------------------------------------------------------
+    void ConcurrentPoolAllocator::_ReleaseThreadSlot( U32 slot )
+    {
+        // Chunks cached by the exiting thread would be stranded otherwise. Holding the
+        // lock keeps the allocators alive and publishes the empty magazines to the next owner.
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock( registry.mutex );
+        if (slot < CONCURRENT_POOL_ALLOCATOR_MAX_THREADS)
+            for (auto allocator : registry.allocators)
+                allocator->_FlushMagazine( allocator->m_magazines[slot] );
+
+        registry.freeSlots.push_back( slot );
+    }
+
+    //----------------------------------------------------------------------
+    U32 ConcurrentPoolAllocator::_PopBatch( Byte** chunks, U32 maxCount )
+    {
+        U64 oldHead = m_head.load( std::memory_order_acquire );
+        while (true)
+        {
+            U32 first = HeadIndex( oldHead );
+            if (first == 0)
+                return 0;
+
+            // Walk along the list. Another thread may pop and overwrite these chunks
+            // concurrently, in which case the links are garbage. This is detected by
+            // the range check or at the latest by the tagged compare-exchange below.
+            U32 count = 0;
+            U32 current = first;
+            bool valid = true;
+            while (count < maxCount && current != 0)
+            {
+                if (current > m_amountOfChunks)
+                {
+                    valid = false;
+                    break;
+                }
+                chunks[count++] = _ToChunk( current - 1 );
+                current = _NextIndex( chunks[count - 1] );
+            }
+
+            if (valid)
+            {
+                U64 newHead = PackHead( HeadTag( oldHead ) + 1, current );
+                if ( m_head.compare_exchange_weak( oldHead, newHead, std::memory_order_acquire, std::memory_order_acquire ) )
+                    return count;
+            }
+            else
+            {
+                oldHead = m_head.load( std::memory_order_acquire );
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void ConcurrentPoolAllocator::_PushBatch( Byte** chunks, U32 count )
+    {
+        ASSERT( count > 0 );
+
+        // Link the chunks among each other first, no one else can see them yet
+        for (U32 i = 0; i < count - 1; i++)
+            _NextIndex( chunks[i] ) = _ToIndex( chunks[i + 1] ) + 1;
+
+        U32 first = _ToIndex( chunks[0] ) + 1;
+        U64 oldHead = m_head.load( std::memory_order_relaxed );
+        do
+        {
+            _NextIndex( chunks[count - 1] ) = HeadIndex( oldHead );
+        } while ( not m_head.compare_exchange_weak( oldHead, PackHead( HeadTag( oldHead ) + 1, first ), std::memory_order_release, std::memory_order_relaxed ) );
+    }
+
+    //----------------------------------------------------------------------
+    void ConcurrentPoolAllocator::_PrepareChunk( Byte* chunk )
+    {
+        if (m_zeroChunks)
+            memset( chunk, 0, m_bytesPerChunk );
+        else
+            _NextIndex( chunk ) = 0;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+#pragma once
+
+/**********************************************************************
+    class: ConcurrentPoolAllocator (concurrent_pool_allocator.h)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Thread-safe variant of the PoolAllocator. Free chunks live in a
+    lock-free global list, but every thread allocates from its own
+    small cache ("magazine") first. Magazines are refilled from and
+    flushed to the global list in batches, so the shared list is only
+    touched once every few allocations. See below for a description.
+**********************************************************************/
+
+#include "iallocator.h"
+#include <atomic>
+
+namespace Memory {
+
+    //----------------------------------------------------------------------
+    // Defines
+    //----------------------------------------------------------------------
+
+    #define CONCURRENT_POOL_ALLOCATOR_MAGAZINE_SIZE     32  // Max cached chunks per thread
+    #define CONCURRENT_POOL_ALLOCATOR_MAX_THREADS       64  // Threads alive at the same time above this use the global list directly
+
+    //**********************************************************************
+    // Features:
+    //  [+] Same as the PoolAllocator
+    //  [+] Allocate/Deallocate from any thread concurrently
+    //  [+] Chunks can be deallocated on a different thread than allocated
+    //  [-] Up to MAGAZINE_SIZE free chunks per thread are cached and are
+    //      not available for other threads until it exits, so plan for
+    //      some slack
+    //  [-] Alignment is only guaranteed up to the largest power of two
+    //      dividing the chunk size (at most POOL_ALLOCATOR_DEFAULT_ALIGNMENT)
+    //  [-] Per allocation statistics are not tracked (getAllocationMemoryInfo())
+    //**********************************************************************
+    class ConcurrentPoolAllocator : public _IAllocator, public _IParentAllocator
+    {
+        //----------------------------------------------------------------------
+        // Per thread cache of free chunks. Only touched by the owning thread.
+        //----------------------------------------------------------------------
+        struct alignas(64) Magazine
+        {
+            Byte*   chunks[CONCURRENT_POOL_ALLOCATOR_MAGAZINE_SIZE];
+            U32     count = 0;
+        };
+
+    public:
+        //----------------------------------------------------------------------
+        // @Params:
+        // "bytesPerChunk": Bytes per chunk. Minimum is sizeof(U32) Bytes.
+        // "amountOfChunks": Maximum number of chunks allocatable
+        // "parentAllocator": Parent allocator from which this allocator pulls
+        //                    his memory out
+        //----------------------------------------------------------------------
+        explicit ConcurrentPoolAllocator(Size bytesPerChunk, Size amountOfChunks, _IParentAllocator* parentAllocator = nullptr);
+        ~ConcurrentPoolAllocator();
+
+        //----------------------------------------------------------------------
+        // Allocate specified amount of bytes. Thread-safe.
+        // @Params:
+        // "amountOfBytes": Amount of bytes to allocate
+        // "alignment":     Alignment to use. MUST be power of two.
+        //----------------------------------------------------------------------
+        void* allocateRaw(Size amountOfBytes, Size alignment = 1) override;
+
+        //----------------------------------------------------------------------
+        // Deallocate the given memory. Does not call any destructor. Thread-safe.
+        // @Params:
+        // "mem": The memory previously allocated from this allocator.
+        //----------------------------------------------------------------------
+        void deallocate(void* data) override;
+
+        //----------------------------------------------------------------------
+        // Allocates and constructs a new object of type T in this allocator.
+        // @Params:
+        // "args": Constructor arguments from the class T
+        //----------------------------------------------------------------------
+        template<typename T, typename... Args>
+        T* allocate(Args&&... args);
+
+        //----------------------------------------------------------------------
+        // Deallocates and deconstructs the given object in this allocator.
+        // @Params:
+        // "data": The object previously allocated from this pool.
+        //----------------------------------------------------------------------
+        template<typename T, typename T2 = typename std::enable_if<!std::is_trivially_destructible<T>::value>::type>
+        void deallocate(T* data);
+
+        //----------------------------------------------------------------------
+        // Returns all chunks cached by the calling thread to the global list.
+        // Happens automatically when a thread exits.
+        //----------------------------------------------------------------------
+        void flushThreadCache();
+
+        //----------------------------------------------------------------------
+        // Whether a whole chunk will be zeroed out on allocation (default: true).
+        //----------------------------------------------------------------------
+        void setZeroChunksOnAllocation(bool zeroChunks) { m_zeroChunks = zeroChunks; }
+
+        //----------------------------------------------------------------------
+        inline Size getChunkSize() const { return m_bytesPerChunk; }
+
+    private:
+        // Top of the global free list: [ABA-Tag (32 Bit) | Chunk-Index + 1 (32 Bit)]
+        // A chunk index of zero represents the empty list.
+        std::atomic<U64>    m_head;
+
+        Size                m_amountOfChunks;
+        Size                m_bytesPerChunk;
+        Size                m_chunkAlignment;   // Alignment every chunk satisfies
+        bool                m_zeroChunks = true;
+
+        Magazine            m_magazines[CONCURRENT_POOL_ALLOCATOR_MAX_THREADS];
+
+        //----------------------------------------------------------------------
+        Magazine*   _GetMagazine();
+        void        _FlushMagazine(Magazine& magazine);
+        void        _WarnBadAlignment(Size alignment);
+
+        static U32  _AcquireThreadSlot();
+        static void _ReleaseThreadSlot(U32 slot);
+        friend struct ThreadSlot;
+        U32         _PopBatch(Byte** chunks, U32 maxCount);
+        void        _PushBatch(Byte** chunks, U32 count);
+        void        _PrepareChunk(Byte* chunk);
+
+        inline U32& _NextIndex(Byte* chunk)         { return *reinterpret_cast<U32*>( chunk ); }
+        inline U32  _ToIndex(Byte* chunk)    const  { return static_cast<U32>( (chunk - m_data) / m_bytesPerChunk ); }
+        inline Byte* _ToChunk(U32 index)     const  { return m_data + index * m_bytesPerChunk; }
+
+        ConcurrentPoolAllocator(const ConcurrentPoolAllocator& other)               = delete;
+        ConcurrentPoolAllocator& operator = (const ConcurrentPoolAllocator& other)  = delete;
+        ConcurrentPoolAllocator(ConcurrentPoolAllocator&& other)                    = delete;
+        ConcurrentPoolAllocator& operator = (ConcurrentPoolAllocator&& other)       = delete;
+    };
+
+    //**********************************************************************
+    // IMPLEMENTATION
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    template <typename T, typename... Args>
+    T* ConcurrentPoolAllocator::allocate( Args&&... args )
+    {
+        void* location = allocateRaw( sizeof(T), alignof(T) );
+
+        // Call constructor using placement new
+        T* retVal = new (location) T( std::forward<Args>( args )... );
+
+        return retVal;
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T, typename T2>
+    void ConcurrentPoolAllocator::deallocate( T* data )
+    {
+        data->~T();
+        deallocate( reinterpret_cast<void*>(data) );
+    }
+
+
+} // end namespaces
\ No newline at end of file
@@ -2,7 +2,9 @@
 
 #include "universal_allocator.h"
 #include "universal_allocator_defragmented.h"
+#include "tlsf_allocator.h"
 #include "pool_allocator.h"
+#include "concurrent_pool_allocator.h"
 #include "pool_list_allocator.h"
 #include "stack_allocator.h"
 
@@ -63,7 +63,10 @@ namespace Memory
         m_head = reinterpret_cast<Byte*>( headChunk->nextFreeChunk );
 
         // Zero out memory for this chunk. Used to detect if a chunk was already deallocated in deallocate()
-        memset( newChunk, 0, m_bytesPerChunk );
+        if (m_zeroChunks)
+            memset( newChunk, 0, m_bytesPerChunk );
+        else
+            newChunk->nextFreeChunk = nullptr;
 
         _LogAllocatedBytes( m_bytesPerChunk );
 
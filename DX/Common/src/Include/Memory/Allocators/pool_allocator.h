@@ -87,6 +87,14 @@ namespace Memory {
         template<typename T, typename T2 = std::enable_if<!std::is_trivially_destructible<T>::value>::type>
         void deallocate(T* data);
 
+        //----------------------------------------------------------------------
+        // Whether a whole chunk will be zeroed out on allocation (default: true).
+        // When disabled only the free-list link is cleared, which is enough
+        // for the double deallocation check. Disable it if chunks are large
+        // and will be overwritten anyway.
+        //----------------------------------------------------------------------
+        void setZeroChunksOnAllocation(bool zeroChunks) { m_zeroChunks = zeroChunks; }
+
         //----------------------------------------------------------------------
         inline Size getChunkSize() const { return m_bytesPerChunk; }
 
@@ -95,6 +103,7 @@ namespace Memory {
 
         Size        m_amountOfChunks;
         Size        m_bytesPerChunk;
+        bool        m_zeroChunks = true;
 
         void _PrintChunks();
         void _WarnBadAlignment(Size misalignment, Size actualAlignment);
@@ -0,0 +1,297 @@
+#include "tlsf_allocator.h"
+/**********************************************************************
+    class: TLSFAllocator (tlsf_allocator.cpp)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    @Considerations:
+      - The pool ends with a zero sized sentinel block which is always
+        in use, so coalescing never has to check the end of the pool.
+      - Two free blocks are never neighbors. Therefore the physical
+        predecessor of every block taken from a free list is in use.
+**********************************************************************/
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace Memory {
+
+    //----------------------------------------------------------------------
+    // @Return:
+    //  Index of the lowest/highest set bit. "value" must not be zero.
+    //----------------------------------------------------------------------
+    static inline U32 FindFirstSet( U32 value )
+    {
+    #ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward( &index, value );
+        return index;
+    #else
+        return __builtin_ctz( value );
+    #endif
+    }
+
+    static inline U32 FindLastSet( U32 value )
+    {
+    #ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse( &index, value );
+        return index;
+    #else
+        return 31 - __builtin_clz( value );
+    #endif
+    }
+
+    //----------------------------------------------------------------------
+    TLSFAllocator::TLSFAllocator( Size amountOfBytes, _IParentAllocator* parentAllocator )
+        : _IAllocator( amountOfBytes, parentAllocator )
+    {
+        ASSERT( m_amountOfBytes < ((Size)1 << 31) && "TLSFAllocator: Pool must be smaller than 2GB." );
+
+        m_data = reinterpret_cast<Byte*>( m_parentAllocator->allocateRaw( m_amountOfBytes, ALIGNMENT ) );
+        ASSERT( m_data != nullptr );
+
+        // Parent allocators might ignore the alignment
+        Byte* firstBlock = alignAddress( m_data, ALIGNMENT );
+        Size  alignmentLoss = firstBlock - m_data;
+        ASSERT( m_amountOfBytes >= alignmentLoss + HEADER_SIZE * 2 + MIN_BLOCK_SIZE );
+
+        // One free block spanning the whole pool followed by the sentinel
+        m_poolSize = (m_amountOfBytes - alignmentLoss - HEADER_SIZE * 2) & ~(ALIGNMENT - 1);
+
+        BlockHeader* block = reinterpret_cast<BlockHeader*>( firstBlock );
+        block->prevPhysical     = nullptr;
+        block->sizeAndFlags     = static_cast<U32>( m_poolSize );
+        block->requestedBytes   = 0;
+
+        BlockHeader* sentinel = _GetNextPhysical( block );
+        sentinel->prevPhysical      = block;
+        sentinel->sizeAndFlags      = 0;
+        sentinel->requestedBytes    = 0;
+
+        _InsertFreeBlock( block );
+    }
+
+    //----------------------------------------------------------------------
+    void* TLSFAllocator::allocateRaw( Size amountOfBytes, Size alignment )
+    {
+        ASSERT( (alignment & (alignment - 1)) == 0 && "TLSFAllocator: Alignment must be a power of two." );
+
+        Size size = std::max( (amountOfBytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1), MIN_BLOCK_SIZE );
+
+        // Payloads are always aligned to ALIGNMENT. For larger alignments search a block
+        // big enough to split off a free block in front of the aligned address.
+        Size gapReserve = (alignment > ALIGNMENT) ? alignment + HEADER_SIZE + MIN_BLOCK_SIZE : 0;
+        Size searchSize = size + gapReserve;
+
+        BlockHeader* block = nullptr;
+        if (searchSize <= m_poolSize) // Also keeps the size class mapping within 32 bits
+        {
+            U32 fl, sl;
+            _MappingSearch( searchSize, fl, sl );
+            if (fl < FL_COUNT)
+                block = _FindSuitableBlock( fl, sl );
+        }
+        if (block == nullptr)
+        {
+            _OutOfMemory();
+            return nullptr;
+        }
+
+        ASSERT( _GetSize( block ) >= searchSize );
+        _RemoveFreeBlock( block );
+
+        if (gapReserve > 0)
+        {
+            Byte* payload = _GetPayload( block );
+            Byte* alignedPayload = alignAddress( payload, alignment );
+
+            // The gap must be able to hold a block on its own
+            if (alignedPayload != payload && Size( alignedPayload - payload ) < HEADER_SIZE + MIN_BLOCK_SIZE)
+                alignedPayload = alignAddress( payload + HEADER_SIZE + MIN_BLOCK_SIZE, alignment );
+
+            Size gap = alignedPayload - payload;
+            if (gap > 0)
+            {
+                BlockHeader* alignedBlock = _GetBlock( alignedPayload );
+                alignedBlock->prevPhysical = block;
+                alignedBlock->sizeAndFlags = static_cast<U32>( _GetSize( block ) - gap );
+                _GetNextPhysical( alignedBlock )->prevPhysical = alignedBlock;
+
+                // The predecessor of "block" is in use, so the gap can't be merged
+                block->sizeAndFlags = static_cast<U32>( gap - HEADER_SIZE );
+                _InsertFreeBlock( block );
+
+                block = alignedBlock;
+            }
+        }
+
+        _TrimBack( block, size );
+
+        block->sizeAndFlags  &= ~FREE_BIT;
+        block->requestedBytes = static_cast<U32>( amountOfBytes );
+
+        _LogAllocatedBytes( amountOfBytes );
+
+        return _GetPayload( block );
+    }
+
+    //----------------------------------------------------------------------
+    Size TLSFAllocator::getLargestFreeBlock() const
+    {
+        if (m_flBitmap == 0)
+            return 0;
+
+        // "_MappingSearch" rounds a request of exactly this size to the same class
+        U32 fl = FindLastSet( m_flBitmap );
+        U32 sl = FindLastSet( m_slBitmaps[fl] );
+        if (fl == 0)
+            return sl * (SMALL_BLOCK / SL_COUNT);
+
+        return (Size)(SL_COUNT + sl) << (fl - 1 + TLSF_ALIGNMENT_LOG2);
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void TLSFAllocator::_MappingInsert( Size size, U32& fl, U32& sl )
+    {
+        if (size < SMALL_BLOCK)
+        {
+            fl = 0;
+            sl = static_cast<U32>( size / (SMALL_BLOCK / SL_COUNT) );
+        }
+        else
+        {
+            U32 msb = FindLastSet( static_cast<U32>( size ) );
+            sl = static_cast<U32>( size >> (msb - TLSF_SL_COUNT_LOG2) ) ^ SL_COUNT;
+            fl = msb - FL_SHIFT + 1;
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void TLSFAllocator::_MappingSearch( Size size, U32& fl, U32& sl )
+    {
+        // Round up to the next class boundary, so any block in that class fits
+        if (size >= SMALL_BLOCK)
+            size += ((Size)1 << (FindLastSet( static_cast<U32>( size ) ) - TLSF_SL_COUNT_LOG2)) - 1;
+
+        _MappingInsert( size, fl, sl );
+    }
+
+    //----------------------------------------------------------------------
+    TLSFAllocator::BlockHeader* TLSFAllocator::_FindSuitableBlock( U32& fl, U32& sl ) const
+    {
+        U32 slMap = m_slBitmaps[fl] & (~0u << sl);
+        if (slMap == 0)
+        {
+            // Nothing in this first level, take the smallest larger one
+            U32 flMap = (fl + 1 < 32) ? m_flBitmap & (~0u << (fl + 1)) : 0;
+            if (flMap == 0)
+                return nullptr;
+
+            fl = FindFirstSet( flMap );
+            slMap = m_slBitmaps[fl];
+        }
+
+        sl = FindFirstSet( slMap );
+        return m_freeLists[fl][sl];
+    }
+
+    //----------------------------------------------------------------------
+    void TLSFAllocator::_InsertFreeBlock( BlockHeader* block )
+    {
+        U32 fl, sl;
+        _MappingInsert( _GetSize( block ), fl, sl );
+
+        BlockHeader* head = m_freeLists[fl][sl];
+        block->sizeAndFlags    |= FREE_BIT;
+        block->requestedBytes   = 0;
+        block->prevFree         = nullptr;
+        block->nextFree         = head;
+        if (head != nullptr)
+            head->prevFree = block;
+
+        m_freeLists[fl][sl] = block;
+        m_flBitmap      |= (1u << fl);
+        m_slBitmaps[fl] |= (1u << sl);
+
+        m_freeBytes += _GetSize( block );
+    }
+
+    //----------------------------------------------------------------------
+    void TLSFAllocator::_RemoveFreeBlock( BlockHeader* block )
+    {
+        U32 fl, sl;
+        _MappingInsert( _GetSize( block ), fl, sl );
+
+        if (block->prevFree != nullptr)
+            block->prevFree->nextFree = block->nextFree;
+        else
+            m_freeLists[fl][sl] = block->nextFree;
+
+        if (block->nextFree != nullptr)
+            block->nextFree->prevFree = block->prevFree;
+
+        if (m_freeLists[fl][sl] == nullptr)
+        {
+            m_slBitmaps[fl] &= ~(1u << sl);
+            if (m_slBitmaps[fl] == 0)
+                m_flBitmap &= ~(1u << fl);
+        }
+
+        m_freeBytes -= _GetSize( block );
+    }
+
+    //----------------------------------------------------------------------
+    void TLSFAllocator::_TrimBack( BlockHeader* block, Size size )
+    {
+        Size blockSize = _GetSize( block );
+        if (blockSize < size + HEADER_SIZE + MIN_BLOCK_SIZE)
+            return;
+
+        block->sizeAndFlags = static_cast<U32>( size );
+
+        BlockHeader* remainder = _GetNextPhysical( block );
+        remainder->prevPhysical = block;
+        remainder->sizeAndFlags = static_cast<U32>( blockSize - size - HEADER_SIZE );
+        _GetNextPhysical( remainder )->prevPhysical = remainder;
+
+        // The successor of a free block is in use, so the remainder can't be merged
+        _InsertFreeBlock( remainder );
+    }
+
+    //----------------------------------------------------------------------
+    TLSFAllocator::BlockHeader* TLSFAllocator::_Coalesce( BlockHeader* block )
+    {
+        BlockHeader* prev = block->prevPhysical;
+        if (prev != nullptr && _IsFree( prev ))
+        {
+            _RemoveFreeBlock( prev );
+            prev->sizeAndFlags = static_cast<U32>( _GetSize( prev ) + HEADER_SIZE + _GetSize( block ) );
+            block = prev;
+        }
+
+        BlockHeader* next = _GetNextPhysical( block );
+        if (_IsFree( next ))
+        {
+            _RemoveFreeBlock( next );
+            block->sizeAndFlags = static_cast<U32>( _GetSize( block ) + HEADER_SIZE + _GetSize( next ) );
+        }
+
+        _GetNextPhysical( block )->prevPhysical = block;
+        return block;
+    }
+
+    //----------------------------------------------------------------------
+    void TLSFAllocator::_Free( BlockHeader* block )
+    {
+        block->requestedBytes = 0;
+        _InsertFreeBlock( _Coalesce( block ) );
+    }
+
+} // end namespaces
@@ -0,0 +1,216 @@
+#pragma once
+
+/**********************************************************************
+    class: TLSFAllocator (tlsf_allocator.h)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Two-Level Segregated Fit allocator. Free blocks are sorted into size
+    classes: The first level is the power of two of the size, the second
+    level divides every power of two linearly. Two bitmaps record which
+    classes have free blocks, so finding a fitting block is a couple of
+    bit scans instead of a walk over all free chunks.
+    See below for a class description.
+**********************************************************************/
+
+#include "iallocator.h"
+
+namespace Memory {
+
+    //----------------------------------------------------------------------
+    // Defines
+    //----------------------------------------------------------------------
+
+    #define TLSF_SL_COUNT_LOG2      4   // Amount of second level classes per power of two (log2)
+    #define TLSF_ALIGNMENT_LOG2     4   // Every block size and payload is a multiple of this (log2)
+
+    //**********************************************************************
+    // Features:
+    //  [+] Allocations can be made in any size/amounts and order
+    //  [+] Deallocations can be made in any order
+    //  [+] Allocation and deallocation take constant time, independent
+    //      of the amount of allocations and of the fragmentation
+    //  [+] Neighboring free blocks are coalesced immediately via
+    //      boundary tags (every block knows its physical predecessor)
+    //  [-] 16 Bytes header per allocation, sizes are rounded up to 16
+    //  [-] A request is served from the next larger size class, so a
+    //      fitting block in the same class might be ignored (good-fit)
+    // Be careful about pointers pointing to memory in this allocator :-)
+    //**********************************************************************
+    class TLSFAllocator : public _IAllocator, public _IParentAllocator
+    {
+        //**********************************************************************
+        // Header in front of every block. The free-list links are only
+        // valid while the block is free and overlap the payload otherwise.
+        //**********************************************************************
+        struct BlockHeader
+        {
+            BlockHeader*    prevPhysical;   // Block directly before this one in memory, nullptr for the first one
+            U32             sizeAndFlags;   // Payload size in bytes. Lowest bit: Block is free
+            U32             requestedBytes; // Amount of bytes the user asked for, zero if free
+
+            alignas(1 << TLSF_ALIGNMENT_LOG2) BlockHeader* nextFree; // Keeps the header size equal on 32 and 64 bit
+            BlockHeader*    prevFree;
+        };
+
+        static constexpr Size   ALIGNMENT       = (Size)1 << TLSF_ALIGNMENT_LOG2;
+        static constexpr Size   HEADER_SIZE     = offsetof( BlockHeader, nextFree );
+        static constexpr Size   MIN_BLOCK_SIZE  = sizeof( BlockHeader ) - HEADER_SIZE; // Room for the free-list links
+        static constexpr U32    SL_COUNT        = 1u << TLSF_SL_COUNT_LOG2;
+        static constexpr U32    FL_SHIFT        = TLSF_SL_COUNT_LOG2 + TLSF_ALIGNMENT_LOG2;
+        static constexpr Size   SMALL_BLOCK     = (Size)1 << FL_SHIFT;   // Below this size the second level is linear
+        static constexpr U32    FL_COUNT        = 32 - FL_SHIFT + 1;      // Block sizes are stored in 32 bits
+        static constexpr U32    FREE_BIT        = 1;
+
+        static_assert( HEADER_SIZE == ALIGNMENT, "TLSFAllocator: Header must keep payloads aligned." );
+
+    public:
+        //----------------------------------------------------------------------
+        // @Params:
+        // "amountOfBytes": Amount of bytes to allocate. Must be less than 2GB.
+        // "parentAllocator": Allocator to which allocate memory from.
+        //----------------------------------------------------------------------
+        explicit TLSFAllocator(Size amountOfBytes, _IParentAllocator* parentAllocator = nullptr);
+        ~TLSFAllocator() {}
+
+        //----------------------------------------------------------------------
+        // Allocate specified amount of bytes.
+        // @Params:
+        // "amountOfBytes": Amount of bytes to allocate.
+        // "alignment":     Alignment to use. MUST be power of two.
+        //----------------------------------------------------------------------
+        void* allocateRaw(Size amountOfBytes, Size alignment = 1) override;
+
+        //----------------------------------------------------------------------
+        // Allocate "amountOfObjects" objects of type T.
+        // @Params:
+        // "amountOfObjects": Amount of objects to allocate (array-allocation).
+        // "args": Constructor arguments from the class T.
+        //----------------------------------------------------------------------
+        template <typename T, typename... Args>
+        T* allocate(Size amountOfObjects = 1, Args&&... args);
+
+        //----------------------------------------------------------------------
+        // Deallocate the given memory. Does not call any destructor.
+        // @Params:
+        // "mem": The memory previously allocated from this allocator.
+        //----------------------------------------------------------------------
+        void deallocate(void* data) override { _Deallocate( reinterpret_cast<Byte*>( data ), false ); }
+
+        //----------------------------------------------------------------------
+        // Deallocates and deconstructs the given object(s).
+        // @Params:
+        // "data": The object(s) previously allocated from this allocator.
+        //----------------------------------------------------------------------
+        template <typename T, typename T2 = std::enable_if<!std::is_trivially_destructible<T>::value>::type>
+        void deallocate(T* data) { _Deallocate( data, true ); }
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Size of the largest allocation which would succeed right now
+        //  with the default alignment. Requests are rounded up to the next
+        //  size class, so this is the lower bound of the largest non-empty
+        //  class and can be less than the largest free block.
+        //----------------------------------------------------------------------
+        Size getLargestFreeBlock() const;
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Amount of bytes in free blocks (excluding block headers).
+        //----------------------------------------------------------------------
+        Size getFreeBytes() const { return m_freeBytes; }
+
+    private:
+        U32             m_flBitmap = 0;                     // Bit i set: First level i has a free block
+        U32             m_slBitmaps[FL_COUNT] = {};         // Bit j set: Free list [i][j] is not empty
+        BlockHeader*    m_freeLists[FL_COUNT][SL_COUNT] = {};
+        Size            m_freeBytes = 0;
+        Size            m_poolSize  = 0;                    // Size of the initial block spanning the whole pool
+
+        //----------------------------------------------------------------------
+        static Size         _GetSize(const BlockHeader* block)  { return block->sizeAndFlags & ~(Size)FREE_BIT; }
+        static bool         _IsFree(const BlockHeader* block)   { return (block->sizeAndFlags & FREE_BIT) != 0; }
+        static Byte*        _GetPayload(BlockHeader* block)     { return reinterpret_cast<Byte*>( block ) + HEADER_SIZE; }
+        static BlockHeader* _GetBlock(void* payload)            { return reinterpret_cast<BlockHeader*>( reinterpret_cast<Byte*>( payload ) - HEADER_SIZE ); }
+        static BlockHeader* _GetNextPhysical(BlockHeader* block){ return reinterpret_cast<BlockHeader*>( _GetPayload( block ) + _GetSize( block ) ); }
+
+        //----------------------------------------------------------------------
+        // Maps a block size to its free list. "_MappingSearch" rounds up
+        // first, so every block in the resulting class is large enough.
+        //----------------------------------------------------------------------
+        static void _MappingInsert(Size size, U32& fl, U32& sl);
+        static void _MappingSearch(Size size, U32& fl, U32& sl);
+
+        // Finds a non-empty free list at [fl][sl] or in a larger class. Nullptr if none.
+        BlockHeader* _FindSuitableBlock(U32& fl, U32& sl) const;
+
+        void _InsertFreeBlock(BlockHeader* block);
+        void _RemoveFreeBlock(BlockHeader* block);
+
+        // Splits the end of the given block into a new free block if the remainder is large enough
+        void _TrimBack(BlockHeader* block, Size size);
+
+        // Merges the given free block with its physical neighbors if they are free
+        BlockHeader* _Coalesce(BlockHeader* block);
+
+        void _Free(BlockHeader* block);
+
+        template <typename T>
+        inline void _Deallocate(T* mem, bool callDestructors);
+
+        TLSFAllocator (const TLSFAllocator& other)              = delete;
+        TLSFAllocator& operator = (const TLSFAllocator& other)  = delete;
+        TLSFAllocator (TLSFAllocator&& other)                   = delete;
+        TLSFAllocator& operator = (TLSFAllocator&& other)       = delete;
+    };
+
+    //**********************************************************************
+    // IMPLEMENTATION
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    template <typename T, typename... Args>
+    T* TLSFAllocator::allocate( Size amountOfObjects, Args&&... args )
+    {
+        Size bytesToAllocate = amountOfObjects * sizeof(T);
+        T* alignedAddress = reinterpret_cast<T*>( allocateRaw( bytesToAllocate, alignof(T) ) );
+
+        if (alignedAddress != nullptr)
+        {
+            // Call constructor on every object manually
+            for (Size i = 0; i < amountOfObjects; i++)
+            {
+                T* objectLocation = std::addressof( alignedAddress[i] );
+                new (objectLocation) T( std::forward<Args>( args )... );
+            }
+        }
+
+        return alignedAddress;
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    void TLSFAllocator::_Deallocate( T* mem, bool callDestructors )
+    {
+        ASSERT( _InMemoryRange( mem ) && "Given memory was not from this allocator!" );
+
+        BlockHeader* block = _GetBlock( mem );
+        ASSERT( not _IsFree( block ) && "Given memory was already deallocated!" );
+
+        Size amountOfBytes = block->requestedBytes;
+        if (callDestructors)
+        {
+            Size amountOfObjects = amountOfBytes / sizeof(T);
+
+            // Call destructor for every object manually
+            for (Size i = 0; i < amountOfObjects; i++)
+                std::addressof( mem[i] ) -> ~T();
+        }
+
+        _Free( block );
+        _LogDeallocatedBytes( amountOfBytes );
+    }
+
+
+} // end namespaces
@@ -49,6 +49,24 @@ namespace Memory {
         return nullptr;
     }
 
+    //----------------------------------------------------------------------
+    Size UniversalAllocator::getLargestFreeChunk() const
+    {
+        Size largest = 0;
+        for (const FreeChunk& freeChunk : m_freeChunks)
+            largest = std::max( largest, freeChunk.m_sizeInBytes );
+        return largest;
+    }
+
+    //----------------------------------------------------------------------
+    Size UniversalAllocator::getFreeBytes() const
+    {
+        Size freeBytes = 0;
+        for (const FreeChunk& freeChunk : m_freeChunks)
+            freeBytes += freeChunk.m_sizeInBytes;
+        return freeBytes;
+    }
+
     //----------------------------------------------------------------------
     void UniversalAllocator::_MergeChunk( FreeChunk* newChunk )
     {
@@ -114,6 +114,18 @@ namespace Memory {
         template <typename T, typename T2 = std::enable_if<!std::is_trivially_destructible<T>::value>::type>
         void deallocate(T* data) { _Deallocate( data, true ); }
 
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Size of the largest contiguous free chunk in bytes.
+        //----------------------------------------------------------------------
+        Size getLargestFreeChunk() const;
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Amount of bytes in all free chunks.
+        //----------------------------------------------------------------------
+        Size getFreeBytes() const;
+
     private:
         // All chunks are sorted by memory address.
         std::vector<FreeChunk> m_freeChunks;
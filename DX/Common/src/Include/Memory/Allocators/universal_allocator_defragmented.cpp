@@ -8,6 +8,7 @@
 
 #include "universal_allocator.h"
 #include "Logging/logging.h"
+#include "OS/PlatformTimer/platform_timer.h"
 
 namespace Memory {
 
@@ -20,61 +21,42 @@ namespace Memory {
         : m_universalAllocator( amountOfBytes, parentAllocator ), 
           m_handleTable( _HandleTableSize, m_universalAllocator.getParentAllocator() ) // Order important!
     {
-        m_usedChunks.reserve( INITIAL_USED_CHUNK_LIST_CAPACITY );
+        m_usedChunks.resize( _HandleTableSize + 1 ); // Handle zero is invalid
     }
 
     //----------------------------------------------------------------------
     void UniversalAllocatorDefragmented::defragment()
     {
-        while ( canBeDefragmented() )
-        {
-            defragmentOnce();
-        }
+        while ( _RelocateNextChunk() > 0 )
+            ;
     }
 
     //----------------------------------------------------------------------
     bool UniversalAllocatorDefragmented::defragmentOnce()
     {
-        if ( not canBeDefragmented() )
-            return false;
+        return _RelocateNextChunk() > 0;
+    }
 
-        // Get the first chunk, which address is where we will move to.
-        UniversalAllocator::FreeChunk& freeChunk = m_universalAllocator.m_freeChunks[0];
+    //----------------------------------------------------------------------
+    bool UniversalAllocatorDefragmented::defragmentStep( const DefragmentationBudget& budget )
+    {
+        U64 startTicks = OS::PlatformTimer::getTicks();
+        Size bytesMoved = 0;
 
-        // Find first UsedChunk right from the first FreeChunk
-        UsedChunk* chunkToRelocate = nullptr;
-        for (UsedChunk& chunk : m_usedChunks)
+        while (true)
         {
-            if (freeChunk.m_address < chunk.getAddress())
-            {
-                chunkToRelocate = &chunk;
-                break;
-            }
-        }
-
-        // Move the chunk to the new position
-        chunkToRelocate->relocate( freeChunk.m_address );
-
-        // Update FreeChunk information
-        Byte* newFreeChunkAddress = ( chunkToRelocate->getAddress() + chunkToRelocate->getSizeInBytes() );
-        freeChunk.m_address = newFreeChunkAddress;
+            Size bytes = _RelocateNextChunk();
+            if (bytes == 0)
+                return false;
 
-        Size amountOfBytes = _UVAllocatorGetAmountOfBytes( chunkToRelocate->getAddress() );
-        Byte newOffset = _UVAllocatorGetOffset( chunkToRelocate->getAddress() );
-        freeChunk.m_sizeInBytes = (amountOfBytes + newOffset);
-
-        // If the updated chunk touches now the following one, merge them
-        if (m_universalAllocator.m_freeChunks.size() > 1)
-        {
-            UniversalAllocator::FreeChunk& nextFreeChunk = m_universalAllocator.m_freeChunks[1];
-            if (freeChunk.touches( nextFreeChunk ))
-            {
-                freeChunk.m_sizeInBytes += nextFreeChunk.m_sizeInBytes;
-                m_universalAllocator._RemoveFreeChunk( nextFreeChunk );
-            }
+            bytesMoved += bytes;
+            if (bytesMoved >= budget.maxBytes)
+                break;
+            if (OS::PlatformTimer::ticksToMilliSeconds( OS::PlatformTimer::getTicks() - startTicks ) >= budget.maxMilliseconds)
+                break;
         }
 
-        return true;
+        return canBeDefragmented();
     }
 
     //----------------------------------------------------------------------
@@ -86,7 +68,7 @@ namespace Memory {
         Size nextFreeHandle = m_handleTable.nextFreeHandle();
         m_handleTable[nextFreeHandle] = mem;
 
-        _AddUsedChunk( nextFreeHandle, amountOfBytes, static_cast<Byte*>(mem) );
+        _AddUsedChunk( nextFreeHandle, amountOfBytes, alignment, static_cast<Byte*>(mem) );
 
         return UAPtr<Byte>( &m_handleTable, nextFreeHandle );
     }
@@ -108,6 +90,9 @@ namespace Memory {
     //----------------------------------------------------------------------
     bool UniversalAllocatorDefragmented::canBeDefragmented()
     {
+        if (m_isStuck)
+            return false;
+
         bool hasOnlyOneFreeChunk = (m_universalAllocator.m_freeChunks.size() == 1);
 
         bool isFreeChunkAtEnd = false;
@@ -133,8 +118,202 @@ namespace Memory {
     //----------------------------------------------------------------------
     void UniversalAllocatorDefragmented::_RemoveUsedChunk( Size handle )
     {
-        UsedChunk chunkToRemove( handle, &m_handleTable );
-        m_usedChunks.erase( std::remove( m_usedChunks.begin(), m_usedChunks.end(), chunkToRemove ), m_usedChunks.end() );
+        if (m_lastRelocatedChunk == handle)
+            m_lastRelocatedChunk = 0;
+
+        _TreeRemove( handle );
+        m_isStuck = false;
+    }
+
+    //----------------------------------------------------------------------
+    Size UniversalAllocatorDefragmented::_RelocateNextChunk()
+    {
+        if ( not canBeDefragmented() )
+            return 0;
+
+        // Get the first chunk, which address is where we will move to.
+        UniversalAllocator::FreeChunk& freeChunk = m_universalAllocator.m_freeChunks[0];
+
+        // Usually the chunk to move directly follows the one moved last. Allocations or
+        // deallocations in between might have changed that, then search the tree.
+        Size handle = 0;
+        if (m_lastRelocatedChunk != 0)
+        {
+            Size next = _TreeNext( m_lastRelocatedChunk );
+            if ( next != 0 && m_usedChunks[m_lastRelocatedChunk].getAddress() < freeChunk.m_address
+                           && freeChunk.m_address < m_usedChunks[next].getAddress() )
+                handle = next;
+        }
+        if (handle == 0)
+            handle = _TreeFindFirstAfter( freeChunk.m_address );
+        ASSERT( handle != 0 );
+
+        UsedChunk& chunkToRelocate = m_usedChunks[handle];
+        Byte* oldAddress = chunkToRelocate.getAddress();
+        Byte* oldEndAddress = oldAddress + chunkToRelocate.getSizeInBytes();
+
+        // The alignment of the chunk might need more than the free space in front of it
+        Byte* newAddress = chunkToRelocate.getAlignedAddress( freeChunk.m_address );
+        if (newAddress >= oldAddress)
+        {
+            // Every further step would try the same chunk again
+            m_isStuck = true;
+            return 0;
+        }
+
+        // Move the chunk to the new position
+        chunkToRelocate.relocate( freeChunk.m_address );
+        m_lastRelocatedChunk = handle;
+
+        // The free chunk now starts behind the moved chunk and ends where the moved chunk ended before
+        freeChunk.m_address = newAddress + chunkToRelocate.getSizeInBytes();
+        freeChunk.m_sizeInBytes = (oldEndAddress - freeChunk.m_address);
+
+        // If the updated chunk touches now the following one, merge them
+        if (m_universalAllocator.m_freeChunks.size() > 1)
+        {
+            UniversalAllocator::FreeChunk& nextFreeChunk = m_universalAllocator.m_freeChunks[1];
+            if (freeChunk.touches( nextFreeChunk ))
+            {
+                freeChunk.m_sizeInBytes += nextFreeChunk.m_sizeInBytes;
+                m_universalAllocator._RemoveFreeChunk( nextFreeChunk );
+            }
+        }
+
+        return chunkToRelocate.getSizeInBytes();
+    }
+
+    //**********************************************************************
+    // Used chunk tree
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void UniversalAllocatorDefragmented::_TreeInsert( Size handle )
+    {
+        // Xorshift, only used to shape the tree
+        m_prioritySeed ^= m_prioritySeed << 13;
+        m_prioritySeed ^= m_prioritySeed >> 17;
+        m_prioritySeed ^= m_prioritySeed << 5;
+
+        UsedChunk& chunk = m_usedChunks[handle];
+        chunk.m_left = chunk.m_right = 0;
+        chunk.m_priority = m_prioritySeed;
+
+        // Insert as a leaf, ordered by address
+        Byte* address = chunk.getAddress();
+        Size parent = 0;
+        Size* link = &m_usedChunksRoot;
+        while (*link != 0)
+        {
+            parent = *link;
+            link = (address < m_usedChunks[parent].getAddress()) ? &m_usedChunks[parent].m_left : &m_usedChunks[parent].m_right;
+        }
+        *link = handle;
+        chunk.m_parent = parent;
+
+        // Restore the heap order of the priorities
+        while (chunk.m_parent != 0 && m_usedChunks[chunk.m_parent].m_priority < chunk.m_priority)
+            _TreeRotateUp( handle );
+    }
+
+    //----------------------------------------------------------------------
+    void UniversalAllocatorDefragmented::_TreeRemove( Size handle )
+    {
+        UsedChunk& chunk = m_usedChunks[handle];
+
+        // Rotate the chunk down until it has at most one child
+        while (chunk.m_left != 0 && chunk.m_right != 0)
+        {
+            Size child = (m_usedChunks[chunk.m_left].m_priority > m_usedChunks[chunk.m_right].m_priority) ? chunk.m_left : chunk.m_right;
+            _TreeRotateUp( child );
+        }
+
+        Size child = (chunk.m_left != 0) ? chunk.m_left : chunk.m_right;
+        if (child != 0)
+            m_usedChunks[child].m_parent = chunk.m_parent;
+
+        if (chunk.m_parent == 0)
+            m_usedChunksRoot = child;
+        else if (m_usedChunks[chunk.m_parent].m_left == handle)
+            m_usedChunks[chunk.m_parent].m_left = child;
+        else
+            m_usedChunks[chunk.m_parent].m_right = child;
+
+        chunk.m_left = chunk.m_right = chunk.m_parent = 0;
+    }
+
+    //----------------------------------------------------------------------
+    void UniversalAllocatorDefragmented::_TreeRotateUp( Size handle )
+    {
+        UsedChunk& chunk = m_usedChunks[handle];
+        Size parentHandle = chunk.m_parent;
+        UsedChunk& parent = m_usedChunks[parentHandle];
+        Size grandParent = parent.m_parent;
+
+        if (parent.m_left == handle)
+        {
+            parent.m_left = chunk.m_right;
+            if (chunk.m_right != 0)
+                m_usedChunks[chunk.m_right].m_parent = parentHandle;
+            chunk.m_right = parentHandle;
+        }
+        else
+        {
+            parent.m_right = chunk.m_left;
+            if (chunk.m_left != 0)
+                m_usedChunks[chunk.m_left].m_parent = parentHandle;
+            chunk.m_left = parentHandle;
+        }
+        parent.m_parent = handle;
+        chunk.m_parent = grandParent;
+
+        if (grandParent == 0)
+            m_usedChunksRoot = handle;
+        else if (m_usedChunks[grandParent].m_left == parentHandle)
+            m_usedChunks[grandParent].m_left = handle;
+        else
+            m_usedChunks[grandParent].m_right = handle;
+    }
+
+    //----------------------------------------------------------------------
+    Size UniversalAllocatorDefragmented::_TreeNext( Size handle ) const
+    {
+        const UsedChunk* chunk = &m_usedChunks[handle];
+        if (chunk->m_right != 0)
+        {
+            handle = chunk->m_right;
+            while (m_usedChunks[handle].m_left != 0)
+                handle = m_usedChunks[handle].m_left;
+            return handle;
+        }
+
+        // Go up until we come from a left child
+        while (chunk->m_parent != 0 && m_usedChunks[chunk->m_parent].m_right == handle)
+        {
+            handle = chunk->m_parent;
+            chunk = &m_usedChunks[handle];
+        }
+        return chunk->m_parent;
+    }
+
+    //----------------------------------------------------------------------
+    Size UniversalAllocatorDefragmented::_TreeFindFirstAfter( Byte* address ) const
+    {
+        Size result = 0;
+        Size handle = m_usedChunksRoot;
+        while (handle != 0)
+        {
+            if (address < m_usedChunks[handle].getAddress())
+            {
+                result = handle;
+                handle = m_usedChunks[handle].m_left;
+            }
+            else
+            {
+                handle = m_usedChunks[handle].m_right;
+            }
+        }
+        return result;
     }
 
     //**********************************************************************
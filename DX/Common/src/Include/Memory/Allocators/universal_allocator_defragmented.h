@@ -21,6 +21,7 @@
 
 #include "universal_allocator.h"
 #include "Logging/logging.h"
+#include <limits>
 
 namespace Memory {
 
@@ -28,8 +29,6 @@ namespace Memory {
     // Defines
     //----------------------------------------------------------------------
 
-    #define INITIAL_USED_CHUNK_LIST_CAPACITY    32
-
     //**********************************************************************
     // Stores the handle table and manages free indices. The indices are 
     // calculated from the values in the unused cells.
@@ -124,10 +123,23 @@ namespace Memory {
         inline T* _Get(){ return m_handleTable == nullptr ? nullptr : static_cast<T*>( m_handleTable->get( m_handle ) ); }
     };
 
+    //**********************************************************************
+    // Limits the work done by one UniversalAllocatorDefragmented::defragmentStep().
+    //**********************************************************************
+    struct DefragmentationBudget
+    {
+        Size    maxBytes        = std::numeric_limits<Size>::max();    // Stop after moving this many bytes
+        F64     maxMilliseconds = std::numeric_limits<F64>::max();     // Stop after this much time
+
+        static DefragmentationBudget Bytes(Size maxBytes)               { DefragmentationBudget budget; budget.maxBytes = maxBytes; return budget; }
+        static DefragmentationBudget Milliseconds(F64 maxMilliseconds)  { DefragmentationBudget budget; budget.maxMilliseconds = maxMilliseconds; return budget; }
+    };
+
     //**********************************************************************
     // Features:
     // [+] Allocations / Deallocations of any size in any order.
-    // [+] Defragmentation is possible via a method.
+    // [+] Defragmentation is possible via a method, also incrementally
+    //     with a budget per call (e.g. once per frame).
     // [-] Pointers are encapsulated in a class which uses a HandleTable
     //     in the background to ensure updated pointers.
     // [-] Less performance and bigger memory footprint than the basic
@@ -136,38 +148,44 @@ namespace Memory {
     class UniversalAllocatorDefragmented
     {
         //**********************************************************************
-        // Represents a used chunk, which can be moved in memory
+        // Represents a used chunk, which can be moved in memory. Every handle
+        // owns exactly one chunk record, which is at the same time a node of
+        // the tree (treap) that orders all used chunks by address.
         //**********************************************************************
         class UsedChunk
         {
         public:
-            // Constructor used for a chunk which should be removed (via std::remove)
-            UsedChunk(Size handle, _HandleTable* handleTable)
-                : m_handle(handle), m_handleTable(handleTable) {}
+            UsedChunk() = default;
 
             template <typename T>
-            UsedChunk(Size handle, Size sizeInBytes, _HandleTable* handleTable, T* type)
-                : m_handle(handle), m_sizeInBytes(sizeInBytes), m_handleTable(handleTable)
+            void set(Size handle, Size sizeInBytes, Size alignment, _HandleTable* handleTable, T* type)
             {
-                m_relocate = &UsedChunk::relocateTemplate<T>;
+                m_handle        = handle;
+                m_sizeInBytes   = sizeInBytes;
+                m_alignment     = alignment;
+                m_handleTable   = handleTable;
+                m_relocate      = &UsedChunk::relocateTemplate<T>;
             }
 
             void  relocate(Byte* newAddress){ (this->*m_relocate)( newAddress ); }
             Byte* getAddress() const { return reinterpret_cast<Byte*>( m_handleTable->get( m_handle ) ); }
             Size  getSizeInBytes() const { return m_sizeInBytes; }
 
-            bool operator <  (const UsedChunk& other) const { return getAddress() < other.getAddress(); }
-            bool operator >  (const UsedChunk& other) const { return getAddress() > other.getAddress(); }
-            bool operator <= (const UsedChunk& other) const { return getAddress() <= other.getAddress(); }
-            bool operator >= (const UsedChunk& other) const { return getAddress() >= other.getAddress(); }
-            bool operator == (const UsedChunk& other) const { return getAddress() == other.getAddress(); }
-            bool operator != (const UsedChunk& other) const { return getAddress() != other.getAddress(); }
+            // Address of the data, if this chunk would be relocated to the given address
+            Byte* getAlignedAddress(Byte* newAddress) const { return alignAddress( newAddress + AMOUNT_OF_BYTES_FOR_OFFSET + AMOUNT_OF_BYTES_FOR_SIZE, m_alignment ); }
+
+            // Tree links as handles. Zero is the invalid handle and marks a missing node.
+            Size    m_left      = 0;
+            Size    m_right     = 0;
+            Size    m_parent    = 0;
+            U32     m_priority  = 0;
 
         private:
-            void (UsedChunk::*m_relocate)(Byte*);
-            _HandleTable*           m_handleTable;
-            Size                    m_handle;
-            Size                    m_sizeInBytes;
+            void (UsedChunk::*m_relocate)(Byte*) = nullptr;
+            _HandleTable*           m_handleTable   = nullptr;
+            Size                    m_handle        = 0;
+            Size                    m_sizeInBytes   = 0;
+            Size                    m_alignment     = 1;
 
             // Relocates this block to the given address
             template <typename T>
@@ -184,7 +202,9 @@ namespace Memory {
         explicit UniversalAllocatorDefragmented(Size amountOfBytes, Size _HandleTableSize, _IParentAllocator* parentAllocator = nullptr);
 
         //----------------------------------------------------------------------
-        // Returns whether an defragmentation is necessary.
+        // Returns whether an defragmentation is necessary. False as well if
+        // the next chunk can't be moved because of its alignment, until the
+        // next allocation or deallocation changes the layout.
         //----------------------------------------------------------------------
         bool canBeDefragmented();
 
@@ -200,6 +220,18 @@ namespace Memory {
         //----------------------------------------------------------------------
         bool defragmentOnce();
 
+        //----------------------------------------------------------------------
+        // Moves used chunks towards the beginning until the budget is used up.
+        // Continues with the chunk after the last one moved by the previous
+        // call, so calling this once per frame spreads the work over frames.
+        // @Params:
+        //  "budget": Bytes to move and/or time to spend. At least one chunk is
+        //            moved per call, so progress is made with any budget.
+        // @Return:
+        //  False, once nothing is left to defragment or nothing can be moved.
+        //----------------------------------------------------------------------
+        bool defragmentStep(const DefragmentationBudget& budget);
+
         //----------------------------------------------------------------------
         // Allocate specified amount of bytes.
         // @Params:
@@ -235,12 +267,33 @@ namespace Memory {
     private:
         UniversalAllocator      m_universalAllocator;
         _HandleTable            m_handleTable;
-        std::vector<UsedChunk>  m_usedChunks;
+        std::vector<UsedChunk>  m_usedChunks;                   // Indexed by handle
+        Size                    m_usedChunksRoot        = 0;    // Handle of the root of the address ordered tree
+        Size                    m_lastRelocatedChunk    = 0;    // Where the next defragmentation step continues
+        bool                    m_isStuck               = false; // The next chunk could not be moved, nothing changes until the layout does
+        U32                     m_prioritySeed          = 0x9E3779B9;
 
         template <typename T>
-        void _AddUsedChunk(Size handle, Size sizeInBytes, T* type);
+        void _AddUsedChunk(Size handle, Size sizeInBytes, Size alignment, T* type);
         void _RemoveUsedChunk(Size handle);
 
+        //----------------------------------------------------------------------
+        // Moves the first used chunk after the first free chunk to the front.
+        // @Return:
+        //  Amount of bytes moved. Zero if nothing could be moved.
+        //----------------------------------------------------------------------
+        Size _RelocateNextChunk();
+
+        //----------------------------------------------------------------------
+        // Address ordered tree of used chunks. Priorities are random, which
+        // keeps the expected depth logarithmic without any rebalancing state.
+        //----------------------------------------------------------------------
+        void _TreeInsert(Size handle);
+        void _TreeRemove(Size handle);
+        void _TreeRotateUp(Size handle);
+        Size _TreeNext(Size handle) const;
+        Size _TreeFindFirstAfter(Byte* address) const; // First chunk whose address is greater, zero if none
+
         UniversalAllocatorDefragmented(const UniversalAllocatorDefragmented& other)                 = delete;
         UniversalAllocatorDefragmented& operator = (const UniversalAllocatorDefragmented& other)    = delete;
         UniversalAllocatorDefragmented(UniversalAllocatorDefragmented&& other)                      = delete;
@@ -261,7 +314,7 @@ namespace Memory {
         Size nextFreeHandle = m_handleTable.nextFreeHandle();
         m_handleTable[nextFreeHandle] = mem;
 
-        _AddUsedChunk(nextFreeHandle, amountOfObjects * sizeof(T), mem);
+        _AddUsedChunk( nextFreeHandle, amountOfObjects * sizeof(T), alignof(T), mem );
 
         return UAPtr<T>( &m_handleTable, nextFreeHandle );
     }
@@ -283,10 +336,11 @@ namespace Memory {
 
     //----------------------------------------------------------------------
     template <typename T>
-    void UniversalAllocatorDefragmented::_AddUsedChunk(Size handle, Size sizeInBytes, T* type)
+    void UniversalAllocatorDefragmented::_AddUsedChunk(Size handle, Size sizeInBytes, Size alignment, T* type)
     {
-        m_usedChunks.push_back(UsedChunk(handle, sizeInBytes, &m_handleTable, type));
-        std::sort(m_usedChunks.begin(), m_usedChunks.end());
+        m_usedChunks[handle].set( handle, sizeInBytes, alignment, &m_handleTable, type );
+        _TreeInsert( handle );
+        m_isStuck = false;
     }
 
     //**********************************************************************
@@ -301,8 +355,7 @@ namespace Memory {
         Byte* currentAddress = getAddress();
 
         // Determine new aligned address
-        U8 additionalBytes = AMOUNT_OF_BYTES_FOR_OFFSET + AMOUNT_OF_BYTES_FOR_SIZE;
-        Byte* alignedAddress = alignAddress( newAddr + additionalBytes, alignof(T) );
+        Byte* alignedAddress = getAlignedAddress( newAddr );
 
         // Save offset and amountOfBytes
         Byte offset = static_cast<Byte>(alignedAddress - newAddr);
@@ -9,48 +9,128 @@
 
 **********************************************************************/
 
+#include <atomic>
+
 namespace OS {
 
+    class JobQueue;
+    class JobPool;
+
+    //----------------------------------------------------------------------
+    #define JOB_SIZE_IN_BYTES       128
+    #define JOB_CALLABLE_ALIGNMENT  16
+
     //**********************************************************************
-    // Represents a job, which will be executed by a thread.
+    // Represents a job, which will be executed by a thread. Jobs are
+    // fixed-size records which live in a JobPool and get reused once
+    // executed. The callable is stored inside the record, only callables
+    // which don't fit are allocated on the heap.
     //**********************************************************************
-    class Job
+    class alignas(64) Job
     {
     public:
-        Job(const std::function<void()>& job = nullptr)
-            : m_job( job )
-        {}
+        Job() = default;
+        ~Job() { _Destroy(); }
 
         //----------------------------------------------------------------------
-        // Wait until a thread has completed its execution.
+        // Executes the job.
         //----------------------------------------------------------------------
-        void wait()
+        void operator() () { m_invoke( m_storage ); }
+
+        //----------------------------------------------------------------------
+        // Incremented each time the job is finished. A handle is done as
+        // soon as the generation differs from the one it was created with.
+        //----------------------------------------------------------------------
+        U32 getGeneration() const { return m_generation.load( std::memory_order_acquire ); }
+
+    private:
+        using InvokeFunc    = void(*)(void*);
+        using DestroyFunc   = void(*)(void*);
+
+        static constexpr Size HEADER_SIZE  = (sizeof( InvokeFunc ) + sizeof( DestroyFunc ) + sizeof( JobQueue* ) + 3 * sizeof( U32 ) + 7) & ~7;
+        static constexpr Size STORAGE_SIZE = JOB_SIZE_IN_BYTES - HEADER_SIZE;
+
+        alignas(JOB_CALLABLE_ALIGNMENT) Byte    m_storage[STORAGE_SIZE];
+        InvokeFunc                              m_invoke    = nullptr;
+        DestroyFunc                             m_destroy   = nullptr;
+        JobQueue*                               m_queue     = nullptr;  // Queue which owns the pool of this job
+        std::atomic<U32>                        m_generation{ 0 };
+        std::atomic<U32>                        m_nextFree{ 0 };        // Index of the next free job, only used by the JobPool
+        U32                                     m_index     = 0;        // Index of this job in the JobPool
+
+        //----------------------------------------------------------------------
+        // Stores the given callable, either inplace or on the heap.
+        //----------------------------------------------------------------------
+        template <typename F>
+        void _Set(F&& func)
         {
-            std::unique_lock<std::mutex> lock( m_mutex );
-            m_cv.wait( lock, [this]() -> bool { return m_done; } );
+            using Func = std::decay_t<F>;
+            if constexpr ( sizeof( Func ) <= STORAGE_SIZE && alignof( Func ) <= JOB_CALLABLE_ALIGNMENT )
+            {
+                new (m_storage) Func( std::forward<F>( func ) );
+                m_invoke  = [](void* storage) { (*reinterpret_cast<Func*>( storage ))(); };
+                m_destroy = [](void* storage) { reinterpret_cast<Func*>( storage )->~Func(); };
+            }
+            else
+            {
+                *reinterpret_cast<Func**>( m_storage ) = new Func( std::forward<F>( func ) );
+                m_invoke  = [](void* storage) { (**reinterpret_cast<Func**>( storage ))(); };
+                m_destroy = [](void* storage) { delete *reinterpret_cast<Func**>( storage ); };
+            }
         }
 
         //----------------------------------------------------------------------
-        // Executes the job. Notify possible waiting threads when it's done.
+        // Destroys the callable. Captured resources are freed before waiters return.
         //----------------------------------------------------------------------
-        void operator() () 
+        void _Destroy()
         {
-            std::unique_lock<std::mutex> lock( m_mutex );
-            m_job();
-
-            m_done = true;
-            m_cv.notify_all();
+            if (m_destroy)
+                m_destroy( m_storage );
+            m_invoke = nullptr;
+            m_destroy = nullptr;
         }
 
-    private:
-        std::function<void()>       m_job;
-        std::mutex                  m_mutex;
-        std::condition_variable     m_cv;
-        bool                        m_done = false;
+        friend class JobQueue;
+        friend class JobPool;
+        friend class JobHandle;
+
+        //----------------------------------------------------------------------
+        Job(const Job& other)                 = delete;
+        Job& operator = (const Job& other)    = delete;
+        Job(Job&& other)                      = delete;
+        Job& operator = (Job&& other)         = delete;
     };
+    static_assert( sizeof( Job ) == JOB_SIZE_IN_BYTES, "Job record has an unexpected size." );
 
-    //----------------------------------------------------------------------
-    using JobPtr = std::shared_ptr<Job>;
+    //**********************************************************************
+    // Refers to one execution of a job. Stays valid after the job record
+    // was reused, because the generation will not match anymore.
+    //**********************************************************************
+    class JobHandle
+    {
+    public:
+        JobHandle() = default;
+        explicit JobHandle(Job* job) : m_job( job ), m_generation( job->getGeneration() ) {}
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  True, if the job was executed (or the handle is empty).
+        //----------------------------------------------------------------------
+        bool isDone() const { return m_job == nullptr or m_job->getGeneration() != m_generation; }
+
+        //----------------------------------------------------------------------
+        // Wait until a thread has completed its execution. Worker threads
+        // execute other jobs in the meantime.
+        //----------------------------------------------------------------------
+        void wait() const;
+
+        //----------------------------------------------------------------------
+        bool isValid() const { return m_job != nullptr; }
+
+    private:
+        Job*    m_job           = nullptr;
+        U32     m_generation    = 0;
+    };
 
 
-} // end namespaces
\ No newline at end of file
+} // end namespaces
@@ -0,0 +1,94 @@
+#include "job_graph.h"
+/**********************************************************************
+    class: JobGraph (job_graph.cpp)
+
+    author: S. Hau
+    date: October 17, 2026
+**********************************************************************/
+
+namespace OS {
+
+    //----------------------------------------------------------------------
+    JobGraph::NodeID JobGraph::add( const std::function<void()>& job, std::initializer_list<NodeID> predecessors )
+    {
+        NodeID id = static_cast<NodeID>( m_nodes.size() );
+        m_nodes.emplace_back();
+        m_nodes.back().job = job;
+
+        for (NodeID predecessor : predecessors)
+            addEdge( predecessor, id );
+
+        return id;
+    }
+
+    //----------------------------------------------------------------------
+    void JobGraph::addEdge( NodeID predecessor, NodeID successor )
+    {
+        ASSERT( predecessor < m_nodes.size() && successor < m_nodes.size() && predecessor != successor );
+        m_nodes[predecessor].successors.push_back( successor );
+        m_nodes[successor].numPredecessors++;
+    }
+
+    //----------------------------------------------------------------------
+    void JobGraph::clear()
+    {
+        ASSERT( m_unfinishedNodes.load() == 0 && "JobGraph::clear(): Graph is still executing." );
+        m_nodes.clear();
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void JobGraph::_Reset( Job* sink )
+    {
+        ASSERT( m_unfinishedNodes.load() == 0 && "JobGraph: Graph was submitted again before it finished." );
+    #ifdef _DEBUG
+        ASSERT( _IsAcyclic() && "JobGraph: Dependencies contain a cycle." );
+    #endif
+
+        U32 numNodes = size();
+        if (m_pendingPredecessorsSize < numNodes)
+        {
+            m_pendingPredecessors.reset( new std::atomic<U32>[numNodes] );
+            m_pendingPredecessorsSize = numNodes;
+        }
+
+        for (U32 i = 0; i < numNodes; i++)
+            m_pendingPredecessors[i].store( m_nodes[i].numPredecessors, std::memory_order_relaxed );
+        m_unfinishedNodes.store( numNodes, std::memory_order_relaxed );
+
+        m_sink = sink;
+    }
+
+    //----------------------------------------------------------------------
+    bool JobGraph::_IsAcyclic() const
+    {
+        // Kahn's algorithm: Every node must be visited once all its predecessors were visited
+        ArrayList<U32>      predecessors( m_nodes.size() );
+        ArrayList<NodeID>   ready;
+        for (NodeID i = 0; i < m_nodes.size(); i++)
+        {
+            predecessors[i] = m_nodes[i].numPredecessors;
+            if (predecessors[i] == 0)
+                ready.push_back( i );
+        }
+
+        U32 numVisited = 0;
+        while ( not ready.empty() )
+        {
+            NodeID node = ready.back();
+            ready.pop_back();
+            numVisited++;
+
+            for (NodeID successor : m_nodes[node].successors)
+                if (--predecessors[successor] == 0)
+                    ready.push_back( successor );
+        }
+
+        return numVisited == m_nodes.size();
+    }
+
+
+} // end namespaces
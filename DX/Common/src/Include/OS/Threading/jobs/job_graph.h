@@ -0,0 +1,102 @@
+#pragma once
+/**********************************************************************
+    class: JobGraph (job_graph.h)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    See below for a class description.
+
+**********************************************************************/
+
+#include "job.hpp"
+#include <atomic>
+
+namespace OS {
+
+    class ThreadPool;
+
+    //**********************************************************************
+    // Describes a set of jobs and the order in which they must run. Every
+    // job keeps an atomic counter of unfinished predecessors. A finished
+    // job decrements the counters of its successors and enqueues every
+    // successor whose counter reaches zero, so no thread ever blocks
+    // between two dependent jobs. Submit it via ThreadPool::addJobGraph(),
+    // which returns a single handle (the sink) to wait on.
+    // @Considerations:
+    //  - The graph must stay alive and unchanged until the sink is done.
+    //    It can be submitted again afterwards, e.g. once per frame.
+    //  - Successors run on the thread which finished the last predecessor
+    //    unless they get stolen.
+    //**********************************************************************
+    class JobGraph
+    {
+    public:
+        using NodeID = U32;
+
+        JobGraph() = default;
+        ~JobGraph() = default;
+
+        //----------------------------------------------------------------------
+        // Adds a new job to the graph.
+        // @Params:
+        //  "job": Job/Task to execute.
+        //  "predecessors": Jobs which have to be finished before this one starts.
+        // @Return:
+        //  ID of the job, used to declare it as a predecessor of other jobs.
+        //----------------------------------------------------------------------
+        NodeID add(const std::function<void()>& job, std::initializer_list<NodeID> predecessors = {});
+
+        //----------------------------------------------------------------------
+        // Declares that "successor" must not start before "predecessor" is done.
+        //----------------------------------------------------------------------
+        void addEdge(NodeID predecessor, NodeID successor);
+
+        //----------------------------------------------------------------------
+        // Removes all jobs. Must not be called while the graph is executing.
+        //----------------------------------------------------------------------
+        void clear();
+
+        //----------------------------------------------------------------------
+        U32  size()  const { return static_cast<U32>( m_nodes.size() ); }
+        bool empty() const { return m_nodes.empty(); }
+
+    private:
+        struct Node
+        {
+            std::function<void()>   job;
+            ArrayList<NodeID>       successors;
+            U32                     numPredecessors = 0;
+        };
+
+        ArrayList<Node>                     m_nodes;
+
+        // Execution state, reset on every submit
+        std::unique_ptr<std::atomic<U32>[]> m_pendingPredecessors;
+        U32                                 m_pendingPredecessorsSize = 0;
+        std::atomic<U32>                    m_unfinishedNodes{ 0 };
+        Job*                                m_sink = nullptr;
+
+        //----------------------------------------------------------------------
+        // Resets the execution state and sets the job which will be released
+        // once every job of the graph is done.
+        //----------------------------------------------------------------------
+        void _Reset(Job* sink);
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  True, if every job can be reached in topological order (no cycles).
+        //----------------------------------------------------------------------
+        bool _IsAcyclic() const;
+
+        friend class ThreadPool;
+
+        //----------------------------------------------------------------------
+        JobGraph(const JobGraph& other)                 = delete;
+        JobGraph& operator = (const JobGraph& other)    = delete;
+        JobGraph(JobGraph&& other)                      = delete;
+        JobGraph& operator = (JobGraph&& other)         = delete;
+    };
+
+
+} // end namespaces
@@ -0,0 +1,99 @@
+#include "job_pool.h"
+/**********************************************************************
+    class: JobPool (job_pool.cpp)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    @Considerations:
+      - A popping thread might read "m_nextFree" of a job which was
+        popped and reused by another thread in the meantime. The tag
+        makes the following compare exchange fail in that case.
+**********************************************************************/
+
+namespace OS {
+
+    //----------------------------------------------------------------------
+    static inline U32 GetIndex(U64 freeList)    { return static_cast<U32>( freeList ); }
+    static inline U64 NextTag(U64 freeList)     { return ((freeList >> 32) + 1) << 32; }
+
+    //----------------------------------------------------------------------
+    JobPool::~JobPool()
+    {
+        for (U32 i = 0; i < m_numChunks; i++)
+            delete[] m_chunks[i];
+    }
+
+    //----------------------------------------------------------------------
+    void JobPool::free( Job* job )
+    {
+        ASSERT( job->m_invoke == nullptr );
+
+        U64 oldFreeList = m_freeList.load( std::memory_order_relaxed );
+        U64 newFreeList;
+        do
+        {
+            job->m_nextFree.store( GetIndex( oldFreeList ), std::memory_order_relaxed );
+            newFreeList = NextTag( oldFreeList ) | job->m_index;
+        } while ( not m_freeList.compare_exchange_weak( oldFreeList, newFreeList, std::memory_order_release, std::memory_order_relaxed ) );
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    Job* JobPool::_Pop()
+    {
+        U64 oldFreeList = m_freeList.load( std::memory_order_acquire );
+        while (true)
+        {
+            U32 index = GetIndex( oldFreeList );
+            if (index == INVALID_INDEX)
+            {
+                _Grow();
+                oldFreeList = m_freeList.load( std::memory_order_acquire );
+                continue;
+            }
+
+            Job& job = _Get( index );
+            U64 newFreeList = NextTag( oldFreeList ) | job.m_nextFree.load( std::memory_order_relaxed );
+            if ( m_freeList.compare_exchange_weak( oldFreeList, newFreeList, std::memory_order_acquire, std::memory_order_acquire ) )
+                return &job;
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void JobPool::_Grow()
+    {
+        std::lock_guard<std::mutex> lock( m_growMutex );
+
+        // Another thread might have grown the pool or freed a job in the meantime
+        if (GetIndex( m_freeList.load( std::memory_order_acquire ) ) != INVALID_INDEX)
+            return;
+
+        ASSERT( m_numChunks < JOB_POOL_MAX_CHUNKS && "JobPool: Too many jobs at the same time." );
+
+        Job* chunk = new Job[JOB_POOL_CHUNK_SIZE];
+        U32 firstIndex = m_numChunks * JOB_POOL_CHUNK_SIZE;
+        for (U32 i = 0; i < JOB_POOL_CHUNK_SIZE; i++)
+        {
+            chunk[i].m_queue = m_queue;
+            chunk[i].m_index = firstIndex + i;
+            chunk[i].m_nextFree.store( firstIndex + i + 1, std::memory_order_relaxed );
+        }
+        m_chunks[m_numChunks++] = chunk;
+
+        // Link the whole chunk in front of the free list
+        Job& last = chunk[JOB_POOL_CHUNK_SIZE - 1];
+        U64 oldFreeList = m_freeList.load( std::memory_order_relaxed );
+        U64 newFreeList;
+        do
+        {
+            last.m_nextFree.store( GetIndex( oldFreeList ), std::memory_order_relaxed );
+            newFreeList = NextTag( oldFreeList ) | firstIndex;
+        } while ( not m_freeList.compare_exchange_weak( oldFreeList, newFreeList, std::memory_order_release, std::memory_order_relaxed ) );
+    }
+
+
+} // end namespaces
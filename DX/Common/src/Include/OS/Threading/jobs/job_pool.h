@@ -0,0 +1,78 @@
+#pragma once
+/**********************************************************************
+    class: JobPool (job_pool.h)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    See below for a class description.
+
+**********************************************************************/
+
+#include "job.hpp"
+#include <mutex>
+
+namespace OS {
+
+    //----------------------------------------------------------------------
+    #define JOB_POOL_CHUNK_SIZE     1024
+    #define JOB_POOL_MAX_CHUNKS     1024    // Limits the amount of jobs which can exist at the same time
+
+    //**********************************************************************
+    // Hands out job records from a lock-free free list. Records are
+    // allocated in chunks and never freed before the pool is destroyed,
+    // so handles can always check the generation of a reused record.
+    //**********************************************************************
+    class JobPool
+    {
+    public:
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "queue": Queue which executes the jobs of this pool.
+        //----------------------------------------------------------------------
+        JobPool(JobQueue* queue) : m_queue( queue ) {}
+        ~JobPool();
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  A free job record which stores the given callable.
+        //----------------------------------------------------------------------
+        template <typename F>
+        Job* allocate(F&& func)
+        {
+            Job* job = _Pop();
+            job->_Set( std::forward<F>( func ) );
+            return job;
+        }
+
+        //----------------------------------------------------------------------
+        // Returns the given job to the pool. The callable must already be destroyed.
+        //----------------------------------------------------------------------
+        void free(Job* job);
+
+    private:
+        JobQueue*               m_queue;
+
+        // Lower 32 bits: Index of the first free job. Upper 32 bits: Tag which prevents the ABA problem.
+        std::atomic<U64>        m_freeList{ INVALID_INDEX };
+
+        std::mutex              m_growMutex;
+        Job*                    m_chunks[JOB_POOL_MAX_CHUNKS] = {};
+        U32                     m_numChunks = 0;
+
+        static constexpr U32    INVALID_INDEX = ~0u;
+
+        //----------------------------------------------------------------------
+        Job&    _Get(U32 index) { return m_chunks[index / JOB_POOL_CHUNK_SIZE][index % JOB_POOL_CHUNK_SIZE]; }
+        Job*    _Pop();
+        void    _Grow();
+
+        //----------------------------------------------------------------------
+        JobPool(const JobPool& other)                 = delete;
+        JobPool& operator = (const JobPool& other)    = delete;
+        JobPool(JobPool&& other)                      = delete;
+        JobPool& operator = (JobPool&& other)         = delete;
+    };
+
+
+} // end namespaces
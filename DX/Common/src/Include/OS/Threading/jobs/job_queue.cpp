@@ -1,7 +1,7 @@
 #include "job_queue.h"
 /**********************************************************************
     class: JobQueue (job_queue.cpp)
-    
+
     author: S. Hau
     date: October 22, 2017
 **********************************************************************/
@@ -9,44 +9,271 @@
 namespace OS {
 
         //----------------------------------------------------------------------
-        void JobQueue::addJob(JobPtr job)
+        // How often a worker searches for a job before it goes to sleep.
+        #define JOB_QUEUE_SPIN_COUNT    64
+
+        //----------------------------------------------------------------------
+        // Set for worker threads on their first grabJob(). Used to push jobs
+        // added from within a job into the workers own deque.
+        static thread_local JobQueue*   t_workerQueue = nullptr;
+        static thread_local U8          t_workerIndex = 0;
+
+        //----------------------------------------------------------------------
+        // Xorshift random number generator for choosing a victim to steal from.
+        static inline U32 NextRandom(U32& state)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        //----------------------------------------------------------------------
+        JobQueue::JobQueue( U8 numWorkers )
+            : m_jobPool( this ), m_workers( new Worker[numWorkers] ), m_numWorkers( numWorkers )
+        {
+            ASSERT( m_numWorkers > 0 );
+            for (U8 i = 0; i < m_numWorkers; i++)
+                m_workers[i].randomState = 2654435761u * (i + 1);
+        }
+
+        //----------------------------------------------------------------------
+        void JobQueue::addJob(Job* job)
         {
-            // Add job to queue
+            ASSERT( job != nullptr );
+
+            // Count it before it becomes visible, otherwise it could finish uncounted
+            m_unfinishedJobs.fetch_add( 1 );
+
+            if (t_workerQueue == this)
             {
-                std::unique_lock<std::mutex> lock( m_mutex );
-                m_jobs.push( job );
+                // Called from within a job, the worker owns this deque
+                m_workers[t_workerIndex].deque.push( job );
+            }
+            else
+            {
+                Worker& worker = m_workers[m_nextInbox.fetch_add( 1, std::memory_order_relaxed ) % m_numWorkers];
+                std::lock_guard<std::mutex> lock( worker.inboxMutex );
+                worker.inbox.push_back( job );
+                worker.inboxSize.fetch_add( 1, std::memory_order_release );
             }
 
-            // Notify a thread that a job is available
-            m_jobCV.notify_one();
+            // Notify a thread that a job is available. If a worker was faster
+            // grabbing the job than us incrementing the counter, the queue
+            // just became empty again instead.
+            if (m_pendingJobs.fetch_add( 1 ) == -1)
+                _NotifyWaiters();
+            else if (m_numSleeping.load() > 0)
+            {
+                std::lock_guard<std::mutex> lock( m_sleepMutex );
+                m_jobCV.notify_one();
+            }
         }
 
         //----------------------------------------------------------------------
-        JobPtr JobQueue::grabJob()
+        Job* JobQueue::grabJob( U8 workerIndex )
         {
-            // Lock access to queue
-            std::unique_lock<std::mutex> lock( m_mutex );
+            ASSERT( workerIndex < m_numWorkers );
+            t_workerQueue = this;
+            t_workerIndex = workerIndex;
 
-            // Wait if no job is available
-            m_jobCV.wait( lock, [this]() -> bool { 
-                return !m_jobs.empty(); 
-            } );
+            while (true)
+            {
+                Job* job = nullptr;
+                for (I32 i = 0; i < JOB_QUEUE_SPIN_COUNT; ++i)
+                {
+                    if ( _TryGetJob( workerIndex, job ) )
+                        return _TakeJob( job );
 
-            // Retrieve next job
-            JobPtr job = m_jobs.front();
-            m_jobs.pop();
+                    if ( m_shutdown.load() && m_pendingJobs.load() <= 0 )
+                        return nullptr;
 
-            if ( m_jobs.empty() )
-                m_isEmptyCV.notify_all();
+                    std::this_thread::yield();
+                }
 
-            return job;
+                // Nothing found, so go to sleep until a job arrives
+                std::unique_lock<std::mutex> lock( m_sleepMutex );
+                m_numSleeping.fetch_add( 1 );
+                m_jobCV.wait( lock, [this]() -> bool {
+                    return m_pendingJobs.load() > 0 || m_shutdown.load();
+                } );
+                m_numSleeping.fetch_sub( 1 );
+            }
+        }
+
+        //----------------------------------------------------------------------
+        void JobQueue::finishJob( Job* job )
+        {
+            releaseJob( job );
+
+            if (m_unfinishedJobs.fetch_sub( 1 ) == 1)
+                _NotifyWaiters();
+        }
+
+        //----------------------------------------------------------------------
+        void JobQueue::releaseJob( Job* job )
+        {
+            job->_Destroy();
+            job->m_generation.fetch_add( 1, std::memory_order_acq_rel );
+            m_jobPool.free( job );
+
+            // Someone might wait for exactly this job
+            _NotifyJobWaiters();
+        }
+
+        //----------------------------------------------------------------------
+        void JobQueue::waitForJob( const JobHandle& handle )
+        {
+            // A waiting worker executes other jobs, otherwise waiting from within a job could starve the pool
+            if (t_workerQueue == this)
+            {
+                while ( not handle.isDone() )
+                {
+                    Job* job = nullptr;
+                    if ( _TryGetJob( t_workerIndex, job ) )
+                    {
+                        (*_TakeJob( job ))();
+                        finishJob( job );
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                return;
+            }
+
+            for (I32 i = 0; i < JOB_QUEUE_SPIN_COUNT; ++i)
+            {
+                if ( handle.isDone() )
+                    return;
+                std::this_thread::yield();
+            }
+
+            std::unique_lock<std::mutex> lock( m_sleepMutex );
+            m_numJobWaiters.fetch_add( 1 );
+            m_waitCV.wait( lock, [&handle]() -> bool { return handle.isDone(); } );
+            m_numJobWaiters.fetch_sub( 1 );
         }
 
         //----------------------------------------------------------------------
         void JobQueue::waitUntilQueueIsEmpty()
         {
-            std::unique_lock<std::mutex> lock( m_mutex );
-            m_isEmptyCV.wait( lock, [this]() -> bool { return m_jobs.empty(); } );
+            std::unique_lock<std::mutex> lock( m_sleepMutex );
+            m_numWaiters.fetch_add( 1 );
+            m_waitCV.wait( lock, [this]() -> bool { return m_pendingJobs.load() <= 0; } );
+            m_numWaiters.fetch_sub( 1 );
+        }
+
+        //----------------------------------------------------------------------
+        void JobQueue::waitUntilAllJobsAreDone()
+        {
+            std::unique_lock<std::mutex> lock( m_sleepMutex );
+            m_numWaiters.fetch_add( 1 );
+            m_waitCV.wait( lock, [this]() -> bool { return m_unfinishedJobs.load() <= 0; } );
+            m_numWaiters.fetch_sub( 1 );
+        }
+
+        //----------------------------------------------------------------------
+        void JobQueue::shutdown()
+        {
+            m_shutdown.store( true );
+
+            std::lock_guard<std::mutex> lock( m_sleepMutex );
+            m_jobCV.notify_all();
+        }
+
+        //**********************************************************************
+        // PRIVATE
+        //**********************************************************************
+
+        //----------------------------------------------------------------------
+        bool JobQueue::_TryGetJob( U8 workerIndex, Job*& job )
+        {
+            Worker& self = m_workers[workerIndex];
+
+            // Own work first
+            if ( self.deque.pop( job ) )
+                return true;
+
+            if ( _TryPopInbox( self, job ) )
+                return true;
+
+            // Visit every other worker once, starting at a random victim
+            U32 start = NextRandom( self.randomState );
+            for (U8 i = 0; i < m_numWorkers; i++)
+            {
+                U8 victimIndex = (start + i) % m_numWorkers;
+                if (victimIndex == workerIndex)
+                    continue;
+
+                Worker& victim = m_workers[victimIndex];
+                if ( victim.deque.steal( job ) )
+                    return true;
+
+                if ( _TryPopInbox( victim, job ) )
+                    return true;
+            }
+
+            return false;
+        }
+
+        //----------------------------------------------------------------------
+        bool JobQueue::_TryPopInbox( Worker& worker, Job*& job )
+        {
+            // Avoid taking the lock if there is nothing to get
+            if (worker.inboxSize.load( std::memory_order_acquire ) == 0)
+                return false;
+
+            std::lock_guard<std::mutex> lock( worker.inboxMutex );
+            if ( worker.inbox.empty() )
+                return false;
+
+            job = worker.inbox.front();
+            worker.inbox.pop_front();
+            worker.inboxSize.fetch_sub( 1, std::memory_order_relaxed );
+
+            return true;
+        }
+
+        //----------------------------------------------------------------------
+        Job* JobQueue::_TakeJob( Job* job )
+        {
+            if (m_pendingJobs.fetch_sub( 1 ) == 1)
+                _NotifyWaiters();
+
+            return job;
+        }
+
+        //----------------------------------------------------------------------
+        void JobQueue::_NotifyWaiters()
+        {
+            if (m_numWaiters.load() > 0)
+            {
+                std::lock_guard<std::mutex> lock( m_sleepMutex );
+                m_waitCV.notify_all();
+            }
+        }
+
+        //----------------------------------------------------------------------
+        void JobQueue::_NotifyJobWaiters()
+        {
+            if (m_numJobWaiters.load() > 0)
+            {
+                std::lock_guard<std::mutex> lock( m_sleepMutex );
+                m_waitCV.notify_all();
+            }
+        }
+
+        //**********************************************************************
+        // JobHandle
+        //**********************************************************************
+
+        //----------------------------------------------------------------------
+        void JobHandle::wait() const
+        {
+            if ( not isDone() )
+                m_job->m_queue->waitForJob( *this );
         }
 
 
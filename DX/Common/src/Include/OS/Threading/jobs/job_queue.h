@@ -1,7 +1,7 @@
 #pragma once
 /**********************************************************************
     class: JobQueue (job_queue.h)
-    
+
     author: S. Hau
     date: October 22, 2017
 
@@ -9,44 +9,122 @@
 
 **********************************************************************/
 
-#include "job.hpp"
+#include "job_pool.h"
+#include "work_stealing_deque.hpp"
+#include <deque>
 
 namespace OS {
 
     //**********************************************************************
-    // Contains a queue in which jobs can be put in. When a job is added
-    // a thread will be notified to execute it. If no thread is idle
-    // the job's execution will be deferred until a thread becomes idle.
+    // Distributes jobs across a fixed amount of worker threads. Every
+    // worker owns a work stealing deque and an inbox. Jobs added by a
+    // worker go into its own deque, jobs added from any other thread are
+    // distributed round robin across the inboxes. A worker without work
+    // steals from a random victim before it goes to sleep. Jobs are
+    // taken from a JobPool and returned once they were executed.
     //**********************************************************************
     class JobQueue
     {
     public:
-        JobQueue() = default;
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "numWorkers": Amount of worker threads which will grab jobs.
+        //----------------------------------------------------------------------
+        JobQueue(U8 numWorkers);
+        ~JobQueue() = default;
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  A new job from the pool which executes the given callable. It must
+        //  either be added via addJob() or returned via releaseJob().
+        //----------------------------------------------------------------------
+        template <typename F>
+        Job* createJob(F&& func) { return m_jobPool.allocate( std::forward<F>( func ) ); }
 
         //----------------------------------------------------------------------
         // Add a new to the queue. The job will be executed by an arbitrary
         // thread immediately if one is idle. Otherwise the execution will
         // deferred until a thread will pick it up.
         //----------------------------------------------------------------------
-        void addJob(JobPtr job);
+        void addJob(Job* job);
+
+        //----------------------------------------------------------------------
+        // Grab a job for the given worker. If no job can be found anywhere,
+        // the thread goes to sleep until a job arrives. Only one thread will
+        // get the job.
+        // @Return:
+        //  The job to execute or nullptr if the queue was shut down.
+        //----------------------------------------------------------------------
+        Job* grabJob(U8 workerIndex);
+
+        //----------------------------------------------------------------------
+        // Must be called by a worker after it has executed a grabbed job.
+        //----------------------------------------------------------------------
+        void finishJob(Job* job);
+
+        //----------------------------------------------------------------------
+        // Marks the given job as done without executing it and returns it to
+        // the pool. Only for jobs which were never added to the queue.
+        //----------------------------------------------------------------------
+        void releaseJob(Job* job);
 
         //----------------------------------------------------------------------
-        // Grab a job from the queue. If the queue is empty, the thread goes
-        // to sleep until a job arrives. If more than one thread waits only
-        // the CHOSEN ONE will get the job.
+        // Wait until the job of the given handle has been executed. A worker
+        // of this queue executes other jobs in the meantime.
         //----------------------------------------------------------------------
-        JobPtr grabJob();
+        void waitForJob(const JobHandle& handle);
 
         //----------------------------------------------------------------------
         // Wait until the queue becomes empty. Returns immediately if already empty.
         //----------------------------------------------------------------------
         void waitUntilQueueIsEmpty();
 
+        //----------------------------------------------------------------------
+        // Wait until every added job has been executed, including jobs which
+        // were added from within other jobs in the meantime.
+        //----------------------------------------------------------------------
+        void waitUntilAllJobsAreDone();
+
+        //----------------------------------------------------------------------
+        // Wakes up all workers. Once every remaining job has been grabbed,
+        // grabJob() returns nullptr.
+        //----------------------------------------------------------------------
+        void shutdown();
+
     private:
-        std::queue<JobPtr>          m_jobs;
-        std::mutex                  m_mutex;
+        struct Worker
+        {
+            WorkStealingDeque<Job*>     deque;
+            std::mutex                  inboxMutex;
+            std::deque<Job*>            inbox;
+            std::atomic<U32>            inboxSize{ 0 };
+            U32                         randomState = 0;
+        };
+
+        JobPool                     m_jobPool;
+        std::unique_ptr<Worker[]>   m_workers;
+        U8                          m_numWorkers;
+
+        // Can become negative for a short time, when a job gets grabbed
+        // before the adding thread has incremented the counter.
+        std::atomic<I64>            m_pendingJobs{ 0 };
+        std::atomic<I64>            m_unfinishedJobs{ 0 };
+        std::atomic<U32>            m_nextInbox{ 0 };
+        std::atomic<U32>            m_numSleeping{ 0 };
+        std::atomic<U32>            m_numWaiters{ 0 };
+        std::atomic<U32>            m_numJobWaiters{ 0 };  // Threads waiting for a single job
+        std::atomic<bool>           m_shutdown{ false };
+
+        std::mutex                  m_sleepMutex;
         std::condition_variable     m_jobCV;
-        std::condition_variable     m_isEmptyCV;
+        std::condition_variable     m_waitCV;
+
+        //----------------------------------------------------------------------
+        bool    _TryGetJob(U8 workerIndex, Job*& job);
+        bool    _TryPopInbox(Worker& worker, Job*& job);
+        Job*    _TakeJob(Job* job);
+        void    _NotifyWaiters();
+        void    _NotifyJobWaiters();
 
         //----------------------------------------------------------------------
         JobQueue(const JobQueue& other)                 = delete;
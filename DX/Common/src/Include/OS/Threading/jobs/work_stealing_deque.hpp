@@ -0,0 +1,164 @@
+#pragma once
+/**********************************************************************
+    class: WorkStealingDeque (work_stealing_deque.hpp)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Chase-Lev work stealing deque as described in "Correct and
+    Efficient Work-Stealing for Weak Memory Models" (Le et al. 2013).
+    The owning thread pushes and pops at the bottom (LIFO), while any
+    other thread can steal from the top (FIFO) without taking a lock.
+    @Considerations:
+      - Retired buffers are only freed in the destructor, because a
+        thief might still read from them after a grow.
+**********************************************************************/
+
+#include <atomic>
+
+namespace OS {
+
+    //**********************************************************************
+    // Lock-free single producer / multiple consumer deque.
+    // T must be trivially copyable (e.g. a pointer).
+    //**********************************************************************
+    template <typename T>
+    class WorkStealingDeque
+    {
+        struct Buffer
+        {
+            Buffer(I64 capacity) : capacity( capacity ), mask( capacity - 1 ), data( new std::atomic<T>[capacity] ) {}
+            ~Buffer() { delete[] data; }
+
+            T    get(I64 i) const      { return data[i & mask].load( std::memory_order_relaxed ); }
+            void put(I64 i, T item)    { data[i & mask].store( item, std::memory_order_relaxed ); }
+
+            I64                 capacity;
+            I64                 mask;
+            std::atomic<T>*     data;
+        };
+
+    public:
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "capacity": Initial capacity. Must be a power of two.
+        //----------------------------------------------------------------------
+        WorkStealingDeque(I64 capacity = 1024)
+            : m_buffer( new Buffer( capacity ) )
+        {
+            ASSERT( (capacity > 0) && ((capacity & (capacity - 1)) == 0) );
+        }
+
+        ~WorkStealingDeque()
+        {
+            delete m_buffer.load();
+            for (auto buffer : m_retiredBuffers)
+                delete buffer;
+        }
+
+        //----------------------------------------------------------------------
+        // Push an item at the bottom. May only be called by the owner thread.
+        //----------------------------------------------------------------------
+        void push(T item)
+        {
+            I64 b = m_bottom.load( std::memory_order_relaxed );
+            I64 t = m_top.load( std::memory_order_acquire );
+            Buffer* buffer = m_buffer.load( std::memory_order_relaxed );
+
+            if ( (b - t) > (buffer->capacity - 1) )
+                buffer = _Grow( buffer, b, t );
+
+            buffer->put( b, item );
+            m_bottom.store( b + 1, std::memory_order_release );
+        }
+
+        //----------------------------------------------------------------------
+        // Pop an item from the bottom. May only be called by the owner thread.
+        // @Return:
+        //  True if an item was popped and written to "item".
+        //----------------------------------------------------------------------
+        bool pop(T& item)
+        {
+            I64 b = m_bottom.load( std::memory_order_relaxed ) - 1;
+            Buffer* buffer = m_buffer.load( std::memory_order_relaxed );
+            m_bottom.store( b, std::memory_order_relaxed );
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+            I64 t = m_top.load( std::memory_order_relaxed );
+
+            if (t > b)
+            {
+                // Deque was empty
+                m_bottom.store( b + 1, std::memory_order_relaxed );
+                return false;
+            }
+
+            item = buffer->get( b );
+            if (t == b)
+            {
+                // Last item, race against thieves
+                bool won = m_top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+                m_bottom.store( b + 1, std::memory_order_relaxed );
+                return won;
+            }
+
+            return true;
+        }
+
+        //----------------------------------------------------------------------
+        // Steal an item from the top. Can be called by any thread.
+        // @Return:
+        //  True if an item was stolen and written to "item".
+        //----------------------------------------------------------------------
+        bool steal(T& item)
+        {
+            I64 t = m_top.load( std::memory_order_acquire );
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+            I64 b = m_bottom.load( std::memory_order_acquire );
+
+            if (t >= b)
+                return false;
+
+            Buffer* buffer = m_buffer.load( std::memory_order_acquire );
+            T stolen = buffer->get( t );
+            if ( not m_top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+                return false;
+
+            item = stolen;
+            return true;
+        }
+
+        //----------------------------------------------------------------------
+        bool empty() const
+        {
+            I64 b = m_bottom.load( std::memory_order_relaxed );
+            I64 t = m_top.load( std::memory_order_relaxed );
+            return b <= t;
+        }
+
+    private:
+        std::atomic<I64>        m_top{ 0 };
+        std::atomic<I64>        m_bottom{ 0 };
+        std::atomic<Buffer*>    m_buffer;
+        ArrayList<Buffer*>      m_retiredBuffers;
+
+        //----------------------------------------------------------------------
+        Buffer* _Grow(Buffer* buffer, I64 bottom, I64 top)
+        {
+            Buffer* newBuffer = new Buffer( buffer->capacity * 2 );
+            for (I64 i = top; i < bottom; ++i)
+                newBuffer->put( i, buffer->get( i ) );
+
+            m_retiredBuffers.push_back( buffer );
+            m_buffer.store( newBuffer, std::memory_order_release );
+            return newBuffer;
+        }
+
+        //----------------------------------------------------------------------
+        WorkStealingDeque(const WorkStealingDeque& other)                 = delete;
+        WorkStealingDeque& operator = (const WorkStealingDeque& other)    = delete;
+        WorkStealingDeque(WorkStealingDeque&& other)                      = delete;
+        WorkStealingDeque& operator = (WorkStealingDeque&& other)         = delete;
+    };
+
+
+} // end namespaces
@@ -0,0 +1,171 @@
+#pragma once
+/**********************************************************************
+    class: None (parallel.hpp)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Parallel loop and sort primitives on top of the ThreadPool. The
+    range is split into chunks which are grabbed by the workers and by
+    the calling thread itself, so the caller helps instead of idling.
+    Chunks start large and shrink towards the end of the range, which
+    balances uneven work without paying a job per element.
+    @Considerations:
+      - The calling thread blocks until the whole range is done, so all
+        state referenced by the function may live on the stack.
+      - The caller never waits for helper jobs which did not start yet
+        (e.g. queued behind a long running job). It only waits for
+        chunks which are currently executed by other threads.
+      - Small ranges run inline on the calling thread.
+**********************************************************************/
+
+#include <algorithm>
+#include <thread>
+#include "thread_pool.h"
+
+namespace OS {
+
+    //----------------------------------------------------------------------
+    #define PARALLEL_SORT_MIN_CHUNK_SIZE    4096    // Below this amount of elements per thread std::sort is used
+
+    namespace Detail
+    {
+        //----------------------------------------------------------------------
+        // Shared state of one parallel loop. Hands out shrinking chunks.
+        //----------------------------------------------------------------------
+        struct ParallelRange
+        {
+            ParallelRange(I64 begin, I64 end, I64 minGrainSize, I64 numParticipants)
+                : next( begin ), end( end ), minGrainSize( minGrainSize ), numParticipants( numParticipants ) {}
+
+            //----------------------------------------------------------------------
+            // @Return:
+            //  False, if the whole range was already handed out.
+            //----------------------------------------------------------------------
+            bool grab(I64& chunkBegin, I64& chunkEnd)
+            {
+                I64 current = next.load( std::memory_order_relaxed );
+                while (current < end)
+                {
+                    // Guided scheduling: Take a fraction of what is left, but at least the grain size
+                    I64 remaining = end - current;
+                    I64 chunkSize = std::min( remaining, std::max( minGrainSize, remaining / (2 * numParticipants) ) );
+                    if ( next.compare_exchange_weak( current, current + chunkSize, std::memory_order_relaxed ) )
+                    {
+                        chunkBegin = current;
+                        chunkEnd   = current + chunkSize;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            std::atomic<I64>    next;
+            std::atomic<I64>    numDone{ 0 };   // Amount of elements whose chunk was executed
+            const I64           end;
+            const I64           minGrainSize;
+            const I64           numParticipants;
+        };
+    }
+
+    //----------------------------------------------------------------------
+    // Calls "func(chunkBegin, chunkEnd)" for disjoint chunks which together
+    // cover [begin, end). Chunks may be executed concurrently.
+    // @Params:
+    //  "threadPool": Pool whose workers help. Nullptr runs everything inline.
+    //  "minGrainSize": Minimum amount of elements per chunk. Should be large
+    //                  enough so that a chunk outweighs the cost of a job.
+    //----------------------------------------------------------------------
+    template <typename Func>
+    void ParallelForRange(ThreadPool* threadPool, I64 begin, I64 end, Func&& func, I64 minGrainSize = 1)
+    {
+        I64 count = end - begin;
+        if (count <= 0)
+            return;
+
+        minGrainSize = std::max( minGrainSize, (I64)1 );
+        I64 maxHelpers = threadPool ? std::min( (I64)threadPool->numThreads(), (count - 1) / minGrainSize ) : 0;
+        if (maxHelpers <= 0)
+        {
+            func( begin, end );
+            return;
+        }
+
+        // Late helpers may still look at the range after this call returned, so it lives on the heap.
+        // They only touch "func" after they grabbed a chunk, which is impossible once everything is done.
+        auto range = std::make_shared<Detail::ParallelRange>( begin, end, minGrainSize, maxHelpers + 1 );
+        auto work = [range, &func] {
+            I64 chunkBegin, chunkEnd;
+            while ( range->grab( chunkBegin, chunkEnd ) )
+            {
+                func( chunkBegin, chunkEnd );
+                range->numDone.fetch_add( chunkEnd - chunkBegin, std::memory_order_release );
+            }
+        };
+
+        for (I64 i = 0; i < maxHelpers; i++)
+            threadPool->addJob( work );
+
+        work();
+
+        // Only chunks which are executing right now remain
+        while (range->numDone.load( std::memory_order_acquire ) < count)
+            std::this_thread::yield();
+    }
+
+    //----------------------------------------------------------------------
+    // Calls "func(i)" for every i in [begin, end). See ParallelForRange().
+    //----------------------------------------------------------------------
+    template <typename Func>
+    void ParallelFor(ThreadPool* threadPool, I64 begin, I64 end, Func&& func, I64 minGrainSize = 1)
+    {
+        ParallelForRange( threadPool, begin, end, [&func](I64 chunkBegin, I64 chunkEnd) {
+            for (I64 i = chunkBegin; i < chunkEnd; ++i)
+                func( i );
+        }, minGrainSize );
+    }
+
+    //----------------------------------------------------------------------
+    // Sorts [first, last) with the given comparison. Every participating
+    // thread sorts one slice, afterwards neighbouring slices are merged
+    // in parallel until one slice remains. Not stable.
+    //----------------------------------------------------------------------
+    template <typename RandomIt, typename Compare>
+    void ParallelSort(ThreadPool* threadPool, RandomIt first, RandomIt last, Compare comp)
+    {
+        I64 count = static_cast<I64>( last - first );
+        I64 numSlices = threadPool ? std::min( (I64)threadPool->numThreads() + 1, count / PARALLEL_SORT_MIN_CHUNK_SIZE ) : 1;
+        if (numSlices <= 1)
+        {
+            std::sort( first, last, comp );
+            return;
+        }
+
+        auto sliceBegin = [=](I64 slice) { return first + (count * slice) / numSlices; };
+
+        ParallelFor( threadPool, 0, numSlices, [&](I64 slice) {
+            std::sort( sliceBegin( slice ), sliceBegin( slice + 1 ), comp );
+        } );
+
+        // Merge pairs of sorted runs, doubling the run length every pass
+        for (I64 runLength = 1; runLength < numSlices; runLength *= 2)
+        {
+            I64 numMerges = (numSlices + 2 * runLength - 1) / (2 * runLength);
+            ParallelFor( threadPool, 0, numMerges, [&](I64 merge) {
+                I64 left  = merge * 2 * runLength;
+                I64 mid   = std::min( left + runLength, numSlices );
+                I64 right = std::min( left + 2 * runLength, numSlices );
+                if (mid < right)
+                    std::inplace_merge( sliceBegin( left ), sliceBegin( mid ), sliceBegin( right ), comp );
+            } );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    template <typename RandomIt>
+    void ParallelSort(ThreadPool* threadPool, RandomIt first, RandomIt last)
+    {
+        ParallelSort( threadPool, first, last, std::less<>() );
+    }
+
+} // end namespaces
@@ -12,8 +12,8 @@ namespace OS {
     U32 Thread::s_threadCounter = 0;
 
     //----------------------------------------------------------------------
-    Thread::Thread( JobQueue& jobQueue )
-        : m_jobQueue( jobQueue )
+    Thread::Thread( JobQueue& jobQueue, U8 workerIndex )
+        : m_jobQueue( jobQueue ), m_workerIndex( workerIndex )
     {
     }
 
@@ -29,16 +29,18 @@ namespace OS {
         while (true)
         {
             // Try to grab a job. The thread will be put to sleep if no job is available
-            m_currentJob = m_jobQueue.grabJob();
+            Job* job = m_jobQueue.grabJob( m_workerIndex );
 
-            // If the job is null, terminate this thread
-            if ( m_currentJob == nullptr )
+            // If the job is null the queue was shut down, so terminate this thread
+            if ( job == nullptr )
                 break;
 
             // Execute the job
-            (*m_currentJob)();
+            m_currentJob = JobHandle( job );
+            (*job)();
 
-            m_currentJob = nullptr;
+            m_currentJob = JobHandle();
+            m_jobQueue.finishJob( job );
         }
     }
 
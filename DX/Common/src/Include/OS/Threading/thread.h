@@ -20,29 +20,31 @@ namespace OS {
         static U32 s_threadCounter; // Used as ID for a thread.
 
     public:
-        Thread(JobQueue& jobQueue);
+        Thread(JobQueue& jobQueue, U8 workerIndex);
         ~Thread();
 
         //----------------------------------------------------------------------
         // Wait until the current job is done.
         //----------------------------------------------------------------------
-        void waitForCurrentJob() const { if( hasJob() ) m_currentJob->wait(); }
+        void waitForCurrentJob() const { m_currentJob.wait(); }
 
         //----------------------------------------------------------------------
         // Check whether this thread currently executes a job (is not idle)
         //----------------------------------------------------------------------
-        bool hasJob() const { return m_currentJob != nullptr; }
+        bool hasJob() const { return m_currentJob.isValid(); }
         bool isIdle() const { return !hasJob(); }
 
         //----------------------------------------------------------------------
         U32  getID()  const { return m_threadID; }
+        U8   getWorkerIndex() const { return m_workerIndex; }
 
 
     private:
         // Order of initialization matters.
         U32                     m_threadID      = s_threadCounter++;
-        JobPtr                  m_currentJob    = nullptr;
+        JobHandle               m_currentJob;
         JobQueue&               m_jobQueue;
+        U8                      m_workerIndex;
 
         // Initialize thread at last. !IMPORTANT!
         std::thread             m_thread        = std::thread( &Thread::_ThreadLoop, this );
@@ -17,14 +17,14 @@ namespace OS {
 
     //----------------------------------------------------------------------
     ThreadPool::ThreadPool( U8 numThreads )
-        : m_numThreads( numThreads )
+        : m_numThreads( numThreads ), m_jobQueue( numThreads )
     {
         ASSERT( (m_numThreads > 0) && (m_numThreads < MAX_POSSIBLE_THREADS) );
 
         // Create threads
         for (U8 i = 0; i < m_numThreads; i++)
         {
-            m_threads[i] = new Thread( m_jobQueue );
+            m_threads[i] = new Thread( m_jobQueue, i );
         }
     }
 
@@ -37,34 +37,63 @@ namespace OS {
     //----------------------------------------------------------------------
     void ThreadPool::waitForThreads()
     {
-        m_jobQueue.waitUntilQueueIsEmpty();
-
-        for (U8 i = 0; i < m_numThreads; i++)
-            m_threads[i]->waitForCurrentJob();
+        m_jobQueue.waitUntilAllJobsAreDone();
     }
 
     //----------------------------------------------------------------------
-    JobPtr ThreadPool::addJob( const std::function<void()>& job )
+    JobHandle ThreadPool::addJobGraph( JobGraph& graph )
     {
-        // Add job to job queue
-        JobPtr newJob = std::make_shared<Job>( std::move( job ) );
-        m_jobQueue.addJob( newJob );
+        // The sink is never executed, it is just released once the graph is done
+        Job* sink = m_jobQueue.createJob( [] {} );
+        JobHandle handle( sink );
+        graph._Reset( sink );
+
+        if ( graph.empty() )
+        {
+            m_jobQueue.releaseJob( sink );
+            return handle;
+        }
+
+        // Count roots first, a root might finish and enqueue successors while we still iterate
+        ArrayList<JobGraph::NodeID> roots;
+        for (JobGraph::NodeID i = 0; i < graph.size(); i++)
+            if (graph.m_nodes[i].numPredecessors == 0)
+                roots.push_back( i );
+
+        for (auto root : roots)
+            _AddGraphNode( graph, root );
 
-        return newJob;
+        return handle;
     }
 
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
     //----------------------------------------------------------------------
-    void ThreadPool::_TerminateThreads()
+    void ThreadPool::_AddGraphNode( JobGraph& graph, JobGraph::NodeID node )
     {
-        // Add termination jobs to the queue.
-        // They will be picked up by any thread to terminate itself.
-        for (U8 i = 0; i < m_numThreads; i++)
-            m_jobQueue.addJob( nullptr );
+        addJob( [this, &graph, node] {
+            auto& graphNode = graph.m_nodes[node];
+            graphNode.job();
+
+            for (auto successor : graphNode.successors)
+                if (graph.m_pendingPredecessors[successor].fetch_sub( 1, std::memory_order_acq_rel ) == 1)
+                    _AddGraphNode( graph, successor );
+
+            // The graph may be destroyed as soon as the sink is released
+            if (graph.m_unfinishedNodes.fetch_sub( 1, std::memory_order_acq_rel ) == 1)
+                m_jobQueue.releaseJob( graph.m_sink );
+        } );
+    }
 
-        // Wait until job queue is empty
-        m_jobQueue.waitUntilQueueIsEmpty();
+    //----------------------------------------------------------------------
+    void ThreadPool::_TerminateThreads()
+    {
+        // Threads terminate themselves once all remaining jobs are grabbed
+        m_jobQueue.shutdown();
 
-        // Destroy threads
+        // Destroy threads (joins them)
         for (U8 i = 0; i < m_numThreads; i++)
         {
             delete m_threads[i];
@@ -8,17 +8,18 @@
 
     Manages a bunch of threads via a job system. A job is basically
     just a function. A job will be executed by an arbitrary thread.
-    When adding a new job the job itself will be returned, so the
+    When adding a new job a handle to it will be returned, so the
     calling thread can wait until this specific job has been executed.
+    Jobs which depend on each other can be added at once as a JobGraph.
+    Each thread owns a work stealing deque, so jobs added from within
+    a job stay on the same thread unless an idle thread steals them.
     @Considerations:
       - Support "Persistens Jobs", aka jobs running in a while(true) loop.
         For now all jobs have to have a clear end.
-      - Add a batch of jobs simultanously. Wait for a batch.
-      - Fetch memory for jobs from an custom allocator
-        (No dynamic allocations via shared-ptr)
 **********************************************************************/
 
 #include "thread.h"
+#include "jobs/job_graph.h"
 
 namespace OS {
 
@@ -57,7 +58,28 @@ namespace OS {
         // @Params:
         //  "job": Job/Task to execute.
         //----------------------------------------------------------------------
-        JobPtr addJob(const std::function<void()>& job);
+        template <typename F>
+        JobHandle addJob(F&& job)
+        {
+            Job* newJob = m_jobQueue.createJob( std::forward<F>( job ) );
+
+            // The handle must be created before the job might get executed
+            JobHandle handle( newJob );
+            m_jobQueue.addJob( newJob );
+
+            return handle;
+        }
+
+        //----------------------------------------------------------------------
+        // Adds all jobs of the given graph. Jobs without predecessors are
+        // enqueued immediately, every other job as soon as its last
+        // predecessor finished.
+        // @Params:
+        //  "graph": The jobs to execute. Must stay alive until the sink is done.
+        // @Return:
+        //  The sink, which is done once every job of the graph was executed.
+        //----------------------------------------------------------------------
+        JobHandle addJobGraph(JobGraph& graph);
 
 
         //----------------------------------------------------------------------
@@ -75,6 +97,11 @@ namespace OS {
         //----------------------------------------------------------------------
         void _TerminateThreads();
 
+        //----------------------------------------------------------------------
+        // Enqueues the given node of a graph, whose predecessors are all done.
+        //----------------------------------------------------------------------
+        void _AddGraphNode(JobGraph& graph, JobGraph::NodeID node);
+
         //----------------------------------------------------------------------
         ThreadPool(const ThreadPool& other)                 = delete;
         ThreadPool& operator = (const ThreadPool& other)    = delete;
@@ -21,6 +21,7 @@ namespace Assets {
     //----------------------------------------------------------------------
     void AssetManager::init()
     {
+        MEM_SCOPE( Assets );
         _CreateDefaultAssets();
     }
 
@@ -36,6 +37,8 @@ namespace Assets {
     //----------------------------------------------------------------------
     Texture2DPtr AssetManager::getTexture2D( const OS::Path& filePath, bool generateMips )
     {
+        MEM_SCOPE( Textures );
+
         // Check if texture was already loaded
         StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
         if ( m_textureCache.find( pathAsID ) != m_textureCache.end() )
@@ -82,6 +85,8 @@ namespace Assets {
                                          const OS::Path& posY, const OS::Path& negY,
                                          const OS::Path& posZ, const OS::Path& negZ, bool generateMips )
     {
+        MEM_SCOPE( Textures );
+
         // Check if cubemap was already loaded (checks only first path)
         StringID pathAsID = SID( StringUtils::toLower( posX.toString() ).c_str() );
         if ( m_cubemapCache.find( pathAsID ) != m_cubemapCache.end() )
@@ -117,6 +122,8 @@ namespace Assets {
     //----------------------------------------------------------------------
     CubemapPtr AssetManager::getCubemap( const OS::Path& path, I32 sizePerFace, bool genMips )
     {
+        MEM_SCOPE( Textures );
+
         // Check if cubemap was already loaded (checks only first path)
         StringID pathAsID = SID( StringUtils::toLower( path.toString() ).c_str() );
         if ( m_cubemapCache.find( pathAsID ) != m_cubemapCache.end() )
@@ -152,6 +159,8 @@ namespace Assets {
     //----------------------------------------------------------------------
     AudioClipPtr AssetManager::getAudioClip( const OS::Path& filePath )
     {
+        MEM_SCOPE( Audio );
+
         // Check if audio was already loaded
         StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
         if ( m_audioCache.find( pathAsID ) != m_audioCache.end() )
@@ -192,6 +201,8 @@ namespace Assets {
     //----------------------------------------------------------------------
     ShaderPtr AssetManager::getShader( const OS::Path& filePath )
     {
+        MEM_SCOPE( Shaders );
+
         // Check if shader was already loaded
         StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
         if ( m_shaderCache.find( pathAsID ) != m_shaderCache.end() )
@@ -227,6 +238,8 @@ namespace Assets {
     //----------------------------------------------------------------------
     MaterialPtr AssetManager::getMaterial( const OS::Path& filePath )
     {
+        MEM_SCOPE( Materials );
+
         // Check if material was already loaded
         StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
         if ( m_materialCache.find( pathAsID ) != m_materialCache.end() )
@@ -263,6 +276,8 @@ namespace Assets {
     MeshPtr AssetManager::getMesh( const OS::Path& filePath, MeshMaterialInfo* materials,
                                    Animation::Skeleton* skeleton, ArrayList<Animation::AnimationClip>* animations )
     {
+        MEM_SCOPE( Meshes );
+
         // Check if mesh was already loaded (only if "materials" and "skeleton" is null)
         StringID pathAsID = SID( StringUtils::toLower( filePath.toString() ).c_str() );
         if ( m_meshCache.find( pathAsID ) != m_meshCache.end() && (materials == nullptr) && (skeleton == nullptr))
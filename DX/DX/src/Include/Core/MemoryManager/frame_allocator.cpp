@@ -0,0 +1,115 @@
+#include "frame_allocator.h"
+/**********************************************************************
+    class: FrameAllocator (frame_allocator.cpp)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    @Considerations:
+      - A region stores the frame it was grabbed in. A region of an
+        older frame is discarded on the next allocation, so endFrame()
+        does not have to visit the other threads.
+      - A region stores the id of its allocator instead of the address.
+        The frame counter of a new allocator at the address of a
+        destroyed one starts at zero again and would match.
+**********************************************************************/
+
+namespace Core { namespace MemoryManagement {
+
+    //----------------------------------------------------------------------
+    struct ThreadRegion
+    {
+        U64     owner   = 0;    // Id of the allocator, zero is never used
+        U64     frame   = 0;
+        Byte*   head    = nullptr;
+        Byte*   end     = nullptr;
+    };
+    static thread_local ThreadRegion t_region;
+    static std::atomic<U64> s_nextID{ 1 };
+
+    //----------------------------------------------------------------------
+    FrameAllocator::FrameAllocator()
+        : m_id( s_nextID.fetch_add( 1, std::memory_order_relaxed ) )
+    {
+    }
+
+    //----------------------------------------------------------------------
+    void FrameAllocator::init( Size bytesPerFrame )
+    {
+        ASSERT( bytesPerFrame >= FRAME_ALLOCATOR_REGION_SIZE );
+
+        m_bytesPerFrame = bytesPerFrame;
+        for (auto& stack : m_stacks)
+            stack = std::make_unique<Memory::StackAllocator>( static_cast<U32>( bytesPerFrame ) );
+    }
+
+    //----------------------------------------------------------------------
+    void FrameAllocator::shutdown()
+    {
+        // Invalidates regions of all threads
+        m_frame.fetch_add( 1, std::memory_order_relaxed );
+
+        for (auto& stack : m_stacks)
+        {
+            stack->clear();
+            stack.reset();
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void* FrameAllocator::allocateRaw( Size amountOfBytes, Size alignment )
+    {
+        U64 frame = m_frame.load( std::memory_order_relaxed );
+
+        ThreadRegion& region = t_region;
+        if (region.owner == m_id && region.frame == frame)
+        {
+            Byte* alignedAddress = Memory::alignAddress( region.head, alignment );
+            if (alignedAddress + amountOfBytes <= region.end)
+            {
+                region.head = alignedAddress + amountOfBytes;
+                return alignedAddress;
+            }
+        }
+
+        // Large allocations would waste most of a region
+        if (amountOfBytes + alignment > FRAME_ALLOCATOR_REGION_SIZE / 4)
+            return _AllocateFromStack( amountOfBytes, alignment );
+
+        Byte* regionBegin = reinterpret_cast<Byte*>( _AllocateFromStack( FRAME_ALLOCATOR_REGION_SIZE, 16 ) );
+        if (regionBegin == nullptr)
+            return nullptr;
+
+        Byte* alignedAddress = Memory::alignAddress( regionBegin, alignment );
+        region.owner = m_id;
+        region.frame = frame;
+        region.head  = alignedAddress + amountOfBytes;
+        region.end   = regionBegin + FRAME_ALLOCATOR_REGION_SIZE;
+
+        return alignedAddress;
+    }
+
+    //----------------------------------------------------------------------
+    void FrameAllocator::endFrame()
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        // The stack of the next frame was last used FRAME_ALLOCATOR_NUM_FRAMES - 1 frames ago
+        U64 nextFrame = m_frame.load( std::memory_order_relaxed ) + 1;
+        m_stacks[nextFrame % FRAME_ALLOCATOR_NUM_FRAMES]->clear();
+
+        m_frame.store( nextFrame, std::memory_order_relaxed );
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void* FrameAllocator::_AllocateFromStack( Size amountOfBytes, Size alignment )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_stacks[m_frame.load( std::memory_order_relaxed ) % FRAME_ALLOCATOR_NUM_FRAMES]->allocateRaw( amountOfBytes, alignment );
+    }
+
+} } // end namespaces
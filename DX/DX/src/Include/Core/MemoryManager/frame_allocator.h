@@ -0,0 +1,143 @@
+#pragma once
+/**********************************************************************
+    class: FrameAllocator (frame_allocator.h)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Linear allocator for scratch data which lives at most a few frames,
+    e.g. cull lists, sorted lights, debug or gui vertices. Instead of a
+    malloc + free for every temporary list, memory is bumped from a
+    StackAllocator and the whole stack is reset at once.
+    @Considerations:
+      - Every thread bumps inside its own region, only fetching a new
+        region from the stack takes a lock.
+      - Destructors are never called, memory is just reused.
+      - Must not be used by jobs which run across a frame boundary.
+**********************************************************************/
+
+#include "Memory/Allocators/stack_allocator.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace Core { namespace MemoryManagement {
+
+    //----------------------------------------------------------------------
+    #define FRAME_ALLOCATOR_NUM_FRAMES          2                   // Amount of frames the memory of one frame survives
+    #define FRAME_ALLOCATOR_BYTES_PER_FRAME     (16 * 1024 * 1024)
+    #define FRAME_ALLOCATOR_REGION_SIZE         (64 * 1024)         // Bytes a thread grabs at once from the stack
+
+    //**********************************************************************
+    // Hands out memory which stays valid until the end of the frame
+    // FRAME_ALLOCATOR_NUM_FRAMES - 1 frames after the current one. Each
+    // frame has its own stack, the oldest one is cleared on endFrame().
+    // With two frames, data recorded this frame is still valid while the
+    // renderer presents it after the frame ended.
+    //**********************************************************************
+    class FrameAllocator
+    {
+    public:
+        FrameAllocator();
+        ~FrameAllocator() = default;
+
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "bytesPerFrame": Maximum amount of bytes allocated in one frame.
+        //----------------------------------------------------------------------
+        void init(Size bytesPerFrame = FRAME_ALLOCATOR_BYTES_PER_FRAME);
+        void shutdown();
+
+        //----------------------------------------------------------------------
+        // Allocate specified amount of bytes. Thread-safe.
+        // @Params:
+        // "amountOfBytes": Amount of bytes to allocate.
+        // "alignment":     Alignment to use. MUST be power of two.
+        //----------------------------------------------------------------------
+        void* allocateRaw(Size amountOfBytes, Size alignment = 1);
+
+        //----------------------------------------------------------------------
+        // Allocate "amountOfObjects" objects of type T. Thread-safe.
+        // @Params:
+        // "amountOfObjects": Amount of objects to allocate (array-allocation).
+        // "args": Constructor arguments from the class T.
+        //----------------------------------------------------------------------
+        template <typename T, typename... Args>
+        T* allocate(Size amountOfObjects = 1, Args&&... args);
+
+        //----------------------------------------------------------------------
+        // Switches to the next frame and clears the memory of the oldest one.
+        // Called at EVENT_FRAME_END. No other thread may allocate meanwhile.
+        //----------------------------------------------------------------------
+        void endFrame();
+
+        //----------------------------------------------------------------------
+        U64  getFrame()         const { return m_frame.load( std::memory_order_relaxed ); }
+        Size getBytesPerFrame() const { return m_bytesPerFrame; }
+
+    private:
+        std::array<std::unique_ptr<Memory::StackAllocator>, FRAME_ALLOCATOR_NUM_FRAMES> m_stacks;
+        std::atomic<U64>    m_frame{ 0 };
+        std::mutex          m_mutex;        // Guards the stack of the current frame
+        Size                m_bytesPerFrame = 0;
+        U64                 m_id;           // Unique per process, a new allocator might reuse the address of a destroyed one
+
+        // Allocates directly from the stack of the current frame
+        void* _AllocateFromStack(Size amountOfBytes, Size alignment);
+
+        NULL_COPY_AND_ASSIGN(FrameAllocator)
+    };
+
+    //**********************************************************************
+    // Adapter to use the frame allocator within STL containers, e.g.
+    //  FrameArrayList<I32> list( Locator::getFrameAllocator() );
+    // Deallocations are ignored.
+    //**********************************************************************
+    template <typename T>
+    class FrameAllocatorSTL
+    {
+    public:
+        using value_type = T;
+
+        FrameAllocatorSTL(FrameAllocator& frameAllocator) : m_frameAllocator( &frameAllocator ) {}
+        template <typename T2>
+        FrameAllocatorSTL(const FrameAllocatorSTL<T2>& other) : m_frameAllocator( other.getFrameAllocator() ) {}
+
+        T*   allocate(Size n) { return static_cast<T*>( m_frameAllocator->allocateRaw( n * sizeof(T), alignof(T) ) ); }
+        void deallocate(T* p, Size n) {}
+
+        FrameAllocator* getFrameAllocator() const { return m_frameAllocator; }
+
+        template <typename T2>
+        bool operator == (const FrameAllocatorSTL<T2>& other) const { return m_frameAllocator == other.getFrameAllocator(); }
+        template <typename T2>
+        bool operator != (const FrameAllocatorSTL<T2>& other) const { return m_frameAllocator != other.getFrameAllocator(); }
+
+    private:
+        FrameAllocator* m_frameAllocator;
+    };
+
+    template <typename T>
+    using FrameArrayList = std::vector<T, FrameAllocatorSTL<T>>;
+
+    //**********************************************************************
+    // IMPLEMENTATION
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    template <typename T, typename... Args>
+    T* FrameAllocator::allocate( Size amountOfObjects, Args&&... args )
+    {
+        static_assert( std::is_trivially_destructible<T>::value, "FrameAllocator: Destructors are never called." );
+
+        T* alignedAddress = reinterpret_cast<T*>( allocateRaw( amountOfObjects * sizeof(T), alignof(T) ) );
+        if (alignedAddress != nullptr)
+        {
+            for (Size i = 0; i < amountOfObjects; i++)
+                new ( std::addressof( alignedAddress[i] ) ) T( std::forward<Args>( args )... );
+        }
+
+        return alignedAddress;
+    }
+
+} } // end namespaces
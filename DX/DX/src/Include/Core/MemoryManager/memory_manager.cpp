@@ -31,16 +31,29 @@
 #include "Logging/logging.h"
 #include "memory_tracker.h"
 #include "Common/utils.h"
+#include "Events/event_dispatcher.h"
+#include "OS/FileSystem/path.h"
 
 #define REPORT_CONTINOUS_ALLOCATIONS    0
 #define REPORT_HEAP_ALLOCATIONS         0
 
+#define CATEGORY_MEMORY                 "Memory"
+#define CATEGORY_MEMORY_BUDGETS         "MemoryBudgets"
+#define CALLSTACK_SAMPLE_RATE           "CallstackSampleRate"
+#define REPORT_FILE                     "ReportFile"
+
 namespace Core { namespace MemoryManagement {
 
     //----------------------------------------------------------------------
     void MemoryManager::init()
     {
         Locator::getCoreEngine().subscribe( this );
+
+        m_frameAllocator.init();
+        m_frameEndListener = Events::EventDispatcher::GetEvent( EVENT_FRAME_END ).addListener( [this] { m_frameAllocator.endFrame(); } );
+
+        // The configuration manager is initialized after this subsystem
+        m_gameStartListener = Events::EventDispatcher::GetEvent( EVENT_GAME_START ).addListener( [this] { _ReadConfig(); } );
     }
 
     //----------------------------------------------------------------------
@@ -48,11 +61,22 @@ namespace Core { namespace MemoryManagement {
     {
         _BasicLeakDetection();
         //_ContinousAllocationLeakDetection();
+        _CheckBudgets();
     }
 
     //----------------------------------------------------------------------
     void MemoryManager::shutdown()
     {
+        m_gameStartListener = Events::EventListener();
+        m_frameEndListener = Events::EventListener();
+        m_frameAllocator.shutdown();
+
+        if ( not m_reportFile.empty() )
+        {
+            if ( MemoryTracker::writeReport( OS::Path( m_reportFile.c_str() ) ) )
+                LOG( "Memory report written to " + m_reportFile );
+        }
+
         auto currentAllocationInfo = getAllocationInfo();
         LOG( "Allocations made throughout the program:" + currentAllocationInfo.toString() );
     }
@@ -69,6 +93,53 @@ namespace Core { namespace MemoryManagement {
         return MemoryTracker::getAllocationMemoryInfo();
     }
 
+    //----------------------------------------------------------------------
+    void MemoryManager::_ReadConfig()
+    {
+        auto& engineIni = CONFIG.getEngineIni();
+
+        // Iterate the entries instead of looking up every tag, otherwise the lookup would add empty entries to the ini
+        for (auto& entryPair : engineIni[CATEGORY_MEMORY_BUDGETS].getEntries())
+        {
+            const StringID& name                = entryPair.first;
+            const Common::VariantType& budget   = entryPair.second;
+
+            Size i = 0;
+            while (i < static_cast<Size>( EMemoryTag::Count ) && name != SID( MemoryTagToString( static_cast<EMemoryTag>( i ) ) ))
+                i++;
+
+            if (i == static_cast<Size>( EMemoryTag::Count ) || budget.getType() == Common::EVariantType::String)
+            {
+                LOG_WARN_MEMORY( "MemoryManager: Invalid memory budget '" + String( name.c_str() ) + "'" );
+                continue;
+            }
+
+            MemoryTracker::setBudget( static_cast<EMemoryTag>( i ), static_cast<I64>( budget.get<F64>() * 1024.0 * 1024.0 ) );
+        }
+
+        auto sampleRate = engineIni[CATEGORY_MEMORY][CALLSTACK_SAMPLE_RATE];
+        if (sampleRate.isValid() && sampleRate.getType() != Common::EVariantType::String)
+            MemoryTracker::setCallstackSampleRate( sampleRate.get<U32>() );
+
+        if ( auto reportFile = engineIni[CATEGORY_MEMORY][REPORT_FILE] )
+            m_reportFile = reportFile.get<CString>();
+    }
+
+    //----------------------------------------------------------------------
+    void MemoryManager::_CheckBudgets()
+    {
+        for (Size i = 0; i < static_cast<Size>( EMemoryTag::Count ); i++)
+        {
+            EMemoryTag tag = static_cast<EMemoryTag>( i );
+            if ( not MemoryTracker::consumeBudgetExceeded( tag ) )
+                continue;
+
+            auto stats = MemoryTracker::getTagStats( tag );
+            LOG_WARN_MEMORY( "Memory budget of '" + String( MemoryTagToString( tag ) ) + "' exceeded: " +
+                             Utils::bytesToString( stats.bytesAllocated ) + " / " + Utils::bytesToString( stats.budget ) );
+        }
+    }
+
     //----------------------------------------------------------------------
     void MemoryManager::_ContinousAllocationLeakDetection()
     {
@@ -6,7 +6,14 @@
     author: S. Hau
     date: October 12, 2017
 
-    Reports memory leaks on shutdown.
+    Reports memory leaks on shutdown and tagged allocations which
+    exceed their budget. Budgets and the callstack sampling are read
+    from the engine.ini:
+        [MemoryBudgets]
+        Textures = 256              (Megabytes per tag)
+        [Memory]
+        CallstackSampleRate = 64    (Sample every n-th allocation)
+        ReportFile = memory.txt     (Written on shutdown)
     @Considerations
       - Allocations from Allocators fetch there memory from a
         universalalloctor in this class?
@@ -15,6 +22,9 @@
 
 #include "Common/i_subsystem.hpp"
 #include "Memory/memory_structs.h"
+#include "Events/event.h"
+#include "frame_allocator.h"
+#include "memory_tracker.h"
 
 
 namespace Core { namespace MemoryManagement{
@@ -45,7 +55,27 @@ namespace Core { namespace MemoryManagement{
         //----------------------------------------------------------------------
         const Memory::AllocationInfo getAllocationInfo() const;
 
+        //----------------------------------------------------------------------
+        // @Return:
+        //   Allocator for scratch memory, which is reset every frame.
+        //----------------------------------------------------------------------
+        FrameAllocator& getFrameAllocator() { return m_frameAllocator; }
+
+        //----------------------------------------------------------------------
+        // Writes the per tag stats and sampled callstacks to the given file.
+        //----------------------------------------------------------------------
+        bool writeReport(const OS::Path& path) { return MemoryTracker::writeReport( path ); }
+
     private:
+        FrameAllocator          m_frameAllocator;
+        Events::EventListener   m_frameEndListener;
+        Events::EventListener   m_gameStartListener;
+        String                  m_reportFile;
+
+        //----------------------------------------------------------------------
+        void _ReadConfig();
+        void _CheckBudgets();
+
         //----------------------------------------------------------------------
         void _ReportPossibleMemoryLeak(const Memory::AllocationInfo& lastAllocationInfo, const Memory::AllocationInfo& allocationInfo);
 
@@ -5,10 +5,25 @@
 
     author: S. Hau
     date: October 7, 2017
+
+    @Considerations:
+      - Every allocation has a header of two words in front of it:
+        [AllocationSize | Tag + (SampleIndex + 1) << 8 | RealMemory]
+      - Tag counters are atomics, so they don't need the global mutex.
+      - Anything running inside the global new/delete must not allocate
+        itself, that's why the sample table is a fixed array.
 **********************************************************************/
 
 #include "Logging/logging.h"
 #include "memory.hpp"
+#include "OS/FileSystem/file.h"
+#include <algorithm>
+#include <atomic>
+
+#ifdef _WIN32
+    #include <DbgHelp.h>
+    #pragma comment(lib, "dbghelp.lib")
+#endif
 
 #ifdef  _DEBUG
     #define TRACK_ALL_ALLOCATIONS 1
@@ -25,6 +40,226 @@ namespace Core { namespace MemoryManagement {
         return mutex;
     }
 
+    //----------------------------------------------------------------------
+    // Per tag counters. Constant initialized, so they are usable by
+    // allocations made before any dynamic initialization.
+    //----------------------------------------------------------------------
+    static constexpr Size NUM_TAGS = static_cast<Size>( EMemoryTag::Count );
+
+    static std::atomic<I64>     s_tagBytes[NUM_TAGS];
+    static std::atomic<I64>     s_tagPeakBytes[NUM_TAGS];
+    static std::atomic<I64>     s_tagNumAllocations[NUM_TAGS];
+    static std::atomic<I64>     s_tagTotalAllocations[NUM_TAGS];
+    static std::atomic<I64>     s_tagBudgets[NUM_TAGS];
+    static std::atomic<bool>    s_tagBudgetExceeded[NUM_TAGS];
+
+    static thread_local EMemoryTag t_currentTag = EMemoryTag::General;
+
+    //----------------------------------------------------------------------
+    // Callstack sampling
+    //----------------------------------------------------------------------
+    #define MEMORY_HOTSPOT_TABLE_SIZE   1024    // Distinct sampled callstacks, must be power of two
+    #define MEMORY_INVALID_SAMPLE       0xFFFFFFFF
+
+    struct Callstack
+    {
+        void*   frames[MEMORY_CALLSTACK_MAX_FRAMES];
+        U32     numFrames;
+        U32     hash;
+    };
+
+    // One sampled allocation which is still alive
+    struct LiveSample
+    {
+        Callstack   callstack;
+        Size        bytes;
+        EMemoryTag  tag;
+        bool        used;
+    };
+
+    // Sum of all sampled allocations with the same callstack, alive or not
+    struct Hotspot
+    {
+        Callstack   callstack;
+        I64         numAllocations;
+        I64         bytes;
+    };
+
+    static std::atomic<U32>     s_sampleRate{ 0 };
+    static thread_local U32     t_allocationsUntilSample = 0;
+    static thread_local bool    t_buildingReport = false;   // Keeps the report out of its own samples
+
+    static LiveSample           s_liveSamples[MEMORY_CALLSTACK_MAX_SAMPLES];
+    static U32                  s_nextFreeSample[MEMORY_CALLSTACK_MAX_SAMPLES];
+    static U32                  s_freeSampleHead    = MEMORY_INVALID_SAMPLE;
+    static U32                  s_numSamplesTouched = 0;    // Samples beyond this were never used
+    static U32                  s_numLiveSamples    = 0;
+    static Hotspot              s_hotspots[MEMORY_HOTSPOT_TABLE_SIZE];
+    static U32                  s_numHotspots       = 0;
+
+    //----------------------------------------------------------------------
+    static std::mutex& GetSamplesMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    //----------------------------------------------------------------------
+    static bool CaptureCallstack( Callstack& callstack )
+    {
+    #ifdef _WIN32
+        // Skip this function and the allocator itself
+        callstack.numFrames = RtlCaptureStackBackTrace( 2, MEMORY_CALLSTACK_MAX_FRAMES, callstack.frames, nullptr );
+    #else
+        callstack.numFrames = 0;
+    #endif
+        for (U32 i = callstack.numFrames; i < MEMORY_CALLSTACK_MAX_FRAMES; i++)
+            callstack.frames[i] = nullptr;
+
+        // FNV-1a over the return addresses
+        U32 hash = 2166136261u;
+        for (U32 i = 0; i < callstack.numFrames; i++)
+            hash = (hash ^ static_cast<U32>( reinterpret_cast<uintptr_t>( callstack.frames[i] ) >> 4 )) * 16777619u;
+        callstack.hash = hash;
+
+        return true;
+    }
+
+    //----------------------------------------------------------------------
+    static bool SameCallstack( const Callstack& a, const Callstack& b )
+    {
+        return a.hash == b.hash && a.numFrames == b.numFrames && memcmp( a.frames, b.frames, sizeof( a.frames ) ) == 0;
+    }
+
+    //----------------------------------------------------------------------
+    // @Return:
+    //  Index of the sample + 1 to store in the allocation header, zero if
+    //  this allocation is not sampled.
+    //----------------------------------------------------------------------
+    static U32 SampleAllocation( Size bytes, EMemoryTag tag )
+    {
+        U32 sampleRate = s_sampleRate.load( std::memory_order_relaxed );
+        if (sampleRate == 0 || t_buildingReport)
+            return 0;
+
+        if (t_allocationsUntilSample > 0)
+        {
+            t_allocationsUntilSample--;
+            return 0;
+        }
+        t_allocationsUntilSample = sampleRate - 1;
+
+        Callstack callstack;
+        CaptureCallstack( callstack );
+
+        std::lock_guard<std::mutex> lock( GetSamplesMutex() );
+
+        // Accumulate into the hotspot table (open addressing, full table just stops counting new callstacks)
+        U32 slot = callstack.hash & (MEMORY_HOTSPOT_TABLE_SIZE - 1);
+        for (U32 probe = 0; probe < MEMORY_HOTSPOT_TABLE_SIZE; probe++, slot = (slot + 1) & (MEMORY_HOTSPOT_TABLE_SIZE - 1))
+        {
+            Hotspot& hotspot = s_hotspots[slot];
+            if (hotspot.numAllocations == 0)
+            {
+                hotspot.callstack = callstack;
+                s_numHotspots++;
+            }
+            else if (not SameCallstack( hotspot.callstack, callstack ))
+            {
+                continue;
+            }
+
+            hotspot.numAllocations++;
+            hotspot.bytes += bytes;
+            break;
+        }
+
+        U32 index;
+        if (s_freeSampleHead != MEMORY_INVALID_SAMPLE)
+        {
+            index = s_freeSampleHead;
+            s_freeSampleHead = s_nextFreeSample[index];
+        }
+        else if (s_numSamplesTouched < MEMORY_CALLSTACK_MAX_SAMPLES)
+        {
+            index = s_numSamplesTouched++;
+        }
+        else
+        {
+            return 0; // Table full, allocation stays untracked
+        }
+
+        LiveSample& sample = s_liveSamples[index];
+        sample.callstack    = callstack;
+        sample.bytes        = bytes;
+        sample.tag          = tag;
+        sample.used         = true;
+        s_numLiveSamples++;
+
+        return index + 1;
+    }
+
+    //----------------------------------------------------------------------
+    static void ReleaseSample( U32 sampleIndexPlusOne )
+    {
+        U32 index = sampleIndexPlusOne - 1;
+        ASSERT( index < MEMORY_CALLSTACK_MAX_SAMPLES );
+
+        std::lock_guard<std::mutex> lock( GetSamplesMutex() );
+        s_liveSamples[index].used = false;
+        s_nextFreeSample[index] = s_freeSampleHead;
+        s_freeSampleHead = index;
+        s_numLiveSamples--;
+    }
+
+    //----------------------------------------------------------------------
+    static void AddTaggedAllocation( EMemoryTag tag, Size bytes )
+    {
+        Size i = static_cast<Size>( tag );
+        I64 previousBytes = s_tagBytes[i].fetch_add( bytes, std::memory_order_relaxed );
+        I64 currentBytes = previousBytes + bytes;
+
+        s_tagNumAllocations[i].fetch_add( 1, std::memory_order_relaxed );
+        s_tagTotalAllocations[i].fetch_add( 1, std::memory_order_relaxed );
+
+        I64 peak = s_tagPeakBytes[i].load( std::memory_order_relaxed );
+        while (currentBytes > peak && not s_tagPeakBytes[i].compare_exchange_weak( peak, currentBytes, std::memory_order_relaxed ))
+            ;
+
+        // Only flag the moment the budget is crossed, not every allocation above it
+        I64 budget = s_tagBudgets[i].load( std::memory_order_relaxed );
+        if (budget > 0 && previousBytes <= budget && currentBytes > budget)
+            s_tagBudgetExceeded[i].store( true, std::memory_order_relaxed );
+    }
+
+    //----------------------------------------------------------------------
+    static void RemoveTaggedAllocation( EMemoryTag tag, Size bytes )
+    {
+        Size i = static_cast<Size>( tag );
+        s_tagBytes[i].fetch_sub( bytes, std::memory_order_relaxed );
+        s_tagNumAllocations[i].fetch_sub( 1, std::memory_order_relaxed );
+    }
+
+    //----------------------------------------------------------------------
+    const char* MemoryTagToString( EMemoryTag tag )
+    {
+        switch (tag)
+        {
+        case EMemoryTag::General:       return "General";
+        case EMemoryTag::Assets:        return "Assets";
+        case EMemoryTag::Textures:      return "Textures";
+        case EMemoryTag::Meshes:        return "Meshes";
+        case EMemoryTag::Shaders:       return "Shaders";
+        case EMemoryTag::Materials:     return "Materials";
+        case EMemoryTag::Audio:         return "Audio";
+        case EMemoryTag::Rendering:     return "Rendering";
+        case EMemoryTag::Scene:         return "Scene";
+        case EMemoryTag::Chunks:        return "Chunks";
+        case EMemoryTag::Debug:         return "Debug";
+        }
+        return "Unknown";
+    }
+
     //----------------------------------------------------------------------
     void* _GlobalNewAndDeleteAllocator::allocate( Size size )
     {
@@ -36,8 +271,13 @@ namespace Core { namespace MemoryManagement {
 
         memset( mem, 0, allocationSize );
 
-        // [&AllocationSize - &RealMemory]
+        EMemoryTag tag = t_currentTag;
+        Size tagAndSample = static_cast<Size>( tag ) | (static_cast<Size>( SampleAllocation( size, tag ) ) << 8);
+        AddTaggedAllocation( tag, size );
+
+        // [&AllocationSize - &TagAndSample - &RealMemory]
         memcpy( mem, &allocationSize, sizeof( Size ));
+        memcpy( mem + sizeof( Size ), &tagAndSample, sizeof( Size ) );
         mem += 2 * sizeof( Size ); // Keep allocations 16 byte aligned
 
         std::lock_guard<std::mutex> lock( getMutex() );
@@ -60,6 +300,12 @@ namespace Core { namespace MemoryManagement {
         mem -= 2 * sizeof( Size );
 
         Size allocatedSize = *(reinterpret_cast<Size*>( mem ));
+        Size tagAndSample  = *(reinterpret_cast<Size*>( mem + sizeof( Size ) ));
+
+        RemoveTaggedAllocation( static_cast<EMemoryTag>( tagAndSample & 0xFF ), allocatedSize - 2 * sizeof( Size ) );
+        if (U32 sampleIndexPlusOne = static_cast<U32>( tagAndSample >> 8 ))
+            ReleaseSample( sampleIndexPlusOne );
+
         std::lock_guard<std::mutex> lock( getMutex() );
         MemoryTracker::getAllocationMemoryInfo().removeAllocation( allocatedSize );
         std::free( mem );
@@ -103,6 +349,225 @@ namespace Core { namespace MemoryManagement {
 #endif
     }
 
+    //----------------------------------------------------------------------
+    EMemoryTag MemoryTracker::setCurrentTag( EMemoryTag tag )
+    {
+        EMemoryTag previousTag = t_currentTag;
+        t_currentTag = tag;
+        return previousTag;
+    }
+
+    //----------------------------------------------------------------------
+    EMemoryTag MemoryTracker::getCurrentTag()
+    {
+        return t_currentTag;
+    }
+
+    //----------------------------------------------------------------------
+    MemoryTagStats MemoryTracker::getTagStats( EMemoryTag tag )
+    {
+        Size i = static_cast<Size>( tag );
+        ASSERT( i < NUM_TAGS );
+
+        MemoryTagStats stats;
+        stats.bytesAllocated        = s_tagBytes[i].load( std::memory_order_relaxed );
+        stats.peakBytesAllocated    = s_tagPeakBytes[i].load( std::memory_order_relaxed );
+        stats.numAllocations        = s_tagNumAllocations[i].load( std::memory_order_relaxed );
+        stats.totalAllocations      = s_tagTotalAllocations[i].load( std::memory_order_relaxed );
+        stats.budget                = s_tagBudgets[i].load( std::memory_order_relaxed );
+        return stats;
+    }
+
+    //----------------------------------------------------------------------
+    void MemoryTracker::setBudget( EMemoryTag tag, I64 bytes )
+    {
+        Size i = static_cast<Size>( tag );
+        ASSERT( i < NUM_TAGS );
+
+        s_tagBudgets[i].store( bytes, std::memory_order_relaxed );
+        s_tagBudgetExceeded[i].store( bytes > 0 && s_tagBytes[i].load( std::memory_order_relaxed ) > bytes, std::memory_order_relaxed );
+    }
+
+    //----------------------------------------------------------------------
+    bool MemoryTracker::consumeBudgetExceeded( EMemoryTag tag )
+    {
+        return s_tagBudgetExceeded[static_cast<Size>( tag )].exchange( false, std::memory_order_relaxed );
+    }
+
+    //----------------------------------------------------------------------
+    void MemoryTracker::setCallstackSampleRate( U32 sampleRate )
+    {
+        s_sampleRate.store( sampleRate, std::memory_order_relaxed );
+    }
+
+    //----------------------------------------------------------------------
+    static String CallstackToString( const Callstack& callstack )
+    {
+        String result;
+        char line[512];
+
+    #ifdef _WIN32
+        // DbgHelp is single threaded
+        static std::mutex dbgHelpMutex;
+        std::lock_guard<std::mutex> lock( dbgHelpMutex );
+
+        static bool symbolsInitialized = false;
+        HANDLE process = GetCurrentProcess();
+        if (not symbolsInitialized)
+        {
+            SymSetOptions( SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES | SYMOPT_UNDNAME );
+            symbolsInitialized = SymInitialize( process, nullptr, TRUE ) == TRUE;
+        }
+
+        alignas(SYMBOL_INFO) Byte symbolBuffer[sizeof( SYMBOL_INFO ) + MAX_SYM_NAME];
+        SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>( symbolBuffer );
+    #endif
+
+        for (U32 i = 0; i < callstack.numFrames; i++)
+        {
+            U64 address = static_cast<U64>( reinterpret_cast<uintptr_t>( callstack.frames[i] ) );
+            snprintf( line, sizeof( line ), "        0x%016llx", address );
+            result += line;
+
+    #ifdef _WIN32
+            if (symbolsInitialized)
+            {
+                memset( symbol, 0, sizeof( SYMBOL_INFO ) );
+                symbol->SizeOfStruct = sizeof( SYMBOL_INFO );
+                symbol->MaxNameLen   = MAX_SYM_NAME;
+
+                DWORD64 displacement = 0;
+                if (SymFromAddr( process, address, &displacement, symbol ))
+                {
+                    result += String( " " ) + symbol->Name;
+
+                    IMAGEHLP_LINE64 sourceLine = {};
+                    sourceLine.SizeOfStruct = sizeof( IMAGEHLP_LINE64 );
+                    DWORD lineDisplacement = 0;
+                    if (SymGetLineFromAddr64( process, address, &lineDisplacement, &sourceLine ))
+                        result += String( " (" ) + sourceLine.FileName + ":" + TS( sourceLine.LineNumber ) + ")";
+                }
+            }
+    #endif
+            result += "\n";
+        }
+
+        if (callstack.numFrames == 0)
+            result += "        <no callstack>\n";
+
+        return result;
+    }
+
+    //----------------------------------------------------------------------
+    String MemoryTracker::getReport()
+    {
+        MemoryScope memoryScope( EMemoryTag::Debug );
+        t_buildingReport = true;
+        String report = _BuildReport();
+        t_buildingReport = false;
+        return report;
+    }
+
+    //----------------------------------------------------------------------
+    String MemoryTracker::_BuildReport()
+    {
+        String report = "Memory Report\n";
+        char line[256];
+
+        snprintf( line, sizeof( line ), "%-12s %14s %14s %12s %14s %14s\n", "Tag", "Bytes", "Peak", "Alive", "Allocations", "Budget" );
+        report += line;
+        for (Size i = 0; i < NUM_TAGS; i++)
+        {
+            EMemoryTag tag = static_cast<EMemoryTag>( i );
+            MemoryTagStats stats = getTagStats( tag );
+            snprintf( line, sizeof( line ), "%-12s %14lld %14lld %12lld %14lld %14lld%s\n", MemoryTagToString( tag ),
+                      stats.bytesAllocated, stats.peakBytesAllocated, stats.numAllocations, stats.totalAllocations,
+                      stats.budget, (stats.budget > 0 && stats.bytesAllocated > stats.budget) ? "  OVER BUDGET" : "" );
+            report += line;
+        }
+
+        U32 sampleRate = s_sampleRate.load( std::memory_order_relaxed );
+        if (sampleRate == 0)
+            return report + "\nCallstack sampling disabled.\n";
+
+        // Copy the tables first. Reserve outside of the lock, because allocating
+        // while holding it would deadlock when that allocation gets sampled.
+        ArrayList<LiveSample> liveSamples;
+        ArrayList<Hotspot> hotspots;
+        liveSamples.reserve( MEMORY_CALLSTACK_MAX_SAMPLES );
+        hotspots.reserve( MEMORY_HOTSPOT_TABLE_SIZE );
+        {
+            std::lock_guard<std::mutex> lock( GetSamplesMutex() );
+            for (U32 i = 0; i < s_numSamplesTouched; i++)
+                if (s_liveSamples[i].used)
+                    liveSamples.push_back( s_liveSamples[i] );
+            for (auto& hotspot : s_hotspots)
+                if (hotspot.numAllocations > 0)
+                    hotspots.push_back( hotspot );
+        }
+
+        // Group live samples with the same callstack
+        std::sort( liveSamples.begin(), liveSamples.end(), [](const LiveSample& a, const LiveSample& b) {
+            if (a.callstack.hash != b.callstack.hash) return a.callstack.hash < b.callstack.hash;
+            return memcmp( a.callstack.frames, b.callstack.frames, sizeof( a.callstack.frames ) ) < 0;
+        } );
+
+        struct LiveGroup { const LiveSample* sample; I64 count; I64 bytes; };
+        ArrayList<LiveGroup> liveGroups;
+        for (auto& sample : liveSamples)
+        {
+            if (liveGroups.empty() || not SameCallstack( liveGroups.back().sample->callstack, sample.callstack ))
+                liveGroups.push_back( { &sample, 0, 0 } );
+            liveGroups.back().count++;
+            liveGroups.back().bytes += sample.bytes;
+        }
+        std::sort( liveGroups.begin(), liveGroups.end(), [](const LiveGroup& a, const LiveGroup& b) { return a.bytes > b.bytes; } );
+        std::sort( hotspots.begin(), hotspots.end(), [](const Hotspot& a, const Hotspot& b) { return a.numAllocations > b.numAllocations; } );
+
+        const Size MAX_ENTRIES = 32;
+
+        snprintf( line, sizeof( line ), "\nLive sampled allocations (every %u. allocation, %u callstacks). Leak candidates if the program is shutting down:\n",
+                  sampleRate, static_cast<U32>( liveGroups.size() ) );
+        report += line;
+        for (Size i = 0; i < std::min( liveGroups.size(), MAX_ENTRIES ); i++)
+        {
+            snprintf( line, sizeof( line ), "    #%u: %lld sampled bytes in %lld allocations [%s]\n", static_cast<U32>( i ),
+                      liveGroups[i].bytes, liveGroups[i].count, MemoryTagToString( liveGroups[i].sample->tag ) );
+            report += line;
+            report += CallstackToString( liveGroups[i].sample->callstack );
+        }
+
+        snprintf( line, sizeof( line ), "\nAllocation hotspots (%u callstacks):\n", s_numHotspots );
+        report += line;
+        for (Size i = 0; i < std::min( hotspots.size(), MAX_ENTRIES ); i++)
+        {
+            snprintf( line, sizeof( line ), "    #%u: %lld sampled allocations, %lld bytes\n", static_cast<U32>( i ),
+                      hotspots[i].numAllocations, hotspots[i].bytes );
+            report += line;
+            report += CallstackToString( hotspots[i].callstack );
+        }
+
+        return report;
+    }
+
+    //----------------------------------------------------------------------
+    bool MemoryTracker::writeReport( const OS::Path& path )
+    {
+        String report = getReport();
+        try
+        {
+            OS::TextFile file( path, OS::EFileMode::WRITE );
+            file.write( report.c_str() );
+        }
+        catch (const std::runtime_error& e)
+        {
+            LOG_WARN( "MemoryTracker::writeReport(): " + String( e.what() ) );
+            return false;
+        }
+
+        return true;
+    }
+
     //----------------------------------------------------------------------
 #ifndef STATIC_LIB
     MemoryTracker MemoryTracker::s_memoryLeakDetectionInstance;
@@ -6,13 +6,60 @@
     author: S. Hau
     date: October 7, 2017
 
-    Tracks all allocated memory from global new/delete.
+    Tracks all allocated memory from global new/delete. Allocations are
+    additionally counted per tag, which is set for a scope on the
+    current thread via MEM_SCOPE(Tag), e.g. MEM_SCOPE(Textures).
 **********************************************************************/
 
 #include "Memory/memory_structs.h"
 
+namespace OS { class Path; }
+
+//----------------------------------------------------------------------
+#define MEMORY_CALLSTACK_MAX_FRAMES     16
+#define MEMORY_CALLSTACK_MAX_SAMPLES    4096    // Sampled allocations which can be alive at the same time
+
+#define _MEM_SCOPE_CONCAT_IMPL(a, b)    a##b
+#define _MEM_SCOPE_CONCAT(a, b)         _MEM_SCOPE_CONCAT_IMPL( a, b )
+
+// Every global allocation on this thread until the end of the scope is counted for the given tag
+#define MEM_SCOPE(TAG)  Core::MemoryManagement::MemoryScope _MEM_SCOPE_CONCAT( __memScope, __LINE__ )( Core::MemoryManagement::EMemoryTag::TAG )
+
 namespace Core { namespace MemoryManagement {
 
+    //**********************************************************************
+    // Subsystems for which memory is counted separately.
+    //**********************************************************************
+    enum class EMemoryTag : U8
+    {
+        General = 0,    // Everything outside of a MEM_SCOPE
+        Assets,
+        Textures,
+        Meshes,
+        Shaders,
+        Materials,
+        Audio,
+        Rendering,
+        Scene,
+        Chunks,
+        Debug,
+        Count
+    };
+
+    const char* MemoryTagToString(EMemoryTag tag);
+
+    //**********************************************************************
+    // Snapshot of the counters of one tag.
+    //**********************************************************************
+    struct MemoryTagStats
+    {
+        I64 bytesAllocated          = 0;
+        I64 peakBytesAllocated      = 0;
+        I64 numAllocations          = 0;    // Currently alive
+        I64 totalAllocations        = 0;
+        I64 budget                  = 0;    // In bytes, zero if none
+    };
+
     //**********************************************************************
     // Global new/delete call this functions in order to allocate/deallocate.
     // Manipulates the AllocationMemoryInfo struct in the MemoryTracker class.
@@ -50,6 +97,52 @@ namespace Core { namespace MemoryManagement {
         //----------------------------------------------------------------------
         static void log();
 
+        //----------------------------------------------------------------------
+        // Changes the tag of the calling thread. Use MEM_SCOPE instead.
+        // @Return:
+        //  The previous tag.
+        //----------------------------------------------------------------------
+        static EMemoryTag setCurrentTag(EMemoryTag tag);
+        static EMemoryTag getCurrentTag();
+
+        //----------------------------------------------------------------------
+        static MemoryTagStats getTagStats(EMemoryTag tag);
+
+        //----------------------------------------------------------------------
+        // @Params:
+        //  "bytes": Amount of bytes the tag should not exceed. Zero disables the budget.
+        //----------------------------------------------------------------------
+        static void setBudget(EMemoryTag tag, I64 bytes);
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  True, if the tag exceeded its budget since the last call.
+        //----------------------------------------------------------------------
+        static bool consumeBudgetExceeded(EMemoryTag tag);
+
+        //----------------------------------------------------------------------
+        // Captures the callstack of every n-th allocation per thread. Samples
+        // are kept until the allocation is freed, so the report shows where
+        // the live memory (or leaked memory on shutdown) comes from.
+        // @Params:
+        //  "sampleRate": Capture every n-th allocation. Zero disables it.
+        //----------------------------------------------------------------------
+        static void setCallstackSampleRate(U32 sampleRate);
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Human readable report with the stats of every tag and the live
+        //  sampled allocations grouped by callstack.
+        //----------------------------------------------------------------------
+        static String getReport();
+
+        //----------------------------------------------------------------------
+        // Writes the report to the given file.
+        // @Return:
+        //  False, if the file could not be written.
+        //----------------------------------------------------------------------
+        static bool writeReport(const OS::Path& path);
+
     private:
 #ifndef STATIC_LIB
         static MemoryTracker s_memoryLeakDetectionInstance;
@@ -58,8 +151,25 @@ namespace Core { namespace MemoryManagement {
         // Check for a memory leak. Halt the program if one detected.
         void _CheckForMemoryLeak();
 
+        static String _BuildReport();
+
         NULL_COPY_AND_ASSIGN(MemoryTracker)
     };
 
+    //**********************************************************************
+    // Sets the memory tag of the current thread for the lifetime of this object.
+    //**********************************************************************
+    class MemoryScope
+    {
+    public:
+        explicit MemoryScope(EMemoryTag tag) : m_previousTag( MemoryTracker::setCurrentTag( tag ) ) {}
+        ~MemoryScope() { MemoryTracker::setCurrentTag( m_previousTag ); }
+
+    private:
+        EMemoryTag m_previousTag;
+
+        NULL_COPY_AND_ASSIGN(MemoryScope)
+    };
+
 
 } } // end namespaces
\ No newline at end of file
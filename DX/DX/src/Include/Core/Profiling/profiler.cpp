@@ -26,6 +26,7 @@ namespace Core { namespace Profiling {
     void Profiler::init()
     {
         Locator::getCoreEngine().subscribe( this );
+        ZoneProfiler::SetThreadName( "Main Thread" );
     }
 
     //----------------------------------------------------------------------
@@ -158,6 +159,40 @@ namespace Core { namespace Profiling {
         LOG( "[Profiler] Begin profiling for " + TS(duration.value) + " seconds..." );
     }
 
+    //----------------------------------------------------------------------
+    bool Profiler::exportChromeTrace( const OS::Path& path, U32 firstFrame, U32 lastFrame )
+    {
+        bool success = ZoneProfiler::ExportChromeTrace( path, firstFrame, lastFrame );
+        if (success)
+            LOG( "[Profiler] Exported frames " + TS( firstFrame ) + " - " + TS( lastFrame ) + " to '" + path.toString() + "'", LOGCOLOR );
+        return success;
+    }
+
+    //----------------------------------------------------------------------
+    void Profiler::logZones( U32 firstFrame, U32 lastFrame )
+    {
+        F64 numFrames = static_cast<F64>( lastFrame - firstFrame + 1 );
+
+        LOG( " >>>> Zones of frames " + TS( firstFrame ) + " - " + TS( lastFrame ) + ": ", LOGCOLOR );
+        for (auto& thread : ZoneProfiler::Collect( firstFrame, lastFrame ))
+        {
+            if ( thread.zones.empty() )
+                continue;
+
+            // Maps [Name] <-> [Ticks]. Zones are recorded with a pointer to a literal, but the same literal might be duplicated.
+            HashMap<StringID, U64> ticksPerZone;
+            for (auto& zone : thread.zones)
+                ticksPerZone[SID( zone.name )] += zone.endTicks - zone.beginTicks;
+
+            LOG( "<<< " + (thread.threadName.empty() ? "Thread #" + TS( thread.threadID ) : thread.threadName) + " >>>", LOGCOLOR );
+            for (auto& pair : ticksPerZone)
+            {
+                F64 ms = OS::PlatformTimer::ticksToMilliSeconds( pair.second ) / numFrames;
+                LOG( "[" + pair.first.toString() + "]: " + TS( ms ) + "ms", LOGCOLOR );
+            }
+        }
+    }
+
     //----------------------------------------------------------------------
     // PRIVATE
     //----------------------------------------------------------------------
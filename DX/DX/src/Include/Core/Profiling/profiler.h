@@ -8,6 +8,7 @@
 **********************************************************************/
 
 #include "Common/i_subsystem.hpp"
+#include "zone_profiler.h"
 
 namespace Core { namespace Profiling {
 
@@ -75,6 +76,26 @@ namespace Core { namespace Profiling {
         //----------------------------------------------------------------------
         void beginProfiling(Time::Seconds duration, std::function<void(ProfileResult)> callback);
 
+        //----------------------------------------------------------------------
+        // @Return:
+        //  Frame number used to tag all zones (see PROFILE_ZONE).
+        //----------------------------------------------------------------------
+        U32 getFrame() const { return ZoneProfiler::GetFrame(); }
+
+        //----------------------------------------------------------------------
+        // Writes all zones of all threads, which began in the given frame range,
+        // as chrome trace-event JSON to the given file.
+        // @Params:
+        //  "firstFrame": First frame to export.
+        //  "lastFrame": Last frame to export (inclusive).
+        //----------------------------------------------------------------------
+        bool exportChromeTrace(const OS::Path& path, U32 firstFrame, U32 lastFrame);
+
+        //----------------------------------------------------------------------
+        // Log the average time of every zone across the given frame range.
+        //----------------------------------------------------------------------
+        void logZones(U32 firstFrame, U32 lastFrame);
+
     private:
         U32                 m_fps = 0;
         Time::Milliseconds  m_updateDelta = 0.0f;
@@ -0,0 +1,243 @@
+#include "zone_profiler.h"
+/**********************************************************************
+    class: ZoneProfiler (zone_profiler.cpp)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    @Considerations:
+      - The ring buffers are read without synchronizing with the owning
+        thread. The write counter is read before and after copying, and
+        all slots which might have been overwritten in between are
+        dropped (similar to a seqlock).
+**********************************************************************/
+
+#include "OS/PlatformTimer/platform_timer.h"
+#include "OS/FileSystem/file.h"
+#include "Logging/logging.h"
+
+namespace Core { namespace Profiling {
+
+    static_assert( (PROFILE_ZONE_BUFFER_SIZE & (PROFILE_ZONE_BUFFER_SIZE - 1)) == 0, "Buffer size must be a power of two." );
+
+    //----------------------------------------------------------------------
+    std::atomic<U32>                                            ZoneProfiler::s_frame{ 0 };
+    std::mutex                                                  ZoneProfiler::s_threadsMutex;
+    ArrayList<std::unique_ptr<ZoneProfiler::ThreadBuffer>>      ZoneProfiler::s_threads;
+    ArrayList<ZoneProfiler::ThreadBuffer*>                      ZoneProfiler::s_freeBuffers;
+
+    //----------------------------------------------------------------------
+    // Appends the string as quoted json string. Quotes, backslashes and
+    // control characters are escaped.
+    //----------------------------------------------------------------------
+    static void AppendJSONString( String& json, const char* str )
+    {
+        json += '"';
+        for (; *str != '\0'; ++str)
+        {
+            char c = *str;
+            switch (c)
+            {
+            case '"':  json += "\\\""; break;
+            case '\\': json += "\\\\"; break;
+            case '\n': json += "\\n"; break;
+            case '\r': json += "\\r"; break;
+            case '\t': json += "\\t"; break;
+            default:
+                if (static_cast<U8>( c ) < 0x20)
+                {
+                    char escaped[8];
+                    snprintf( escaped, sizeof( escaped ), "\\u%04x", static_cast<U8>( c ) );
+                    json += escaped;
+                }
+                else
+                {
+                    json += c;
+                }
+            }
+        }
+        json += '"';
+    }
+
+    //----------------------------------------------------------------------
+    // Appends the formatted string. The required size is queried first, so
+    // nothing is ever truncated.
+    //----------------------------------------------------------------------
+    template <typename... Args>
+    static void AppendFormat( String& str, const char* format, Args... args )
+    {
+        I32 length = snprintf( nullptr, 0, format, args... );
+        if (length <= 0)
+            return;
+
+        Size offset = str.size();
+        str.resize( offset + length + 1 );
+        snprintf( &str[offset], length + 1, format, args... );
+        str.resize( offset + length );
+    }
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void ZoneProfiler::SetThreadName( const String& name )
+    {
+        auto& buffer = _GetThreadBuffer();
+
+        std::lock_guard<std::mutex> lock( s_threadsMutex );
+        buffer.name = name;
+    }
+
+    //----------------------------------------------------------------------
+    ArrayList<ThreadZones> ZoneProfiler::Collect( U32 firstFrame, U32 lastFrame )
+    {
+        ArrayList<ThreadZones> result;
+
+        std::lock_guard<std::mutex> lock( s_threadsMutex );
+        for (auto& buffer : s_threads)
+        {
+            ThreadZones threadZones;
+            threadZones.threadName  = buffer->name;
+            threadZones.threadID    = buffer->threadID;
+
+            U64 writtenBefore = buffer->written.load( std::memory_order_acquire );
+            U64 begin = writtenBefore > PROFILE_ZONE_BUFFER_SIZE ? writtenBefore - PROFILE_ZONE_BUFFER_SIZE : 0;
+
+            ArrayList<ZoneEvent> copy( buffer->zones, buffer->zones + PROFILE_ZONE_BUFFER_SIZE );
+            U64 writtenAfter = buffer->written.load( std::memory_order_acquire );
+
+            // The owner might be writing the slot of zone "writtenAfter", which was zone "writtenAfter - SIZE" before
+            if (writtenAfter >= PROFILE_ZONE_BUFFER_SIZE)
+                begin = std::max( begin, writtenAfter - PROFILE_ZONE_BUFFER_SIZE + 1 );
+
+            for (U64 i = begin; i < writtenBefore; ++i)
+            {
+                const ZoneEvent& zone = copy[i & (PROFILE_ZONE_BUFFER_SIZE - 1)];
+                if (zone.frame >= firstFrame && zone.frame <= lastFrame)
+                    threadZones.zones.push_back( zone );
+            }
+
+            result.emplace_back( std::move( threadZones ) );
+        }
+
+        return result;
+    }
+
+    //----------------------------------------------------------------------
+    String ZoneProfiler::ToChromeTrace( const ArrayList<ThreadZones>& threads )
+    {
+        // Timestamps are relative to the first zone, so they stay small
+        U64 originTicks = ~0ull;
+        for (auto& thread : threads)
+            for (auto& zone : thread.zones)
+                originTicks = std::min( originTicks, zone.beginTicks );
+
+        String json = "{\"traceEvents\":[\n";
+        bool first = true;
+        for (auto& thread : threads)
+        {
+            String threadName = thread.threadName.empty() ? "Thread #" + TS( thread.threadID ) : thread.threadName;
+            AppendFormat( json, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",\n", thread.threadID );
+            AppendJSONString( json, threadName.c_str() );
+            json += "}}";
+            first = false;
+
+            for (auto& zone : thread.zones)
+            {
+                F64 ts  = OS::PlatformTimer::ticksToMicroSeconds( zone.beginTicks - originTicks );
+                F64 dur = OS::PlatformTimer::ticksToMicroSeconds( zone.endTicks - zone.beginTicks );
+                json += ",\n{\"name\":";
+                AppendJSONString( json, zone.name );
+                AppendFormat( json, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u,\"args\":{\"frame\":%u,\"depth\":%u}}",
+                              ts, dur, thread.threadID, zone.frame, zone.depth );
+            }
+        }
+        json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+        return json;
+    }
+
+    //----------------------------------------------------------------------
+    bool ZoneProfiler::ExportChromeTrace( const OS::Path& path, U32 firstFrame, U32 lastFrame )
+    {
+        String json = ToChromeTrace( Collect( firstFrame, lastFrame ) );
+        try
+        {
+            OS::TextFile file( path, OS::EFileMode::WRITE );
+            file.write( json.c_str() );
+        }
+        catch (const std::runtime_error& e)
+        {
+            LOG_WARN( "ZoneProfiler::ExportChromeTrace(): " + String( e.what() ) );
+            return false;
+        }
+
+        return true;
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    ZoneProfiler::ThreadBuffer& ZoneProfiler::_GetThreadBuffer()
+    {
+        static thread_local ThreadBufferOwner owner;
+        if (owner.buffer == nullptr)
+        {
+            std::lock_guard<std::mutex> lock( s_threadsMutex );
+            if ( not s_freeBuffers.empty() )
+            {
+                // The previous owner is gone and Collect() holds the lock, so nobody else touches the buffer
+                owner.buffer = s_freeBuffers.back();
+                s_freeBuffers.pop_back();
+                owner.buffer->name.clear();
+                owner.buffer->depth = 0;
+                owner.buffer->written.store( 0, std::memory_order_relaxed );
+            }
+            else
+            {
+                s_threads.emplace_back( std::make_unique<ThreadBuffer>() );
+                owner.buffer = s_threads.back().get();
+                owner.buffer->threadID = static_cast<U32>( s_threads.size() - 1 );
+            }
+        }
+        return *owner.buffer;
+    }
+
+    //----------------------------------------------------------------------
+    ZoneProfiler::ThreadBufferOwner::~ThreadBufferOwner()
+    {
+        if (buffer == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> lock( s_threadsMutex );
+        s_freeBuffers.push_back( buffer );
+    }
+
+    //**********************************************************************
+    // ScopedZone
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    ScopedZone::ScopedZone( const char* name )
+        : m_buffer( ZoneProfiler::_GetThreadBuffer() ), m_name( name ), m_frame( ZoneProfiler::GetFrame() )
+    {
+        m_buffer.depth++;
+        m_beginTicks = OS::PlatformTimer::getTicks();
+    }
+
+    //----------------------------------------------------------------------
+    ScopedZone::~ScopedZone()
+    {
+        U64 endTicks = OS::PlatformTimer::getTicks();
+        m_buffer.depth--;
+
+        // Only this thread writes, so the counter can be read relaxed. The release store publishes the slot.
+        U64 index = m_buffer.written.load( std::memory_order_relaxed );
+        m_buffer.zones[index & (PROFILE_ZONE_BUFFER_SIZE - 1)] = { m_name, m_beginTicks, endTicks, m_frame, m_buffer.depth };
+        m_buffer.written.store( index + 1, std::memory_order_release );
+    }
+
+} } // End namespaces
@@ -0,0 +1,142 @@
+#pragma once
+/**********************************************************************
+    class: ZoneProfiler (zone_profiler.h)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Records scoped, nested zones on any thread, including worker jobs.
+    Every thread writes into its own ring buffer without taking a lock.
+    The recorded zones of a frame range can be exported as chrome
+    trace-event JSON (chrome://tracing or ui.perfetto.dev). Does not
+    depend on any subsystem, so it works headless as well.
+    @Considerations:
+      - Each thread keeps only its last PROFILE_ZONE_BUFFER_SIZE zones.
+      - The buffer of an exited thread is handed to the next new thread,
+        so memory only grows with the number of threads alive at once.
+        Zones of exited threads are kept until then.
+      - Zone names are stored as pointers, so they must stay alive
+        (e.g. string literals).
+**********************************************************************/
+
+#include <atomic>
+#include <mutex>
+#include "OS/FileSystem/path.h"
+
+#define PROFILE_ZONES_ENABLED       1
+#define PROFILE_ZONE_BUFFER_SIZE    16384 // Zones per thread, must be a power of two
+
+#define _PROFILE_ZONE_CONCAT_IMPL(a, b)  a##b
+#define _PROFILE_ZONE_CONCAT(a, b)       _PROFILE_ZONE_CONCAT_IMPL( a, b )
+
+#if PROFILE_ZONES_ENABLED
+    // Profiles the enclosing scope under the given name
+    #define PROFILE_ZONE(name)  Core::Profiling::ScopedZone _PROFILE_ZONE_CONCAT( __profileZone, __LINE__ )( name )
+#else
+    #define PROFILE_ZONE(name)
+#endif
+
+namespace Core { namespace Profiling {
+
+    //----------------------------------------------------------------------
+    struct ZoneEvent
+    {
+        const char* name;
+        U64         beginTicks;
+        U64         endTicks;
+        U32         frame;  // Frame in which the zone began
+        U32         depth;  // 0 = top level zone of the thread
+    };
+
+    //----------------------------------------------------------------------
+    struct ThreadZones
+    {
+        String                  threadName;
+        U32                     threadID;
+        ArrayList<ZoneEvent>    zones;
+    };
+
+    //**********************************************************************
+    class ZoneProfiler
+    {
+    public:
+        //----------------------------------------------------------------------
+        // Advances the frame counter. Called at the beginning of every frame by the core engine.
+        //----------------------------------------------------------------------
+        static void NextFrame()         { s_frame.fetch_add( 1, std::memory_order_relaxed ); }
+        static U32  GetFrame()          { return s_frame.load( std::memory_order_relaxed ); }
+
+        //----------------------------------------------------------------------
+        // Sets the name of the calling thread, which shows up in the trace.
+        //----------------------------------------------------------------------
+        static void SetThreadName(const String& name);
+
+        //----------------------------------------------------------------------
+        // Collects the zones of all threads, which began in the given frame range.
+        // Can be called while other threads keep recording.
+        // @Params:
+        //  "firstFrame": First frame to collect.
+        //  "lastFrame": Last frame to collect (inclusive).
+        //----------------------------------------------------------------------
+        static ArrayList<ThreadZones> Collect(U32 firstFrame, U32 lastFrame);
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  The given zones as a chrome trace-event JSON string.
+        //----------------------------------------------------------------------
+        static String ToChromeTrace(const ArrayList<ThreadZones>& threads);
+
+        //----------------------------------------------------------------------
+        // Writes all zones in the given frame range as chrome trace-event JSON.
+        // @Return:
+        //  False, if the file could not be written.
+        //----------------------------------------------------------------------
+        static bool ExportChromeTrace(const OS::Path& path, U32 firstFrame, U32 lastFrame);
+
+    private:
+        struct ThreadBuffer
+        {
+            String              name;
+            U32                 threadID;
+            U32                 depth = 0;
+            std::atomic<U64>    written{ 0 }; // Total amount of zones ever written, only the owner increments
+            ZoneEvent           zones[PROFILE_ZONE_BUFFER_SIZE];
+        };
+
+        // Returns the buffer of its thread to the free list when the thread exits
+        struct ThreadBufferOwner
+        {
+            ThreadBuffer* buffer = nullptr;
+            ~ThreadBufferOwner();
+        };
+
+        static std::atomic<U32>                             s_frame;
+        static std::mutex                                   s_threadsMutex;
+        static ArrayList<std::unique_ptr<ThreadBuffer>>     s_threads;      // Buffers outlive their threads, so zones of finished jobs are kept
+        static ArrayList<ThreadBuffer*>                     s_freeBuffers;  // Buffers of exited threads, reused by new threads
+
+        //----------------------------------------------------------------------
+        static ThreadBuffer& _GetThreadBuffer();
+
+        friend class ScopedZone;
+    };
+
+    //**********************************************************************
+    // Records a zone from construction until destruction.
+    //**********************************************************************
+    class ScopedZone
+    {
+    public:
+        explicit ScopedZone(const char* name);
+        ~ScopedZone();
+
+    private:
+        ZoneProfiler::ThreadBuffer& m_buffer;
+        const char*                 m_name;
+        U64                         m_beginTicks;
+        U32                         m_frame;
+
+        NULL_COPY_AND_ASSIGN(ScopedZone)
+    };
+
+} } // End namespaces
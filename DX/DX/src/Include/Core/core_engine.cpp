@@ -96,6 +96,9 @@ namespace Core {
         m_isRunning = true;
         while ( m_isRunning && not m_window.shouldBeClosed() )
         {
+            Profiling::ZoneProfiler::NextFrame();
+            PROFILE_ZONE( "Frame" );
+
             Time::Seconds delta = m_engineClock._Update();
             if (delta > 0.5f) delta = 0.5f;
 
@@ -133,6 +136,7 @@ namespace Core {
     //----------------------------------------------------------------------
     void CoreEngine::_Render()
     {
+        PROFILE_ZONE( "Render" );
         auto& graphicsEngine = Locator::getRenderer();
 
         // Update global buffer
@@ -146,7 +150,10 @@ namespace Core {
         Events::EventDispatcher::GetEvent( EVENT_FRAME_END ).invoke();
 
         // Present backbuffer(s) to screen
-        graphicsEngine.present();
+        {
+            PROFILE_ZONE( "Present" );
+            graphicsEngine.present();
+        }
 
         m_frameCounter++;
     }
@@ -176,6 +183,7 @@ namespace Core {
     //----------------------------------------------------------------------
     void CoreEngine::_NotifyOnTick( Time::Seconds delta )
     {
+        PROFILE_ZONE( "OnTick" );
         for (auto& subscriber : m_subscribers)
             subscriber->OnTick( delta );
     }
@@ -183,6 +191,7 @@ namespace Core {
     //----------------------------------------------------------------------
     void CoreEngine::_NotifyOnUpdate( Time::Seconds delta )
     {
+        PROFILE_ZONE( "OnUpdate" );
         for (auto& subscriber : m_subscribers)
             subscriber->OnUpdate( delta );
     }
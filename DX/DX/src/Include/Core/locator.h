@@ -55,6 +55,7 @@
 #define WINDOW                  Locator::getWindow()
 #define CONFIG                  Locator::getConfiguration()
 #define RENDERER                Locator::getRenderer()
+#define FRAME_ALLOCATOR         Locator::getFrameAllocator()
 
 //*********************************************************************
 // Retrieve / Change every subsystem via a static method.
@@ -80,6 +81,7 @@ public:
     static Core::Debug::DebugManager&                 getDebugManager()   { return *gDebugManager;}
     static Assets::AssetManager&                      getAssetManager()   { return *gAssetManager; }
     static Core::Audio::AudioManager&                 getAudioManager()   { return *gAudioManager; }
+    static Core::MemoryManagement::FrameAllocator&    getFrameAllocator() { return gMemoryManager->getFrameAllocator(); }
 
     //----------------------------------------------------------------------
     // Provide a Sub-System
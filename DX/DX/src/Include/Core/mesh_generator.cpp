@@ -159,7 +159,7 @@ namespace Core {
         };
 
         auto mesh = RESOURCES.createMesh( vertices, indices, uvs );
-        mesh->recalculateNormals();
+        mesh->recalculateNormals( &Locator::getThreadManager().getThreadPool() );
         mesh->recalculateTangents();
         return mesh;
     }
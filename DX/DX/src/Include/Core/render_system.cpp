@@ -12,7 +12,7 @@
 #include "GameplayLayer/gameobject.h"
 #include "GameplayLayer/Components/Rendering/i_light_component.h"
 #include "GameplayLayer/Components/Rendering/i_render_component.hpp"
-#include <unordered_set>
+#include "OS/Threading/parallel.hpp"
 
 namespace Core {
 
@@ -23,128 +23,220 @@ namespace Core {
     //----------------------------------------------------------------------
     void RenderSystem::execute()
     {
+        PROFILE_ZONE( "RenderSystem::execute" );
+        MEM_SCOPE( Rendering );
         auto& renderer = Locator::getRenderer();
 
-        // List of lights which rendered a shadowmap this frame. This is needed in order to prevent
-        // a shadowmap rendered from a light multiple times (because more than one camera renders the same light)
-        std::unordered_set<Components::ILightComponent*> shadowMapsRendered;
+        // Submit command buffers to render engine
+        for (auto cmd : record( &Locator::getThreadManager().getThreadPool() ))
+            renderer.dispatch( *cmd );
+    }
 
-        // Render each camera
+    //----------------------------------------------------------------------
+    const ArrayList<const Graphics::CommandBuffer*>& RenderSystem::record( OS::ThreadPool* threadPool )
+    {
         auto& scene = Locator::getSceneManager().getCurrentScene();
-        for (auto& cam : scene.getComponentManager().getCameras())
+        auto& componentManager = scene.getComponentManager();
+
+        // Only moved renderers and lights are reinserted, which validates their transforms aswell.
+        // Cameras are validated in _RecordLights(), so the jobs only read transforms afterwards.
+        componentManager.updateSpatialIndex();
+
+        _RecordLights();
+
+        // Shadowmaps first, they are usually the most expensive jobs
+        OS::ParallelFor( threadPool, 0, m_numShadowPasses + m_numCameraPasses, [&](I64 i) {
+            PROFILE_ZONE( "RenderSystem::RecordPass" );
+            MEM_SCOPE( Rendering );
+            if (i < m_numShadowPasses)
+                m_shadowPasses[i].light->recordShadowMapCommands( scene, m_shadowPasses[i].cmd );
+            else
+                _RecordCameraPass( m_cameraPasses[i - m_numShadowPasses] );
+        } );
+
+        // Shadowmaps of a camera must be rendered before the camera itself
+        m_recordedBuffers.clear();
+        for (U32 i = 0; i < m_numCameraPasses; ++i)
+        {
+            for (U32 shadow = m_firstShadowPass[i]; shadow < m_firstShadowPass[i + 1]; ++shadow)
+                m_recordedBuffers.push_back( &m_shadowPasses[shadow].cmd );
+            m_recordedBuffers.push_back( &m_cameraPasses[i].cmd );
+        }
+
+        return m_recordedBuffers;
+    }
+
+    //----------------------------------------------------------------------
+    bool RenderSystem::validateParallelRecording( OS::ThreadPool* threadPool )
+    {
+        ArrayList<Graphics::CommandBuffer> serialBuffers;
+        for (auto cmd : record( nullptr ))
+            serialBuffers.push_back( *cmd );
+
+        auto& parallelBuffers = record( threadPool );
+        if (parallelBuffers.size() != serialBuffers.size())
+            return false;
+
+        for (Size i = 0; i < serialBuffers.size(); ++i)
+            if ( not serialBuffers[i].isIdentical( *parallelBuffers[i] ) )
+                return false;
+
+        return true;
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void RenderSystem::_RecordLights()
+    {
+        auto& renderer = Locator::getRenderer();
+        auto& componentManager = Locator::getSceneManager().getCurrentScene().getComponentManager();
+
+        // Scratch lists are taken from the frame allocator, so no heap allocations happen here every frame.
+        auto& frameAllocator = Locator::getFrameAllocator();
+
+        m_numCameraPasses = 0;
+        m_numShadowPasses = 0;
+        m_firstShadowPass.clear();
+
+        for (auto& cam : componentManager.getCameras())
         {
             if ( not cam->isActive() )
                 continue;
 
-            // Update camera 
-            auto transform = cam->getGameObject()->getTransform();
-            auto modelMatrix = transform->getWorldMatrix();
-            Math::Vec3 camWorldPos;
-            DirectX::XMStoreFloat3( &camWorldPos, modelMatrix.r[3] );
+            if (m_numCameraPasses == m_cameraPasses.size())
+                m_cameraPasses.emplace_back();
+            CameraPass& pass = m_cameraPasses[m_numCameraPasses++];
+            m_firstShadowPass.push_back( m_numShadowPasses );
+
+            // Update camera
+            auto modelMatrix = cam->getGameObject()->getTransform()->getWorldMatrix();
+            DirectX::XMStoreFloat3( &pass.worldPosition, modelMatrix.r[3] );
             cam->m_camera.setModelMatrix( modelMatrix );
+            pass.camera = cam;
 
             // Set camera
-            Graphics::CommandBuffer cmd;
-            cmd.setCamera( cam->m_camera );
-
-            // Lights
+            pass.cmd.reset();
+            pass.cmd.setCamera( cam->m_camera );
+
+            // Record commands for every light component
+            MemoryManagement::FrameArrayList<Components::ILightComponent*> visibleLights( frameAllocator );
+            auto cullLight = [&](Components::ILightComponent* light) {
+                if ( not light->isActive() )
+                    return;
+
+                // Check if layer matches
+                bool layerMatch = cam->m_cullingMask & light->getGameObject()->getLayerMask();
+                if ( not layerMatch )
+                    return;
+
+                // Check if light is visible. The tree only tests a box around the light.
+                bool isVisible = light->cull( cam->m_camera );
+                if (isVisible)
+                    visibleLights.push_back( light );
+            };
+            componentManager.getLightTree().queryFrustum( cam->m_camera.getFrustumPlanes(), cullLight );
+            for (auto light : componentManager.getUnboundedLights())
+                cullLight( light );
+
+            // Sort lights by distance, so lights nearest to camera will be drawn first (or even not culled due to light limit)
+            Math::Vec3 camWorldPos = pass.worldPosition;
+            std::sort( visibleLights.begin(), visibleLights.end(), [camWorldPos](Components::ILightComponent*& l1, Components::ILightComponent*& l2) {
+                auto pos = l1->getGameObject()->getTransform()->getWorldPosition();
+                auto pos2 = l2->getGameObject()->getTransform()->getWorldPosition();
+                return camWorldPos.distance( pos ) < camWorldPos.distance( pos2 );
+            } );
+
+            // Record commands for a light
+            U32 lightsDrawn = 0;
+            for (auto& light : visibleLights)
             {
-                // Record commands for every light component
-                ArrayList<Components::ILightComponent*> visibleLights;
-                for ( auto& light : scene.getComponentManager().getLights() )
-                {
-                    if ( not light->isActive() )
-                        continue;
-
-                    // Check if layer matches
-                    bool layerMatch = cam->m_cullingMask & light->getGameObject()->getLayerMask();
-                    if ( not layerMatch )
-                        continue;
-
-                    // Check if light is visible
-                    bool isVisible = light->cull( cam->m_camera );
-                    if (isVisible)
-                        visibleLights.push_back( light );
-                }
-
-                // Sort lights by distance, so lights nearest to camera will be drawn first (or even not culled due to light limit)
-                std::sort( visibleLights.begin(), visibleLights.end(), [camWorldPos](Components::ILightComponent*& l1, Components::ILightComponent*& l2) {
-                    auto pos = l1->getGameObject()->getTransform()->getWorldPosition();
-                    auto pos2 = l2->getGameObject()->getTransform()->getWorldPosition();
-                    return camWorldPos.distance( pos ) < camWorldPos.distance( pos2 );
-                } );
+                // Draw light
+                light->recordGraphicsCommands( pass.cmd );
 
-                // Record commands for a light
-                U32 lightsDrawn = 0;
-                for (auto& light : visibleLights)
+                // Draw shadowmap if enabled and we are still under the limit
+                if ( light->shadowsEnabled() && (m_numShadowPasses < renderer.getLimits().maxShadowmaps) )
                 {
-                    // Draw light
-                    light->recordGraphicsCommands( cmd );
+                    // This prevents rendering of a shadowmap multiple times per frame (because the light is rendered by >1 cameras)
+                    auto shadowPassesEnd = m_shadowPasses.begin() + m_numShadowPasses;
+                    bool alreadyRendered = std::find_if( m_shadowPasses.begin(), shadowPassesEnd, [light](const ShadowPass& shadowPass) {
+                        return shadowPass.light == light;
+                    } ) != shadowPassesEnd;
 
-                    // Draw shadowmap if enabled and we are still under the limit
-                    if ( light->shadowsEnabled() && (shadowMapsRendered.size() < renderer.getLimits().maxShadowmaps) )
+                    if ( not alreadyRendered )
                     {
-                        // This prevents rendering of a shadowmap multiple times per frame (because the light is rendered by >1 cameras)
-                        if ( shadowMapsRendered.find( light ) == shadowMapsRendered.end() )
-                        {
-                            light->renderShadowMap( scene );
-                            shadowMapsRendered.insert( light );
-                        }
+                        if (m_numShadowPasses == m_shadowPasses.size())
+                            m_shadowPasses.emplace_back();
+                        ShadowPass& shadowPass = m_shadowPasses[m_numShadowPasses++];
+                        shadowPass.light = light;
+                        shadowPass.cmd.reset();
                     }
-
-                    lightsDrawn++;
-                    if (lightsDrawn == renderer.getLimits().maxLights)
-                        break;
                 }
+
+                lightsDrawn++;
+                if (lightsDrawn == renderer.getLimits().maxLights)
+                    break;
             }
+        }
 
-            // Rendering components (e.g. mesh-renderer)
+        m_firstShadowPass.push_back( m_numShadowPasses );
+    }
+
+    //----------------------------------------------------------------------
+    void RenderSystem::_RecordCameraPass( CameraPass& pass )
+    {
+        auto cam = pass.camera;
+        auto& cmd = pass.cmd;
+        auto& componentManager = Locator::getSceneManager().getCurrentScene().getComponentManager();
+
+        // Rendering components (e.g. mesh-renderer)
+        {
+            auto recordRenderer = [&](Components::IRenderComponent* renderer) {
+                if ( not renderer->isActive() )
+                    return;
+
+                // Check if layer matches
+                bool layerMatch = cam->m_cullingMask & renderer->getGameObject()->getLayerMask();
+                if (layerMatch)
+                    renderer->recordGraphicsCommands( cmd );
+            };
+
+            // Only renderers in visible nodes of the tree are tested at all
+            componentManager.getRendererTree().queryFrustum( cam->m_camera.getFrustumPlanes(), recordRenderer );
+
+            for (auto renderer : componentManager.getUnboundedRenderer())
             {
-                for ( auto& renderer : scene.getComponentManager().getRenderer() )
-                {
-                    if ( not renderer->isActive() )
-                        continue;
-
-                    // Check if layer matches
-                    bool layerMatch = cam->m_cullingMask & renderer->getGameObject()->getLayerMask();
-                    if ( not layerMatch )
-                        continue;
-
-                    // Check if component is visible
-                    bool isVisible = renderer->cull( cam->m_camera );
-                    if (isVisible)
-                        renderer->recordGraphicsCommands( cmd );
-                }
+                if ( renderer->cull( cam->m_camera ) )
+                    recordRenderer( renderer );
             }
+        }
 
-            // Merge all geometry commands
-            for (auto& additionalCmd : cam->m_additionalCommandBuffers[Components::CameraEvent::Geometry])
-                cmd.merge( *additionalCmd );
-
-            // Sort all draw commands
-            cmd.sortDrawCommands( camWorldPos );
+        // Merge all geometry commands
+        for (auto& additionalCmd : cam->m_additionalCommandBuffers[Components::CameraEvent::Geometry])
+            cmd.merge( *additionalCmd );
 
-            // Merge all post process commands
-            for (auto& additionalCmd : cam->m_additionalCommandBuffers[Components::CameraEvent::PostProcess])
-                cmd.merge( *additionalCmd );
+        // Sort all draw commands
+        cmd.sortDrawCommands( pass.worldPosition );
 
-            // Merge all gui commands
-            for (auto& additionalCmd : cam->m_additionalCommandBuffers[Components::CameraEvent::Overlay])
-                cmd.merge( *additionalCmd );
+        // Merge all post process commands
+        for (auto& additionalCmd : cam->m_additionalCommandBuffers[Components::CameraEvent::PostProcess])
+            cmd.merge( *additionalCmd );
 
-            // Inject an command which blits last rendered buffer to the screen/render target if we
-            // have at least one post processing command buffer attached or we are rendering to the screen.
-            if ( cam->isBlittingToScreen() || cam->isBlittingToHMD() )
-                cmd.blit( PREVIOUS_BUFFER, SCREEN_BUFFER, ASSETS.getPostProcessMaterial() );
-            else if (cam->m_additionalCommandBuffers[Components::CameraEvent::PostProcess].size() > 0)
-                cmd.blit( PREVIOUS_BUFFER, cam->getRenderTarget(), ASSETS.getPostProcessMaterial() );
+        // Merge all gui commands
+        for (auto& additionalCmd : cam->m_additionalCommandBuffers[Components::CameraEvent::Overlay])
+            cmd.merge( *additionalCmd );
 
-            // Add an end camera command
-            cmd.endCamera();
+        // Inject an command which blits last rendered buffer to the screen/render target if we
+        // have at least one post processing command buffer attached or we are rendering to the screen.
+        if ( cam->isBlittingToScreen() || cam->isBlittingToHMD() )
+            cmd.blit( PREVIOUS_BUFFER, SCREEN_BUFFER, ASSETS.getPostProcessMaterial() );
+        else if (cam->m_additionalCommandBuffers[Components::CameraEvent::PostProcess].size() > 0)
+            cmd.blit( PREVIOUS_BUFFER, cam->getRenderTarget(), ASSETS.getPostProcessMaterial() );
 
-            // Submit command buffer to render engine
-            renderer.dispatch( cmd );
-        }
+        // Add an end camera command
+        cmd.endCamera();
     }
 
-}
\ No newline at end of file
+}
@@ -4,8 +4,27 @@
 
     author: S. Hau
     date: June 30, 2018
+
+    Records the command buffers of every camera and shadowmap each
+    frame and dispatches them to the renderer.
+    @Considerations:
+      - Lights are culled and recorded on the calling thread, because
+        recording a light writes into the light itself. Afterwards the
+        renderers of every camera and the shadow casters of every light
+        are recorded as parallel jobs, each into its own command buffer.
+      - Transforms cache their world data lazily. Updating the spatial
+        index of the component manager validates every moved renderer
+        and light, the cameras are validated when the lights are culled.
+      - Renderers and lights are culled hierarchically with that index.
+      - The buffers are dispatched in the same order as before, so the
+        result is identical to recording everything serially.
 **********************************************************************/
 
+#include "Graphics/command_buffer.h"
+
+namespace OS { class ThreadPool; }
+namespace Components { class Camera; class ILightComponent; }
+
 namespace Core {
 
     //**********************************************************************
@@ -20,10 +39,57 @@ namespace Core {
 
         void execute();
 
+        //----------------------------------------------------------------------
+        // Culls and records all command buffers of the current scene without
+        // dispatching them. Shadowmaps come right before the first camera
+        // which needs them, so the list is in dispatch order.
+        // @Params:
+        //  "threadPool": Pool to record cameras and shadowmaps on in parallel.
+        //                Nullptr records everything on the calling thread.
+        // @Return:
+        //  The recorded buffers. Valid until the next call.
+        //----------------------------------------------------------------------
+        const ArrayList<const Graphics::CommandBuffer*>& record(OS::ThreadPool* threadPool);
+
+        //----------------------------------------------------------------------
+        // Records the current scene serially and in parallel.
+        // @Return:
+        //  True, if both produced bit identical command buffers.
+        //----------------------------------------------------------------------
+        bool validateParallelRecording(OS::ThreadPool* threadPool);
+
     private:
+        struct CameraPass
+        {
+            Components::Camera*     camera;
+            Math::Vec3              worldPosition;
+            Graphics::CommandBuffer cmd;
+        };
+
+        struct ShadowPass
+        {
+            Components::ILightComponent*    light;
+            Graphics::CommandBuffer         cmd;
+        };
+
+        // Passes are kept between frames, so their command buffers reuse their memory
+        ArrayList<CameraPass>   m_cameraPasses;
+        ArrayList<ShadowPass>   m_shadowPasses;
+        ArrayList<U32>          m_firstShadowPass;  // Per camera pass: Index of its first shadow pass. Has one extra entry at the end.
+        U32                     m_numCameraPasses = 0;
+        U32                     m_numShadowPasses = 0;
+
+        ArrayList<const Graphics::CommandBuffer*> m_recordedBuffers;
+
+        //----------------------------------------------------------------------
+        // Culls and records the lights of every camera on the calling thread and decides which lights render a shadowmap.
+        void _RecordLights();
+
+        // Records all renderers visible by the given camera and finishes its command buffer
+        void _RecordCameraPass(CameraPass& pass);
+
         RenderSystem() = default;
         NULL_COPY_AND_ASSIGN(RenderSystem)
     };
 
 }
-
@@ -123,7 +123,7 @@ namespace Components {
         auto transform = getGameObject()->getTransform();
         ASSERT( transform != nullptr );
 
-        m_dirLight->setDirection( transform->rotation.getForward() );
+        m_dirLight->setDirection( transform->getRotation().getForward() );
     }
 
     //----------------------------------------------------------------------
@@ -133,7 +133,7 @@ namespace Components {
     }
 
     //----------------------------------------------------------------------
-    void DirectionalLight::renderShadowMap( const IScene& scene )
+    void DirectionalLight::recordShadowMapCommands( const IScene& scene, Graphics::CommandBuffer& cmd )
     {
         auto mainCamera = SCENE.getMainCamera();
 
@@ -143,54 +143,82 @@ namespace Components {
         case Graphics::ShadowType::Soft:
             // Adapt view frustum so it follows the main camera around
             _AdaptOrthographicViewFrustum( mainCamera, mainCamera->getZNear(), m_dirLight->getShadowRange() );
-            ILightComponent::renderShadowMap( scene );
+            ILightComponent::recordShadowMapCommands( scene, cmd );
             break;
         case Graphics::ShadowType::CSM:
         case Graphics::ShadowType::CSMSoft:
+            _RecordCascadedShadowMap( scene, cmd );
+            break;
+        default:
+            ASSERT( "This should never happen!" );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void DirectionalLight::_RecordCascadedShadowMap( const IScene& scene, Graphics::CommandBuffer& cmd )
+    {
+        auto mainCamera = SCENE.getMainCamera();
+        auto& splits = m_dirLight->getCSMSplits();
+        U32 numCascades = static_cast<U32>( splits.size() );
+        ASSERT( numCascades <= 32 && "Cascade mask has only 32 bits" );
+
+        // Adapt orthographic frustum for every cascade first
+        auto modelMatrix = getGameObject()->getTransform()->getWorldMatrix();
+        m_cascadeCameras.clear();
+        m_cascadePlanes.resize( numCascades );
+        for (U32 cascade = 0; cascade < numCascades; ++cascade)
         {
-            Graphics::CommandBuffer cmd;
+            F32 zNear = mainCamera->getZNear();
+            if (cascade != 0) // First cascade starts at zNear
+                zNear = splits[cascade-1].range;
+            F32 zFar = splits[cascade].range;
+
+            _AdaptOrthographicViewFrustum( mainCamera, zNear, zFar );
+            m_camera->setModelMatrix( modelMatrix );
+
+            // Set light-view projection for this cascade
+            m_dirLight->setCSMShadowViewProjection( cascade, m_camera->getViewProjectionMatrix() );
+
+            m_cascadeCameras.push_back( *m_camera );
+            m_cascadePlanes[cascade] = m_camera->getFrustumPlanes();
+        }
 
-            auto& splits = m_dirLight->getCSMSplits();
-            for (auto cascade = 0; cascade < splits.size(); ++cascade)
+        // Cull every caster against all cascades at once, in one traversal of the tree
+        auto& componentManager = scene.getComponentManager();
+        m_shadowCasters.clear();
+        componentManager.getRendererTree().queryFrustums( m_cascadePlanes.data(), numCascades, [&](IRenderComponent* renderer, U32 cascadeMask) {
+            if ( renderer->isActive() && renderer->isCastingShadows() )
+                m_shadowCasters.push_back( { renderer, cascadeMask } );
+        } );
+
+        for ( auto& renderer : componentManager.getUnboundedRenderer() )
+        {
+            if ( not renderer->isActive() || not renderer->isCastingShadows() )
+                continue;
+
+            // Renderers without bounds decide themselves
+            U32 cascadeMask = 0;
+            for (U32 cascade = 0; cascade < numCascades; ++cascade)
+                if ( renderer->cull( m_cascadeCameras[cascade] ) )
+                    cascadeMask |= (1u << cascade);
+
+            if (cascadeMask != 0)
+                m_shadowCasters.push_back( { renderer, cascadeMask } );
+        }
+
+        // Fill the command list of every cascade from the masks
+        for (U32 cascade = 0; cascade < numCascades; ++cascade)
+        {
+            cmd.setCamera( m_cascadeCameras[cascade] );
+            for (auto& caster : m_shadowCasters)
             {
-                // Adapt orthographic frustum for this cascade
-                F32 zNear = mainCamera->getZNear();
-                if (cascade != 0) // First cascade starts at zNear
-                    zNear = splits[cascade-1].range;
-                F32 zFar = splits[cascade].range;
-
-                _AdaptOrthographicViewFrustum( mainCamera, zNear, zFar );
-
-                // Record commands
-                auto transform = getGameObject()->getTransform();
-                auto modelMatrix = transform->getWorldMatrix();
-                m_camera->setModelMatrix( modelMatrix );
-
-                // Set light-view projection for this cascade
-                m_dirLight->setCSMShadowViewProjection( cascade, m_camera->getViewProjectionMatrix() );
-
-                // Set camera and record commands for every rendering component
-                cmd.setCamera( *m_camera );
-                for ( auto& renderer : scene.getComponentManager().getRenderer() )
-                {
-                    if ( not renderer->isActive() || not renderer->isCastingShadows() )
-                        continue;
-
-                    // Check if component is visible
-                    bool isVisible = renderer->cull( *m_camera );
-                    if (isVisible)
-                        renderer->recordGraphicsCommands( cmd );
-                }
-                cmd.endCamera();
-
-                // Copy rendering into appropriate array slice
-                cmd.copyTexture( m_camera->getRenderTarget()->getBuffer(), 0, 0, m_dirLight->getShadowMap(), cascade, 0 );
+                if (caster.cascadeMask & (1u << cascade))
+                    caster.renderer->recordGraphicsCommands( cmd );
             }
-            Locator::getRenderer().dispatch( cmd );
-            break;
-        }
-        default:
-            ASSERT( "This should never happen!" );
+            cmd.endCamera();
+
+            // Copy rendering into appropriate array slice
+            cmd.copyTexture( m_camera->getRenderTarget()->getBuffer(), 0, 0, m_dirLight->getShadowMap(), cascade, 0 );
         }
     }
 
@@ -245,11 +273,11 @@ namespace Components {
 
         if (snapShotTimeCounter > Time::Seconds(0))
         {
-            DEBUG.drawFrustum({}, transform->rotation, m_camera->getLeft(), m_camera->getRight(), 
+            DEBUG.drawFrustum({}, transform->getRotation(), m_camera->getLeft(), m_camera->getRight(), 
                                                         m_camera->getBottom(), m_camera->getTop(), 
                                                         m_camera->getZNear(), m_camera->getZFar(), Color::BLUE, 0);
 
-            DEBUG.drawFrustum(mainCameraTransform->position, mainCameraTransform->rotation.getForward(), mainCameraTransform->rotation.getUp(), 
+            DEBUG.drawFrustum(mainCameraTransform->getPosition(), mainCameraTransform->getRotation().getForward(), mainCameraTransform->getRotation().getUp(), 
                               mainCamera->getFOV(), zNear, zFar, mainCamera->getAspectRatio(), Color::GREEN, 0);
 
             snapShotTimeCounter -= static_cast<Time::Seconds>( PROFILER.getUpdateDelta() );
@@ -259,15 +287,15 @@ namespace Components {
         if (KEYBOARD.wasKeyReleased(KEY_DEBUG_SNAPSHOT))
         {
             snapShotTimeCounter = snapShotTime;
-            DEBUG.drawFrustum( {}, transform->rotation, m_camera->getLeft(), m_camera->getRight(), 
+            DEBUG.drawFrustum( {}, transform->getRotation(), m_camera->getLeft(), m_camera->getRight(), 
                                                        m_camera->getBottom(), m_camera->getTop(), 
                                                        m_camera->getZNear(), m_camera->getZFar(), Color::BLUE, snapShotTime );
 
-            DEBUG.drawFrustum( mainCameraTransform->position, mainCameraTransform->rotation.getForward(), mainCameraTransform->rotation.getUp(), 
+            DEBUG.drawFrustum( mainCameraTransform->getPosition(), mainCameraTransform->getRotation().getForward(), mainCameraTransform->getRotation().getUp(), 
                                mainCamera->getFOV(), zNear, zFar, mainCamera->getAspectRatio(), Color::GREEN, snapShotTime );
 
             //DEBUG.drawSphere( sphereCenter, radius, Color::VIOLET, snapShotTime );
-            //DEBUG.drawLine( mainCameraTransform->position, sphereCenter, Color::GREEN, snapShotTime );
+            //DEBUG.drawLine( mainCameraTransform->getPosition(), sphereCenter, Color::GREEN, snapShotTime );
         }
 #endif
     }
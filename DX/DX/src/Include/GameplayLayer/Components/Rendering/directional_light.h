@@ -11,9 +11,12 @@
 
 #include "i_light_component.h"
 #include "Graphics/Lighting/lights.h"
+#include "Graphics/camera.h"
 
 namespace Components {
 
+    class IRenderComponent;
+
     //**********************************************************************
     class DirectionalLight : public ILightComponent
     {
@@ -36,17 +39,32 @@ namespace Components {
     private:
         Graphics::DirectionalLight* m_dirLight;
 
+        // Renderer which casts a shadow into at least one cascade. Bit i of the mask: Visible in cascade i.
+        struct ShadowCaster
+        {
+            IRenderComponent*   renderer;
+            U32                 cascadeMask;
+        };
+
+        // Scratch memory for the cascaded shadowmaps, kept to avoid allocations every frame
+        ArrayList<ShadowCaster>         m_shadowCasters;
+        ArrayList<Graphics::Camera>     m_cascadeCameras;
+        ArrayList<Math::FrustumPlanes>  m_cascadePlanes;
+
         //----------------------------------------------------------------------
         // ILightComponent Interface
         //----------------------------------------------------------------------
         void recordGraphicsCommands(Graphics::CommandBuffer& cmd) override;
         bool cull(const Graphics::Camera& camera) override { return true; }
-        void renderShadowMap(const IScene& scene) override;
+        void recordShadowMapCommands(const IScene& scene, Graphics::CommandBuffer& cmd) override;
         void _CreateShadowMap(Graphics::ShadowMapQuality) override;
 
         //----------------------------------------------------------------------
         void _AdaptOrthographicViewFrustum(Components::Camera* camera, F32 zNear, F32 zFar);
 
+        // Culls every shadow caster against all cascades in one pass and records one camera per cascade
+        void _RecordCascadedShadowMap(const IScene& scene, Graphics::CommandBuffer& cmd);
+
         NULL_COPY_AND_ASSIGN(DirectionalLight)
     };
 
@@ -203,10 +203,10 @@ namespace Components {
                     m_cmd.setScissor( r );
 
                     // Set indices
-                    ArrayList<U32> indices( pcmd->ElemCount );
+                    m_indices.resize( pcmd->ElemCount );
                     for (U32 i = 0; i < pcmd->ElemCount; i++)
-                        indices[i] = idx_buffer[i];
-                    m_dynamicMesh->setIndices( indices, subMesh, Graphics::MeshTopology::Triangles, baseVertex );
+                        m_indices[i] = idx_buffer[i];
+                    m_dynamicMesh->setIndices( m_indices, subMesh, Graphics::MeshTopology::Triangles, baseVertex );
 
                     // Draw mesh with given material
                     MaterialPtr* material = static_cast<MaterialPtr*>( pcmd->TextureId );
@@ -65,6 +65,7 @@ namespace Components {
         Graphics::CommandBuffer m_cmd;
         Components::Camera*     m_camera;
         MaterialPtr             m_fontAtlasMaterial;
+        ArrayList<U32>          m_indices;  // Reused every frame, so it only allocates when it grows
 
         void _UpdateIMGUI(F32 delta);
         void _SetMouseInputExclusive(bool enable);
@@ -68,10 +68,8 @@ namespace Components {
     //**********************************************************************
 
     //----------------------------------------------------------------------
-    void ILightComponent::renderShadowMap( const IScene& scene )
+    void ILightComponent::recordShadowMapCommands( const IScene& scene, Graphics::CommandBuffer& cmd )
     {
-        Graphics::CommandBuffer cmd;
-
         // Update camera 
         auto transform = getGameObject()->getTransform();
         auto modelMatrix = transform->getWorldMatrix();
@@ -82,8 +80,14 @@ namespace Components {
         // Set camera
         cmd.setCamera( *m_camera );
 
-        // Record commands for every rendering component
-        for ( auto& renderer : scene.getComponentManager().getRenderer() )
+        // Record commands for every visible rendering component
+        auto& componentManager = scene.getComponentManager();
+        componentManager.getRendererTree().queryFrustum( m_camera->getFrustumPlanes(), [&](IRenderComponent* renderer) {
+            if ( renderer->isActive() && renderer->isCastingShadows() )
+                renderer->recordGraphicsCommands( cmd );
+        } );
+
+        for ( auto& renderer : componentManager.getUnboundedRenderer() )
         {
             if ( not renderer->isActive() || not renderer->isCastingShadows() )
                 continue;
@@ -95,8 +99,6 @@ namespace Components {
         }
 
         cmd.endCamera();
-
-        Locator::getRenderer().dispatch( cmd );
     }
 
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #include "../i_component.h"
 #include "Graphics/Lighting/lights.h"
+#include "Math/aabb.h"
 
 namespace Core { class RenderSystem; }
 namespace Graphics { class Camera; }
@@ -18,6 +19,7 @@ class IScene;
 namespace Components {
 
     class Camera;
+    class Transform;
 
     //**********************************************************************
     class ILightComponent : public IComponent
@@ -43,20 +45,43 @@ namespace Components {
         void setShadowType          (Graphics::ShadowType shadowType);
         void setShadowTypeAndQuality(Graphics::ShadowType shadowType, Graphics::ShadowMapQuality quality);
 
+        //----------------------------------------------------------------------
+        // Refreshes the bounds in the spatial index, e.g. after the range changed.
+        //----------------------------------------------------------------------
+        void markBoundsDirty() { if (not m_boundsDirty) { m_boundsDirty = true; m_pSpatialQueue->push_back( this ); } }
+
     protected:
         std::unique_ptr<Graphics::Light>    m_light             = nullptr;
         std::unique_ptr<Graphics::Camera>   m_camera            = nullptr;
         Graphics::ShadowMapQuality          m_shadowMapQuality  = Graphics::ShadowMapQuality::High;
 
-        virtual void renderShadowMap(const IScene& scene);
+        //----------------------------------------------------------------------
+        // Records the commands which render the shadowmap into "cmd". Only
+        // touches state of this light, so lights can record in parallel.
+        //----------------------------------------------------------------------
+        virtual void recordShadowMapCommands(const IScene& scene, Graphics::CommandBuffer& cmd);
         virtual void _CreateShadowMap(Graphics::ShadowMapQuality) = 0;
 
     private:
+        // Entry in the spatial index of the component manager
+        I32                             m_spatialHandle     = -1;
+        bool                            m_unbounded         = false;    // In the unbounded list instead of the tree
+        bool                            m_boundsDirty       = true;     // Queued for the next updateSpatialIndex()
+        ArrayList<ILightComponent*>*    m_pSpatialQueue     = nullptr;  // Set by the component manager on creation
+        Transform*                      m_pSpatialTransform = nullptr;  // Transform which queues this component when it moved
+
         //----------------------------------------------------------------------
         friend class Core::RenderSystem;
+        friend class ComponentManager;
         virtual void recordGraphicsCommands(Graphics::CommandBuffer& cmd) {}
         virtual bool cull(const Graphics::Camera& camera) { return true; }
 
+        //----------------------------------------------------------------------
+        // Bounds of the lit area for the spatial index. Lights returning false
+        // (e.g. directional lights) are culled one by one via cull() instead.
+        //----------------------------------------------------------------------
+        virtual bool getCullingBounds(Math::AABB& bounds, DirectX::XMMATRIX& worldMatrix) { return false; }
+
         NULL_COPY_AND_ASSIGN(ILightComponent)
     };
 
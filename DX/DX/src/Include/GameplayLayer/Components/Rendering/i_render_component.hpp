@@ -9,12 +9,15 @@
 **********************************************************************/
 
 #include "../i_component.h"
+#include "Math/aabb.h"
 
 namespace Core { class RenderSystem; }
 namespace Graphics { class Camera; }
 
 namespace Components {
 
+    class Transform;
+
     //**********************************************************************
     class IRenderComponent : public IComponent
     {
@@ -28,15 +31,35 @@ namespace Components {
         //----------------------------------------------------------------------
         void setCastShadows(bool castShadows) { m_castShadows = castShadows; }
 
+        //----------------------------------------------------------------------
+        // Bounds in the spatial index are only refreshed when the transform
+        // moved. Call this when the local bounds changed, e.g. a new mesh.
+        //----------------------------------------------------------------------
+        void markBoundsDirty() { if (not m_boundsDirty) { m_boundsDirty = true; m_pSpatialQueue->push_back( this ); } }
+
     private:
         bool m_castShadows = true;
 
+        // Entry in the spatial index of the component manager
+        I32                             m_spatialHandle     = -1;
+        bool                            m_unbounded         = false;    // In the unbounded list instead of the tree
+        bool                            m_boundsDirty       = true;     // Queued for the next updateSpatialIndex()
+        ArrayList<IRenderComponent*>*   m_pSpatialQueue     = nullptr;  // Set by the component manager on creation
+        Transform*                      m_pSpatialTransform = nullptr;  // Transform which queues this component when it moved
+
         //----------------------------------------------------------------------
         friend class Core::RenderSystem;
+        friend class ComponentManager;
         friend class ILightComponent; friend class DirectionalLight; friend class SpotLight; friend class PointLight;
         virtual void recordGraphicsCommands(Graphics::CommandBuffer& cmd) {}
         virtual bool cull(const Graphics::Camera& camera) { return true; }
 
+        //----------------------------------------------------------------------
+        // Bounds for the spatial index of the component manager. Renderers
+        // returning false are culled one by one via cull() instead.
+        //----------------------------------------------------------------------
+        virtual bool getCullingBounds(Math::AABB& bounds, DirectX::XMMATRIX& worldMatrix) { return false; }
+
         NULL_COPY_AND_ASSIGN(IRenderComponent)
     };
 
@@ -32,6 +32,7 @@ namespace Components {
     void MeshRenderer::setMesh( const MeshPtr& mesh )
     { 
         m_mesh = mesh;
+        markBoundsDirty();
         if (m_mesh != nullptr)
         {
             m_materials.resize( std::max( (I32)m_mesh->getSubMeshCount(), 1 ) );
@@ -73,4 +74,15 @@ namespace Components {
         auto modelMatrix = getGameObject()->getTransform()->getWorldMatrix();
         return camera.cull( m_mesh->getBounds(), modelMatrix );
     }
+
+    //----------------------------------------------------------------------
+    bool MeshRenderer::getCullingBounds( Math::AABB& bounds, DirectX::XMMATRIX& worldMatrix )
+    {
+        if ( m_mesh == nullptr )
+            return false;
+
+        bounds = m_mesh->getBounds();
+        worldMatrix = getGameObject()->getTransform()->getWorldMatrix();
+        return true;
+    }
 }
\ No newline at end of file
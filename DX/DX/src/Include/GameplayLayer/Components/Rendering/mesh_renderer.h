@@ -51,6 +51,7 @@ namespace Components {
         //----------------------------------------------------------------------
         void recordGraphicsCommands(Graphics::CommandBuffer& cmd) override;
         bool cull(const Graphics::Camera& camera) override;
+        bool getCullingBounds(Math::AABB& bounds, DirectX::XMMATRIX& worldMatrix) override;
 
         NULL_COPY_AND_ASSIGN(MeshRenderer)
     };
@@ -0,0 +1,289 @@
+#include "particle_streams.h"
+/**********************************************************************
+    class: ParticleStreams (particle_streams.cpp)
+
+    author: S. Hau
+    date: October 17, 2026
+**********************************************************************/
+
+#include "Common/radix_sort.hpp"
+#include "OS/Threading/parallel.hpp"
+
+namespace Components {
+
+    using namespace DirectX;
+
+    //----------------------------------------------------------------------
+    static inline XMVECTOR Load4( const F32* data )        { return XMLoadFloat4( reinterpret_cast<const XMFLOAT4*>( data ) ); }
+    static inline void     Store4( F32* data, XMVECTOR v ) { XMStoreFloat4( reinterpret_cast<XMFLOAT4*>( data ), v ); }
+
+    //----------------------------------------------------------------------
+    static inline U32 PaddedCount( U32 count ) { return (count + 3) & ~3u; }
+
+    //----------------------------------------------------------------------
+    #define SORT_BLOCKS_PER_JOB     1024 // Minimum amount of four particle blocks per job
+
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void ParticleStreams::resize( U32 maxParticles )
+    {
+        for (auto& stream : m_streams)
+            stream.resize( PaddedCount( maxParticles ), 0.0f );
+    }
+
+    //----------------------------------------------------------------------
+    void ParticleStreams::spawn( U32 index, F32 lifetime, F32 scale, const Math::Quat& rotation, const Math::Vec3& position,
+                                 const Color& color, const Math::Vec3& velocity )
+    {
+        auto& s = m_streams;
+        s[StartLifetime][index] = s[RemainingLifetime][index] = lifetime;
+        s[SpawnScale][index]    = s[Scale][index] = scale;
+
+        s[SpawnRotationX][index] = s[RotationX][index] = rotation.x;
+        s[SpawnRotationY][index] = s[RotationY][index] = rotation.y;
+        s[SpawnRotationZ][index] = s[RotationZ][index] = rotation.z;
+        s[SpawnRotationW][index] = s[RotationW][index] = rotation.w;
+
+        s[PositionX][index] = position.x;
+        s[PositionY][index] = position.y;
+        s[PositionZ][index] = position.z;
+
+        auto normalizedColor = color.normalized();
+        s[SpawnColorR][index] = s[ColorR][index] = normalizedColor[0];
+        s[SpawnColorG][index] = s[ColorG][index] = normalizedColor[1];
+        s[SpawnColorB][index] = s[ColorB][index] = normalizedColor[2];
+        s[SpawnColorA][index] = s[ColorA][index] = normalizedColor[3];
+
+        s[SpawnVelocityX][index] = s[VelocityX][index] = velocity.x;
+        s[SpawnVelocityY][index] = s[VelocityY][index] = velocity.y;
+        s[SpawnVelocityZ][index] = s[VelocityZ][index] = velocity.z;
+    }
+
+    //----------------------------------------------------------------------
+    F32 ParticleStreams::getNormalizedAge( U32 index ) const
+    {
+        F32 lifeTimeNormalized = 1.0f - m_streams[RemainingLifetime][index] / m_streams[StartLifetime][index];
+        return std::min( lifeTimeNormalized, 1.0f );
+    }
+
+    //----------------------------------------------------------------------
+    U32 ParticleStreams::age( U32 count, F32 delta )
+    {
+        F32* remaining = m_streams[RemainingLifetime].data();
+
+        XMVECTOR vDelta = XMVectorReplicate( delta );
+        for (U32 i = 0; i < count; i += 4)
+            Store4( &remaining[i], XMVectorSubtract( Load4( &remaining[i] ), vDelta ) );
+
+        // Move last living particle into the slot of every dead one
+        for (U32 i = 0; i < count;)
+        {
+            if (remaining[i] < 0.0f)
+            {
+                _Copy( i, count - 1 );
+                --count;
+                continue;
+            }
+            ++i;
+        }
+
+        return count;
+    }
+
+    //----------------------------------------------------------------------
+    void ParticleStreams::integrate( U32 count, F32 delta, F32 gravity )
+    {
+        auto& s = m_streams;
+        XMVECTOR vDelta = XMVectorReplicate( delta );
+        XMVECTOR vGravity = XMVectorReplicate( gravity );
+        for (U32 i = 0; i < count; i += 4)
+        {
+            // Gravity grows with the age of the particle
+            XMVECTOR age = XMVectorSubtract( Load4( &s[StartLifetime][i] ), Load4( &s[RemainingLifetime][i] ) );
+            XMVECTOR velocityY = XMVectorNegativeMultiplySubtract( vGravity, age, Load4( &s[VelocityY][i] ) );
+            Store4( &s[VelocityY][i], velocityY );
+
+            Store4( &s[PositionX][i], XMVectorMultiplyAdd( Load4( &s[VelocityX][i] ), vDelta, Load4( &s[PositionX][i] ) ) );
+            Store4( &s[PositionY][i], XMVectorMultiplyAdd( velocityY,                 vDelta, Load4( &s[PositionY][i] ) ) );
+            Store4( &s[PositionZ][i], XMVectorMultiplyAdd( Load4( &s[VelocityZ][i] ), vDelta, Load4( &s[PositionZ][i] ) ) );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void ParticleStreams::resetVelocities( U32 count )
+    {
+        for (I32 c = 0; c < 3; ++c)
+            memcpy( m_streams[VelocityX + c].data(), m_streams[SpawnVelocityX + c].data(), count * sizeof( F32 ) );
+    }
+
+    //----------------------------------------------------------------------
+    void ParticleStreams::resetRotations( U32 count )
+    {
+        for (I32 c = 0; c < 4; ++c)
+            memcpy( m_streams[RotationX + c].data(), m_streams[SpawnRotationX + c].data(), count * sizeof( F32 ) );
+    }
+
+    //----------------------------------------------------------------------
+    void ParticleStreams::rotate( U32 count, const Math::Quat& rotation )
+    {
+        // Same as XMQuaternionMultiply( particleRotation, rotation ), four particles at a time
+        XMVECTOR qx = XMVectorReplicate( rotation.x );
+        XMVECTOR qy = XMVectorReplicate( rotation.y );
+        XMVECTOR qz = XMVectorReplicate( rotation.z );
+        XMVECTOR qw = XMVectorReplicate( rotation.w );
+
+        auto& s = m_streams;
+        for (U32 i = 0; i < count; i += 4)
+        {
+            XMVECTOR x = Load4( &s[RotationX][i] );
+            XMVECTOR y = Load4( &s[RotationY][i] );
+            XMVECTOR z = Load4( &s[RotationZ][i] );
+            XMVECTOR w = Load4( &s[RotationW][i] );
+
+            XMVECTOR rx = XMVectorMultiply( qw, x );
+            rx = XMVectorMultiplyAdd( qx, w, rx );
+            rx = XMVectorMultiplyAdd( qy, z, rx );
+            rx = XMVectorNegativeMultiplySubtract( qz, y, rx );
+
+            XMVECTOR ry = XMVectorMultiply( qw, y );
+            ry = XMVectorNegativeMultiplySubtract( qx, z, ry );
+            ry = XMVectorMultiplyAdd( qy, w, ry );
+            ry = XMVectorMultiplyAdd( qz, x, ry );
+
+            XMVECTOR rz = XMVectorMultiply( qw, z );
+            rz = XMVectorMultiplyAdd( qx, y, rz );
+            rz = XMVectorNegativeMultiplySubtract( qy, x, rz );
+            rz = XMVectorMultiplyAdd( qz, w, rz );
+
+            XMVECTOR rw = XMVectorMultiply( qw, w );
+            rw = XMVectorNegativeMultiplySubtract( qx, x, rw );
+            rw = XMVectorNegativeMultiplySubtract( qy, y, rw );
+            rw = XMVectorNegativeMultiplySubtract( qz, z, rw );
+
+            Store4( &s[RotationX][i], rx );
+            Store4( &s[RotationY][i], ry );
+            Store4( &s[RotationZ][i], rz );
+            Store4( &s[RotationW][i], rw );
+        }
+    }
+
+    //----------------------------------------------------------------------
+    void ParticleStreams::sortByDistance( U32 count, const XMMATRIX& worldMatrix, const Math::Vec3& eyePos, OS::ThreadPool* threadPool )
+    {
+        if (count < 2)
+            return;
+
+        auto& s = m_streams;
+        m_sortItems.resize( PaddedCount( count ) );
+        m_sortTemp.resize( count );
+
+        XMFLOAT4X4 m;
+        XMStoreFloat4x4( &m, worldMatrix );
+
+        // Squared distance between the eye and every particle in world space
+        XMVECTOR eyeX = XMVectorReplicate( eyePos.x - m._41 );
+        XMVECTOR eyeY = XMVectorReplicate( eyePos.y - m._42 );
+        XMVECTOR eyeZ = XMVectorReplicate( eyePos.z - m._43 );
+        OS::ParallelForRange( threadPool, 0, PaddedCount( count ) / 4, [&](I64 firstBlock, I64 lastBlock) {
+            for (U32 i = (U32)firstBlock * 4; i < (U32)lastBlock * 4; i += 4)
+            {
+                XMVECTOR px = Load4( &s[PositionX][i] );
+                XMVECTOR py = Load4( &s[PositionY][i] );
+                XMVECTOR pz = Load4( &s[PositionZ][i] );
+
+                XMVECTOR dx = XMVectorSubtract( eyeX, XMVectorMultiplyAdd( pz, XMVectorReplicate( m._31 ), XMVectorMultiplyAdd( py, XMVectorReplicate( m._21 ), XMVectorMultiply( px, XMVectorReplicate( m._11 ) ) ) ) );
+                XMVECTOR dy = XMVectorSubtract( eyeY, XMVectorMultiplyAdd( pz, XMVectorReplicate( m._32 ), XMVectorMultiplyAdd( py, XMVectorReplicate( m._22 ), XMVectorMultiply( px, XMVectorReplicate( m._12 ) ) ) ) );
+                XMVECTOR dz = XMVectorSubtract( eyeZ, XMVectorMultiplyAdd( pz, XMVectorReplicate( m._33 ), XMVectorMultiplyAdd( py, XMVectorReplicate( m._23 ), XMVectorMultiply( px, XMVectorReplicate( m._13 ) ) ) ) );
+                XMVECTOR distanceSq = XMVectorMultiplyAdd( dz, dz, XMVectorMultiplyAdd( dy, dy, XMVectorMultiply( dx, dx ) ) );
+
+                // Positive floats keep their order when compared as integers. Inverted, so the farthest particle comes first.
+                XMUINT4 bits;
+                XMStoreUInt4( &bits, distanceSq );
+                m_sortItems[i + 0] = { ~bits.x & 0xFFFFFFFFull, i + 0 };
+                m_sortItems[i + 1] = { ~bits.y & 0xFFFFFFFFull, i + 1 };
+                m_sortItems[i + 2] = { ~bits.z & 0xFFFFFFFFull, i + 2 };
+                m_sortItems[i + 3] = { ~bits.w & 0xFFFFFFFFull, i + 3 };
+            }
+        }, SORT_BLOCKS_PER_JOB );
+
+        Common::RadixSort64( m_sortItems.data(), m_sortTemp.data(), count, [](const SortItem& item) { return item.key; } );
+
+        // Apply the new order to every stream, one stream per job if there are enough particles
+        I64 streamsPerJob = (count >= SORT_BLOCKS_PER_JOB * 4) ? 1 : NUM_STREAMS;
+        OS::ParallelFor( threadPool, 0, NUM_STREAMS, [&](I64 streamIndex) {
+            static thread_local ArrayList<F32> scratch;
+            scratch.resize( count );
+
+            auto& stream = m_streams[streamIndex];
+            for (U32 i = 0; i < count; ++i)
+                scratch[i] = stream[m_sortItems[i].index];
+            memcpy( stream.data(), scratch.data(), count * sizeof( F32 ) );
+        }, streamsPerJob );
+    }
+
+    //----------------------------------------------------------------------
+    void ParticleStreams::writeInstanceData( U32 count, XMMATRIX* matrices, Math::Vec4* colors ) const
+    {
+        auto& s = m_streams;
+        const XMVECTOR zero = XMVectorZero();
+        const XMVECTOR one = XMVectorSplatOne();
+        for (U32 i = 0; i < count; i += 4)
+        {
+            XMVECTOR x = Load4( &s[RotationX][i] );
+            XMVECTOR y = Load4( &s[RotationY][i] );
+            XMVECTOR z = Load4( &s[RotationZ][i] );
+            XMVECTOR w = Load4( &s[RotationW][i] );
+            XMVECTOR scale = Load4( &s[Scale][i] );
+
+            // Rotation matrix rows like XMMatrixRotationQuaternion(), each row multiplied by the uniform scale
+            XMVECTOR x2 = XMVectorAdd( x, x ), y2 = XMVectorAdd( y, y ), z2 = XMVectorAdd( z, z );
+            XMVECTOR xx = XMVectorMultiply( x, x2 ), yy = XMVectorMultiply( y, y2 ), zz = XMVectorMultiply( z, z2 );
+            XMVECTOR xy = XMVectorMultiply( x, y2 ), xz = XMVectorMultiply( x, z2 ), yz = XMVectorMultiply( y, z2 );
+            XMVECTOR wx = XMVectorMultiply( w, x2 ), wy = XMVectorMultiply( w, y2 ), wz = XMVectorMultiply( w, z2 );
+
+            XMMATRIX row0( XMVectorMultiply( XMVectorSubtract( XMVectorSubtract( one, yy ), zz ), scale ),
+                           XMVectorMultiply( XMVectorAdd( xy, wz ), scale ),
+                           XMVectorMultiply( XMVectorSubtract( xz, wy ), scale ),
+                           zero );
+            XMMATRIX row1( XMVectorMultiply( XMVectorSubtract( xy, wz ), scale ),
+                           XMVectorMultiply( XMVectorSubtract( XMVectorSubtract( one, xx ), zz ), scale ),
+                           XMVectorMultiply( XMVectorAdd( yz, wx ), scale ),
+                           zero );
+            XMMATRIX row2( XMVectorMultiply( XMVectorAdd( xz, wy ), scale ),
+                           XMVectorMultiply( XMVectorSubtract( yz, wx ), scale ),
+                           XMVectorMultiply( XMVectorSubtract( XMVectorSubtract( one, xx ), yy ), scale ),
+                           zero );
+            XMMATRIX row3( Load4( &s[PositionX][i] ), Load4( &s[PositionY][i] ), Load4( &s[PositionZ][i] ), one );
+            XMMATRIX color( Load4( &s[ColorR][i] ), Load4( &s[ColorG][i] ), Load4( &s[ColorB][i] ), Load4( &s[ColorA][i] ) );
+
+            // Transposing turns four lanes of a row into the same row of four particles
+            row0 = XMMatrixTranspose( row0 );
+            row1 = XMMatrixTranspose( row1 );
+            row2 = XMMatrixTranspose( row2 );
+            row3 = XMMatrixTranspose( row3 );
+            color = XMMatrixTranspose( color );
+
+            U32 numLanes = std::min( 4u, count - i );
+            for (U32 lane = 0; lane < numLanes; ++lane)
+            {
+                matrices[i + lane] = XMMATRIX( row0.r[lane], row1.r[lane], row2.r[lane], row3.r[lane] );
+                XMStoreFloat4( &colors[i + lane], color.r[lane] );
+            }
+        }
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void ParticleStreams::_Copy( U32 dst, U32 src )
+    {
+        for (auto& stream : m_streams)
+            stream[dst] = stream[src];
+    }
+
+}
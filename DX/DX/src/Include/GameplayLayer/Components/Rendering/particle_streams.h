@@ -0,0 +1,116 @@
+#pragma once
+/**********************************************************************
+    class: ParticleStreams (particle_streams.h)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Stores the attributes of particles as separate float streams
+    (structure of arrays). The hot loops of the particle system run on
+    these streams four particles at a time. Independent of any mesh or
+    scene, so it can be simulated headless.
+**********************************************************************/
+
+namespace OS { class ThreadPool; }
+
+namespace Components {
+
+    //**********************************************************************
+    class ParticleStreams
+    {
+    public:
+        //----------------------------------------------------------------------
+        enum Stream
+        {
+            StartLifetime, RemainingLifetime,
+            PositionX, PositionY, PositionZ,
+            VelocityX, VelocityY, VelocityZ,
+            SpawnVelocityX, SpawnVelocityY, SpawnVelocityZ,
+            Scale, SpawnScale,
+            RotationX, RotationY, RotationZ, RotationW,
+            SpawnRotationX, SpawnRotationY, SpawnRotationZ, SpawnRotationW,
+            ColorR, ColorG, ColorB, ColorA,
+            SpawnColorR, SpawnColorG, SpawnColorB, SpawnColorA,
+            NUM_STREAMS
+        };
+
+        ParticleStreams() = default;
+        ~ParticleStreams() = default;
+
+        //----------------------------------------------------------------------
+        // Resizes every stream to hold at least "maxParticles" particles.
+        // Streams are padded to a multiple of four.
+        //----------------------------------------------------------------------
+        void resize(U32 maxParticles);
+
+        //----------------------------------------------------------------------
+        F32*        operator[] (Stream stream)          { return m_streams[stream].data(); }
+        const F32*  operator[] (Stream stream) const    { return m_streams[stream].data(); }
+
+        //----------------------------------------------------------------------
+        // Initializes the particle at the given index.
+        //----------------------------------------------------------------------
+        void spawn(U32 index, F32 lifetime, F32 scale, const Math::Quat& rotation, const Math::Vec3& position,
+                   const Color& color, const Math::Vec3& velocity);
+
+        //----------------------------------------------------------------------
+        // @Return:
+        //  From 0 - 1 across the whole lifetime of the particle. 0 means
+        //  particle just spawned, 1 it's near death.
+        //----------------------------------------------------------------------
+        F32 getNormalizedAge(U32 index) const;
+
+        //----------------------------------------------------------------------
+        // Decreases the remaining lifetime of all particles. Dead particles are
+        // replaced by the last living particle.
+        // @Return:
+        //  New amount of particles.
+        //----------------------------------------------------------------------
+        U32 age(U32 count, F32 delta);
+
+        //----------------------------------------------------------------------
+        // Applies gravity to the current velocity and moves all particles.
+        // The velocity must be reset beforehand, e.g. with resetVelocities().
+        //----------------------------------------------------------------------
+        void integrate(U32 count, F32 delta, F32 gravity);
+
+        //----------------------------------------------------------------------
+        // Copies the spawn velocity/rotation into the current velocity/rotation.
+        //----------------------------------------------------------------------
+        void resetVelocities(U32 count);
+        void resetRotations(U32 count);
+
+        //----------------------------------------------------------------------
+        // Multiplies the rotation of all particles with the given rotation.
+        //----------------------------------------------------------------------
+        void rotate(U32 count, const Math::Quat& rotation);
+
+        //----------------------------------------------------------------------
+        // Sorts the particles back to front.
+        // @Params:
+        //  "worldMatrix": Transforms particles into world space.
+        //  "eyePos": Camera position in world space.
+        //  "threadPool": If not null, the distances and the reordering of the
+        //                streams are split across the workers of this pool.
+        //----------------------------------------------------------------------
+        void sortByDistance(U32 count, const DirectX::XMMATRIX& worldMatrix, const Math::Vec3& eyePos, OS::ThreadPool* threadPool = nullptr);
+
+        //----------------------------------------------------------------------
+        // Writes the model matrix and the normalized color of every particle.
+        // Both arrays must be able to hold "count" elements.
+        //----------------------------------------------------------------------
+        void writeInstanceData(U32 count, DirectX::XMMATRIX* matrices, Math::Vec4* colors) const;
+
+    private:
+        ArrayList<F32>  m_streams[NUM_STREAMS];
+
+        // Scratch memory for sorting
+        struct SortItem { U64 key; U32 index; };
+        ArrayList<SortItem> m_sortItems;
+        ArrayList<SortItem> m_sortTemp;
+
+        //----------------------------------------------------------------------
+        void _Copy(U32 dst, U32 src);
+    };
+
+}
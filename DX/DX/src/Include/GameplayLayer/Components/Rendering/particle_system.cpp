@@ -144,57 +144,62 @@ namespace Components {
     //----------------------------------------------------------------------
     void ParticleSystem::_SpawnParticle( U32 particleIndex )
     {
-        m_particles[particleIndex].startLifetime = m_particles[particleIndex].remainingLifetime = m_spawnLifeTimeFnc();
-
-        m_particles[particleIndex].spawnScale    = m_particles[particleIndex].scale = m_spawnScaleFnc();
-        m_particles[particleIndex].spawnRotation = m_particles[particleIndex].rotation = m_spawnRotationFnc();
-        m_particles[particleIndex].position      = m_spawnPositionFnc();
-
-        m_particles[particleIndex].spawnColor    = m_particles[particleIndex].color = m_spawnColorFnc();
-        m_particles[particleIndex].spawnVelocity = m_particles[particleIndex].velocity = m_spawnVelocityFnc();
+        m_particles.spawn( particleIndex, m_spawnLifeTimeFnc(), m_spawnScaleFnc(), m_spawnRotationFnc(), m_spawnPositionFnc(),
+                           m_spawnColorFnc(), m_spawnVelocityFnc() );
     }
 
     //----------------------------------------------------------------------
     void ParticleSystem::_UpdateParticles( Time::Seconds d )
     {
         F32 delta = (F32)d;
-        for (U32 i = 0; i < m_currentParticleCount;)
+        m_currentParticleCount = m_particles.age( m_currentParticleCount, delta );
+
+        // Lifetime functions are evaluated per particle, everything else runs on four particles at a time
+        m_particles.resetVelocities( m_currentParticleCount );
+        if (m_lifeTimeVelocityFnc)
         {
-            m_particles[i].remainingLifetime -= d;
-            if (m_particles[i].remainingLifetime < 0_s)
+            for (U32 i = 0; i < m_currentParticleCount; ++i)
             {
-                // Move last living particle in this slot
-                m_particles[i] = m_particles[m_currentParticleCount - 1];
-                --m_currentParticleCount;
-                continue;
+                auto velocity = m_lifeTimeVelocityFnc( m_particles.getNormalizedAge( i ) );
+                m_particles[ParticleStreams::VelocityX][i] += velocity.x;
+                m_particles[ParticleStreams::VelocityY][i] += velocity.y;
+                m_particles[ParticleStreams::VelocityZ][i] += velocity.z;
             }
+        }
 
-            // From 0 - 1 across the whole lifetime of the particle. 0 means particle just spawned, 1 it's near death.
-            F32 lifeTimeNormalized = 1.0f - (F32)(m_particles[i].remainingLifetime / m_particles[i].startLifetime);
-            lifeTimeNormalized = std::min( lifeTimeNormalized, 1.0f );
-
-            m_particles[i].velocity = m_particles[i].spawnVelocity;
-            if (m_lifeTimeVelocityFnc)
-                m_particles[i].velocity += m_lifeTimeVelocityFnc( lifeTimeNormalized );
-
-            // Add gravity
-            m_particles[i].velocity -= Math::Vec3{ 0, m_gravity * (F32)(m_particles[i].startLifetime - m_particles[i].remainingLifetime), 0 };
-
-            // Add velocity to position
-            m_particles[i].position += m_particles[i].velocity * delta;
-
-            // Evaluate all lifetime functions
-            m_particles[i].rotation = m_particles[i].spawnRotation; // Set always rotation here, so particles can be aligned later on
-            if (m_lifeTimeRotationFnc)
-                m_particles[i].rotation *= m_lifeTimeRotationFnc( lifeTimeNormalized );
+        m_particles.integrate( m_currentParticleCount, delta, m_gravity );
 
-            if (m_lifeTimeScaleFnc)
-                m_particles[i].scale = m_particles[i].spawnScale * m_lifeTimeScaleFnc( lifeTimeNormalized );
+        // Set always rotation here, so particles can be aligned later on
+        m_particles.resetRotations( m_currentParticleCount );
+        if (m_lifeTimeRotationFnc)
+        {
+            for (U32 i = 0; i < m_currentParticleCount; ++i)
+            {
+                Math::Quat rotation( m_particles[ParticleStreams::RotationX][i], m_particles[ParticleStreams::RotationY][i],
+                                     m_particles[ParticleStreams::RotationZ][i], m_particles[ParticleStreams::RotationW][i] );
+                rotation *= m_lifeTimeRotationFnc( m_particles.getNormalizedAge( i ) );
+
+                m_particles[ParticleStreams::RotationX][i] = rotation.x;
+                m_particles[ParticleStreams::RotationY][i] = rotation.y;
+                m_particles[ParticleStreams::RotationZ][i] = rotation.z;
+                m_particles[ParticleStreams::RotationW][i] = rotation.w;
+            }
+        }
 
-            if (m_lifeTimeColorFnc)
-                m_particles[i].color = m_particles[i].spawnColor * m_lifeTimeColorFnc( lifeTimeNormalized );
+        if (m_lifeTimeScaleFnc)
+        {
+            for (U32 i = 0; i < m_currentParticleCount; ++i)
+                m_particles[ParticleStreams::Scale][i] = m_particles[ParticleStreams::SpawnScale][i] * m_lifeTimeScaleFnc( m_particles.getNormalizedAge( i ) );
+        }
 
-            ++i;
+        if (m_lifeTimeColorFnc)
+        {
+            for (U32 i = 0; i < m_currentParticleCount; ++i)
+            {
+                auto color = m_lifeTimeColorFnc( m_particles.getNormalizedAge( i ) ).normalized();
+                for (I32 c = 0; c < 4; ++c)
+                    m_particles[(ParticleStreams::Stream)(ParticleStreams::ColorR + c)][i] = m_particles[(ParticleStreams::Stream)(ParticleStreams::SpawnColorR + c)][i] * color[c];
+            }
         }
     }
 
@@ -210,8 +215,7 @@ namespace Components {
             auto worldRot = getGameObject()->getTransform()->getWorldRotation();
             auto& eyeRot = SCENE.getMainCamera()->getGameObject()->getTransform()->getWorldRotation();
             auto alignedRotation = eyeRot * worldRot.conjugate();
-            for (U32 i = 0; i < m_currentParticleCount; ++i)
-                m_particles[i].rotation *= alignedRotation;
+            m_particles.rotate( m_currentParticleCount, alignedRotation );
             break;
         }
         case ParticleAlignment::None: break;
@@ -225,23 +229,12 @@ namespace Components {
         {
         case SortMode::ByDistance:
         {
-            auto worldMatrix = getGameObject()->getTransform()->getWorldMatrix();
-            auto eyePos = DirectX::XMLoadFloat3( &SCENE.getMainCamera()->getGameObject()->getTransform()->getWorldPosition() );
-
             // Sorting particles by distance to camera comes with one caveat:
             // 1.) Floating point precision can cause incorrect ordering when the camera moves around the particle
             //     Solution: Disable Z-Writes
-            std::sort( m_particles.begin(), m_particles.begin() + m_currentParticleCount, [worldMatrix, eyePos](const Particle& p1, const Particle& p2) {
-                auto vPos1 = DirectX::XMLoadFloat3( &p1.position );
-                auto vPos2 = DirectX::XMLoadFloat3( &p2.position );
-                auto pos1 = DirectX::XMVector3Transform( vPos1, worldMatrix );
-                auto pos2 = DirectX::XMVector3Transform( vPos2, worldMatrix );
-
-                auto distance1 = DirectX::XMVector3LengthSq( DirectX::XMVectorSubtract( eyePos, pos1 ) );
-                auto distance2 = DirectX::XMVector3LengthSq( DirectX::XMVectorSubtract( eyePos, pos2 ) );
-
-                return DirectX::XMVector3Greater( distance1, distance2 );
-            } );
+            auto worldMatrix = getGameObject()->getTransform()->getWorldMatrix();
+            auto eyePos = SCENE.getMainCamera()->getGameObject()->getTransform()->getWorldPosition();
+            m_particles.sortByDistance( m_currentParticleCount, worldMatrix, eyePos, &Locator::getThreadManager().getThreadPool() );
             break;
         }
         case SortMode::None: break;
@@ -251,17 +244,12 @@ namespace Components {
     //----------------------------------------------------------------------
     void ParticleSystem::_UpdateMesh()
     {
+        if (m_currentParticleCount == 0)
+            return;
+
         auto& matrixStream = m_particleMesh->getVertexStream<DirectX::XMMATRIX>( SHADER_NAME_MODEL_MATRIX );
         auto& colorStream = m_particleMesh->getVertexStream<Math::Vec4>( Graphics::SID_VERTEX_COLOR );
-        for (U32 i = 0; i < m_currentParticleCount; ++i)
-        {
-            DirectX::XMVECTOR s = DirectX::XMLoadFloat3( &m_particles[i].scale );
-            DirectX::XMVECTOR r = DirectX::XMLoadFloat4( &m_particles[i].rotation );
-            DirectX::XMVECTOR p = DirectX::XMLoadFloat3( &m_particles[i].position );
-            matrixStream[i] = DirectX::XMMatrixAffineTransformation( s, DirectX::XMQuaternionIdentity(), r, p );
-
-            colorStream[i] = m_particles[i].color.normalized();
-        }
+        m_particles.writeInstanceData( m_currentParticleCount, &matrixStream[0], &colorStream[0] );
     }
 
     //----------------------------------------------------------------------
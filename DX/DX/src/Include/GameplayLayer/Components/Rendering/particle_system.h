@@ -12,6 +12,7 @@
 #include "Time/clock.h"
 #include "Math/random.h"
 #include "Math/math_utils.h"
+#include "particle_streams.h"
 
 namespace Components {
 
@@ -176,22 +177,7 @@ namespace Components {
         F32                 m_accumulatedSpawnTime = 0.0f;
         bool                m_paused = false;
 
-        //**********************************************************************
-        struct Particle
-        {
-            Time::Seconds   startLifetime;
-            Time::Seconds   remainingLifetime;
-            Math::Vec3      position;
-            Math::Vec3      spawnScale;
-            Math::Vec3      scale;
-            Math::Quat      spawnRotation;
-            Math::Quat      rotation;
-            Math::Vec3      spawnVelocity;
-            Math::Vec3      velocity;
-            Color           spawnColor;
-            Color           color;
-        };
-        ArrayList<Particle> m_particles;
+        ParticleStreams     m_particles;
 
         //----------------------------------------------------------------------
         std::function<F32()>        m_spawnLifeTimeFnc  = Constant<F32>{ 4.0f };
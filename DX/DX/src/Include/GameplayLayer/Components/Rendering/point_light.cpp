@@ -42,10 +42,19 @@ namespace Components {
     }
 
     //----------------------------------------------------------------------
-    void PointLight::renderShadowMap( const IScene& scene )
+    bool PointLight::getCullingBounds( Math::AABB& bounds, DirectX::XMMATRIX& worldMatrix )
     {
-        Graphics::CommandBuffer cmd;
+        // Box around the sphere, same as in cull()
+        F32 range = getRange();
+        auto worldPos = getGameObject()->getTransform()->getWorldPosition();
+        bounds = Math::AABB( Math::Vec3( -range ), Math::Vec3( range ) );
+        worldMatrix = DirectX::XMMatrixTranslation( worldPos.x, worldPos.y, worldPos.z );
+        return true;
+    }
 
+    //----------------------------------------------------------------------
+    void PointLight::recordShadowMapCommands( const IScene& scene, Graphics::CommandBuffer& cmd )
+    {
         DirectX::XMVECTOR directions[] = {
             { 1, 0, 0, 0 }, { -1,  0,  0, 0 },
             { 0, 1, 0, 0 }, {  0, -1,  0, 0 },
@@ -60,18 +69,40 @@ namespace Components {
         m_camera->setZFar( getRange() );
 
         auto transform = getGameObject()->getTransform();
+        auto worldPos = transform->getWorldPosition();
+
+        std::array<DirectX::XMMATRIX, 6> views;
+        std::array<Math::FrustumPlanes, 6> planes;
+        for (I32 face = 0; face < 6; face++)
+        {
+            views[face] = DirectX::XMMatrixLookToLH( DirectX::XMLoadFloat3( &worldPos ), directions[face], ups[face] );
+            m_camera->setViewMatrix( views[face] );
+            planes[face] = m_camera->getFrustumPlanes();
+        }
+
+        // Test every caster against all six faces in one traversal of the tree
+        auto& componentManager = scene.getComponentManager();
+        m_shadowCasters.clear();
+        componentManager.getRendererTree().queryFrustums( planes.data(), 6, [&](IRenderComponent* renderer, U32 faceMask) {
+            if ( renderer->isActive() && renderer->isCastingShadows() )
+                m_shadowCasters.push_back( { renderer, faceMask } );
+        } );
 
         for (I32 face = 0; face < 6; face++)
         {
-            auto worldPos = DirectX::XMLoadFloat3( &transform->getWorldPosition() );
-            auto view = DirectX::XMMatrixLookToLH( worldPos, directions[face], ups[face] );
-            m_camera->setViewMatrix( view );
+            m_camera->setViewMatrix( views[face] );
 
             // Set camera
             cmd.setCamera( *m_camera );
 
             // Record commands for every rendering component
-            for ( auto& renderer : scene.getComponentManager().getRenderer() )
+            for (auto& caster : m_shadowCasters)
+            {
+                if (caster.faceMask & (1u << face))
+                    caster.renderer->recordGraphicsCommands( cmd );
+            }
+
+            for ( auto& renderer : componentManager.getUnboundedRenderer() )
             {
                 if ( not renderer->isActive() || not renderer->isCastingShadows() )
                     continue;
@@ -86,8 +117,6 @@ namespace Components {
 
             cmd.copyTexture( m_camera->getRenderTarget()->getDepthBuffer(), 0, 0, m_light->getShadowMap(), face, 0 );
         }
-
-        Locator::getRenderer().dispatch( cmd );
     }
 
     //**********************************************************************
@@ -14,6 +14,8 @@
 
 namespace Components {
 
+    class IRenderComponent;
+
     //**********************************************************************
     class PointLight : public ILightComponent
     {
@@ -25,17 +27,26 @@ namespace Components {
         F32 getRange() const { return m_pointLight->getRange(); }
 
         //----------------------------------------------------------------------
-        void setRange(F32 range) { m_pointLight->setRange(range); }
+        void setRange(F32 range) { m_pointLight->setRange(range); markBoundsDirty(); }
 
     private:
         Graphics::PointLight* m_pointLight;
 
+        // Renderer which casts a shadow into at least one face. Bit i of the mask: Visible by face i.
+        struct ShadowCaster
+        {
+            IRenderComponent*   renderer;
+            U32                 faceMask;
+        };
+        ArrayList<ShadowCaster> m_shadowCasters; // Scratch memory, kept to avoid allocations every frame
+
         //----------------------------------------------------------------------
         // IRendererComponent Interface
         //----------------------------------------------------------------------
         void recordGraphicsCommands(Graphics::CommandBuffer& cmd) override;
         bool cull(const Graphics::Camera& camera) override;
-        void renderShadowMap(const IScene& scene) override;
+        bool getCullingBounds(Math::AABB& bounds, DirectX::XMMATRIX& worldMatrix) override;
+        void recordShadowMapCommands(const IScene& scene, Graphics::CommandBuffer& cmd) override;
         void _CreateShadowMap(Graphics::ShadowMapQuality) override;
 
         NULL_COPY_AND_ASSIGN(PointLight)
@@ -8,7 +8,6 @@
 
 #include "GameplayLayer/gameobject.h"
 #include "Graphics/command_buffer.h"
-#include "Common/finite_range.hpp"
 #include "Math/math_utils.h"
 #include "../transform.h"
 #include "camera.h"
@@ -17,6 +16,58 @@ namespace Components {
 
     static constexpr StringID SID_BONE_TRANSFORMS("_BoneTransforms");
 
+    //----------------------------------------------------------------------
+    #define KEYFRAME_CURSOR_MAX_STEPS 4 // Keys to step forward from the cursor before searching the whole track
+
+    //----------------------------------------------------------------------
+    // Finds the keys enclosing the given time. Starts at the cursor and steps
+    // forward, which covers normal playback. Any other jump (looping, seeking,
+    // large deltas) falls back to a binary search.
+    // @Params:
+    //  "keys": Keys sorted by time, at least two.
+    //  "cursor": Index of the last used key. Will be updated.
+    //  "time": Time to sample.
+    // @Return:
+    //  Index of the first key. The second key is the next one.
+    //----------------------------------------------------------------------
+    template <typename TKey>
+    static U32 FindKeyframe( const ArrayList<TKey>& keys, U32& cursor, Time::Seconds time )
+    {
+        const U32 lastBegin = (U32)keys.size() - 2;
+
+        U32 begin = std::min( cursor, lastBegin );
+        if (keys[begin].time <= time)
+        {
+            for (I32 step = 0; step < KEYFRAME_CURSOR_MAX_STEPS; step++)
+            {
+                if (time <= keys[begin + 1].time || begin == lastBegin)
+                {
+                    cursor = begin;
+                    return begin;
+                }
+                begin++;
+            }
+        }
+
+        // First key with a time >= the given time is the end key
+        auto end = std::lower_bound( keys.begin() + 1, keys.end(), time, [](const TKey& key, Time::Seconds t) { return key.time < t; } );
+        begin = std::min( (U32)(end - keys.begin()) - 1, lastBegin );
+
+        cursor = begin;
+        return begin;
+    }
+
+    //----------------------------------------------------------------------
+    // @Return:
+    //  Lerp factor between the given two keys.
+    //----------------------------------------------------------------------
+    template <typename TKey>
+    static F32 KeyframeLerp( const TKey& begin, const TKey& end, Time::Seconds time )
+    {
+        F32 lerp = (F32)((time - begin.time).value / (end.time - begin.time).value);
+        return Math::Clamp( lerp, 0.0f, 1.0f );
+    }
+
     //----------------------------------------------------------------------
     SkinnedMeshRenderer::SkinnedMeshRenderer( const MeshPtr& mesh, const Animation::Skeleton& skeleton, 
                                              const Animation::AnimationClip& animation, const MaterialPtr& material )
@@ -80,6 +131,7 @@ namespace Components {
             return;
         }
         m_animation = animation;
+        m_keyframeCursors.assign( animation.jointSamples.size(), KeyframeCursor{} );
         m_clock.setDuration( animation.duration );
         m_clock.setTime( 0_ms );
     }
@@ -108,18 +160,10 @@ namespace Components {
         if (transKeys.size() == 1)
             return DirectX::XMLoadFloat3( &transKeys.front().translation );
 
-        Common::FiniteRange<I32> begin( 0, 0, (I32)transKeys.size() );
-        Common::FiniteRange<I32> end( 1, 0, (I32)transKeys.size() );
-        while (clockTime > transKeys[end.value()].time)
-        {
-            begin += 1;
-            end += 1;
-        }
-        F32 lerp = (F32)((clockTime - transKeys[begin.value()].time).value / 
-                         (transKeys[ end.value() ].time - transKeys[ begin.value() ].time).value);
-        ASSERT( lerp >= 0.0f && lerp <= 1.0f );
-        auto pBegin = DirectX::XMLoadFloat3( &transKeys[ begin.value() ].translation );
-        auto pEnd = DirectX::XMLoadFloat3( &transKeys[ end.value() ].translation );
+        U32 begin = FindKeyframe( transKeys, m_keyframeCursors[joint].translation, clockTime );
+        F32 lerp = KeyframeLerp( transKeys[begin], transKeys[begin + 1], clockTime );
+        auto pBegin = DirectX::XMLoadFloat3( &transKeys[begin].translation );
+        auto pEnd = DirectX::XMLoadFloat3( &transKeys[begin + 1].translation );
 
         return DirectX::XMVectorLerp( pBegin, pEnd, lerp );
     }
@@ -132,18 +176,10 @@ namespace Components {
         if (rotKeys.size() == 1)
             return DirectX::XMLoadFloat4( &rotKeys.front().rotation );
 
-        Common::FiniteRange<I32> begin( 0, 0, (I32)rotKeys.size() );
-        Common::FiniteRange<I32> end( 1, 0, (I32)rotKeys.size() );
-        while (clockTime > rotKeys[ end.value() ].time)
-        {
-            begin += 1;
-            end += 1;
-        }
-        F32 lerp = (F32)( (clockTime - rotKeys[begin.value()].time).value / 
-                          (rotKeys[ end.value() ].time - rotKeys[ begin.value() ].time).value);
-        ASSERT( lerp >= 0.0f && lerp <= 1.0f );
-        auto rBegin = DirectX::XMLoadFloat4( &rotKeys[begin.value()].rotation );
-        auto rEnd = DirectX::XMLoadFloat4( &rotKeys[end.value()].rotation );
+        U32 begin = FindKeyframe( rotKeys, m_keyframeCursors[joint].rotation, clockTime );
+        F32 lerp = KeyframeLerp( rotKeys[begin], rotKeys[begin + 1], clockTime );
+        auto rBegin = DirectX::XMLoadFloat4( &rotKeys[begin].rotation );
+        auto rEnd = DirectX::XMLoadFloat4( &rotKeys[begin + 1].rotation );
 
         return DirectX::XMQuaternionSlerp( rBegin, rEnd, lerp );
     }
@@ -156,18 +192,10 @@ namespace Components {
         if (scaleKeys.size() == 1)
             return DirectX::XMLoadFloat3( &scaleKeys.front().scale );
 
-        Common::FiniteRange<I32> begin( 0, 0, (I32)scaleKeys.size() );
-        Common::FiniteRange<I32> end( 1, 0, (I32)scaleKeys.size() );
-        while (clockTime > scaleKeys[ end.value() ].time)
-        {
-            begin += 1;
-            end += 1;
-        }
-        F32 lerp = (F32)( (clockTime - scaleKeys[begin.value()].time).value /
-                          (scaleKeys[ end.value() ].time - scaleKeys[ begin.value() ].time).value);
-        ASSERT( lerp >= 0.0f && lerp <= 1.0f );
-        auto sBegin = DirectX::XMLoadFloat3( &scaleKeys[begin.value()].scale );
-        auto sEnd = DirectX::XMLoadFloat3( &scaleKeys[end.value()].scale );
+        U32 begin = FindKeyframe( scaleKeys, m_keyframeCursors[joint].scale, clockTime );
+        F32 lerp = KeyframeLerp( scaleKeys[begin], scaleKeys[begin + 1], clockTime );
+        auto sBegin = DirectX::XMLoadFloat3( &scaleKeys[begin].scale );
+        auto sEnd = DirectX::XMLoadFloat3( &scaleKeys[begin + 1].scale );
 
         return DirectX::XMVectorLerp( sBegin, sEnd, lerp );
     }
@@ -50,6 +50,18 @@ namespace Components {
         Animation::Skeleton             m_skeleton;
         Animation::AnimationClip        m_animation;
 
+        //----------------------------------------------------------------------
+        // Index of the last used key per joint and channel. The clock mostly
+        // moves forward a key or two per tick, so sampling starts from here.
+        //----------------------------------------------------------------------
+        struct KeyframeCursor
+        {
+            U32 translation = 0;
+            U32 rotation    = 0;
+            U32 scale       = 0;
+        };
+        ArrayList<KeyframeCursor>       m_keyframeCursors;
+
         DirectX::XMVECTOR _GetInterpolatedTranslation(U32 joint, Time::Seconds clockTime);
         DirectX::XMVECTOR _GetInterpolatedRotation(U32 joint, Time::Seconds clockTime);
         DirectX::XMVECTOR _GetInterpolatedScale(U32 joint, Time::Seconds clockTime);
@@ -40,6 +40,17 @@ namespace Components {
         return camera.cull( getGameObject()->getTransform()->getWorldPosition(), getRange() );
     }
 
+    //----------------------------------------------------------------------
+    bool SpotLight::getCullingBounds( Math::AABB& bounds, DirectX::XMMATRIX& worldMatrix )
+    {
+        // Box around the sphere, same as in cull()
+        F32 range = getRange();
+        auto worldPos = getGameObject()->getTransform()->getWorldPosition();
+        bounds = Math::AABB( Math::Vec3( -range ), Math::Vec3( range ) );
+        worldMatrix = DirectX::XMMatrixTranslation( worldPos.x, worldPos.y, worldPos.z );
+        return true;
+    }
+
     //**********************************************************************
     // PUBLIC
     //**********************************************************************
@@ -26,7 +26,7 @@ namespace Components {
         F32     getAngle()      const;
 
         //----------------------------------------------------------------------
-        void setRange       (F32 range)     { m_spotLight->setRange(range); }
+        void setRange       (F32 range)     { m_spotLight->setRange(range); markBoundsDirty(); }
         void setAngle       (F32 angle);
 
     private:
@@ -37,6 +37,7 @@ namespace Components {
         //----------------------------------------------------------------------
         void recordGraphicsCommands(Graphics::CommandBuffer& cmd) override;
         bool cull(const Graphics::Camera& camera) override;
+        bool getCullingBounds(Math::AABB& bounds, DirectX::XMMATRIX& worldMatrix) override;
         void _CreateShadowMap(Graphics::ShadowMapQuality) override;
 
         NULL_COPY_AND_ASSIGN(SpotLight)
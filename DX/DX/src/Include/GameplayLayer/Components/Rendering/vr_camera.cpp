@@ -148,8 +148,8 @@ namespace Components {
         for (auto eye : { LeftEye, RightEye })
         {
             auto transform = m_eyeGameObjects[eye]->getTransform();
-            transform->position = eyePoses[eye].position;
-            transform->rotation = eyePoses[eye].rotation;
+            transform->setPosition( eyePoses[eye].position );
+            transform->setRotation( eyePoses[eye].rotation );
         }
     }
 
@@ -166,8 +166,8 @@ namespace Components {
             auto& touchPose = RENDERER.getHMD().getTouchPose( m_hand, Locator::getCoreEngine().getFrameCount() );
 
             auto transform = getGameObject()->getTransform();
-            transform->position = touchPose.position;
-            transform->rotation = touchPose.rotation;
+            transform->setPosition( touchPose.position );
+            transform->setRotation( touchPose.rotation );
         });
     }
 
@@ -6,7 +6,73 @@
     date: March 7, 2018
 **********************************************************************/
 
+#include "GameplayLayer/gameobject.h"
+
 namespace Components {
 
+    //**********************************************************************
+    // PUBLIC
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    void ComponentManager::updateSpatialIndex()
+    {
+        for (auto renderer : m_dirtyRenderer)
+            _UpdateSpatialEntry( renderer, m_rendererTree, m_unboundedRenderer );
+        m_dirtyRenderer.clear();
+
+        for (auto light : m_dirtyLights)
+            _UpdateSpatialEntry( light, m_lightTree, m_unboundedLights );
+        m_dirtyLights.clear();
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    void ComponentManager::_UpdateSpatialEntry( T* component, Math::LooseOctree<T*>& tree, ArrayList<T*>& unbounded )
+    {
+        // From now on the transform queues this component whenever it gets dirty
+        auto transform = component->getGameObject()->getTransform();
+        if (component->m_pSpatialTransform == nullptr)
+        {
+            component->m_pSpatialTransform = transform;
+            _GetSpatialComponents<T>( transform ).push_back( component );
+        }
+
+        // Recording jobs read the world matrix concurrently later on, so it must be valid
+        transform->getWorldMatrix();
+
+        Math::AABB bounds;
+        DirectX::XMMATRIX worldMatrix;
+        if ( component->getCullingBounds( bounds, worldMatrix ) )
+        {
+            Math::Vec3 center, extent;
+            Math::TransformBounds( bounds, worldMatrix, center, extent );
+
+            if (component->m_spatialHandle < 0)
+                component->m_spatialHandle = tree.insert( center, extent, component );
+            else
+                tree.update( component->m_spatialHandle, center, extent );
+
+            if (component->m_unbounded)
+                unbounded.erase( std::remove( unbounded.begin(), unbounded.end(), component ), unbounded.end() );
+            component->m_unbounded = false;
+        }
+        else
+        {
+            if (component->m_spatialHandle >= 0)
+                tree.remove( component->m_spatialHandle );
+            component->m_spatialHandle = -1;
+
+            if ( not component->m_unbounded )
+                unbounded.push_back( component );
+            component->m_unbounded = true;
+        }
+
+        component->m_boundsDirty = false;
+    }
 
-}
\ No newline at end of file
+}
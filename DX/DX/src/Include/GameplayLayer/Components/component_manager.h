@@ -4,11 +4,22 @@
 
     author: S. Hau
     date: December 19, 2017
+
+    Owns all components. Renderers and lights with bounds are kept in
+    loose octrees, so culling doesn't have to visit all of them.
+    @Considerations:
+      - Renderers and lights register at their transform, which queues
+        them when it gets dirty. Only queued components are refreshed,
+        unchanged ones are never visited.
+      - Bounds are refreshed once per frame by updateSpatialIndex(). This
+        validates the transforms of all queued components aswell.
 **********************************************************************/
 
 #include "Rendering/camera.h"
 #include "Rendering/i_render_component.hpp"
 #include "Rendering/i_light_component.h"
+#include "transform.h"
+#include "Math/loose_octree.h"
 
 namespace Components {
 
@@ -40,22 +51,46 @@ namespace Components {
             _Destroy<T>( component );
         }
 
+        // <---------------------- SPATIAL INDEX ---------------------------->
+        //----------------------------------------------------------------------
+        // Refreshes the bounds of all renderers and lights which moved or were
+        // marked dirty. Called once per frame before anything is culled.
+        // Afterwards their transforms are valid and can be read concurrently.
+        //----------------------------------------------------------------------
+        void updateSpatialIndex();
+
+        //----------------------------------------------------------------------
+        // Renderers and lights with bounds. Components without bounds are not
+        // in the trees and have to be culled one by one.
+        //----------------------------------------------------------------------
+        const Math::LooseOctree<IRenderComponent*>& getRendererTree()       const { return m_rendererTree; }
+        const Math::LooseOctree<ILightComponent*>&  getLightTree()          const { return m_lightTree; }
+        const ArrayList<IRenderComponent*>&         getUnboundedRenderer()  const { return m_unboundedRenderer; }
+        const ArrayList<ILightComponent*>&          getUnboundedLights()    const { return m_unboundedLights; }
+
     private:
         ArrayList<Camera*>              m_pCameras;
         ArrayList<IRenderComponent*>    m_pRenderer;
         ArrayList<ILightComponent*>     m_pLights;
 
+        Math::LooseOctree<IRenderComponent*>    m_rendererTree;
+        Math::LooseOctree<ILightComponent*>     m_lightTree;
+        ArrayList<IRenderComponent*>            m_unboundedRenderer;
+        ArrayList<ILightComponent*>             m_unboundedLights;
+        ArrayList<IRenderComponent*>            m_dirtyRenderer;
+        ArrayList<ILightComponent*>             m_dirtyLights;
+
         //----------------------------------------------------------------------
         template <typename T, typename... Args> T*   _Create( Args&&... args );
         template <typename T>                   void _Destroy( T* component );
 
+        template <typename T> void _UpdateSpatialEntry( T* component, Math::LooseOctree<T*>& tree, ArrayList<T*>& unbounded );
+        template <typename T> void _RemoveSpatialEntry( T* component, Math::LooseOctree<T*>& tree, ArrayList<T*>& unbounded );
+        template <typename T> static ArrayList<T*>& _GetSpatialComponents( Transform* transform );
+
         NULL_COPY_AND_ASSIGN(ComponentManager)
     };
 
-    //**********************************************************************
-    // TEMPLATE - PUBLIC
-    //**********************************************************************
-
     //**********************************************************************
     // TEMPLATE - PRIVATE
     //**********************************************************************
@@ -74,11 +109,20 @@ namespace Components {
         if constexpr( std::is_base_of<IRenderComponent, T>::value )
         {
             m_pRenderer.push_back( component );
+
+            // New components start dirty, so they are inserted with the next update
+            IRenderComponent* renderer = component;
+            renderer->m_pSpatialQueue = &m_dirtyRenderer;
+            m_dirtyRenderer.push_back( renderer );
         }
 
         if constexpr( std::is_base_of<ILightComponent, T>::value )
         {
             m_pLights.push_back( component );
+
+            ILightComponent* light = component;
+            light->m_pSpatialQueue = &m_dirtyLights;
+            m_dirtyLights.push_back( light );
         }
 
         return component;
@@ -92,10 +136,59 @@ namespace Components {
             m_pCameras.erase( std::remove( m_pCameras.begin(), m_pCameras.end(), c ) );
 
         if (auto r = dynamic_cast<IRenderComponent*>( component ))
+        {
             m_pRenderer.erase( std::remove( m_pRenderer.begin(), m_pRenderer.end(), r) );
+            _RemoveSpatialEntry( r, m_rendererTree, m_unboundedRenderer );
+        }
 
         if (auto l = dynamic_cast<ILightComponent*>( component ))
+        {
             m_pLights.erase( std::remove( m_pLights.begin(), m_pLights.end(), l ) );
+            _RemoveSpatialEntry( l, m_lightTree, m_unboundedLights );
+        }
+
+        // Components might outlive their transform when the gameobject is destroyed
+        if (auto t = dynamic_cast<Transform*>( component ))
+        {
+            for (auto renderer : t->m_pSpatialRenderer)
+                renderer->m_pSpatialTransform = nullptr;
+            for (auto light : t->m_pSpatialLights)
+                light->m_pSpatialTransform = nullptr;
+        }
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    void ComponentManager::_RemoveSpatialEntry( T* component, Math::LooseOctree<T*>& tree, ArrayList<T*>& unbounded )
+    {
+        if (component->m_pSpatialTransform)
+        {
+            auto& registered = _GetSpatialComponents<T>( component->m_pSpatialTransform );
+            registered.erase( std::remove( registered.begin(), registered.end(), component ), registered.end() );
+        }
+
+        if (component->m_boundsDirty)
+        {
+            auto& queue = *component->m_pSpatialQueue;
+            queue.erase( std::remove( queue.begin(), queue.end(), component ), queue.end() );
+        }
+
+        if (component->m_spatialHandle >= 0)
+            tree.remove( component->m_spatialHandle );
+        component->m_spatialHandle = -1;
+
+        if (component->m_unbounded)
+            unbounded.erase( std::remove( unbounded.begin(), unbounded.end(), component ), unbounded.end() );
+    }
+
+    //----------------------------------------------------------------------
+    template <typename T>
+    ArrayList<T*>& ComponentManager::_GetSpatialComponents( Transform* transform )
+    {
+        if constexpr( std::is_same<IRenderComponent, T>::value )
+            return transform->m_pSpatialRenderer;
+        else
+            return transform->m_pSpatialLights;
     }
 
 }
\ No newline at end of file
@@ -21,7 +21,7 @@ namespace Components {
         m_pTransform = go->getComponent<Components::Transform>();
 
         // Save start position by setting necessary fields, otherwise the script will lerp to the default values
-        m_desiredDistance = m_pointOfInterest.distance( m_pTransform->position );
+        m_desiredDistance = m_pointOfInterest.distance( m_pTransform->getPosition() );
         m_pTransform->lookAt( m_pointOfInterest );
         _ResetAnglesToCurrentView();
     }
@@ -44,7 +44,7 @@ namespace Components {
             case ECameraMode::FPS: 
                 break;
             case ECameraMode::MAYA:
-                m_desiredDistance = m_pointOfInterest.distance( m_pTransform->position );
+                m_desiredDistance = m_pointOfInterest.distance( m_pTransform->getPosition() );
                 m_pTransform->lookAt( m_pointOfInterest );
                 _ResetAnglesToCurrentView();
                 break;
@@ -53,7 +53,7 @@ namespace Components {
 
         if( KEYBOARD.isKeyDown( Key::R ) )
         {
-            auto lookToCenter = Math::Quat::LookRotation( (m_pointOfInterest - m_pTransform->position), Math::Vec3::UP );
+            auto lookToCenter = Math::Quat::LookRotation( (m_pointOfInterest - m_pTransform->getPosition()), Math::Vec3::UP );
             auto eulers = lookToCenter.toEulerAngles();
             m_mousePitchDeg = eulers.x;
             m_mouseYawDeg = eulers.y;
@@ -73,17 +73,17 @@ namespace Components {
     //----------------------------------------------------------------------
     void FPSCamera::_UpdateFPSCamera( F32 delta )
     {
-        Math::Vec3 forward  = m_pTransform->rotation.getForward();
-        Math::Vec3 left     = m_pTransform->rotation.getLeft();
-        Math::Vec3 up       = m_pTransform->rotation.getUp();
+        Math::Vec3 forward  = m_pTransform->getRotation().getForward();
+        Math::Vec3 left     = m_pTransform->getRotation().getLeft();
+        Math::Vec3 up       = m_pTransform->getRotation().getUp();
 
         F32 speed = m_fpsSpeed;
         if ( KEYBOARD.isKeyDown( Key::Control ) )
             speed *= 10.0f;
 
-        m_pTransform->position += left    * (F32)AXIS_MAPPER.getAxisValue( "Horizontal" ) * speed;
-        m_pTransform->position += forward * (F32)AXIS_MAPPER.getAxisValue( "Vertical" )   * speed;
-        m_pTransform->position += up      * (F32)AXIS_MAPPER.getAxisValue( "Up" )         * speed;
+        m_pTransform->setPosition( m_pTransform->getPosition() + left    * (F32)AXIS_MAPPER.getAxisValue( "Horizontal" ) * speed );
+        m_pTransform->setPosition( m_pTransform->getPosition() + forward * (F32)AXIS_MAPPER.getAxisValue( "Vertical" )   * speed );
+        m_pTransform->setPosition( m_pTransform->getPosition() + up      * (F32)AXIS_MAPPER.getAxisValue( "Up" )         * speed );
 
         // Rotation with mouse using delta-mouse
         if ( MOUSE.isKeyDown( MouseKey::RButton ) )
@@ -95,10 +95,10 @@ namespace Components {
 
         // Smoothly lerp to desired rotation
         Math::Quat desiredRotation = Math::Quat::FromEulerAngles( m_mousePitchDeg, m_mouseYawDeg, 0.0f );
-        m_pTransform->rotation = Math::Quat::Slerp( m_pTransform->rotation, desiredRotation, 0.1f * m_mouseDamping );
+        m_pTransform->setRotation( Math::Quat::Slerp( m_pTransform->getRotation(), desiredRotation, 0.1f * m_mouseDamping ) );
 
         // Scroll wheel
-        m_pTransform->position += m_pTransform->rotation.getForward() * (F32)AXIS_MAPPER.getMouseWheelAxisValue() * 0.5f;
+        m_pTransform->setPosition( m_pTransform->getPosition() + m_pTransform->getRotation().getForward() * (F32)AXIS_MAPPER.getMouseWheelAxisValue() * 0.5f );
     }
 
     //----------------------------------------------------------------------
@@ -113,7 +113,7 @@ namespace Components {
         }
 
         // Adjust distance if wheel is used. Move faster the farther away from POI
-        F32 distanceToPOI = (m_pTransform->position - m_pointOfInterest).magnitude();
+        F32 distanceToPOI = (m_pTransform->getPosition() - m_pointOfInterest).magnitude();
         m_desiredDistance -= (F32)AXIS_MAPPER.getMouseWheelAxisValue() * distanceToPOI * 0.05f;
         m_desiredDistance = m_desiredDistance < 0.1f ? 0.1f : m_desiredDistance;
 
@@ -122,7 +122,7 @@ namespace Components {
         Math::Vec3 desiredPosition = quat.getForward() * -m_desiredDistance;
 
         // Smoothly lerp to target position
-        m_pTransform->position = Math::Lerp( m_pTransform->position, desiredPosition, 0.2f * m_mouseDamping );
+        m_pTransform->setPosition( Math::Lerp( m_pTransform->getPosition(), desiredPosition, 0.2f * m_mouseDamping ) );
 
         // Make sure we are always looking at the target
         m_pTransform->lookAt( m_pointOfInterest );
@@ -131,7 +131,7 @@ namespace Components {
     //----------------------------------------------------------------------
     void FPSCamera::_ResetAnglesToCurrentView()
     {
-        auto eulers = m_pTransform->rotation.toEulerAngles();
+        auto eulers = m_pTransform->getRotation().toEulerAngles();
         m_mousePitchDeg = eulers.x;
         m_mouseYawDeg   = eulers.y;
     }
@@ -161,13 +161,13 @@ namespace Components {
         auto worldRotation = headTransform->getWorldRotation();
         Math::Vec3 lookDir = worldRotation.getForward();
         Math::Vec3 rightDir = worldRotation.getRight();
-        if ( KEYBOARD.isKeyDown( Key::W ) ) transform->position += lookDir * speed * delta;
-        if ( KEYBOARD.isKeyDown( Key::S ) ) transform->position -= lookDir * speed * delta;
-        transform->position += lookDir * (F32)AXIS_MAPPER.getMouseWheelAxisValue() * 0.3f;
+        if ( KEYBOARD.isKeyDown( Key::W ) ) transform->setPosition( transform->getPosition() + lookDir * speed * delta );
+        if ( KEYBOARD.isKeyDown( Key::S ) ) transform->setPosition( transform->getPosition() - lookDir * speed * delta );
+        transform->setPosition( transform->getPosition() + lookDir * (F32)AXIS_MAPPER.getMouseWheelAxisValue() * 0.3f );
 
         auto leftThumb = CONTROLLER.getThumbstick( Core::Input::ESide::Left );
-        transform->position += lookDir * leftThumb.y * speed * delta;
-        transform->position += rightDir * leftThumb.x * speed * delta;
+        transform->setPosition( transform->getPosition() + lookDir * leftThumb.y * speed * delta );
+        transform->setPosition( transform->getPosition() + rightDir * leftThumb.x * speed * delta );
 
         // Rotation
         auto rightThumb = CONTROLLER.getThumbstick( Core::Input::ESide::Right );
@@ -175,27 +175,27 @@ namespace Components {
         {
         case Mode::Smooth: // Rotate smoothly
         {
-            if ( KEYBOARD.isKeyDown( Key::A ) ) transform->rotation *= Math::Quat({0, 1, 0}, -m_rotationAngle);
-            if ( KEYBOARD.isKeyDown( Key::D ) ) transform->rotation *= Math::Quat({0, 1, 0}, m_rotationAngle);
-            transform->rotation *= Math::Quat({ 0, 1, 0 }, rightThumb.x);
+            if ( KEYBOARD.isKeyDown( Key::A ) ) transform->setRotation( transform->getRotation() * Math::Quat({0, 1, 0}, -m_rotationAngle) );
+            if ( KEYBOARD.isKeyDown( Key::D ) ) transform->setRotation( transform->getRotation() * Math::Quat({0, 1, 0}, m_rotationAngle) );
+            transform->setRotation( transform->getRotation() * Math::Quat({ 0, 1, 0 }, rightThumb.x) );
             break;
         }
         case Mode::Fixed: // Rotate in fixed steps
         {
-            if ( KEYBOARD.wasKeyPressed( Key::A ) ) transform->rotation *= Math::Quat({0, 1, 0}, -m_rotationAngle);
-            if ( KEYBOARD.wasKeyPressed( Key::D ) ) transform->rotation *= Math::Quat({0, 1, 0}, m_rotationAngle);
+            if ( KEYBOARD.wasKeyPressed( Key::A ) ) transform->setRotation( transform->getRotation() * Math::Quat({0, 1, 0}, -m_rotationAngle) );
+            if ( KEYBOARD.wasKeyPressed( Key::D ) ) transform->setRotation( transform->getRotation() * Math::Quat({0, 1, 0}, m_rotationAngle) );
 
             static bool rotated = false;
             if (rightThumb.x > -0.5f && rightThumb.x < 0.5f)
                 rotated = false;
             else if (rightThumb.x > 0.5f && not rotated)
             {
-                transform->rotation *= Math::Quat({ 0, 1, 0 }, m_rotationAngle);
+                transform->setRotation( transform->getRotation() * Math::Quat({ 0, 1, 0 }, m_rotationAngle) );
                 rotated = true;
             }
             else if (rightThumb.x < -0.5f && not rotated)
             {
-                transform->rotation *= Math::Quat({ 0, 1, 0 }, -m_rotationAngle);
+                transform->setRotation( transform->getRotation() * Math::Quat({ 0, 1, 0 }, -m_rotationAngle) );
                 rotated = true;
             }
             break;
@@ -229,8 +229,8 @@ namespace Components {
             //static bool triggered = false;
             //if (CONTROLLER.isKeyDown(ControllerKey::LHandTrigger) && CONTROLLER.isKeyDown(ControllerKey::RHandTrigger))
             //{
-            //    auto lHandPos = getTransformFromChild(LEFT_HAND_NAME)->position;
-            //    auto rHandPos = getTransformFromChild(RIGHT_HAND_NAME)->position;
+            //    auto lHandPos = getTransformFromChild(LEFT_HAND_NAME)->getPosition();
+            //    auto rHandPos = getTransformFromChild(RIGHT_HAND_NAME)->getPosition();
 
             //    auto distance = (lHandPos - rHandPos).magnitude();
             //    if (not triggered)
@@ -270,7 +270,7 @@ namespace Components {
 
             if (handTransform)
             {
-                transform->position += (gripPos - handTransform->getWorldPosition());
+                transform->setPosition( transform->getPosition() + (gripPos - handTransform->getWorldPosition()) );
                 gripPos = handTransform->getWorldPosition();
             }
 
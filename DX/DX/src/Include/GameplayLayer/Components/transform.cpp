@@ -6,6 +6,9 @@
     date: December 17, 2017
 **********************************************************************/
 
+#include "Rendering/i_render_component.hpp"
+#include "Rendering/i_light_component.h"
+
 #define LERP_TRANSFORM 0
 
 namespace Components {
@@ -15,66 +18,55 @@ namespace Components {
     //**********************************************************************
 
     //----------------------------------------------------------------------
-    void Transform::getWorldTransform( Math::Vec3* pos, Math::Vec3* scale, Math::Quat* quat )
+    void Transform::getWorldTransform( Math::Vec3* pos, Math::Vec3* scale, Math::Quat* quat ) const
     {
-        DirectX::XMVECTOR s, r, p;
-        DirectX::XMMatrixDecompose( &s, &r, &p, getWorldMatrix() );
+        _UpdateDecomposition();
 
-        DirectX::XMStoreFloat3( pos, p );
-        DirectX::XMStoreFloat3( scale, s );
-        DirectX::XMStoreFloat4( quat, r );
+        *pos   = m_worldPosition;
+        *scale = m_worldScale;
+        *quat  = m_worldRotation;
     }
 
     //----------------------------------------------------------------------
     Math::Vec3 Transform::getWorldPosition() const
     {
-        DirectX::XMVECTOR s, r, p;
-        DirectX::XMMatrixDecompose( &s, &r, &p, getWorldMatrix() );
-
-        Math::Vec3 worldPos;
-        DirectX::XMStoreFloat3( &worldPos, p );
-        return worldPos;
+        _UpdateDecomposition();
+        return m_worldPosition;
     }
 
     //----------------------------------------------------------------------
     Math::Vec3 Transform::getWorldScale() const
     {
-        DirectX::XMVECTOR s, r, p;
-        DirectX::XMMatrixDecompose( &s, &r, &p, getWorldMatrix() );
-
-        Math::Vec3 worldScale;
-        DirectX::XMStoreFloat3( &worldScale, s );
-        return worldScale;
+        _UpdateDecomposition();
+        return m_worldScale;
     }
 
     //----------------------------------------------------------------------
     Math::Quat Transform::getWorldRotation() const
     {
-        DirectX::XMVECTOR s, r, p;
-        DirectX::XMMatrixDecompose( &s, &r, &p, getWorldMatrix() );
-
-        Math::Quat worldRotation;
-        DirectX::XMStoreFloat4( &worldRotation, r );
-        return worldRotation;
+        _UpdateDecomposition();
+        return m_worldRotation;
     }
 
     //----------------------------------------------------------------------
     void Transform::lookAt( const Math::Vec3& target )
     {
-        Math::Vec3 forward = (target - position).normalized();
-        rotation = Math::Quat::LookRotation( forward, Math::Vec3::UP );
+        Math::Vec3 forward = (target - m_position).normalized();
+        setRotation( Math::Quat::LookRotation( forward, Math::Vec3::UP ) );
     }
 
     //----------------------------------------------------------------------
     DirectX::XMMATRIX Transform::getWorldMatrix() const
     {
-        auto transformationMatrix = _GetLocalTransformationMatrix();
-        if (m_pParent)
-        {
-            auto parentMatrix = m_pParent->getWorldMatrix();
-            return DirectX::XMMatrixMultiply( transformationMatrix, parentMatrix );
-        }
-        return transformationMatrix;
+        _UpdateWorldMatrix();
+        return DirectX::XMLoadFloat4x4( &m_worldMatrix );
+    }
+
+    //----------------------------------------------------------------------
+    U32 Transform::getWorldVersion() const
+    {
+        _UpdateWorldMatrix();
+        return m_worldVersion;
     }
 
     //----------------------------------------------------------------------
@@ -92,9 +84,9 @@ namespace Components {
             DirectX::XMVECTOR s, r, p;
             DirectX::XMMatrixDecompose( &s, &r, &p, matrix );
 
-            DirectX::XMStoreFloat3( &position, p );
-            DirectX::XMStoreFloat3( &scale, s );
-            DirectX::XMStoreFloat4( &rotation, r );
+            DirectX::XMStoreFloat3( &m_position, p );
+            DirectX::XMStoreFloat3( &m_scale, s );
+            DirectX::XMStoreFloat4( &m_rotation, r );
         }
 
         // Remove from current parent 
@@ -106,6 +98,8 @@ namespace Components {
         // Add to new parent
         if (m_pParent)
             m_pParent->m_pChildren.emplace_back( this );
+
+        _MarkDirty();
     }
 
     //----------------------------------------------------------------------
@@ -129,11 +123,60 @@ namespace Components {
     //----------------------------------------------------------------------
     DirectX::XMMATRIX Transform::_GetLocalTransformationMatrix() const
     {
-        DirectX::XMVECTOR s = DirectX::XMLoadFloat3( &scale );
-        DirectX::XMVECTOR r = DirectX::XMLoadFloat4( &rotation );
-        DirectX::XMVECTOR p = DirectX::XMLoadFloat3( &position );
+        DirectX::XMVECTOR s = DirectX::XMLoadFloat3( &m_scale );
+        DirectX::XMVECTOR r = DirectX::XMLoadFloat4( &m_rotation );
+        DirectX::XMVECTOR p = DirectX::XMLoadFloat3( &m_position );
 
         return DirectX::XMMatrixAffineTransformation( s, DirectX::XMQuaternionIdentity(), r, p );
     }
 
+    //----------------------------------------------------------------------
+    void Transform::_UpdateWorldMatrix() const
+    {
+        // Ancestors of a clean transform are clean aswell, so they are only visited if this one changed
+        if (not m_worldDirty)
+            return;
+
+        auto transformationMatrix = _GetLocalTransformationMatrix();
+        if (m_pParent)
+            transformationMatrix = DirectX::XMMatrixMultiply( transformationMatrix, m_pParent->getWorldMatrix() );
+        DirectX::XMStoreFloat4x4( &m_worldMatrix, transformationMatrix );
+
+        m_worldVersion++;
+        m_worldDirty     = false;
+        m_decomposeDirty = true;
+    }
+
+    //----------------------------------------------------------------------
+    void Transform::_UpdateDecomposition() const
+    {
+        _UpdateWorldMatrix();
+        if (not m_decomposeDirty)
+            return;
+
+        DirectX::XMVECTOR s, r, p;
+        DirectX::XMMatrixDecompose( &s, &r, &p, DirectX::XMLoadFloat4x4( &m_worldMatrix ) );
+
+        DirectX::XMStoreFloat3( &m_worldPosition, p );
+        DirectX::XMStoreFloat3( &m_worldScale, s );
+        DirectX::XMStoreFloat4( &m_worldRotation, r );
+        m_decomposeDirty = false;
+    }
+
+    //----------------------------------------------------------------------
+    void Transform::_MarkDirty()
+    {
+        if (m_worldDirty)
+            return;
+
+        m_worldDirty = true;
+        for (auto renderer : m_pSpatialRenderer)
+            renderer->markBoundsDirty();
+        for (auto light : m_pSpatialLights)
+            light->markBoundsDirty();
+
+        for (auto child : m_pChildren)
+            child->_MarkDirty();
+    }
+
 }
\ No newline at end of file
@@ -5,28 +5,46 @@
     author: S. Hau
     date: December 17, 2017
 
+    The world matrix and its decomposition are cached. Position, scale
+    and rotation are changed through setters, which mark the transform
+    and all of its descendants dirty. A query on a clean transform
+    returns the cached matrix without visiting any ancestor.
+    @Considerations:
+      - Marking stops at transforms which are already dirty, because
+        their descendants are dirty aswell.
+      - Renderers and lights registered by the component manager are
+        queued for the spatial index whenever their transform gets dirty.
+      - The const getters rebuild the cache, so they do write to this
+        transform and to its dirty ancestors. They must not run
+        concurrently unless the transform was validated before.
 **********************************************************************/
 
 #include "i_component.h"
 
 namespace Components {
 
+    class IRenderComponent;
+    class ILightComponent;
+
     //**********************************************************************
     class Transform : public IComponent
     {
     public:
         Transform() {}
 
-        Math::Vec3 position = Math::Vec3( 0.0f, 0.0f, 0.0f );
-        Math::Vec3 scale    = Math::Vec3( 1.0f, 1.0f, 1.0f );
-        Math::Quat rotation = Math::Quat( 0.0f, 0.0f, 0.0f, 1.0f );
+        const Math::Vec3&               getPosition()   const { return m_position; }
+        const Math::Vec3&               getScale()      const { return m_scale; }
+        const Math::Quat&               getRotation()   const { return m_rotation; }
+        void                            setPosition(const Math::Vec3& position) { m_position = position; _MarkDirty(); }
+        void                            setScale(const Math::Vec3& scale)       { m_scale = scale; _MarkDirty(); }
+        void                            setRotation(const Math::Quat& rotation) { m_rotation = rotation; _MarkDirty(); }
 
         const ArrayList<Transform*>&    getChildren()   const { return m_pChildren; }
         const Transform*                getParent()     const { return m_pParent; }
         Math::Vec3                      getWorldPosition() const;
         Math::Vec3                      getWorldScale() const;
         Math::Quat                      getWorldRotation() const;
-        void                            getWorldTransform(Math::Vec3* pos, Math::Vec3* scale, Math::Quat* quat);
+        void                            getWorldTransform(Math::Vec3* pos, Math::Vec3* scale, Math::Quat* quat) const;
 
         //----------------------------------------------------------------------
         // Rotates this transform to look at the given target. 
@@ -51,17 +69,46 @@ namespace Components {
         void addChild(Transform* t, bool keepWorldTransform = true);
 
         //----------------------------------------------------------------------
-        // Returns the final composited world transformation matrix.
+        // Returns the final composited world transformation matrix. Only
+        // recomputed if this or any parent transform changed since the last call.
+        // Not thread-safe, because that updates the cache (see @Considerations).
         //----------------------------------------------------------------------
         DirectX::XMMATRIX getWorldMatrix() const;
 
+        //----------------------------------------------------------------------
+        // Returns a number which changes whenever the world matrix changes.
+        // Validates the world matrix, so this is a cheap way to detect movement.
+        //----------------------------------------------------------------------
+        U32 getWorldVersion() const;
+
     private:
+        Math::Vec3            m_position = Math::Vec3( 0.0f, 0.0f, 0.0f );
+        Math::Vec3            m_scale    = Math::Vec3( 1.0f, 1.0f, 1.0f );
+        Math::Quat            m_rotation = Math::Quat( 0.0f, 0.0f, 0.0f, 1.0f );
         Transform*            m_pParent = nullptr;
         ArrayList<Transform*> m_pChildren;
 
+        // Cached world data. Updated on demand from the const getters.
+        mutable DirectX::XMFLOAT4X4 m_worldMatrix;
+        mutable Math::Vec3          m_worldPosition;
+        mutable Math::Vec3          m_worldScale;
+        mutable Math::Quat          m_worldRotation;
+
+        mutable U32                 m_worldVersion      = 0;    // Incremented whenever the world matrix changes
+        mutable bool                m_worldDirty        = true; // If set, all descendants are dirty aswell
+        mutable bool                m_decomposeDirty    = true;
+
+        // Components in the spatial index of the component manager, which are queued when this gets dirty
+        ArrayList<IRenderComponent*>    m_pSpatialRenderer;
+        ArrayList<ILightComponent*>     m_pSpatialLights;
+
         inline void _RemoveFromParent();
         inline DirectX::XMMATRIX _GetLocalTransformationMatrix() const;
+        void _UpdateWorldMatrix() const;
+        void _UpdateDecomposition() const;
+        void _MarkDirty();
 
+        friend class ComponentManager;
         NULL_COPY_AND_ASSIGN(Transform)
     };
 
@@ -26,7 +26,7 @@ public:
         go = createGameObject("Camera");
         cam = go->addComponent<Components::Camera>( 45.0f, 0.1f, 1000.0f, Graphics::MSAASamples::Four );
         cam->setClearColor(Color(175, 181, 191));
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 1, -5);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 1, -5) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
         go->addComponent<Components::AudioListener>();
 
@@ -238,7 +238,7 @@ private:
             if (not vrCamGO)
             {
                 vrCamGO = SCENE.createGameObject("VRCamera");
-                vrCamGO->getTransform()->position = go->getTransform()->position;
+                vrCamGO->getTransform()->setPosition( go->getTransform()->getPosition() );
                 bool isHDR = mainCamera->isHDR();
                 auto vrCam = vrCamGO->addComponent<Components::VRCamera>(Components::ScreenDisplay::LeftEye, Graphics::MSAASamples::Four, isHDR);
                 vrCam->setClearColor(mainCamera->getClearColor());
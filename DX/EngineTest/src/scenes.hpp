@@ -16,7 +16,7 @@ public:
     {
         go = createGameObject("Camera");
         cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
         cam->setCameraMode(Graphics::CameraMode::Perspective);
         F32 size = 5.0f;
@@ -40,7 +40,7 @@ public:
             // CAMERA 2
             auto go3 = createGameObject("Camera2");
             auto cam2 = go3->addComponent<Components::Camera>();
-            go3->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -5);
+            go3->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -5) );
             //cam2->setClearMode(Graphics::CameraClearMode::None);
 
             auto& viewport2 = cam2->getViewport();
@@ -51,7 +51,7 @@ public:
             // CAMERA 3
             auto go4 = createGameObject("Camera3");
             auto cam3 = go4->addComponent<Components::Camera>();
-            go4->getComponent<Components::Transform>()->position = Math::Vec3(0, 5, 5);
+            go4->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 5, 5) );
             go4->getComponent<Components::Transform>()->lookAt(Math::Vec3(0));
             //cam3->setClearMode(Graphics::CameraClearMode::None);
 
@@ -63,7 +63,7 @@ public:
             // CAMERA 4
             auto go5 = createGameObject("Camera4");
             auto cam4 = go5->addComponent<Components::Camera>();
-            go5->getComponent<Components::Transform>()->position = Math::Vec3(0, -5, -5);
+            go5->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, -5, -5) );
             go5->getComponent<Components::Transform>()->lookAt(Math::Vec3(0));
             //cam4->setClearMode(Graphics::CameraClearMode::None);
 
@@ -96,7 +96,7 @@ public:
     {
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0,10,-25);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0,10,-25) );
         //go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
         go->addComponent<AutoOrbiting>(15.0f);
 
@@ -121,12 +121,12 @@ public:
             auto mr = goModel->addComponent<Components::MeshRenderer>(cube, ASSETS.getColorMaterial());
 
             GameObject* goModel2 = createGameObject("Test");
-            goModel2->getComponent<Components::Transform>()->position = {5,0,0};
+            goModel2->getComponent<Components::Transform>()->setPosition( {5,0,0} );
             goModel2->addComponent<ConstantRotation>(20.0f, 20.0f, 0.0f);
             mr = goModel2->addComponent<Components::MeshRenderer>(sphere, ASSETS.getColorMaterial());
 
             GameObject* goModel3 = createGameObject("Test");
-            goModel3->getComponent<Components::Transform>()->position = { -5,0,0 };
+            goModel3->getComponent<Components::Transform>()->setPosition( { -5,0,0 } );
             goModel3->addComponent<ConstantRotation>(0.0f, 0.0f, 20.0f);
             mr = goModel3->addComponent<Components::MeshRenderer>(plane, ASSETS.getColorMaterial());
         }
@@ -136,10 +136,11 @@ public:
     {
         static F32 speed = 50.0f;
         F32 delta = (F32)d.value;
+        auto transform = goModel->getComponent<Components::Transform>();
         if (KEYBOARD.isKeyDown(Key::Add))
-            goModel->getComponent<Components::Transform>()->scale.y += speed * delta;
+            transform->setScale( transform->getScale() + Math::Vec3( 0, speed * delta, 0 ) );
         if (KEYBOARD.isKeyDown(Key::Subtract))
-            goModel->getComponent<Components::Transform>()->scale.y -= speed * delta;
+            transform->setScale( transform->getScale() - Math::Vec3( 0, speed * delta, 0 ) );
     }
 
 };
@@ -155,7 +156,7 @@ public:
     {
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -500);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -500) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
 
         // MESH
@@ -167,7 +168,7 @@ public:
         {
             auto go = createGameObject("Test");
             go->addComponent<Components::MeshRenderer>(cube, ASSETS.getColorMaterial());
-            go->getComponent<Components::Transform>()->position = Math::Random::Vec3(-1,1).normalized() * sq;
+            go->getComponent<Components::Transform>()->setPosition( Math::Random::Vec3(-1,1).normalized() * sq );
         }
     }
 };
@@ -182,7 +183,7 @@ public:
         // Camera
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
 
         auto cubemap = ASSETS.getCubemap("/cubemaps/tropical_sunny_day/Left.png", "/cubemaps/tropical_sunny_day/Right.png",
@@ -193,7 +194,7 @@ public:
         // Camera 2
         auto renderTex = RESOURCES.createRenderTexture(1024, 720, Graphics::TextureFormat::D32, Graphics::TextureFormat::BGRA32, 2, Graphics::MSAASamples::Four);
         auto cam2GO = createGameObject("Camera2");
-        cam2GO->getComponent<Components::Transform>()->position = Math::Vec3(0, 3, -10);
+        cam2GO->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 3, -10) );
         cam2GO->getTransform()->lookAt({});
         //cam2GO->addComponent<AutoOrbiting>(10.0f);
 
@@ -213,14 +214,14 @@ public:
         // GAMEOBJECT
         auto go3 = createGameObject("Test3");
         go3->addComponent<Components::MeshRenderer>(Core::MeshGenerator::CreatePlane(), customTexMaterial);
-        go3->getTransform()->position = Math::Vec3(0, 1.5f, 0);
-        go3->getTransform()->scale = { 3 };
+        go3->getTransform()->setPosition( Math::Vec3(0, 1.5f, 0) );
+        go3->getTransform()->setScale( { 3 } );
 
         auto player = createGameObject("Player");
         player->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/monkey.obj"), ASSETS.getMaterial("/materials/normals.material"));
         player->getTransform()->setParent(go->getTransform(), false);
-        player->getTransform()->position = { 0, 0, -0.5f };
-        player->getTransform()->rotation *= Math::Quat(Math::Vec3::UP, 180.0f);
+        player->getTransform()->setPosition( { 0, 0, -0.5f } );
+        player->getTransform()->setRotation( player->getTransform()->getRotation() * Math::Quat(Math::Vec3::UP, 180.0f) );
     }
 };
 
@@ -234,7 +235,7 @@ public:
         // Camera
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
 
         auto grid = createGameObject("Grid");
@@ -254,7 +255,7 @@ public:
         // GAMEOBJECT
         auto go2 = createGameObject("Test2");
         go2->addComponent<Components::MeshRenderer>(sphere, material);
-        go2->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, 0);
+        go2->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, 0) );
     }
 };
 
@@ -270,7 +271,7 @@ public:
         // Camera
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
 
         createGameObject("Grid")->addComponent<GridGeneration>(20);
@@ -315,11 +316,11 @@ public:
 
         auto go3 = createGameObject("Test3");
         go3->addComponent<Components::MeshRenderer>(plane, material2);
-        go3->getComponent<Components::Transform>()->position.x = -2;
+        go3->getComponent<Components::Transform>()->setPosition( { -2, 0, 0 } );
 
         auto go4 = createGameObject("Test4");
         go4->addComponent<Components::MeshRenderer>(plane, material3);
-        go4->getComponent<Components::Transform>()->position.x = 2;
+        go4->getComponent<Components::Transform>()->setPosition( { 2, 0, 0 } );
     }
 };
 
@@ -337,7 +338,7 @@ public:
         // Camera
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
 
         createGameObject("Grid")->addComponent<GridGeneration>(20);
@@ -367,13 +368,11 @@ public:
 
         child = createGameObject("Test3");
         child->addComponent<Components::MeshRenderer>(mesh, material2);
-        child->getTransform()->position.x = 5;
-        child->getTransform()->position.y = 1;
+        child->getTransform()->setPosition( { 5, 1, 0 } );
 
         child2 = createGameObject("Test4");
         child2->addComponent<Components::MeshRenderer>(mesh, material2);
-        child2->getTransform()->position.y = 3;
-        child2->getTransform()->position.z = 2;
+        child2->getTransform()->setPosition( { 0, 3, 2 } );
 
         parent->getTransform()->addChild(child->getTransform());
         parent->getTransform()->addChild(child2->getTransform());
@@ -400,7 +399,7 @@ public:
         // Camera
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 10.0f, 0.3f, 1.0f);
         go->addComponent<DrawFrustum>();
 
@@ -410,7 +409,7 @@ public:
                                                  Graphics::MSAASamples::Four, true);
         rt1->setDynamicScreenScale(true, 0.25f);
         auto cam2 = go3->addComponent<Components::Camera>(rt1);
-        go3->getComponent<Components::Transform>()->position = Math::Vec3(0, 5, -10);
+        go3->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 5, -10) );
         go3->addComponent<AutoOrbiting>(10.0f);
         cam2->getViewport().width = 0.25f / 1.33f;
         cam2->getViewport().height = 0.25f;
@@ -440,7 +439,7 @@ public:
         // Camera
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
 
         createGameObject("Grid")->addComponent<GridGeneration>(20);
@@ -453,11 +452,11 @@ public:
 
         auto go3 = createGameObject("Obj");
         go3->addComponent<Components::MeshRenderer>(plane, mat);
-        go3->getTransform()->position.z = 3;
+        go3->getTransform()->setPosition( { 0, 0, 3 } );
 
         auto go4 = createGameObject("Obj");
         go4->addComponent<Components::MeshRenderer>(plane, mat);
-        go4->getTransform()->position.z = -3;
+        go4->getTransform()->setPosition( { 0, 0, -3 } );
     }
 };
 
@@ -473,7 +472,7 @@ public:
         // Camera
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
 
         spot = go->addComponent<Components::SpotLight>(2.0f, Color::RED, 25.0f, 20.0f, false);
@@ -486,8 +485,8 @@ public:
         auto go2 = createGameObject("Obj");
         go2->addComponent<Components::MeshRenderer>(mesh, mat);
         go2->addComponent<VisualizeNormals>(0.1f, Color::WHITE);
-        go2->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, 90);
-        go2->getTransform()->scale = { 10,10,10 };
+        go2->getTransform()->setRotation( go2->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, 90) );
+        go2->getTransform()->setScale( { 10,10,10 } );
 
         I32 loop = 2;
         F32 distance = 3.0f;
@@ -499,8 +498,8 @@ public:
                 {
                     auto gameobject = createGameObject("Obj");
                     gameobject->addComponent<Components::MeshRenderer>(mesh, mat);
-                    gameobject->getTransform()->position = Math::Vec3(x * distance, y * distance + 0.01f, z * distance);
-                    gameobject->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, 90);
+                    gameobject->getTransform()->setPosition( Math::Vec3(x * distance, y * distance + 0.01f, z * distance) );
+                    gameobject->getTransform()->setRotation( gameobject->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, 90) );
                 }
             }
         }
@@ -513,18 +512,18 @@ public:
             {
                 auto gameobject = createGameObject("Obj");
                 gameobject->addComponent<Components::PointLight>(2.0f, Math::Random::Color());
-                gameobject->getTransform()->position = Math::Vec3(x * distance2, 1.0f, z * distance2);
+                gameobject->getTransform()->setPosition( Math::Vec3(x * distance2, 1.0f, z * distance2) );
                 gameobject->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
             }
         }
 
         //auto sun = createGameObject("Sun");
         //sun->addComponent<Components::DirectionalLight>(1.0f, Color::WHITE);
-        //sun->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 });
+        //sun->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }) );
 
         auto pl = createGameObject("PointLight");
         pl->addComponent<Components::PointLight>(2.0f, Color::GREEN);
-        pl->getTransform()->position = { 3, 1, 0 };
+        pl->getTransform()->setPosition( { 3, 1, 0 } );
         pl->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
         pl->addComponent<AutoOrbiting>(20.0f);
     }
@@ -570,7 +569,7 @@ public:
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>(45.0f, 0.1f, 1000.0f, Graphics::MSAASamples::One);
         cam->setClearColor(Color::BLUE);
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
 
         Assets::BRDFLut brdfLut;
@@ -591,7 +590,7 @@ public:
     {
         // Camera
         auto go = createGameObject("Camera");
-        go->getTransform()->position = { 0, 2, -10 };
+        go->getTransform()->setPosition( { 0, 2, -10 } );
         auto cam = go->addComponent<Components::Camera>(45.0f, 0.1f, 1000.0f, Graphics::MSAASamples::Four, true);
         go->addComponent<Components::FPSCamera>();
         go->addComponent<Tonemap>();
@@ -619,9 +618,9 @@ public:
 
         auto go2 = createGameObject("Obj");
         go2->addComponent<Components::MeshRenderer>(mesh, mat);
-        go2->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, 90);
-        go2->getTransform()->scale = { 1.0f };
-        go2->getTransform()->position = { 0, 0, -3 };
+        go2->getTransform()->setRotation( go2->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, 90) );
+        go2->getTransform()->setScale( { 1.0f } );
+        go2->getTransform()->setPosition( { 0, 0, -3 } );
         go2->addComponent<Components::Skybox>(cubemapHDR);
 
         I32 num = 7;
@@ -645,17 +644,17 @@ public:
                 material->setFloat("useMetallicMap", 0.0f);
 
                 gameobject->addComponent<Components::MeshRenderer>(mesh, material);
-                gameobject->getTransform()->position = Math::Vec3(x * distance - (num / 2 * distance), y * distance + 0.01f, 0.0f);
+                gameobject->getTransform()->setPosition( Math::Vec3(x * distance - (num / 2 * distance), y * distance + 0.01f, 0.0f) );
             }
         }
 
         //auto sun = createGameObject("Sun");
         //sun->addComponent<Components::DirectionalLight>(1.0f, Color::WHITE);
-        //sun->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 });
+        //sun->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }) );
 
         auto pl = createGameObject("PointLight");
         pl->addComponent<Components::PointLight>(3.0f, Color::WHITE);
-        pl->getTransform()->position = { 5, 2, 0 };
+        pl->getTransform()->setPosition( { 5, 2, 0 } );
         pl->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
         pl->addComponent<AutoOrbiting>(20.0f);
 
@@ -663,22 +662,22 @@ public:
         F32 range = 30.0f;
         //auto pl2 = createGameObject("PointLight");
         //pl2->addComponent<Components::PointLight>(intensity, Math::Random::Color(), range);
-        //pl2->getTransform()->position = { -5, 3, -3 };
+        //pl2->getTransform()->setPosition( { -5, 3, -3 } );
         //pl2->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
 
         //auto pl3 = createGameObject("PointLight");
         //pl3->addComponent<Components::PointLight>(intensity, Math::Random::Color(), range);
-        //pl3->getTransform()->position = { 5, 3, -3 };
+        //pl3->getTransform()->setPosition( { 5, 3, -3 } );
         //pl3->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
 
         //auto pl4 = createGameObject("PointLight");
         //pl4->addComponent<Components::PointLight>(intensity, Math::Random::Color(), range);
-        //pl4->getTransform()->position = { -5, -3, -3 };
+        //pl4->getTransform()->setPosition( { -5, -3, -3 } );
         //pl4->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
 
         //auto pl5 = createGameObject("PointLight");
         //pl5->addComponent<Components::PointLight>(intensity, Math::Random::Color(), range);
-        //pl5->getTransform()->position = { 5, -3, -3 };
+        //pl5->getTransform()->setPosition( { 5, -3, -3 } );
         //pl5->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.3f);
     }
 };
@@ -695,7 +694,7 @@ public:
         // Camera
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>(45.0f, 0.1f, 1000.0f, Graphics::MSAASamples::Four, true);
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
         toneMapComponent = go->addComponent<Tonemap>();
 
@@ -722,22 +721,22 @@ public:
         auto pistolMesh = ASSETS.getMesh("/models/pistol.fbx");
         auto pistol = createGameObject("Pistol");
         pistol->addComponent<Components::MeshRenderer>(pistolMesh, ASSETS.getMaterial("/materials/pbr/pistol.pbrmaterial"));
-        pistol->getTransform()->scale = { 0.1f };
-        pistol->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, -90.0f);
-        pistol->getTransform()->rotation *= Math::Quat(Math::Vec3::UP, -90.0f);
-        pistol->getTransform()->position = { 5, 0, 0 };
+        pistol->getTransform()->setScale( { 0.1f } );
+        pistol->getTransform()->setRotation( pistol->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, -90.0f) );
+        pistol->getTransform()->setRotation( pistol->getTransform()->getRotation() * Math::Quat(Math::Vec3::UP, -90.0f) );
+        pistol->getTransform()->setPosition( { 5, 0, 0 } );
 
         auto daggerMesh = ASSETS.getMesh("/models/dagger.obj");
         auto dagger = createGameObject("Dagger");
         dagger->addComponent<Components::MeshRenderer>(daggerMesh, ASSETS.getMaterial("/materials/pbr/dagger.pbrmaterial"));
-        dagger->getTransform()->scale = { 0.1f };
-        dagger->getTransform()->rotation *= Math::Quat(Math::Vec3::FORWARD, -90.0f);
-        dagger->getTransform()->position = { 0, 4, 0 };
+        dagger->getTransform()->setScale( { 0.1f } );
+        dagger->getTransform()->setRotation( dagger->getTransform()->getRotation() * Math::Quat(Math::Vec3::FORWARD, -90.0f) );
+        dagger->getTransform()->setPosition( { 0, 4, 0 } );
 
         // LIGHTS
         auto sun = createGameObject("Sun");
         sun->addComponent<Components::DirectionalLight>(5.0f, Color::WHITE);
-        sun->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 });
+        sun->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }) );
     }
 
     void tick(Time::Seconds d)
@@ -804,7 +803,7 @@ public:
         // Camera
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>(45.0f, 0.1f, 1000.0f, Graphics::MSAASamples::Four, true);
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
         go->addComponent<Tonemap>();
 
@@ -832,7 +831,7 @@ public:
         auto mr = obj->addComponent<Components::MeshRenderer>(mesh, nullptr);
         //obj->addComponent<VisualizeNormals>(1.0f, Color::BLUE);
         //obj->addComponent<VisualizeTangents>(1.0f, Color::RED);
-        obj->getTransform()->scale = { 0.05f };
+        obj->getTransform()->setScale( { 0.05f } );
 
         if ( materialImportInfo.isValid() )
         {
@@ -844,11 +843,11 @@ public:
         // LIGHTS
         //auto sun = createGameObject("Sun");
         //sun->addComponent<Components::DirectionalLight>(5.0f, Color::WHITE);
-        //sun->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 });
+        //sun->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }) );
 
         auto pl = createGameObject("PointLight");
         pl->addComponent<Components::PointLight>(15.0f, Color::WHITE, 30.0f);
-        pl->getTransform()->position = { 5, 2, 0 };
+        pl->getTransform()->setPosition( { 5, 2, 0 } );
         pl->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
         pl->addComponent<AutoOrbiting>(20.0f);
     }
@@ -871,7 +870,7 @@ public:
                                                   Graphics::TextureFormat::D32, Graphics::TextureFormat::RGBAFloat,
                                                   Graphics::MSAASamples::Four, true );
         cam = go->addComponent<Components::Camera>(rt1);
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA);
         cam->getViewport().width = 0.5f;
         cam->getViewport().height = 0.5f;
@@ -950,7 +949,7 @@ public:
         // Camera 1
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 3, -8);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 3, -8) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
 
         createGameObject("Grid")->addComponent<GridGeneration>(20);
@@ -979,7 +978,7 @@ public:
         //guiScreenMat->setTexture("tex", cam2->getRenderTarget()->getColorBuffer());
         //guiScreenMat->setColor("tintColor", Color::WHITE);
         //rtGO->addComponent<Components::MeshRenderer>(Core::MeshGenerator::CreatePlane(), guiScreenMat);
-        //rtGO->getTransform()->position = { 0, 1, 0 };
+        //rtGO->getTransform()->setPosition( { 0, 1, 0 } );
     }
 };
 
@@ -993,7 +992,7 @@ public:
         // Camera 1
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 10, -25);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 10, -25) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
         cam->setClearColor(Color(66, 134, 244));
         //go->addComponent<AutoOrbiting>(15.0f);
@@ -1001,28 +1000,28 @@ public:
         auto player = createGameObject("Player");
         player->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/monkey.obj"), ASSETS.getMaterial("/materials/normals.material"));
         player->getTransform()->setParent(go->getTransform(), false);
-        player->getTransform()->position = { 0, 0, -0.5f };
-        player->getTransform()->rotation *= Math::Quat(Math::Vec3::UP, 180.0f);
+        player->getTransform()->setPosition( { 0, 0, -0.5f } );
+        player->getTransform()->setRotation( player->getTransform()->getRotation() * Math::Quat(Math::Vec3::UP, 180.0f) );
 
         //auto obj = createGameObject("GO");
         //obj->addComponent<Components::MeshRenderer>(Core::MeshGenerator::CreatePlane(), ASSETS.getMaterial("/materials/blinn_phong/grass.material"));
-        //obj->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, 90.0f);
-        //obj->getTransform()->scale = { 20,20,20 };
+        //obj->getTransform()->setRotation( obj->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, 90.0f) );
+        //obj->getTransform()->setScale( { 20,20,20 } );
         auto terrainGO = createGameObject("Terrain");
         terrainGO->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/terrain.obj"), ASSETS.getMaterial("/materials/blinn_phong/terrain.material"));
 
         auto obj2 = createGameObject("GO2");
         obj2->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/monkey.obj"), ASSETS.getMaterial("/materials/blinn_phong/monkey.material"));
-        obj2->getTransform()->position = { 5, 1, 0 };
+        obj2->getTransform()->setPosition( { 5, 1, 0 } );
 
         auto cubeGO = createGameObject("GO3");
         cubeGO->addComponent<Components::MeshRenderer>(Core::MeshGenerator::CreateCubeUV(0.3f), ASSETS.getMaterial("/materials/blinn_phong/cube.material"));
-        cubeGO->getTransform()->position = { -5.0f, 0.3001f, 0.0f };
+        cubeGO->getTransform()->setPosition( { -5.0f, 0.3001f, 0.0f } );
         cubeGO->addComponent<ConstantRotation>(0.0f, 10.0f, 0.0f);
 
         auto cubeGO2 = createGameObject("GO3");
         cubeGO2->addComponent<Components::MeshRenderer>(Core::MeshGenerator::CreateCubeUV(0.3f), ASSETS.getMaterial("/materials/blinn_phong/cube.material"));
-        cubeGO2->getTransform()->position = { -8.0f, 0.3001f, 0.0f };
+        cubeGO2->getTransform()->setPosition( { -8.0f, 0.3001f, 0.0f } );
 
         Assets::MeshMaterialInfo matInfo;
         auto treeMesh = ASSETS.getMesh("/models/tree/tree.obj", &matInfo);
@@ -1057,23 +1056,23 @@ public:
         auto sun = createGameObject("Sun");
         auto dl = sun->addComponent<Components::DirectionalLight>(0.3f, Color::WHITE, Graphics::ShadowType::CSMSoft, ArrayList<F32>{10.0f, 30.0f, 80.0f, 200.0f});
         //auto dl = sun->addComponent<Components::DirectionalLight>(0.0f, Color::WHITE);
-        sun->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 });
+        sun->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }) );
         //sun->addComponent<ConstantRotation>(5.0f, 0.0f, 0.0f);
 
         //auto sun2 = createGameObject("Sun2");
         //sun2->addComponent<Components::DirectionalLight>(0.3f, Color::WHITE);
-        //sun2->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, -1 });
+        //sun2->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, -1 }) );
 
         auto plg = createGameObject("PL");
         auto pl = plg->addComponent<Components::PointLight>(1.0f, Color::ORANGE, 5.0f, true);
-        plg->getTransform()->position = { 3, 2, 0 };
+        plg->getTransform()->setPosition( { 3, 2, 0 } );
         plg->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
         go->addComponent<Components::Skybox>(pl->getShadowMap());
 
         auto slg = createGameObject("PL");
         auto sl = slg->addComponent<Components::SpotLight>(1.0f, Color::WHITE, 25.0f, 20.0f);
-        slg->getTransform()->position = { -5, 2, -2 };
-        slg->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 });
+        slg->getTransform()->setPosition( { -5, 2, -2 } );
+        slg->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }) );
         slg->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/spotLight.png"), 0.5f);
         //slg->addComponent<DrawFrustum>();
 
@@ -1086,7 +1085,9 @@ public:
             ImGui::SliderFloat("Ambient", &ambient, 0.0f, 1.0f);
             Locator::getRenderer().setGlobalFloat(SID("_Ambient"), ambient);
 
-            obj2->getTransform()->position.x = 5.0f + std::sinf((F32)TIME.getTime());
+            auto obj2Pos = obj2->getTransform()->getPosition();
+            obj2Pos.x = 5.0f + std::sinf((F32)TIME.getTime());
+            obj2->getTransform()->setPosition( obj2Pos );
 
             if (ImGui::CollapsingHeader("Shadows"))
             {
@@ -1107,11 +1108,11 @@ public:
                 {
                     static F32 animateSpeed = 0.0f;
                     ImGui::SliderFloat("Speed", &animateSpeed, -20.0f, 20.0f);
-                    dl->getGameObject()->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, animateSpeed * (F32)PROFILER.getDelta());
+                    dl->getGameObject()->getTransform()->setRotation( dl->getGameObject()->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, animateSpeed * (F32)PROFILER.getDelta()) );
 
                     static Math::Vec3 deg{ 45.0f, 0.0f, 0.0f };
                     if (ImGui::SliderFloat2("Rotation", &deg.x, 0.0f, 360.0f))
-                        sun->getTransform()->rotation = Math::Quat::FromEulerAngles(deg);
+                        sun->getTransform()->setRotation( Math::Quat::FromEulerAngles(deg) );
 
                     static F32 color[4] = { 1,1,1,1 };
                     if (ImGui::ColorEdit4("Color", color))
@@ -1150,7 +1151,7 @@ public:
                 {
                     static Math::Vec3 plPos{ 0, 2.5, -1 };
                     if (ImGui::SliderFloat3("Position", &plPos.x, -3.0f, 3.0f))
-                        plg->getTransform()->position = plPos;
+                        plg->getTransform()->setPosition( plPos );
 
                     static F32 plRange;
                     plRange = pl->getRange();
@@ -1231,7 +1232,7 @@ public:
         // Camera 1
         go = createGameObject("Camera");
         cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 1, -15);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 1, -15) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
 
         createGameObject("Grid")->addComponent<GridGeneration>(20);
@@ -1286,11 +1287,11 @@ public:
                 {
                     static F32 pos[3];
                     ImGui::SliderFloat3("Pos", pos, -10.0f, 10.0f);
-                    ps->getGameObject()->getTransform()->position = { pos[0],pos[1],pos[2] };
+                    ps->getGameObject()->getTransform()->setPosition( { pos[0],pos[1],pos[2] } );
 
                     static F32 scale = 1.0f;
                     ImGui::SliderFloat("Scale", &scale, 0.0f, 10.0f);
-                    ps->getGameObject()->getTransform()->scale = scale;
+                    ps->getGameObject()->getTransform()->setScale( scale );
 
                     {
                         if (ImGui::Button("Restart")) ps->play();
@@ -1612,7 +1613,7 @@ public:
         // Camera 1
         auto go = createGameObject("Camera");
         go->addComponent<Components::AudioListener>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 1, -1);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 1, -1) );
 
         if (RENDERER.hasHMD())
         {
@@ -1627,7 +1628,7 @@ public:
             cam2GO = createGameObject("Observer Camera");
             cam2GO->setActive(false);
             cam2GO->addComponent<Components::Camera>();
-            cam2GO->getComponent<Components::Transform>()->position = Math::Vec3(5, 4, 0);
+            cam2GO->getComponent<Components::Transform>()->setPosition( Math::Vec3(5, 4, 0) );
             cam2GO->getComponent<Components::Transform>()->lookAt({0});
             cam2GO->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
         }
@@ -1635,7 +1636,7 @@ public:
         {
             LOG_WARN( "VRScene(): VR is disabled or no VR headset found." );
             go->addComponent<Components::Camera>();
-            go->getComponent<Components::Transform>()->position = Math::Vec3(0, 1, -3);
+            go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 1, -3) );
             go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
         }
 
@@ -1643,19 +1644,19 @@ public:
 
         auto world = createGameObject("World");
         world->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/box_n_inside.obj"), ASSETS.getMaterial("/materials/blinn_phong/cellar.material"));
-        world->getTransform()->position.y = 10.0f;
-        world->getTransform()->scale = 10.0f;
+        world->getTransform()->setPosition( { 0, 10.0f, 0 } );
+        world->getTransform()->setScale( 10.0f );
 
         auto plg = createGameObject("PL");
         plg->addComponent<Components::PointLight>(2.0f, Color::ORANGE, 15.0f);
-        plg->getTransform()->position = { 0, 1.5f, 0 };
+        plg->getTransform()->setPosition( { 0, 1.5f, 0 } );
         plg->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
 
         auto monkey = createGameObject("monkey");
         monkey->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/monkey.obj"), ASSETS.getMaterial("/materials/normals.material"));
         auto t = monkey->getTransform();
-        t->scale = { 0.2f };
-        t->position.y = 0.3f;
+        t->setScale( { 0.2f } );
+        t->setPosition( { 0, 0.3f, 0 } );
         monkey->addComponent<ConstantRotation>(0.0f, 15.0f, 0.0f);
         //monkey->addComponent<Components::AudioSource>(ASSETS.getAudioClip("/audio/start_dash.wav"));
 
@@ -1746,7 +1747,7 @@ public:
         // Camera 1
         auto go = createGameObject("Camera");
         go->addComponent<Components::Camera>(45.0f, 0.1f, 1000.0f, Graphics::MSAASamples::Eight);
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -5);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -5) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
 
         m_mesh = RESOURCES.createMesh();
@@ -1837,13 +1838,13 @@ public:
 
             // Position ship
             auto newShipPos = m_spline.getPoint(normalizedOffset);
-            m_shipTransform->position = { newShipPos.x, newShipPos.y, 0 };
+            m_shipTransform->setPosition( { newShipPos.x, newShipPos.y, 0 } );
 
             // Rotate ship
             auto gradient = m_spline.getGradient(normalizedOffset);
             F32 roll = Math::Rad2Deg(std::acos(gradient.dot({1,0,0})));
-            m_shipTransform->rotation = Math::Quat::FromEulerAngles(0.0f, 0.0f, gradient.y < 0 ? 360-roll : roll);
-            //DEBUG.drawLine(m_shipTransform->position - gradient * 0.5f, m_shipTransform->position + gradient*0.5f, Color::GREEN, 0);
+            m_shipTransform->setRotation( Math::Quat::FromEulerAngles(0.0f, 0.0f, gradient.y < 0 ? 360-roll : roll) );
+            //DEBUG.drawLine(m_shipTransform->getPosition() - gradient * 0.5f, m_shipTransform->getPosition() + gradient*0.5f, Color::GREEN, 0);
         }
     }
 };
@@ -1861,7 +1862,7 @@ public:
         auto camGO = createGameObject("Camera");
         cam = camGO->addComponent<Components::Camera>(45.0f, 0.1f, 1000.0f, Graphics::MSAASamples::Four);
         cam->setClearColor(Color(175, 181, 191));
-        camGO->getComponent<Components::Transform>()->position = Math::Vec3(0, 2, -5);
+        camGO->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 2, -5) );
         camGO->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
         camGO->addComponent<Components::AudioListener>();
 
@@ -1901,9 +1902,9 @@ public:
         //    }
         //}
 
-        meshGO->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, -90.0f);
-        meshGO->getTransform()->rotation *= Math::Quat(Math::Vec3::UP, 180.0f);
-        meshGO->getTransform()->scale *= 0.5f;
+        meshGO->getTransform()->setRotation( meshGO->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, -90.0f) );
+        meshGO->getTransform()->setRotation( meshGO->getTransform()->getRotation() * Math::Quat(Math::Vec3::UP, 180.0f) );
+        meshGO->getTransform()->setScale( meshGO->getTransform()->getScale() * 0.5f );
 
         camGO->addComponent<Components::GUI>();
         camGO->addComponent<Components::GUICustom>([=] {
@@ -2000,12 +2001,12 @@ public:
 
         auto obj = createGameObject("GO");
         obj->addComponent<Components::MeshRenderer>(Core::MeshGenerator::CreatePlane(), ASSETS.getMaterial("/materials/blinn_phong/grass.material"));
-        obj->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, 90.0f);
-        obj->getTransform()->scale = { 20,20,20 };
+        obj->getTransform()->setRotation( obj->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, 90.0f) );
+        obj->getTransform()->setScale( { 20,20,20 } );
 
         auto sun = createGameObject("Sun");
         auto dl = sun->addComponent<Components::DirectionalLight>(0.5f, Color::WHITE, Graphics::ShadowType::CSMSoft, ArrayList<F32>{20.0f, 40.0f, 80.0f, 200.0f});
-        sun->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }, Math::Vec3{ 0, 0, 1 });
+        sun->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }, Math::Vec3{ 0, 0, 1 }) );
         dl->setShadowMapQuality(Graphics::ShadowMapQuality::Insane);
 
         auto cubemap = ASSETS.getCubemap("/cubemaps/tropical_sunny_day/Left.png", "/cubemaps/tropical_sunny_day/Right.png",
@@ -2029,7 +2030,7 @@ public:
         auto camGO = createGameObject("Camera");
         cam = camGO->addComponent<Components::Camera>(45.0f, 0.1f, 1000.0f, Graphics::MSAASamples::Four);
         cam->setClearColor(Color(175, 181, 191));
-        camGO->getComponent<Components::Transform>()->position = Math::Vec3(0, 2, -5);
+        camGO->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 2, -5) );
         camGO->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
         camGO->addComponent<Components::AudioListener>();
 
@@ -2048,10 +2049,10 @@ public:
                 auto meshGO2 = createGameObject("GO2");
                 meshGO2->addComponent<Components::SkinnedMeshRenderer>(mesh, skeleton, anims.front(), mat);
 
-                meshGO2->getTransform()->position = { x * 3.0f, 0.0f, z * 3.0f };
-                meshGO2->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, -90.0f);
-                meshGO2->getTransform()->rotation *= Math::Quat(Math::Vec3::UP, 180.0f);
-                meshGO2->getTransform()->scale *= 0.5f;
+                meshGO2->getTransform()->setPosition( { x * 3.0f, 0.0f, z * 3.0f } );
+                meshGO2->getTransform()->setRotation( meshGO2->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, -90.0f) );
+                meshGO2->getTransform()->setRotation( meshGO2->getTransform()->getRotation() * Math::Quat(Math::Vec3::UP, 180.0f) );
+                meshGO2->getTransform()->setScale( meshGO2->getTransform()->getScale() * 0.5f );
             }
         }
 
@@ -2060,12 +2061,12 @@ public:
 
         auto obj = createGameObject("GO");
         obj->addComponent<Components::MeshRenderer>(Core::MeshGenerator::CreatePlane(), ASSETS.getMaterial("/materials/blinn_phong/grass.material"));
-        obj->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, 90.0f);
-        obj->getTransform()->scale = { 20,20,20 };
+        obj->getTransform()->setRotation( obj->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, 90.0f) );
+        obj->getTransform()->setScale( { 20,20,20 } );
 
         auto sun = createGameObject("Sun");
         auto dl = sun->addComponent<Components::DirectionalLight>(0.5f, Color::WHITE, Graphics::ShadowType::CSMSoft, ArrayList<F32>{20.0f, 40.0f, 80.0f, 200.0f});
-        sun->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }, Math::Vec3{ 0, 0, 1 });
+        sun->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }, Math::Vec3{ 0, 0, 1 }) );
         dl->setShadowMapQuality(Graphics::ShadowMapQuality::Insane);
 
         auto cubemap = ASSETS.getCubemap("/cubemaps/tropical_sunny_day/Left.png", "/cubemaps/tropical_sunny_day/Right.png",
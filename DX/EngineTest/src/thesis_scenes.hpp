@@ -18,7 +18,7 @@ public:
         go = createGameObject("Camera");
         cam = go->addComponent<Components::Camera>(45.0f, 0.1f, 1000.0f, Graphics::MSAASamples::One);
         cam->setClearColor(Color(175, 181, 191));
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -5);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -5) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
         go->addComponent<Components::AudioListener>();
 
@@ -28,14 +28,14 @@ public:
         cam2->setClearColor(Color(175, 181, 191));
         cam2->getViewport().width = 0.3f;
         cam2->getViewport().topLeftX = 0.31f;
-        cam2->getGameObject()->getTransform()->position = go->getTransform()->position;
+        cam2->getGameObject()->getTransform()->setPosition( go->getTransform()->getPosition() );
         cam2->getGameObject()->addComponent<DrawFrustum>();
 
         auto cam3 = createGameObject("Camera2")->addComponent<Components::Camera>(45.0f, 0.1f, 1000.0f, Graphics::MSAASamples::One);
         cam3->setClearColor(Color(175, 181, 191));
         cam3->getViewport().width = 0.3f;
         cam3->getViewport().topLeftX = 0.62f;
-        cam3->getGameObject()->getTransform()->position = go->getTransform()->position + Math::Vec3{ 20.0f, 0, 0 };
+        cam3->getGameObject()->getTransform()->setPosition( go->getTransform()->getPosition() + Math::Vec3{ 20.0f, 0, 0 } );
 
         // MATERIALS
         auto texMat = RESOURCES.createMaterial(ASSETS.getShader("/shaders/tex.shader"));
@@ -56,14 +56,13 @@ public:
 
         auto plane = Core::MeshGenerator::CreatePlane();
         auto mr = createGameObject("GO")->addComponent<Components::MeshRenderer>(plane, alphaMat);
-        mr->getGameObject()->getTransform()->position.z = -2.0f;
+        mr->getGameObject()->getTransform()->setPosition( { 0, 0, -2.0f } );
 
         auto mr22 = createGameObject("Cube")->addComponent<Components::MeshRenderer>(cube, texMat);
-        mr22->getGameObject()->getTransform()->position.x = 20.0f;
+        mr22->getGameObject()->getTransform()->setPosition( { 20.0f, 0, 0 } );
 
         auto mr33 = createGameObject("GO")->addComponent<Components::MeshRenderer>(plane, alphaMatWrong);
-        mr33->getGameObject()->getTransform()->position.x = 20.0f;
-        mr33->getGameObject()->getTransform()->position.z = -2.0f;
+        mr33->getGameObject()->getTransform()->setPosition( { 20.0f, 0, -2.0f } );
     }
 };
 
@@ -78,7 +77,7 @@ public:
         // Camera 1
         auto go = createGameObject("Camera");
         go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 1, -3);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 1, -3) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
         go->addComponent<Components::AudioListener>();
 
@@ -86,28 +85,27 @@ public:
 
         auto world = createGameObject("World");
         world->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/box_n_inside.obj"), ASSETS.getMaterial("/materials/blinn_phong/cellar.material"));
-        world->getTransform()->position.y = 5.0f;
-        world->getTransform()->scale = 5.0f;
+        world->getTransform()->setPosition( { 0, 5.0f, 0 } );
+        world->getTransform()->setScale( 5.0f );
 
         auto obj = createGameObject("obj");
         obj->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/monkey.obj"), ASSETS.getMaterial("/materials/blinn_phong/monkey.material"));
-        obj->getTransform()->scale = {0.5f};
-        obj->getTransform()->position.y = 0.5f;
+        obj->getTransform()->setScale( {0.5f} );
+        obj->getTransform()->setPosition( { 0, 0.5f, 0 } );
 
         auto plg = createGameObject("PL");
         plg->addComponent<Components::PointLight>(2.0f, Color::ORANGE, 15.0f);
-        plg->getTransform()->position = { 0, 1.5f, 0 };
+        plg->getTransform()->setPosition( { 0, 1.5f, 0 } );
         plg->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
 
         auto plg2 = createGameObject("PL");
         plg2->addComponent<Components::PointLight>(2.0f, Color::BLUE, 15.0f);
-        plg2->getTransform()->position = { 1.0f, 1.5f,
- 0 };
+        plg2->getTransform()->setPosition( { 1.0f, 1.5f, 0 } );
         plg2->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
 
         auto plg3 = createGameObject("PL");
         plg3->addComponent<Components::PointLight>(2.0f, Color::RED, 15.0f);
-        plg3->getTransform()->position = { -1.0f, 1.5f, 0 };
+        plg3->getTransform()->setPosition( { -1.0f, 1.5f, 0 } );
         plg3->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
     }
 };
@@ -122,7 +120,7 @@ public:
         // Camera 1
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>(45.0f, 0.1f, 1000.0f, Graphics::MSAASamples::Four);
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 1, -3);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 1, -3) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
         cam->setClearColor(Color(66, 134, 244));
 
@@ -130,29 +128,28 @@ public:
 
         auto world = createGameObject("World");
         world->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/box_n_inside.obj"), ASSETS.getMaterial("/materials/blinn_phong/cellar.material"));
-        world->getTransform()->position.y = 5.0f;
-        world->getTransform()->scale = 5.0f;
+        world->getTransform()->setPosition( { 0, 5.0f, 0 } );
+        world->getTransform()->setScale( 5.0f );
 
         auto obj = createGameObject("obj");
         obj->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/monkey.obj"), ASSETS.getMaterial("/materials/blinn_phong/white.material"));
-        obj->getTransform()->scale = { 0.5f };
-        obj->getTransform()->position.y = 0.5f;
+        obj->getTransform()->setScale( { 0.5f } );
+        obj->getTransform()->setPosition( { 0, 0.5f, 0 } );
 
         auto obj2 = createGameObject("obj");
         obj2->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/teapot.obj"), ASSETS.getMaterial("/materials/blinn_phong/white.material"));
-        obj2->getTransform()->scale = { 0.2f };
-        obj2->getTransform()->position.x = 1.5f;
+        obj2->getTransform()->setScale( { 0.2f } );
+        obj2->getTransform()->setPosition( { 1.5f, 0, 0 } );
 
         auto obj3 = createGameObject("obj");
         obj3->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/sphere.obj"), ASSETS.getMaterial("/materials/blinn_phong/white.material"));
-        obj3->getTransform()->scale = { 0.5f };
-        obj3->getTransform()->position.y = 0.5f;
-        obj3->getTransform()->position.x = -1.5f;
+        obj3->getTransform()->setScale( { 0.5f } );
+        obj3->getTransform()->setPosition( { -1.5f, 0.5f, 0 } );
 
         // LIGHTS
         auto plg = createGameObject("PL");
         auto pl = plg->addComponent<Components::PointLight>(1.0f, Color::ORANGE, 10.0f, true);
-        plg->getTransform()->position = { 0, 2, 0 };
+        plg->getTransform()->setPosition( { 0, 2, 0 } );
         plg->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
     }
 };
@@ -167,37 +164,36 @@ public:
         // Camera 1
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 1, -5);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 1, -5) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
 
         RENDERER.setGlobalFloat(SID("_Ambient"), 0.2f);
 
         auto world = createGameObject("World");
         world->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/box_n_inside.obj"), ASSETS.getMaterial("/materials/blinn_phong/cellar.material"));
-        world->getTransform()->position.y = 7.0f;
-        world->getTransform()->scale = 7.0f;
+        world->getTransform()->setPosition( { 0, 7.0f, 0 } );
+        world->getTransform()->setScale( 7.0f );
 
         auto obj = createGameObject("obj");
         obj->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/monkey.obj"), ASSETS.getMaterial("/materials/blinn_phong/white.material"));
-        obj->getTransform()->scale = { 0.5f };
-        obj->getTransform()->position.y = 0.5f;
+        obj->getTransform()->setScale( { 0.5f } );
+        obj->getTransform()->setPosition( { 0, 0.5f, 0 } );
 
         auto obj2 = createGameObject("obj");
         obj2->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/teapot.obj"), ASSETS.getMaterial("/materials/blinn_phong/white.material"));
-        obj2->getTransform()->scale = { 0.2f };
-        obj2->getTransform()->position.x = 1.5f;
+        obj2->getTransform()->setScale( { 0.2f } );
+        obj2->getTransform()->setPosition( { 1.5f, 0, 0 } );
 
         auto obj3 = createGameObject("obj");
         obj3->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/sphere.obj"), ASSETS.getMaterial("/materials/blinn_phong/white.material"));
-        obj3->getTransform()->scale = { 0.5f };
-        obj3->getTransform()->position.y = 0.5f;
-        obj3->getTransform()->position.x = -1.5f;
+        obj3->getTransform()->setScale( { 0.5f } );
+        obj3->getTransform()->setPosition( { -1.5f, 0.5f, 0 } );
 
         // LIGHTS
         auto slg = createGameObject("PL");
         auto sl = slg->addComponent<Components::SpotLight>(1.0f, Color::WHITE, 45.0f, 20.0f, true);
-        slg->getTransform()->position = { 0, 2, -2 };
-        slg->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 });
+        slg->getTransform()->setPosition( { 0, 2, -2 } );
+        slg->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }) );
         slg->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/spotLight.png"), 0.5f);
     }
 };
@@ -214,7 +210,7 @@ public:
         // Camera 1
         auto go = createGameObject("Camera");
         auto cam = go->addComponent<Components::Camera>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 10, -25);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 10, -25) );
         go->addComponent<Components::FPSCamera>(Components::FPSCamera::MAYA, 0.1f);
         cam->setClearColor(Color(66, 134, 244));
 
@@ -227,8 +223,8 @@ public:
         auto grassMat = ASSETS.getMaterial("/materials/blinn_phong/grass.material");
         grassMat->setFloat("uvScale", 10.0f);
         obj->addComponent<Components::MeshRenderer>(Core::MeshGenerator::CreatePlane(), grassMat);
-        obj->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, 90.0f);
-        obj->getTransform()->scale = { 20,20,20 };
+        obj->getTransform()->setRotation( obj->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, 90.0f) );
+        obj->getTransform()->setScale( { 20,20,20 } );
 
         Assets::MeshMaterialInfo matInfo;
         auto treeMesh = ASSETS.getMesh("/models/tree/tree.obj", &matInfo);
@@ -262,7 +258,7 @@ public:
         // LIGHTS
         auto sun = createGameObject("Sun");
         auto dl = sun->addComponent<Components::DirectionalLight>(0.3f, Color::WHITE, Graphics::ShadowType::CSMSoft, ArrayList<F32>{10.0f, 30.0f, 80.0f, 200.0f});
-        sun->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 });
+        sun->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }) );
 
         gui = go->addComponent<Components::GUI>();
         go->addComponent<Components::GUIFPS>();
@@ -288,11 +284,11 @@ public:
             {
                 static F32 animateSpeed = 0.0f;
                 ImGui::SliderFloat("Speed", &animateSpeed, -20.0f, 20.0f);
-                dl->getGameObject()->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, animateSpeed * (F32)PROFILER.getDelta());
+                dl->getGameObject()->getTransform()->setRotation( dl->getGameObject()->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, animateSpeed * (F32)PROFILER.getDelta()) );
 
                 static Math::Vec3 deg{ 45.0f, 0.0f, 0.0f };
                 if (ImGui::SliderFloat2("Rotation", &deg.x, 0.0f, 360.0f))
-                    sun->getTransform()->rotation = Math::Quat::FromEulerAngles(deg);
+                    sun->getTransform()->setRotation( Math::Quat::FromEulerAngles(deg) );
 
                 static F32 color[4] = { 1,1,1,1 };
                 if (ImGui::ColorEdit4("Color", color))
@@ -365,7 +361,7 @@ public:
     {
         auto go = createGameObject("Camera");
         go->addComponent<Components::AudioListener>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 1, -1);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 1, -1) );
 
         if (not AddVRCameraComponent(go))
             LOG_WARN("VR is disabled or no VR headset found.");
@@ -382,7 +378,7 @@ public:
     {
         auto go = createGameObject("Camera");
         go->addComponent<Components::AudioListener>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 10, -20);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 10, -20) );
 
         if (not AddVRCameraComponent(go))
             LOG_WARN("VR is disabled or no VR headset found.");
@@ -406,7 +402,7 @@ public:
                 {
                     auto go = createGameObject("Test");
                     go->addComponent<Components::MeshRenderer>(cube, ASSETS.getColorMaterial());
-                    go->getComponent<Components::Transform>()->position = { (F32)x * spacing, (F32)y * spacing, (F32)z * spacing };
+                    go->getComponent<Components::Transform>()->setPosition( { (F32)x * spacing, (F32)y * spacing, (F32)z * spacing } );
                 }
             }
         }
@@ -422,7 +418,7 @@ public:
     {
         auto go = createGameObject("Camera");
         go->addComponent<Components::AudioListener>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(50, 0, -100);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(50, 0, -100) );
 
         if (not AddVRCameraComponent(go, true))
             LOG_WARN("VR is disabled or no VR headset found.");
@@ -458,17 +454,17 @@ public:
                 auto pistolMesh = ASSETS.getMesh("/models/pistol.fbx");
                 auto pistol = createGameObject("Pistol");
                 pistol->addComponent<Components::MeshRenderer>(pistolMesh, ASSETS.getMaterial("/materials/pbr/pistol.pbrmaterial"));
-                pistol->getTransform()->scale = { 0.1f };
-                pistol->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, -90.0f);
-                pistol->getTransform()->rotation *= Math::Quat(Math::Vec3::UP, -90.0f);
-                pistol->getTransform()->position = { 5 + (i * xSpacing), (y * ySpacing), 0 };
+                pistol->getTransform()->setScale( { 0.1f } );
+                pistol->getTransform()->setRotation( pistol->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, -90.0f) );
+                pistol->getTransform()->setRotation( pistol->getTransform()->getRotation() * Math::Quat(Math::Vec3::UP, -90.0f) );
+                pistol->getTransform()->setPosition( { 5 + (i * xSpacing), (y * ySpacing), 0 } );
 
                 auto daggerMesh = ASSETS.getMesh("/models/dagger.obj");
                 auto dagger = createGameObject("Dagger");
                 dagger->addComponent<Components::MeshRenderer>(daggerMesh, ASSETS.getMaterial("/materials/pbr/dagger.pbrmaterial"));
-                dagger->getTransform()->scale = { 0.1f };
-                dagger->getTransform()->rotation *= Math::Quat(Math::Vec3::FORWARD, -90.0f);
-                dagger->getTransform()->position = { 0 + (i * xSpacing), 4 + (y * ySpacing), 0 };
+                dagger->getTransform()->setScale( { 0.1f } );
+                dagger->getTransform()->setRotation( dagger->getTransform()->getRotation() * Math::Quat(Math::Vec3::FORWARD, -90.0f) );
+                dagger->getTransform()->setPosition( { 0 + (i * xSpacing), 4 + (y * ySpacing), 0 } );
             }
         }
     }
@@ -483,7 +479,7 @@ public:
     {
         auto go = createGameObject("Camera");
         go->addComponent<Components::AudioListener>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
 
         if (not AddVRCameraComponent(go, true))
             LOG_WARN("VR is disabled or no VR headset found.");
@@ -525,7 +521,7 @@ public:
     {
         auto go = createGameObject("Camera");
         go->addComponent<Components::AudioListener>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 0, -10);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 0, -10) );
 
         if (not AddVRCameraComponent(go, true))
             LOG_WARN("VR is disabled or no VR headset found.");
@@ -542,8 +538,8 @@ public:
         // GAME OBJECTS
         auto world = createGameObject("World");
         world->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/box_n_inside.obj"), ASSETS.getMaterial("/materials/blinn_phong/cellar.material"));
-        world->getTransform()->position.y = 0.0f;
-        world->getTransform()->scale = { 30.0f, 3.0f, 30.0f };
+        world->getTransform()->setPosition( { 0, 0.0f, 0 } );
+        world->getTransform()->setScale( { 30.0f, 3.0f, 30.0f } );
 
         // LIGHTING
         F32 spacing = 4.0f;
@@ -551,7 +547,7 @@ public:
         {
             auto plg = createGameObject("PL");
             plg->addComponent<Components::PointLight>(2.0f, Math::Random::Color(), 15.0f);
-            plg->getTransform()->position = { (-4 * spacing) + i * spacing, 0, -5.0f };
+            plg->getTransform()->setPosition( { (-4 * spacing) + i * spacing, 0, -5.0f } );
             plg->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
         }
 
@@ -559,7 +555,7 @@ public:
         {
             auto plg = createGameObject("PL");
             plg->addComponent<Components::SpotLight>(4.0f, Math::Random::Color(), 45.0f, 15.0f);
-            plg->getTransform()->position = { (-4 * spacing) + i * spacing, 0, 0 };
+            plg->getTransform()->setPosition( { (-4 * spacing) + i * spacing, 0, 0 } );
             plg->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/spotlight.png"), 0.5f);
         }
     }
@@ -574,7 +570,7 @@ public:
     {
         auto go = createGameObject("Camera");
         go->addComponent<Components::AudioListener>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 5, -5);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 5, -5) );
 
         if (not AddVRCameraComponent(go, true))
             LOG_WARN("VR is disabled or no VR headset found.");
@@ -586,16 +582,16 @@ public:
 
         auto obj = createGameObject("GO");
         obj->addComponent<Components::MeshRenderer>(Core::MeshGenerator::CreatePlane(), ASSETS.getMaterial("/materials/blinn_phong/grass.material"));
-        obj->getTransform()->rotation *= Math::Quat(Math::Vec3::RIGHT, 90.0f);
-        obj->getTransform()->scale = { 25,25,25 };
+        obj->getTransform()->setRotation( obj->getTransform()->getRotation() * Math::Quat(Math::Vec3::RIGHT, 90.0f) );
+        obj->getTransform()->setScale( { 25,25,25 } );
 
         auto obj2 = createGameObject("GO2");
         obj2->addComponent<Components::MeshRenderer>(ASSETS.getMesh("/models/monkey.obj"), ASSETS.getMaterial("/materials/blinn_phong/white.material"));
-        obj2->getTransform()->position = { 5, 1, 0 };
+        obj2->getTransform()->setPosition( { 5, 1, 0 } );
 
         auto cubeGO = createGameObject("GO3");
         cubeGO->addComponent<Components::MeshRenderer>(Core::MeshGenerator::CreateCubeUV(0.3f), ASSETS.getMaterial("/materials/blinn_phong/cube.material"));
-        cubeGO->getTransform()->position = { -5.0f, 0.3001f, 0.0f };
+        cubeGO->getTransform()->setPosition( { -5.0f, 0.3001f, 0.0f } );
         cubeGO->addComponent<ConstantRotation>(0.0f, 10.0f, 0.0f);
 
         Assets::MeshMaterialInfo matInfo;
@@ -613,8 +609,8 @@ public:
         for (I32 i = 0; i < (I32)treePositions.size(); ++i)
         {
             auto tree = createGameObject("Tree");
-            tree->getTransform()->position = treePositions[i];
-            tree->getTransform()->scale = Math::Random::Vec3(0.8f, 1.2f);
+            tree->getTransform()->setPosition( treePositions[i] );
+            tree->getTransform()->setScale( Math::Random::Vec3(0.8f, 1.2f) );
             trees.push_back(tree);
 
             auto mr = tree->addComponent<Components::MeshRenderer>(treeMesh);
@@ -650,33 +646,33 @@ public:
         // LIGHTS
         auto sun = createGameObject("Sun");
         sun->addComponent<Components::DirectionalLight>(0.3f, Color::WHITE, Graphics::ShadowType::CSMSoft, ArrayList<F32>{10.0f, 30.0f, 80.0f, 200.0f});
-        sun->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 });
+        sun->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }) );
 
         auto sun2 = createGameObject("Sun");
         sun2->addComponent<Components::DirectionalLight>(0.3f, Color::WHITE, Graphics::ShadowType::Soft);
-        sun2->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 1,-1, 0 });
+        sun2->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 1,-1, 0 }) );
 
         auto plg = createGameObject("PL");
         plg->addComponent<Components::PointLight>(1.0f, Color::ORANGE, 10.0f, true);
-        plg->getTransform()->position = { 3, 4, 0 };
+        plg->getTransform()->setPosition( { 3, 4, 0 } );
         plg->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
 
         auto slg = createGameObject("SL");
         slg->addComponent<Components::SpotLight>(1.0f, Color::WHITE, 25.0f, 20.0f);
-        slg->getTransform()->position = { -5, 2, -2 };
-        slg->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 });
+        slg->getTransform()->setPosition( { -5, 2, -2 } );
+        slg->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 1 }) );
         slg->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/spotLight.png"), 0.5f);
 
         auto slg2 = createGameObject("SL");
         slg2->addComponent<Components::SpotLight>(2.5f, Color::RED, 25.0f, 20.0f);
-        slg2->getTransform()->position = { 0, 10, 0 };
-        slg2->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 0 }, Math::Vec3::FORWARD);
+        slg2->getTransform()->setPosition( { 0, 10, 0 } );
+        slg2->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 0 }, Math::Vec3::FORWARD) );
         slg2->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/spotLight.png"), 0.5f);
 
         auto slg3 = createGameObject("SL");
         slg3->addComponent<Components::SpotLight>(2.5f, Color::VIOLET, 25.0f, 20.0f);
-        slg3->getTransform()->position = { 0, 10, 10 };
-        slg3->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 0 }, Math::Vec3::FORWARD);
+        slg3->getTransform()->setPosition( { 0, 10, 10 } );
+        slg3->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 0 }, Math::Vec3::FORWARD) );
         slg3->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/spotLight.png"), 0.5f);
     }
 };
@@ -690,7 +686,7 @@ public:
     {
         auto go = createGameObject("Camera");
         go->addComponent<Components::AudioListener>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 5, -5);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 5, -5) );
 
         if (not AddVRCameraComponent(go, true))
             LOG_WARN("VR is disabled or no VR headset found.");
@@ -714,7 +710,7 @@ public:
     {
         auto go = createGameObject("Camera");
         go->addComponent<Components::AudioListener>();
-        go->getComponent<Components::Transform>()->position = Math::Vec3(0, 5, -1);
+        go->getComponent<Components::Transform>()->setPosition( Math::Vec3(0, 5, -1) );
 
         if (not AddVRCameraComponent(go, true))
             LOG_WARN("VR is disabled or no VR headset found.");
@@ -748,7 +744,7 @@ public:
 
         auto obj = createGameObject("Obj");
         auto mr = obj->addComponent<Components::MeshRenderer>(mesh, nullptr);
-        obj->getTransform()->scale = { 0.01f };
+        obj->getTransform()->setScale( { 0.01f } );
 
         if (materialImportInfo.isValid())
         {
@@ -760,7 +756,7 @@ public:
         // LIGHTS
         auto sun = createGameObject("Sun");
         auto dl = sun->addComponent<Components::DirectionalLight>(10.0f, Color::WHITE, Graphics::ShadowType::CSMSoft, ArrayList<F32>{10.0f, 30.0f, 80.0f, 200.0f});
-        sun->getTransform()->rotation = Math::Quat::LookRotation(Math::Vec3{ 0,-1, 0.1f });
+        sun->getTransform()->setRotation( Math::Quat::LookRotation(Math::Vec3{ 0,-1, 0.1f }) );
 
         F32 pointLightIntensity = 10.0f;
         F32 pointLightRange = 5.0f;
@@ -768,25 +764,25 @@ public:
 
         auto pl = createGameObject("PointLight");
         pl->addComponent<Components::PointLight>(pointLightIntensity, pointLightColor, pointLightRange);
-        pl->getTransform()->position = { 4.9f, 1.55f, 1.4f };
+        pl->getTransform()->setPosition( { 4.9f, 1.55f, 1.4f } );
         pl->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
         //pl->addComponent<Components::ParticleSystem>("/particles/smoke.ps");
 
         auto pl2 = createGameObject("PointLight");
         pl2->addComponent<Components::PointLight>(pointLightIntensity, pointLightColor, pointLightRange);
-        pl2->getTransform()->position = { 4.9f, 1.55f, -2.2f };
+        pl2->getTransform()->setPosition( { 4.9f, 1.55f, -2.2f } );
         pl2->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
         //pl2->addComponent<Components::ParticleSystem>("/particles/smoke.ps");
 
         auto pl3 = createGameObject("PointLight");
         pl3->addComponent<Components::PointLight>(pointLightIntensity, pointLightColor, pointLightRange);
-        pl3->getTransform()->position = { -6.2f, 1.55f, 1.4f };
+        pl3->getTransform()->setPosition( { -6.2f, 1.55f, 1.4f } );
         pl3->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
         //pl3->addComponent<Components::ParticleSystem>("/particles/smoke.ps");
 
         auto pl4 = createGameObject("PointLight");
         pl4->addComponent<Components::PointLight>(pointLightIntensity, pointLightColor, pointLightRange, true);
-        pl4->getTransform()->position = { -6.2f, 1.55f, -2.2f };
+        pl4->getTransform()->setPosition( { -6.2f, 1.55f, -2.2f } );
         pl4->addComponent<Components::Billboard>(ASSETS.getTexture2D("/engine/textures/pointLight.png"), 0.5f);
         //pl4->addComponent<Components::ParticleSystem>("/particles/smoke.ps");
 
@@ -102,51 +102,50 @@ namespace Graphics {
     //----------------------------------------------------------------------
     void D3D11Renderer::_ExecuteCommandBuffer( const CommandBuffer& cmd )
     {
-        auto& commands = cmd.getGPUCommands();
-
-        for ( auto& command : commands )
+        for ( U32 i = 0; i < cmd.getCommandCount(); ++i )
         {
-            switch ( command->getType() )
+            auto& command = cmd.getCommand( i );
+            switch ( command.getType() )
             {
                 case GPUCommand::SET_CAMERA:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_SetCamera*>( command.get() );
-                    _SetCamera( &cmd.camera );
+                    auto& setCamera = reinterpret_cast<const GPUC_SetCamera&>( command );
+                    _SetCamera( cmd.getCamera( setCamera.cameraIndex ) );
                     break;
                 }
                 case GPUCommand::END_CAMERA:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_EndCamera*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_EndCamera&>( command );
                     renderContext.Reset();
                     break;
                 }
                 case GPUCommand::DRAW_MESH:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_DrawMesh*>( command.get() );
-                    _DrawMesh( cmd.mesh.get(), cmd.material, cmd.modelMatrix, cmd.subMeshIndex );
+                    auto& cmd = reinterpret_cast<const GPUC_DrawMesh&>( command );
+                    _DrawMesh( cmd.mesh, cmd.material, cmd.modelMatrix, cmd.subMeshIndex );
                     break;
                 }
                 case GPUCommand::DRAW_MESH_INSTANCED:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_DrawMeshInstanced*>( command.get() );
-                    _DrawMeshInstanced( cmd.mesh.get(), cmd.material, cmd.modelMatrix, cmd.instanceCount );
+                    auto& cmd = reinterpret_cast<const GPUC_DrawMeshInstanced&>( command );
+                    _DrawMeshInstanced( cmd.mesh, cmd.material, cmd.modelMatrix, cmd.instanceCount );
                     break;
                 }
                 case GPUCommand::DRAW_MESH_SKINNED:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_DrawMeshSkinned*>( command.get() );
-                    _DrawMeshSkinned( cmd.mesh.get(), cmd.material, cmd.modelMatrix, cmd.subMeshIndex, cmd.matrixPalette );
+                    auto& cmd = reinterpret_cast<const GPUC_DrawMeshSkinned&>( command );
+                    _DrawMeshSkinned( cmd.mesh, cmd.material, cmd.modelMatrix, cmd.subMeshIndex, *cmd.matrixPalette );
                     break;
                 }
                 case GPUCommand::COPY_TEXTURE:
                 {
-                    auto& cmd = *dynamic_cast<GPUC_CopyTexture*>( command.get() );
-                    _CopyTexture( cmd.srcTex.get(), cmd.srcElement, cmd.srcMip, cmd.dstTex.get(), cmd.dstElement, cmd.dstMip );
+                    auto& cmd = reinterpret_cast<const GPUC_CopyTexture&>( command );
+                    _CopyTexture( cmd.srcTex, cmd.srcElement, cmd.srcMip, cmd.dstTex, cmd.dstElement, cmd.dstMip );
                     break;
                 }
                 case GPUCommand::DRAW_LIGHT:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_DrawLight*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_DrawLight&>( command );
                     if ( renderContext.lightCount < MAX_LIGHTS )
                     {
                         // Add light to list and update light count
@@ -161,13 +160,13 @@ namespace Graphics {
                 }
                 case GPUCommand::SET_RENDER_TARGET:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_SetRenderTarget*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_SetRenderTarget&>( command );
                     renderContext.BindRendertarget( cmd.target, m_frameCount );
                     break;
                 }
                 case GPUCommand::DRAW_FULLSCREEN_QUAD:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_DrawFullscreenQuad*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_DrawFullscreenQuad&>( command );
                     auto currRT = renderContext.getRenderTarget();
                     D3D11_VIEWPORT vp = { 0, 0, (F32)currRT->getWidth(), (F32)currRT->getHeight(), 0, 1 };
                     _DrawFullScreenQuad( cmd.material, vp );
@@ -175,26 +174,26 @@ namespace Graphics {
                 }
                 case GPUCommand::RENDER_CUBEMAP:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_RenderCubemap*>( command.get() );
-                    _RenderCubemap( cmd.cubemap.get(), cmd.material, cmd.dstMip );
+                    auto& cmd = reinterpret_cast<const GPUC_RenderCubemap&>( command );
+                    _RenderCubemap( cmd.cubemap, cmd.material, cmd.dstMip );
                     break;
                 }
                 case GPUCommand::BLIT:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_Blit*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_Blit&>( command );
                     _Blit( cmd.src, cmd.dst, cmd.material );
                     break;
                 }
                 case GPUCommand::SET_SCISSOR:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_SetScissor*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_SetScissor&>( command );
                     const D3D11_RECT r = { cmd.rect.left, cmd.rect.top, cmd.rect.right, cmd.rect.bottom };
                     g_pImmediateContext->RSSetScissorRects( 1, &r );
                     break;
                 }
                 case GPUCommand::SET_CAMERA_MATRIX:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_SetCameraMatrix*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_SetCameraMatrix&>( command );
                     StringID name;
                     switch (cmd.member)
                     {
@@ -234,11 +233,17 @@ namespace Graphics {
 
         // Execute command buffers
         _LockQueue();
-        for (auto& cmd : m_pendingCmdQueue)
-            _ExecuteCommandBuffer( cmd );
-        m_pendingCmdQueue.clear();
+        for (Size i = 0; i < m_pendingCmdCount; ++i)
+        {
+            _ExecuteCommandBuffer( m_pendingCmdQueue[i] );
+            m_pendingCmdQueue[i].reset();
+        }
+        m_pendingCmdCount = 0;
         _UnlockQueue();
 
+        // The context only holds raw pointers. Resources of the executed command buffers might be gone next frame.
+        renderContext.Reset();
+
         // Present rendered image(s)
         bool vsync = m_vsync;
         if ( hasHMD() )
@@ -256,6 +261,7 @@ namespace Graphics {
     void D3D11Renderer::dispatchImmediate( const CommandBuffer& cmd )
     {
         _ExecuteCommandBuffer( cmd );
+        renderContext.Reset();
     }
 
     //----------------------------------------------------------------------
@@ -432,7 +438,7 @@ namespace Graphics {
         }
 
         renderContext.SetCamera( camera );
-        renderContext.BindRendertarget( renderTarget, m_frameCount );
+        renderContext.BindRendertarget( renderTarget.get(), m_frameCount );
 
         // Clear rendertarget
         switch ( camera->getClearMode() )
@@ -492,7 +498,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void D3D11Renderer::_Bind( IMesh* mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex )
+    void D3D11Renderer::_Bind( IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex )
     {
         // Update global buffer if necessary
         if (m_globalBuffer)
@@ -527,7 +533,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void D3D11Renderer::_DrawMesh( IMesh* mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex )
+    void D3D11Renderer::_DrawMesh( IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex )
     {
         // Measuring per frame data
         if (auto curCamera = renderContext.getCamera())
@@ -545,7 +551,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void D3D11Renderer::_DrawMeshInstanced( IMesh* mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 instanceCount )
+    void D3D11Renderer::_DrawMeshInstanced( IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& modelMatrix, I32 instanceCount )
     {
         // Measuring per frame data
         if (auto curCamera = renderContext.getCamera())
@@ -563,7 +569,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void D3D11Renderer::_DrawMeshSkinned(IMesh* mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex, const ArrayList<DirectX::XMMATRIX>& matrixPalette)
+    void D3D11Renderer::_DrawMeshSkinned(IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex, const ArrayList<DirectX::XMMATRIX>& matrixPalette)
     {
         // Measuring per frame data
         if (auto curCamera = renderContext.getCamera())
@@ -862,7 +868,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void D3D11Renderer::_RenderCubemap( ICubemap* cubemap, const MaterialPtr& material, U32 dstMip )
+    void D3D11Renderer::_RenderCubemap( ICubemap* cubemap, IMaterial* material, U32 dstMip )
     {
         DirectX::XMVECTOR directions[] = {
             { 1, 0, 0, 0 }, { -1,  0,  0, 0 },
@@ -908,7 +914,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void D3D11Renderer::_Blit( const RenderTexturePtr& src, const RenderTexturePtr& dst, const MaterialPtr& material )
+    void D3D11Renderer::_Blit( IRenderTexture* src, IRenderTexture* dst, IMaterial* material )
     {
         auto currRT = renderContext.getRenderTarget();
         if (currRT == SCREEN_BUFFER && dst == SCREEN_BUFFER)
@@ -916,7 +922,7 @@ namespace Graphics {
                                 " occur if two blits in succession with both target = nullptr (to screen) were recorded." );
 
         // Use the src texture as the input IF not null. Otherwise use the current bound render target.
-        auto input = src.get() ? src.get() : currRT;
+        auto input = src ? src : currRT;
         if (input == SCREEN_BUFFER)
         {
             LOG_WARN_RENDERING( "D3D11[Blit]: Previous render target was screen, which can't be used as input! This happens when a blit-command "
@@ -977,7 +983,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void D3D11Renderer::_DrawFullScreenQuad( const MaterialPtr& material, const D3D11_VIEWPORT& viewport )
+    void D3D11Renderer::_DrawFullScreenQuad( IMaterial* material, const D3D11_VIEWPORT& viewport )
     {
         renderContext.BindShader( material->getShader() );
         renderContext.BindMaterial( material );
@@ -1038,7 +1044,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void D3D11Renderer::RenderContext::BindMaterial( const MaterialPtr& material )
+    void D3D11Renderer::RenderContext::BindMaterial( IMaterial* material )
     {
         // Don't bind same material again
         if (material == m_material)
@@ -1060,7 +1066,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void D3D11Renderer::RenderContext::BindRendertarget( const RenderTexturePtr& rt, U64 frameCount )
+    void D3D11Renderer::RenderContext::BindRendertarget( IRenderTexture* rt, U64 frameCount )
     {
         // Unbind all shader resources, because the render target might be used as a srv
         ID3D11ShaderResourceView* resourceViews[16] = {};
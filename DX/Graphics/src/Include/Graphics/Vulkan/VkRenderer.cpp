@@ -152,52 +152,51 @@ namespace Graphics {
     //----------------------------------------------------------------------
     void VkRenderer::_ExecuteCommandBuffer( const CommandBuffer& cmd )
     {
-        auto& commands = cmd.getGPUCommands();
-
-        for ( auto& command : commands )
+        for ( U32 i = 0; i < cmd.getCommandCount(); ++i )
         {
-            switch ( command->getType() )
+            auto& command = cmd.getCommand( i );
+            switch ( command.getType() )
             {
                 case GPUCommand::SET_CAMERA:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_SetCamera*>( command.get() );
-                    _SetCamera( &cmd.camera );
+                    auto& setCamera = reinterpret_cast<const GPUC_SetCamera&>( command );
+                    _SetCamera( cmd.getCamera( setCamera.cameraIndex ) );
                     break;
                 }
                 case GPUCommand::END_CAMERA:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_EndCamera*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_EndCamera&>( command );
                     g_vulkan.ctx.EndRenderPass();
                     renderContext.Reset();
                     break;
                 }
                 case GPUCommand::DRAW_MESH:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_DrawMesh*>( command.get() );
-                    _DrawMesh( cmd.mesh.get(), cmd.material, cmd.modelMatrix, cmd.subMeshIndex );
+                    auto& cmd = reinterpret_cast<const GPUC_DrawMesh&>( command );
+                    _DrawMesh( cmd.mesh, cmd.material, cmd.modelMatrix, cmd.subMeshIndex );
                     break;
                 }
                 case GPUCommand::DRAW_MESH_INSTANCED:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_DrawMeshInstanced*>( command.get() );
-                    _DrawMeshInstanced( cmd.mesh.get(), cmd.material, cmd.modelMatrix, cmd.instanceCount );
+                    auto& cmd = reinterpret_cast<const GPUC_DrawMeshInstanced&>( command );
+                    _DrawMeshInstanced( cmd.mesh, cmd.material, cmd.modelMatrix, cmd.instanceCount );
                     break;
                 }
                 case GPUCommand::DRAW_MESH_SKINNED:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_DrawMeshSkinned*>( command.get() );
-                    _DrawMeshSkinned( cmd.mesh.get(), cmd.material, cmd.modelMatrix, cmd.subMeshIndex, cmd.matrixPalette );
+                    auto& cmd = reinterpret_cast<const GPUC_DrawMeshSkinned&>( command );
+                    _DrawMeshSkinned( cmd.mesh, cmd.material, cmd.modelMatrix, cmd.subMeshIndex, *cmd.matrixPalette );
                     break;
                 }
                 case GPUCommand::COPY_TEXTURE:
                 {
-                    auto& cmd = *dynamic_cast<GPUC_CopyTexture*>( command.get() );
-                    _CopyTexture( cmd.srcTex.get(), cmd.srcElement, cmd.srcMip, cmd.dstTex.get(), cmd.dstElement, cmd.dstMip );
+                    auto& cmd = reinterpret_cast<const GPUC_CopyTexture&>( command );
+                    _CopyTexture( cmd.srcTex, cmd.srcElement, cmd.srcMip, cmd.dstTex, cmd.dstElement, cmd.dstMip );
                     break;
                 }
                 case GPUCommand::DRAW_LIGHT:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_DrawLight*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_DrawLight&>( command );
                     if ( renderContext.lightCount < MAX_LIGHTS )
                     {
                         // Add light to list and update light count
@@ -212,13 +211,13 @@ namespace Graphics {
                 }
                 case GPUCommand::SET_RENDER_TARGET:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_SetRenderTarget*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_SetRenderTarget&>( command );
                     renderContext.BindRendertarget( cmd.target, m_frameCount );
                     break;
                 }
                 case GPUCommand::DRAW_FULLSCREEN_QUAD:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_DrawFullscreenQuad*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_DrawFullscreenQuad&>( command );
                     auto currRT = renderContext.getRenderTarget();
                     ASSERT( currRT && "No rendertarget was previously set." );
                     ViewportRect vp = { 0, 0, (F32)currRT->getWidth(), (F32)currRT->getHeight() };
@@ -227,19 +226,19 @@ namespace Graphics {
                 }
                 case GPUCommand::RENDER_CUBEMAP:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_RenderCubemap*>( command.get() );
-                    _RenderCubemap( cmd.cubemap.get(), cmd.material, cmd.dstMip );
+                    auto& cmd = reinterpret_cast<const GPUC_RenderCubemap&>( command );
+                    _RenderCubemap( cmd.cubemap, cmd.material, cmd.dstMip );
                     break;
                 }
                 case GPUCommand::BLIT:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_Blit*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_Blit&>( command );
                     _Blit( cmd.src, cmd.dst, cmd.material );
                     break;
                 }
                 case GPUCommand::SET_SCISSOR:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_SetScissor*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_SetScissor&>( command );
                     VkRect2D scissor{};
                     scissor.offset = { cmd.rect.left, cmd.rect.top };
                     scissor.extent = { (U32)(cmd.rect.right - cmd.rect.left), (U32)(cmd.rect.bottom - cmd.rect.top) };
@@ -248,7 +247,7 @@ namespace Graphics {
                 }
                 case GPUCommand::SET_CAMERA_MATRIX:
                 {
-                    auto& cmd = *reinterpret_cast<GPUC_SetCameraMatrix*>( command.get() );
+                    auto& cmd = reinterpret_cast<const GPUC_SetCameraMatrix&>( command );
                     StringID name;
                     switch (cmd.member)
                     {
@@ -303,10 +302,16 @@ namespace Graphics {
             m_animationBuffer->newFrame();
             {
                 _LockQueue();
-                for (auto& cmd : m_pendingCmdQueue)
-                    _ExecuteCommandBuffer( cmd );
-                m_pendingCmdQueue.clear();
+                for (Size i = 0; i < m_pendingCmdCount; ++i)
+                {
+                    _ExecuteCommandBuffer( m_pendingCmdQueue[i] );
+                    m_pendingCmdQueue[i].reset();
+                }
+                m_pendingCmdCount = 0;
                 _UnlockQueue();
+
+                // The context only holds raw pointers. Resources of the executed command buffers might be gone next frame.
+                renderContext.Reset();
             }
         }
         g_vulkan.ctx.EndFrame();
@@ -464,7 +469,7 @@ namespace Graphics {
         default: LOG_WARN_RENDERING( "Unknown Clear-Mode in camera!" );
         }
 
-        renderContext.BindRendertarget( renderTarget, m_frameCount );
+        renderContext.BindRendertarget( renderTarget.get(), m_frameCount );
 
         if ( camera->isBlittingToScreen() )
         {
@@ -509,7 +514,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void VkRenderer::_Bind( IMesh* mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex )
+    void VkRenderer::_Bind( IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex )
     {
         // Update global buffer if necessary
         if ( m_globalBuffer )
@@ -544,7 +549,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void VkRenderer::_DrawMesh( IMesh* mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex )
+    void VkRenderer::_DrawMesh( IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex )
     {
         // Measuring per frame data
         if (auto curCamera = renderContext.getCamera())
@@ -561,7 +566,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void VkRenderer::_DrawMeshInstanced( IMesh* mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 instanceCount )
+    void VkRenderer::_DrawMeshInstanced( IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& modelMatrix, I32 instanceCount )
     {
         // Measuring per frame data
         if (auto curCamera = renderContext.getCamera())
@@ -578,7 +583,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void VkRenderer::_DrawMeshSkinned( IMesh* mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex, const ArrayList<DirectX::XMMATRIX>& matrixPalette)
+    void VkRenderer::_DrawMeshSkinned( IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex, const ArrayList<DirectX::XMMATRIX>& matrixPalette)
     {
         // Measuring per frame data
         if (auto curCamera = renderContext.getCamera())
@@ -872,7 +877,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void VkRenderer::_RenderCubemap( ICubemap* cubemap, const MaterialPtr& material, U32 dstMip )
+    void VkRenderer::_RenderCubemap( ICubemap* cubemap, IMaterial* material, U32 dstMip )
     {
          DirectX::XMVECTOR directions[] = {
             { 1, 0, 0, 0 }, { -1,  0,  0, 0 },
@@ -919,7 +924,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void VkRenderer::_Blit( const RenderTexturePtr& src, const RenderTexturePtr& dst, const MaterialPtr& material )
+    void VkRenderer::_Blit( IRenderTexture* src, IRenderTexture* dst, IMaterial* material )
     {
         auto currRT = renderContext.getRenderTarget();
         if (currRT == SCREEN_BUFFER && dst == SCREEN_BUFFER)
@@ -927,7 +932,7 @@ namespace Graphics {
                                 "occur if two blits in succession with both target = nullptr (to screen) were recorded." );
 
         // Use the src texture as the input IF not null. Otherwise use the current bound render target.
-        auto input = src.get() ? src.get() : currRT;
+        auto input = src ? src : currRT;
         if (input == SCREEN_BUFFER)
         {
             LOG_WARN_RENDERING( "VkRenderer[Blit]: Previous render target was screen, which can't be used as input! This happens when a blit-command "
@@ -986,7 +991,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void VkRenderer::_DrawFullScreenQuad( const MaterialPtr& material, const ViewportRect& viewport )
+    void VkRenderer::_DrawFullScreenQuad( IMaterial* material, const ViewportRect& viewport )
     {
         renderContext.BindShader( material->getShader() );
         renderContext.BindMaterial( material );
@@ -1048,7 +1053,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void VkRenderer::RenderContext::BindMaterial( const MaterialPtr& material )
+    void VkRenderer::RenderContext::BindMaterial( IMaterial* material )
     {
         // Don't bind same material again
         if (material == m_material)
@@ -1070,7 +1075,7 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void VkRenderer::RenderContext::BindRendertarget( const RenderTexturePtr& rt, U64 frameCount )
+    void VkRenderer::RenderContext::BindRendertarget( IRenderTexture* rt, U64 frameCount )
     {
         m_renderTarget = rt;
         if (m_renderTarget)
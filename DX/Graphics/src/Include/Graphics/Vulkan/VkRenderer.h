@@ -73,14 +73,14 @@ namespace Graphics {
 
         //----------------------------------------------------------------------
         inline void _SetCamera(Camera* camera);
-        inline void _Bind(IMesh* mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex);
-        inline void _DrawMesh(IMesh* mesh, const MaterialPtr& material, const DirectX::XMMATRIX& model, I32 subMeshIndex);
-        inline void _DrawMeshInstanced(IMesh* mesh, const MaterialPtr& material, const DirectX::XMMATRIX& model, I32 instanceCount);
-        inline void _DrawMeshSkinned(IMesh* mesh, const MaterialPtr& material, const DirectX::XMMATRIX& model, I32 subMeshIndex, const ArrayList<DirectX::XMMATRIX>& matrixPalette);
+        inline void _Bind(IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex);
+        inline void _DrawMesh(IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& model, I32 subMeshIndex);
+        inline void _DrawMeshInstanced(IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& model, I32 instanceCount);
+        inline void _DrawMeshSkinned(IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& model, I32 subMeshIndex, const ArrayList<DirectX::XMMATRIX>& matrixPalette);
         inline void _CopyTexture(ITexture* srcTex, I32 srcElement, I32 srcMip, ITexture* dstTex, I32 dstElement, I32 dstMip);
-        inline void _RenderCubemap(ICubemap* cubemap, const MaterialPtr& material, U32 dstMip);
-        inline void _Blit(const RenderTexturePtr& src, const RenderTexturePtr& dst, const MaterialPtr& material);
-        inline void _DrawFullScreenQuad(const MaterialPtr& material, const ViewportRect& viewport);
+        inline void _RenderCubemap(ICubemap* cubemap, IMaterial* material, U32 dstMip);
+        inline void _Blit(IRenderTexture* src, IRenderTexture* dst, IMaterial* material);
+        inline void _DrawFullScreenQuad(IMaterial* material, const ViewportRect& viewport);
 
         //----------------------------------------------------------------------
         void _SetGPUDescription();
@@ -107,20 +107,20 @@ namespace Graphics {
             bool         lightsUpdated = false; // Set to true whenever a new light has been added
 
             inline void Reset();
-            inline void BindMaterial(const MaterialPtr& material);
+            inline void BindMaterial(IMaterial* material);
             inline void BindShader(const std::shared_ptr<IShader>& shader);
-            inline void BindRendertarget(const RenderTexturePtr& rt, U64 frameCount);
+            inline void BindRendertarget(IRenderTexture* rt, U64 frameCount);
             inline void SetCamera(Camera* camera);
 
             inline IShader*         getShader()         const { return m_shader.get(); }
-            inline IRenderTexture*  getRenderTarget()   const { return m_renderTarget.get(); }
+            inline IRenderTexture*  getRenderTarget()   const { return m_renderTarget; }
             inline Camera*          getCamera()         const { return m_camera; }
 
         private:
             Camera*                     m_camera = nullptr;       // Current camera
-            MaterialPtr                 m_material = nullptr;     // Current bound material
+            IMaterial*                  m_material = nullptr;     // Current bound material
             std::shared_ptr<IShader>    m_shader = nullptr;       // Current bound shader
-            RenderTexturePtr            m_renderTarget = nullptr; // Current render target
+            IRenderTexture*             m_renderTarget = nullptr; // Current render target
         } renderContext;
 
         NULL_COPY_AND_ASSIGN(VkRenderer)
@@ -10,6 +10,7 @@
 #include "i_render_texture.h"
 #include "structs.hpp"
 #include "Math/aabb.h"
+#include "Math/frustum_culler.h"
 
 namespace Graphics {
 
@@ -128,6 +129,7 @@ namespace Graphics {
         inline const DirectX::XMMATRIX& getViewProjectionMatrix()  const { return m_viewProjection; }
         inline const DirectX::XMMATRIX& getViewMatrix()            const { return m_view; }
         inline const DirectX::XMMATRIX& getModelMatrix()           const { return m_model; }
+        inline const Math::FrustumPlanes& getFrustumPlanes()       const { return m_planes; }
 
         //----------------------------------------------------------------------
         // Set the model matrix for this camera.
@@ -200,7 +202,7 @@ namespace Graphics {
 
         // Culling planes
         enum side { LEFT = 0, RIGHT = 1, TOP = 2, BOTTOM = 3, BACK = 4, FRONT = 5 };
-        std::array<Math::Vec4, 6> m_planes;
+        Math::FrustumPlanes m_planes;
 
         // If not null, materials will use this shader if not overriden
         ShaderPtr m_replacementShader = nullptr;
@@ -9,111 +9,176 @@
 #include "Logging/logging.h"
 #include "i_material.h"
 #include "i_shader.h"
+#include "Common/radix_sort.hpp"
 
 namespace Graphics {
 
     //----------------------------------------------------------------------
-    I32 getRenderQueue( const std::shared_ptr<GPUCommandBase>& cmd )
+    // Layout of a draw key (from most to least significant):
+    //  [Renderqueue 16 Bit | Shader 12 Bit | Material 12 Bit | Mesh 8 Bit | Depth 16 Bit]
+    // Back to front sorted draws only use [Boundary 16 Bit | 0 | Inverted depth 32 Bit].
+    // Shader, material and mesh are hashed pointers. A collision only worsens the batching.
+    //----------------------------------------------------------------------
+    #define SORT_KEY_QUEUE_SHIFT        48
+    #define SORT_KEY_QUEUE_BIAS         0x8000
+    #define SORT_KEY_LIGHT_QUEUE        -8196 // Low enough so lights are always before every draw command
+    #define SORT_KEY_TRANSPARENT_QUEUE  ((U64)((I32)RenderQueue::BackToFrontBoundary + SORT_KEY_QUEUE_BIAS))
+
+    //----------------------------------------------------------------------
+    static inline U64 QueueBits( I32 renderQueue )
     {
-        switch ( cmd->getType() )
-        {
-        case GPUCommand::DRAW_MESH:
-        {
-            auto drawCmd = std::reinterpret_pointer_cast<GPUC_DrawMesh>(cmd);
-            return drawCmd->material->getShader()->getRenderQueue();
-        }
-        case GPUCommand::DRAW_MESH_INSTANCED:
-        {
-            auto drawCmd = std::reinterpret_pointer_cast<GPUC_DrawMeshInstanced>(cmd);
-            return drawCmd->material->getShader()->getRenderQueue();
-        }
-        case GPUCommand::DRAW_MESH_SKINNED:
-        {
-            auto drawCmd = std::reinterpret_pointer_cast<GPUC_DrawMeshSkinned>(cmd);
-            return drawCmd->material->getShader()->getRenderQueue();
-        }
-        case GPUCommand::DRAW_LIGHT:
-            return -8196; // return low enough so it is always before every draw command
-        }
-        LOG_WARN_RENDERING( "CommandBuffer::getRenderQueue(): Expected draw command but was not! Consult your local programmer to fix this!" );
-        return 0;
+        I32 biased = std::max( 0, std::min( renderQueue + SORT_KEY_QUEUE_BIAS, 0xFFFF ) );
+        return static_cast<U64>( biased );
+    }
+
+    //----------------------------------------------------------------------
+    static inline U64 PointerBits( const void* ptr, U32 numBits )
+    {
+        U64 h = reinterpret_cast<U64>( ptr );
+        h ^= h >> 17;
+        h *= 0x9E3779B97F4A7C15ull;
+        return h >> (64 - numBits);
+    }
+
+    //----------------------------------------------------------------------
+    static U64 MakeDrawKey( const IMesh* mesh, const IMaterial* material )
+    {
+        auto& shader = material->getShader();
+        return (QueueBits( shader->getRenderQueue() ) << SORT_KEY_QUEUE_SHIFT) | (PointerBits( shader.get(), 12 ) << 36)
+             | (PointerBits( material, 12 ) << 24) | (PointerBits( mesh, 8 ) << 16);
+    }
+
+    //----------------------------------------------------------------------
+    static inline bool IsDrawCommand( GPUCommand type )
+    {
+        return type == GPUCommand::DRAW_MESH || type == GPUCommand::DRAW_MESH_INSTANCED ||
+               type == GPUCommand::DRAW_MESH_SKINNED || type == GPUCommand::DRAW_LIGHT;
     }
 
     //----------------------------------------------------------------------
     CommandBuffer::CommandBuffer()
     {
-        m_gpuCommands.reserve( COMMAND_BUFFER_INITIAL_CAPACITY );
+        // Most commands are draw calls, so reserve enough memory for those
+        m_data.reserve( COMMAND_BUFFER_INITIAL_CAPACITY * sizeof( GPUC_DrawMesh ) / sizeof( Block ) );
+        m_commands.reserve( COMMAND_BUFFER_INITIAL_CAPACITY );
     }
 
     //----------------------------------------------------------------------
     void CommandBuffer::sortCommands()
     {
-        std::sort( m_gpuCommands.begin(), m_gpuCommands.end(), [](const std::shared_ptr<Graphics::GPUCommandBase>& c1, const std::shared_ptr<Graphics::GPUCommandBase>& c2) {
-            return c1->getType() < c2->getType();
+        std::sort( m_commands.begin(), m_commands.end(), [this](U32 c1, U32 c2) {
+            return _GetCommand( c1 ).getType() < _GetCommand( c2 ).getType();
         } );
     }
 
     //----------------------------------------------------------------------
     void CommandBuffer::sortDrawCommands( const Math::Vec3& cameraPos )
     {
-        // Sort draw commands by renderqueue first
-        auto itBeginDraw = m_gpuCommands.begin();
-        while ( itBeginDraw != m_gpuCommands.end() && ((*itBeginDraw)->getType() != GPUCommand::DRAW_MESH && 
-                                                       (*itBeginDraw)->getType() != GPUCommand::DRAW_MESH_INSTANCED &&
-                                                       (*itBeginDraw)->getType() != GPUCommand::DRAW_MESH_SKINNED &&
-                                                       (*itBeginDraw)->getType() != GPUCommand::DRAW_LIGHT) )
+        auto itBeginDraw = m_commands.begin();
+        while ( itBeginDraw != m_commands.end() && not IsDrawCommand( _GetCommand( *itBeginDraw ).getType() ) )
             itBeginDraw++;
 
         auto itEndDraw = itBeginDraw;
-        while ( itEndDraw != m_gpuCommands.end() && ((*itEndDraw)->getType() == GPUCommand::DRAW_MESH ||
-                                                     (*itEndDraw)->getType() == GPUCommand::DRAW_MESH_INSTANCED || 
-                                                     (*itEndDraw)->getType() == GPUCommand::DRAW_MESH_SKINNED || 
-                                                     (*itEndDraw)->getType() == GPUCommand::DRAW_LIGHT) )
+        while ( itEndDraw != m_commands.end() && IsDrawCommand( _GetCommand( *itEndDraw ).getType() ) )
             itEndDraw++;
 
-        std::sort( itBeginDraw, itEndDraw, [] (const std::shared_ptr<Graphics::GPUCommandBase>& c1, const std::shared_ptr<Graphics::GPUCommandBase>& c2) {
-            return getRenderQueue( c1 ) < getRenderQueue( c2 );
-        } );
+        Size count = itEndDraw - itBeginDraw;
+        if (count < 2)
+            return;
+
+        // Complete the keys with the camera distance, which is only known now
+        m_sortItems.resize( count );
+        m_sortTemp.resize( count );
+
+        auto camPos = DirectX::XMLoadFloat3( &cameraPos );
+        auto completeKey = [&]( const auto& drawCmd ) {
+            F32 distance = DirectX::XMVectorGetX( DirectX::XMVector3LengthSq( DirectX::XMVectorSubtract( camPos, drawCmd.modelMatrix.r[3] ) ) );
+
+            // Positive floats keep their order when compared as integers
+            U32 distanceBits;
+            memcpy( &distanceBits, &distance, sizeof( distanceBits ) );
+
+            U64 key = drawCmd.sortKey;
+            if ( (key >> SORT_KEY_QUEUE_SHIFT) >= SORT_KEY_TRANSPARENT_QUEUE )
+                return (SORT_KEY_TRANSPARENT_QUEUE << SORT_KEY_QUEUE_SHIFT) | static_cast<U64>( ~distanceBits );
+            return key | (distanceBits >> 16);
+        };
 
-        // All draw commands are now ordered properly e.g. drawmesh by renderqueue
-        auto itBeginDrawTransparent = itBeginDraw;
-        while (itBeginDrawTransparent != m_gpuCommands.end() && 
-              ((*itBeginDrawTransparent)->getType() == GPUCommand::DRAW_MESH ||
-               (*itBeginDrawTransparent)->getType() == GPUCommand::DRAW_MESH_INSTANCED ||
-               (*itBeginDrawTransparent)->getType() == GPUCommand::DRAW_MESH_SKINNED ||
-               (*itBeginDrawTransparent)->getType() == GPUCommand::DRAW_LIGHT) )
+        for (Size i = 0; i < count; ++i)
         {
-            if ( getRenderQueue(*itBeginDrawTransparent) >= (I32)Graphics::RenderQueue::BackToFrontBoundary)
-                break;
-            itBeginDrawTransparent++;
-        }
+            U32 offset = itBeginDraw[i];
+            auto& command = _GetCommand( offset );
+
+            U64 key = QueueBits( SORT_KEY_LIGHT_QUEUE ) << SORT_KEY_QUEUE_SHIFT;
+            switch ( command.getType() )
+            {
+            case GPUCommand::DRAW_MESH:             key = completeKey( reinterpret_cast<const GPUC_DrawMesh&>( command ) ); break;
+            case GPUCommand::DRAW_MESH_INSTANCED:   key = completeKey( reinterpret_cast<const GPUC_DrawMeshInstanced&>( command ) ); break;
+            case GPUCommand::DRAW_MESH_SKINNED:     key = completeKey( reinterpret_cast<const GPUC_DrawMeshSkinned&>( command ) ); break;
+            default: break; // Lights
+            }
 
-        // Sort transparent draw materials by camera distance
-        std::sort( itBeginDrawTransparent, itEndDraw, [cameraPos](const std::shared_ptr<Graphics::GPUCommandBase>& c1, const std::shared_ptr<Graphics::GPUCommandBase>& c2) {
-            auto d1 = std::reinterpret_pointer_cast<Graphics::GPUC_DrawMesh>( c1 );
-            auto d2 = std::reinterpret_pointer_cast<Graphics::GPUC_DrawMesh>( c2 );
-            auto pos = d1->modelMatrix.r[3];
-            auto pos2 = d2->modelMatrix.r[3];
+            m_sortItems[i] = { key, offset };
+        }
 
-            auto camPos = DirectX::XMLoadFloat3( &cameraPos );
-            auto distance1 = DirectX::XMVector4LengthSq( DirectX::XMVectorSubtract( camPos, pos ) );
-            auto distance2 = DirectX::XMVector4LengthSq( DirectX::XMVectorSubtract( camPos, pos2 ) );
+        Common::RadixSort64( m_sortItems.data(), m_sortTemp.data(), count, [](const SortItem& item) { return item.key; } );
 
-            return DirectX::XMVector4Greater( distance1, distance2 );
-        } );
+        for (Size i = 0; i < count; ++i)
+            itBeginDraw[i] = m_sortItems[i].offset;
     }
 
     //----------------------------------------------------------------------
     void CommandBuffer::merge( const CommandBuffer& cmd )
     {
-        auto& commands = cmd.m_gpuCommands;
-        m_gpuCommands.insert( m_gpuCommands.end(), commands.begin(), commands.end() );
+        ASSERT( &cmd != this );
+
+        U32 dataOffset = static_cast<U32>( m_data.size() * sizeof( Block ) );
+        U32 cameraOffset = static_cast<U32>( m_cameras.size() );
+
+        // Commands are plain old data, so just copy the memory and fix up the offsets afterwards
+        m_data.insert( m_data.end(), cmd.m_data.begin(), cmd.m_data.end() );
+        m_cameras.insert( m_cameras.end(), cmd.m_cameras.begin(), cmd.m_cameras.end() );
+        m_resources.insert( m_resources.end(), cmd.m_resources.begin(), cmd.m_resources.end() );
+
+        m_commands.reserve( m_commands.size() + cmd.m_commands.size() );
+        for (U32 offset : cmd.m_commands)
+        {
+            m_commands.push_back( dataOffset + offset );
+
+            auto& command = _GetCommand( dataOffset + offset );
+            if (command.getType() == GPUCommand::SET_CAMERA)
+                reinterpret_cast<GPUC_SetCamera&>( command ).cameraIndex += cameraOffset;
+        }
     }
 
     //----------------------------------------------------------------------
     void CommandBuffer::reset()
     {
-        m_gpuCommands.clear();
+        // Keep the memory, so the next recording does not allocate again
+        m_data.clear();
+        m_commands.clear();
+        m_cameras.clear();
+        m_resources.clear();
+    }
+
+    //----------------------------------------------------------------------
+    bool CommandBuffer::isIdentical( const CommandBuffer& other ) const
+    {
+        if (m_commands != other.m_commands || m_data.size() != other.m_data.size() || m_cameras.size() != other.m_cameras.size())
+            return false;
+
+        // Commands are plain old data and their memory is zeroed before recording, so padding compares equal too
+        if ( memcmp( _GetData(), other._GetData(), m_data.size() * sizeof( Block ) ) != 0 )
+            return false;
+
+        for (Size i = 0; i < m_cameras.size(); i++)
+        {
+            if ( memcmp( &m_cameras[i].getViewMatrix(), &other.m_cameras[i].getViewMatrix(), sizeof( DirectX::XMMATRIX ) ) != 0 ||
+                 memcmp( &m_cameras[i].getProjectionMatrix(), &other.m_cameras[i].getProjectionMatrix(), sizeof( DirectX::XMMATRIX ) ) != 0 )
+                return false;
+        }
+
+        return m_resources == other.m_resources;
     }
 
     //----------------------------------------------------------------------
@@ -121,7 +186,8 @@ namespace Graphics {
     {
         ASSERT( mesh && "Mesh is null, which is not allowed!" );
         ASSERT( material && "Material is null, which is not allowed!" );
-        m_gpuCommands.push_back( std::make_unique<GPUC_DrawMesh>( mesh, material, modelMatrix, subMeshIndex ) );
+        auto& drawCmd = _Record<GPUC_DrawMesh>( mesh.get(), material.get(), modelMatrix, subMeshIndex );
+        drawCmd.sortKey = MakeDrawKey( drawCmd.mesh, drawCmd.material );
     }
 
     //----------------------------------------------------------------------
@@ -130,7 +196,8 @@ namespace Graphics {
         ASSERT( mesh && "Mesh is null, which is not allowed!" );
         ASSERT( material && "Material is null, which is not allowed!" );
         ASSERT( instanceCount > 0 && "Material is null, which is not allowed!" );
-        m_gpuCommands.push_back( std::make_unique<GPUC_DrawMeshInstanced>( mesh, material, modelMatrix, instanceCount ) );
+        auto& drawCmd = _Record<GPUC_DrawMeshInstanced>( mesh.get(), material.get(), modelMatrix, instanceCount );
+        drawCmd.sortKey = MakeDrawKey( drawCmd.mesh, drawCmd.material );
     }
 
     //----------------------------------------------------------------------
@@ -138,19 +205,22 @@ namespace Graphics {
     {
         ASSERT( mesh && "Mesh is null, which is not allowed!" );
         ASSERT( material && "Material is null, which is not allowed!" );
-        m_gpuCommands.push_back( std::make_unique<GPUC_DrawMeshSkinned>( mesh, material, modelMatrix, subMeshIndex, matrixPalette ) );
+        auto& drawCmd = _Record<GPUC_DrawMeshSkinned>( mesh.get(), material.get(), modelMatrix, subMeshIndex, &matrixPalette );
+        drawCmd.sortKey = MakeDrawKey( drawCmd.mesh, drawCmd.material );
     }
 
     //----------------------------------------------------------------------
     void CommandBuffer::setCamera( const Camera& camera )
     {
-        m_gpuCommands.push_back( std::make_unique<GPUC_SetCamera>( camera ) );
+        // The camera has to be copied, because it might be changed and set again before this buffer gets executed
+        _Record<GPUC_SetCamera>( static_cast<U32>( m_cameras.size() ) );
+        m_cameras.push_back( camera );
     }
 
     //----------------------------------------------------------------------
     void CommandBuffer::endCamera()
     {
-        m_gpuCommands.push_back( std::make_unique<GPUC_EndCamera>() );
+        _Record<GPUC_EndCamera>();
     }
 
     //----------------------------------------------------------------------
@@ -163,49 +233,79 @@ namespace Graphics {
     void CommandBuffer::copyTexture( const TexturePtr& srcTex, I32 srcElement, I32 srcMip, const TexturePtr& dstTex, I32 dstElement, I32 dstMip )
     {
         ASSERT( srcTex->getWidth() == dstTex->getWidth() && srcTex->getHeight() == dstTex->getHeight() && "Textures must be of same size" );
-        m_gpuCommands.push_back( std::make_unique<GPUC_CopyTexture>( srcTex, srcElement, srcMip, dstTex, dstElement, dstMip ) );
+        m_resources.push_back( srcTex );
+        m_resources.push_back( dstTex );
+        _Record<GPUC_CopyTexture>( srcTex.get(), srcElement, srcMip, dstTex.get(), dstElement, dstMip );
     }
 
     //----------------------------------------------------------------------
     void CommandBuffer::drawLight( const Light* light )
     {
-        m_gpuCommands.push_back( std::make_unique<GPUC_DrawLight>( light ) );
+        _Record<GPUC_DrawLight>( light );
     }
 
     //----------------------------------------------------------------------
     void CommandBuffer::setRenderTarget( const RenderTexturePtr& target )
     {
-        m_gpuCommands.push_back( std::make_unique<GPUC_SetRenderTarget>( target ) );
+        m_resources.push_back( target );
+        _Record<GPUC_SetRenderTarget>( target.get() );
     }
 
     //----------------------------------------------------------------------
     void CommandBuffer::drawFullscreenQuad( const MaterialPtr& material )
     {
-        m_gpuCommands.push_back( std::make_unique<GPUC_DrawFullscreenQuad>( material ) );
+        m_resources.push_back( material );
+        _Record<GPUC_DrawFullscreenQuad>( material.get() );
     }
 
     //----------------------------------------------------------------------
     void CommandBuffer::renderCubemap( const CubemapPtr& cubemap, const MaterialPtr& material, I32 dstMip )
     {
-        m_gpuCommands.push_back( std::make_unique<GPUC_RenderCubemap>( cubemap, material, dstMip ) );
+        m_resources.push_back( cubemap );
+        m_resources.push_back( material );
+        _Record<GPUC_RenderCubemap>( cubemap.get(), material.get(), dstMip );
     }
 
     //----------------------------------------------------------------------
     void CommandBuffer::blit( const RenderTexturePtr& src, const RenderTexturePtr& dst, const MaterialPtr& material )
     {
-        m_gpuCommands.push_back( std::make_unique<GPUC_Blit>( src, dst, material ) );
+        if (src) m_resources.push_back( src );
+        if (dst) m_resources.push_back( dst );
+        m_resources.push_back( material );
+        _Record<GPUC_Blit>( src.get(), dst.get(), material.get() );
     }
 
     //----------------------------------------------------------------------
     void CommandBuffer::setScissor( const Math::Rect& rect )
     {
-        m_gpuCommands.push_back( std::make_unique<GPUC_SetScissor>( rect ) );
+        _Record<GPUC_SetScissor>( rect );
     }
 
     //----------------------------------------------------------------------
     void CommandBuffer::setCameraMatrix( CameraMember member, const DirectX::XMMATRIX& matrix )
     {
-        m_gpuCommands.push_back( std::make_unique<GPUC_SetCameraMatrix>( member, matrix ) );
+        _Record<GPUC_SetCameraMatrix>( member, matrix );
+    }
+
+    //**********************************************************************
+    // PRIVATE
+    //**********************************************************************
+
+    //----------------------------------------------------------------------
+    template <typename T, typename... Args>
+    T& CommandBuffer::_Record( Args&&... args )
+    {
+        static_assert( std::is_trivially_copyable<T>::value, "GPU commands are copied bytewise and must be trivially copyable." );
+        static_assert( alignof(T) <= COMMAND_BUFFER_ALIGNMENT, "GPU command exceeds the alignment of the command buffer." );
+
+        // Bump allocate the command at the end of the buffer
+        U32 offset = static_cast<U32>( m_data.size() * sizeof( Block ) );
+        m_data.resize( m_data.size() + (sizeof(T) + sizeof(Block) - 1) / sizeof(Block) );
+
+        T* command = new (_GetData() + offset) T( std::forward<Args>( args )... );
+        m_commands.push_back( offset );
+
+        return *command;
     }
 
 } // End namespaces
\ No newline at end of file
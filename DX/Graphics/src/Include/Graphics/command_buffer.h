@@ -8,13 +8,20 @@
     - Consists of arbitrary GPU commands
     - Can be passed to the renderer, who transform these calls to api
       dependant calls (and possibly do optimizations e.g. batch stuff)
+    - Commands are stored tightly packed in a linear chunk of memory,
+      which is reused after a reset. Sorting only moves the offsets.
+    @Considerations:
+      - Draw commands do NOT keep their mesh, material or bone matrices
+        alive. Those must outlive the execution of the command buffer.
+        All other resources are kept alive by the command buffer.
 **********************************************************************/
 
 #include "gpu_commands.hpp"
 
 namespace Graphics {
 
-    #define COMMAND_BUFFER_INITIAL_CAPACITY 128
+    #define COMMAND_BUFFER_INITIAL_CAPACITY 128 // Initial amount of commands
+    #define COMMAND_BUFFER_ALIGNMENT        16  // Alignment of every command, required by DirectX::XMMATRIX
 
     //**********************************************************************
     class CommandBuffer
@@ -31,9 +38,12 @@ namespace Graphics {
         //----------------------------------------------------------------------
         // Sort the draw commands in the most efficient way:
         //  - All drawLight() commands will come first
-        //  - All drawMesh() commands are sorted first by material (less state changes)
-        //    > second by camera distance if the material has possibly transparent rendercalls (determine by shaderqueue)
+        //  - All drawMesh() commands are sorted first by renderqueue
+        //    > then by shader, material and mesh (less state changes) and front to back
+        //    > or only back to front if the renderqueue is possibly transparent
         //  - It assumes every draw command is subsequently
+        // The shader/material part of the key is computed once when recording,
+        // the commands are then sorted with a radix sort over 64-Bit keys.
         //----------------------------------------------------------------------
         void sortDrawCommands(const Math::Vec3& camPos);
 
@@ -47,8 +57,27 @@ namespace Graphics {
         //----------------------------------------------------------------------
         void reset();
 
+        //----------------------------------------------------------------------
+        // @Return:
+        //  True, if both buffers contain bit for bit the same commands in the
+        //  same order, with the same camera matrices and resources.
+        //----------------------------------------------------------------------
+        bool isIdentical(const CommandBuffer& other) const;
+
+        //----------------------------------------------------------------------
+        // Access the recorded commands in their current order. Use getType()
+        // to determine which GPUC_* struct the command actually is.
+        //----------------------------------------------------------------------
+        U32                     getCommandCount()       const { return static_cast<U32>( m_commands.size() ); }
+        const GPUCommandBase&   getCommand(U32 index)   const { return *reinterpret_cast<const GPUCommandBase*>( _GetData() + m_commands[index] ); }
+
+        //----------------------------------------------------------------------
+        // @Return: The copy of the camera referenced by a SET_CAMERA command.
+        //          Renderers update its frame info, hence it is not const.
+        //----------------------------------------------------------------------
+        Camera*                 getCamera(U32 cameraIndex) const { return &m_cameras[cameraIndex]; }
+
         // <------------------------ GPU COMMANDS ----------------------------->
-        const ArrayList<std::shared_ptr<GPUCommandBase>>& getGPUCommands() const { return m_gpuCommands; }
         void drawMesh(const MeshPtr& mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex);
         void drawMeshInstanced(const MeshPtr& mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 instanceCount);
         void drawMeshSkinned(const MeshPtr& mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex, const ArrayList<DirectX::XMMATRIX>& matrixPalette);
@@ -66,7 +95,24 @@ namespace Graphics {
 
 
     private:
-        ArrayList<std::shared_ptr<GPUCommandBase>> m_gpuCommands;
+        struct alignas(COMMAND_BUFFER_ALIGNMENT) Block { Byte bytes[COMMAND_BUFFER_ALIGNMENT]; };
+
+        ArrayList<Block>                    m_data;         // Packed commands
+        ArrayList<U32>                      m_commands;     // Byte offset of each command into m_data, in execution order
+        mutable ArrayList<Camera>           m_cameras;      // Cameras copied by setCamera()
+        ArrayList<std::shared_ptr<void>>    m_resources;    // Keeps resources of non-draw commands alive
+
+        struct SortItem { U64 key; U32 offset; };
+        ArrayList<SortItem>                 m_sortItems;    // Scratch memory for sortDrawCommands()
+        ArrayList<SortItem>                 m_sortTemp;
+
+        //----------------------------------------------------------------------
+        template <typename T, typename... Args>
+        T& _Record(Args&&... args);
+
+        inline Byte*        _GetData()          { return reinterpret_cast<Byte*>( m_data.data() ); }
+        inline const Byte*  _GetData() const    { return reinterpret_cast<const Byte*>( m_data.data() ); }
+        inline GPUCommandBase& _GetCommand(U32 offset) { return *reinterpret_cast<GPUCommandBase*>( _GetData() + offset ); }
     };
 
 } // End namespaces
\ No newline at end of file
@@ -38,12 +38,16 @@ namespace Graphics {
         BLIT,
     };
 
+    //**********************************************************************
+    // All commands are plain old data. A command buffer copies them as is
+    // into its linear memory, so they reference resources only by raw
+    // pointers. Data which can't be stored that way (e.g. cameras) lives
+    // in the command buffer and is referenced by an index.
     //**********************************************************************
     struct GPUCommandBase
     {
     public:
         GPUCommandBase( GPUCommand type ) : m_type( type ) {}
-        virtual ~GPUCommandBase() = default;
 
         //----------------------------------------------------------------------
         GPUCommand  getType() const { return m_type; }
@@ -55,51 +59,54 @@ namespace Graphics {
     //**********************************************************************
     struct GPUC_DrawMesh : public GPUCommandBase
     {
-        GPUC_DrawMesh( const MeshPtr& mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex )
+        GPUC_DrawMesh( IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex )
             : GPUCommandBase( GPUCommand::DRAW_MESH ),
             material( material ), mesh( mesh ), modelMatrix( modelMatrix ), subMeshIndex( subMeshIndex ) {}
 
         DirectX::XMMATRIX   modelMatrix;
-        MeshPtr             mesh;
-        MaterialPtr         material;
+        IMesh*              mesh;
+        IMaterial*          material;
+        U64                 sortKey = 0; // Set by the command buffer
         I32                 subMeshIndex;
     };
 
     //**********************************************************************
     struct GPUC_DrawMeshInstanced : public GPUCommandBase
     {
-        GPUC_DrawMeshInstanced( const MeshPtr& mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 instanceCount )
+        GPUC_DrawMeshInstanced( IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& modelMatrix, I32 instanceCount )
             : GPUCommandBase( GPUCommand::DRAW_MESH_INSTANCED ),
             material( material ), mesh( mesh ), modelMatrix( modelMatrix ), instanceCount( instanceCount ) {}
 
         DirectX::XMMATRIX   modelMatrix;
-        MeshPtr             mesh;
-        MaterialPtr         material;
+        IMesh*              mesh;
+        IMaterial*          material;
+        U64                 sortKey = 0; // Set by the command buffer
         I32                 instanceCount;
     };
 
     //**********************************************************************
     struct GPUC_DrawMeshSkinned : public GPUCommandBase
     {
-        GPUC_DrawMeshSkinned( const MeshPtr& mesh, const MaterialPtr& material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex, const ArrayList<DirectX::XMMATRIX>& matrixPalette )
+        GPUC_DrawMeshSkinned( IMesh* mesh, IMaterial* material, const DirectX::XMMATRIX& modelMatrix, I32 subMeshIndex, const ArrayList<DirectX::XMMATRIX>* matrixPalette )
             : GPUCommandBase( GPUCommand::DRAW_MESH_SKINNED ),
             material( material ), mesh( mesh ), modelMatrix( modelMatrix ), subMeshIndex( subMeshIndex ), matrixPalette( matrixPalette ) {}
 
         DirectX::XMMATRIX                   modelMatrix;
-        MeshPtr                             mesh;
-        MaterialPtr                         material;
+        IMesh*                              mesh;
+        IMaterial*                          material;
+        U64                                 sortKey = 0; // Set by the command buffer
         I32                                 subMeshIndex;
-        const ArrayList<DirectX::XMMATRIX>& matrixPalette;
+        const ArrayList<DirectX::XMMATRIX>* matrixPalette;
     };
 
     //**********************************************************************
     struct GPUC_SetCamera : public GPUCommandBase
     {
-        GPUC_SetCamera( const Camera& camera )
+        GPUC_SetCamera( U32 cameraIndex )
             : GPUCommandBase( GPUCommand::SET_CAMERA ), 
-            camera( camera ) {}
+            cameraIndex( cameraIndex ) {}
 
-        Camera camera;
+        U32 cameraIndex; // Index of the camera copy in the command buffer
     };
 
     //**********************************************************************
@@ -112,12 +119,12 @@ namespace Graphics {
     //**********************************************************************
     struct GPUC_CopyTexture : public GPUCommandBase
     {
-        GPUC_CopyTexture(const TexturePtr& srcTex, I32 srcElement, I32 srcMip, const TexturePtr& dstTex, I32 dstElement, I32 dstMip)
+        GPUC_CopyTexture(ITexture* srcTex, I32 srcElement, I32 srcMip, ITexture* dstTex, I32 dstElement, I32 dstMip)
             : GPUCommandBase( GPUCommand::COPY_TEXTURE ), 
             srcTex( srcTex ), srcElement(srcElement ), srcMip( srcMip ), dstTex( dstTex ), dstElement( dstElement ), dstMip( dstMip ){}
 
-        TexturePtr  srcTex;
-        TexturePtr  dstTex;
+        ITexture*   srcTex;
+        ITexture*   dstTex;
         I32         srcElement, dstElement, srcMip, dstMip;
     };
 
@@ -134,45 +141,45 @@ namespace Graphics {
     //**********************************************************************
     struct GPUC_SetRenderTarget : public GPUCommandBase
     {
-        GPUC_SetRenderTarget(const RenderTexturePtr& target )
+        GPUC_SetRenderTarget(IRenderTexture* target )
             : GPUCommandBase( GPUCommand::SET_RENDER_TARGET ),
             target( target ) {}
 
-        const RenderTexturePtr  target;
+        IRenderTexture* target;
     };
 
     //**********************************************************************
     struct GPUC_DrawFullscreenQuad : public GPUCommandBase
     {
-        GPUC_DrawFullscreenQuad( const MaterialPtr& material )
+        GPUC_DrawFullscreenQuad( IMaterial* material )
             : GPUCommandBase( GPUCommand::DRAW_FULLSCREEN_QUAD ),
             material( material ) {}
 
-        const MaterialPtr material;
+        IMaterial* material;
     };
 
     //**********************************************************************
     struct GPUC_RenderCubemap : public GPUCommandBase
     {
-        GPUC_RenderCubemap( const CubemapPtr& cubemap, const MaterialPtr& material, I32 dstMip )
+        GPUC_RenderCubemap( ICubemap* cubemap, IMaterial* material, I32 dstMip )
             : GPUCommandBase( GPUCommand::RENDER_CUBEMAP ),
             cubemap( cubemap ), material( material ), dstMip( dstMip ) {}
 
-        const CubemapPtr  cubemap;
-        const MaterialPtr material;
-        I32               dstMip;
+        ICubemap*   cubemap;
+        IMaterial*  material;
+        I32         dstMip;
     };
 
     //**********************************************************************
     struct GPUC_Blit : public GPUCommandBase
     {
-        GPUC_Blit( const RenderTexturePtr& src, const RenderTexturePtr& dst, const MaterialPtr& material )
+        GPUC_Blit( IRenderTexture* src, IRenderTexture* dst, IMaterial* material )
             : GPUCommandBase( GPUCommand::BLIT ),
             src( src ), dst( dst ), material( material ) {}
 
-        const RenderTexturePtr  src;
-        const RenderTexturePtr  dst;
-        const MaterialPtr       material;
+        IRenderTexture* src;
+        IRenderTexture* dst;
+        IMaterial*      material;
     };
 
     //**********************************************************************
@@ -182,7 +189,7 @@ namespace Graphics {
             : GPUCommandBase( GPUCommand::SET_SCISSOR ),
             rect( rect ) {}
 
-        const Math::Rect rect;
+        Math::Rect rect;
     };
 
     //**********************************************************************
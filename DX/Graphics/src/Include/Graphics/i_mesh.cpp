@@ -7,6 +7,7 @@
 **********************************************************************/
 
 #include "Logging/logging.h"
+#include "OS/Threading/parallel.hpp"
 
 namespace Graphics {
 
@@ -217,12 +218,15 @@ namespace Graphics {
     }
 
     //----------------------------------------------------------------------
-    void IMesh::recalculateNormals()
+    void IMesh::recalculateNormals( OS::ThreadPool* threadPool )
     {
+        const I64 GRAIN_SIZE = 4096;
+
         const auto& vertices = getVertexPositions();
         ArrayList<Math::Vec3> normals( vertices.size(), Math::Vec3( 0.0f ) );
 
-        // Calculate normals
+        // Gather the triangles of all submeshes
+        ArrayList<U32> indices;
         for (auto& subMesh : m_subMeshes)
         {
             if (subMesh.topology != MeshTopology::Triangles)
@@ -230,30 +234,41 @@ namespace Graphics {
                 LOG_WARN_RENDERING( "IMesh::recalculateNormals(): Normal recalculation not supported for this (sub)mesh topology!" );
                 continue;
             }
-
-            for (I32 i = 0; i < subMesh.indices.size(); i += 3)
-            {
-                U32 index0 = subMesh.indices[ i + 0 ];
-                U32 index1 = subMesh.indices[ i + 1 ];
-                U32 index2 = subMesh.indices[ i + 2 ];
-
-                auto vert0 = vertices[ index0 ];
-                auto vert1 = vertices[ index1 ];
-                auto vert2 = vertices[ index2 ];
-
-                auto edge0 = vert1 - vert0;
-                auto edge1 = vert2 - vert0;
-
-                auto normal = edge0.cross( edge1 );
-
-                normals[ index0 ] += normal;
-                normals[ index1 ] += normal;
-                normals[ index2 ] += normal;
-            }
+            indices.insert( indices.end(), subMesh.indices.begin(), subMesh.indices.end() );
         }
-
-        for (I32 i = 0; i < normals.size(); i++)
-            normals[i].normalize();
+        I64 numTriangles = static_cast<I64>( indices.size() / 3 );
+
+        // Calculate face normals
+        ArrayList<Math::Vec3> faceNormals( numTriangles );
+        OS::ParallelFor( threadPool, 0, numTriangles, [&](I64 triangle) {
+            auto vert0 = vertices[ indices[ triangle * 3 + 0 ] ];
+            auto vert1 = vertices[ indices[ triangle * 3 + 1 ] ];
+            auto vert2 = vertices[ indices[ triangle * 3 + 2 ] ];
+
+            auto edge0 = vert1 - vert0;
+            auto edge1 = vert2 - vert0;
+
+            faceNormals[triangle] = edge0.cross( edge1 );
+        }, GRAIN_SIZE );
+
+        // List the triangles of every vertex (counting sort, keeps the triangle order)
+        ArrayList<U32> firstTriangle( vertices.size() + 1, 0 );
+        for (U32 index : indices)
+            firstTriangle[index + 1]++;
+        for (Size i = 1; i < firstTriangle.size(); i++)
+            firstTriangle[i] += firstTriangle[i - 1];
+
+        ArrayList<U32> vertexTriangles( indices.size() );
+        ArrayList<U32> cursor( firstTriangle.begin(), firstTriangle.end() - 1 );
+        for (Size i = 0; i < indices.size(); i++)
+            vertexTriangles[cursor[indices[i]]++] = static_cast<U32>( i / 3 );
+
+        // Every vertex sums the normals of its triangles in triangle order, so the result does not depend on the thread count
+        OS::ParallelFor( threadPool, 0, static_cast<I64>( vertices.size() ), [&](I64 vertex) {
+            for (U32 i = firstTriangle[vertex]; i < firstTriangle[vertex + 1]; i++)
+                normals[vertex] += faceNormals[vertexTriangles[i]];
+            normals[vertex].normalize();
+        }, GRAIN_SIZE );
 
         setNormals( normals );
     }
@@ -15,6 +15,8 @@
 #include "vertex_layout.hpp"
 #include "Math/aabb.h"
 
+namespace OS { class ThreadPool; }
+
 namespace Graphics {
 
     class IShader;
@@ -168,8 +170,11 @@ namespace Graphics {
 
         //----------------------------------------------------------------------
         // Recalculates the normals from the vertices
+        // @Params:
+        //  "threadPool": If not null, large meshes are processed by the workers
+        //                of this pool. The result is the same in both cases.
         //----------------------------------------------------------------------
-        void recalculateNormals();
+        void recalculateNormals(OS::ThreadPool* threadPool = nullptr);
 
         //----------------------------------------------------------------------
         // Recalculates the tangents from the vertices and uvs
@@ -33,7 +33,12 @@ namespace Graphics {
     void IRenderer::dispatch( const CommandBuffer& cmd )
     {
         _LockQueue();
-        m_pendingCmdQueue.push_back( cmd );
+        {
+            // Copy into a command buffer of a previous frame, so its memory can be reused
+            if (m_pendingCmdCount == m_pendingCmdQueue.size())
+                m_pendingCmdQueue.emplace_back();
+            m_pendingCmdQueue[m_pendingCmdCount++].merge( cmd );
+        }
         _UnlockQueue();
     }
 
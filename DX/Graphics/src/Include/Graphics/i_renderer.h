@@ -98,7 +98,8 @@ namespace Graphics {
     protected:
         U64                         m_frameCount = 0;
         OS::Window*                 m_window;
-        ArrayList<CommandBuffer>    m_pendingCmdQueue;
+        ArrayList<CommandBuffer>    m_pendingCmdQueue;      // Reused every frame, only the first "m_pendingCmdCount" are valid
+        Size                        m_pendingCmdCount = 0;
         Limits                      m_limits;
         bool                        m_vsync = false;
         GPUDescription              m_gpuDescription;
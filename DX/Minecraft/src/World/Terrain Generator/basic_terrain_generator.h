@@ -1,7 +1,8 @@
 #pragma once
 
 #include "terrain_generator.h"
-#include "perlin_noise.h"
+#include "terrain_noise.h"
+#include "chunk_random.h"
 
 #define BLOCK_OAK_LEAVES    Block("oak_leaves")
 #define BLOCK_OAK           Block("oak")
@@ -9,8 +10,6 @@
 #define BLOCK_BIRCH         Block("birch")
 #define BLOCK_GRASS         Block("grass")
 
-#define BIOME_TRANSITION_WIDTH 3
-
 
 //----------------------------------------------------------------------
 void _Fill(Chunk& chunk, I32 y, I32 xBegin, I32 xEnd, I32 zBegin, I32 zEnd, Block block)
@@ -20,9 +19,9 @@ void _Fill(Chunk& chunk, I32 y, I32 xBegin, I32 xEnd, I32 zBegin, I32 zEnd, Bloc
             chunk.setVoxelAt(x, y, z, block);
 }
 //----------------------------------------------------------------------
-void _MakeTree(Chunk& chunk, I32 x, I32 y, I32 z, Block log, Block leaves)
+void _MakeTree(Chunk& chunk, I32 x, I32 y, I32 z, Block log, Block leaves, ChunkRandom& random)
 {
-    I32 h = Math::Random::Int(4, 7);
+    I32 h = random.Int(4, 7);
     I32 leafSize = 2;
     I32 newY = h + y;
 
@@ -49,21 +48,16 @@ struct TerrainType
 class Biome
 {
 public:
-    Biome(I32 seed, NoiseParams params, F32 elevation) : m_seed(seed), m_noiseParams(params), m_elevation(elevation) {}
+    Biome(F32 elevation) : m_elevation(elevation) {}
 
-    virtual void generateTerrainFor(Chunk& chunk, I32 x, I32 height, I32 z) = 0;
+    // "random": Random numbers of the chunk. Must be the only source of randomness, so chunks are reproducible.
+    virtual void generateTerrainFor(Chunk& chunk, I32 x, I32 height, I32 z, ChunkRandom& random) = 0;
 
-    I32 getHeight(I32 x, I32 z, const Math::Vec2Int& pos)
-    {
-        PerlinNoise noiseMap(m_seed, m_noiseParams);
-        F32 noiseValue = noiseMap.get(x, z, pos);
-        return I32(noiseValue * m_elevation);
-    }
+    // The height noise of a biome is evaluated by the TerrainNoise
+    F32 getElevation() const { return m_elevation; }
 
 protected:
-    I32                     m_seed;
     F32                     m_elevation;
-    NoiseParams             m_noiseParams;
     ArrayList<TerrainType>  m_regions;
 
     //----------------------------------------------------------------------
@@ -80,16 +74,16 @@ protected:
 class ForestBiome : public Biome
 {
 public:
-    ForestBiome(I32 seed, NoiseParams params, F32 height) : Biome(seed, params, height)
+    ForestBiome(F32 height) : Biome(height)
     {
         m_regions.push_back(TerrainType{ 0.1f, Block("sand") });
         m_regions.push_back(TerrainType{ 0.12f, Block("gravel") });
         m_regions.push_back(TerrainType{ 2.0f, Block("dirt") });
     }
 
-    void generateTerrainFor(Chunk& chunk, I32 x, I32 height, I32 z) override
+    void generateTerrainFor(Chunk& chunk, I32 x, I32 height, I32 z, ChunkRandom& random) override
     {
-        I32 clampedHeight = Math::Clamp(height, -CHUNK_HEIGHT, CHUNK_HEIGHT);
+        I32 clampedHeight = Math::Clamp(height, -CHUNK_HEIGHT, CHUNK_HEIGHT - 1);
 
         F32 noiseValue = clampedHeight / m_elevation;
         Block block = _GetBlockFromHeight(noiseValue);
@@ -107,12 +101,12 @@ public:
         bool notAtEdge = x > 2 && x < CHUNK_SIZE - 2 && z > 2 && z < CHUNK_SIZE - 2;
         if (block == Block("dirt") && notAtEdge)
         {
-            if (Math::Random::Int(0, 30) == 0)
+            if (random.Int(0, 30) == 0)
             {
-                if (Math::Random::Int(1) == 0)
-                    _MakeTree(chunk, x, clampedHeight + 1, z, BLOCK_OAK, BLOCK_OAK_LEAVES);
+                if (random.Int(1) == 0)
+                    _MakeTree(chunk, x, clampedHeight + 1, z, BLOCK_OAK, BLOCK_OAK_LEAVES, random);
                 else
-                    _MakeTree(chunk, x, clampedHeight + 1, z, BLOCK_BIRCH, BLOCK_BIRCH_LEAVES);
+                    _MakeTree(chunk, x, clampedHeight + 1, z, BLOCK_BIRCH, BLOCK_BIRCH_LEAVES, random);
             }
         }
     }
@@ -122,14 +116,14 @@ public:
 class DesertBiome : public Biome
 {
 public:
-    DesertBiome(I32 seed, NoiseParams params, F32 height) : Biome(seed, params, height)
+    DesertBiome(F32 height) : Biome(height)
     {
         m_regions.push_back(TerrainType{ 2.0f, Block("sand") });
     }
 
-    void generateTerrainFor(Chunk& chunk, I32 x, I32 height, I32 z) override
+    void generateTerrainFor(Chunk& chunk, I32 x, I32 height, I32 z, ChunkRandom& random) override
     {
-        I32 clampedHeight = Math::Clamp(height, -CHUNK_HEIGHT, CHUNK_HEIGHT);
+        I32 clampedHeight = Math::Clamp(height, -CHUNK_HEIGHT, CHUNK_HEIGHT - 1);
 
         F32 noiseValue = clampedHeight / m_elevation;
         Block block = _GetBlockFromHeight(noiseValue);
@@ -140,9 +134,9 @@ public:
         bool notAtEdge = x > 1 && x < CHUNK_SIZE - 1 && z > 1 && z < CHUNK_SIZE - 1;
         if (notAtEdge && clampedHeight > (WATER_LEVEL + 1))
         {
-            if (Math::Random::Int(0, 500) == 0)
+            if (random.Int(0, 500) == 0)
             {
-                I32 cactusHeight = Math::Random::Int(3,5);
+                I32 cactusHeight = random.Int(3,5);
                 for (I32 cacY = clampedHeight; cacY < clampedHeight + cactusHeight; cacY++)
                     chunk.setVoxelAt(x, cacY, z, Block("cactus"));
             }
@@ -154,7 +148,7 @@ public:
 class HillsBiome : public Biome
 {
 public:
-    HillsBiome(I32 seed, NoiseParams params, F32 height) : Biome(seed, params, height)
+    HillsBiome(F32 height) : Biome(height)
     {
         m_regions.push_back(TerrainType{ 0.15f, Block("gravel") });
         m_regions.push_back(TerrainType{ 0.25f, Block("dirt") });
@@ -162,9 +156,9 @@ public:
         m_regions.push_back(TerrainType{ 2.0f, Block("snow") });
     }
 
-    void generateTerrainFor(Chunk& chunk, I32 x, I32 height, I32 z) override
+    void generateTerrainFor(Chunk& chunk, I32 x, I32 height, I32 z, ChunkRandom& random) override
     {
-        I32 clampedHeight = Math::Clamp(height, -CHUNK_HEIGHT, CHUNK_HEIGHT);
+        I32 clampedHeight = Math::Clamp(height, -CHUNK_HEIGHT, CHUNK_HEIGHT - 1);
 
         F32 noiseValue = clampedHeight / m_elevation;
         Block block = _GetBlockFromHeight(noiseValue);
@@ -176,85 +170,58 @@ public:
 //**********************************************************************
 class BasicTerrainGenerator : public TerrainGenerator
 {
-    NoiseParams m_biomeParams;
     I32 m_seed;
 
     F32 m_terrainHeight = 50.0f;
     ArrayList<std::shared_ptr<Biome>> m_biomes;
+    std::unique_ptr<TerrainNoise> m_terrainNoise;
 
 public:
     BasicTerrainGenerator(I32 seed) : m_seed(seed)
     {
         Core::Config::ConfigFile terrain("res/terrain.ini");
-        m_biomeParams.scale       = terrain["Biomes"]["scale"];
-        m_biomeParams.lacunarity  = terrain["Biomes"]["lacunarity"];
-        m_biomeParams.gain        = terrain["Biomes"]["gain"];
-        m_biomeParams.octaves     = terrain["Biomes"]["octaves"];
-
-        NoiseParams forestParams;
-        forestParams.scale       = terrain["Forest"]["scale"];
-        forestParams.lacunarity  = terrain["Forest"]["lacunarity"];
-        forestParams.gain        = terrain["Forest"]["gain"];
-        forestParams.octaves     = terrain["Forest"]["octaves"];
-        m_biomes.push_back(std::make_shared<ForestBiome>(m_seed, forestParams, terrain["Forest"]["elevation"]));
-
-        NoiseParams desertParams;
-        desertParams.scale       = terrain["Desert"]["scale"];
-        desertParams.lacunarity  = terrain["Desert"]["lacunarity"];
-        desertParams.gain        = terrain["Desert"]["gain"];
-        desertParams.octaves     = terrain["Desert"]["octaves"];
-        m_biomes.push_back(std::make_shared<DesertBiome>(m_seed, desertParams, terrain["Desert"]["elevation"]));
-
-        NoiseParams hillParams;
-        hillParams.scale      = terrain["Hills"]["scale"];
-        hillParams.lacunarity = terrain["Hills"]["lacunarity"];
-        hillParams.gain       = terrain["Hills"]["gain"];
-        hillParams.octaves    = terrain["Hills"]["octaves"];
-        m_biomes.push_back(std::make_shared<HillsBiome>(m_seed, hillParams, terrain["Hills"]["elevation"]));
+        m_terrainNoise = std::make_unique<TerrainNoise>(m_seed, _ReadNoiseParams(terrain, "Biomes"));
+
+        m_biomes.push_back(std::make_shared<ForestBiome>(terrain["Forest"]["elevation"]));
+        m_terrainNoise->addBiome(_ReadNoiseParams(terrain, "Forest"), m_biomes.back()->getElevation());
+
+        m_biomes.push_back(std::make_shared<DesertBiome>(terrain["Desert"]["elevation"]));
+        m_terrainNoise->addBiome(_ReadNoiseParams(terrain, "Desert"), m_biomes.back()->getElevation());
+
+        m_biomes.push_back(std::make_shared<HillsBiome>(terrain["Hills"]["elevation"]));
+        m_terrainNoise->addBiome(_ReadNoiseParams(terrain, "Hills"), m_biomes.back()->getElevation());
     }
 
     void generateTerrainFor(Chunk& chunk) override
     {
-        static const I32 NUM_SAMPLES = (BIOME_TRANSITION_WIDTH + BIOME_TRANSITION_WIDTH + 1) *
-                                       (BIOME_TRANSITION_WIDTH + BIOME_TRANSITION_WIDTH + 1);
         //DEBUG.drawCube(chunk.bounds, Color::GREEN, 20000);
 
-        // Noise must be larger, so it fills the boundary blocks aswell, otherwise the mesh will contain holes
-        PerlinNoise noiseMap( m_seed, m_biomeParams );
-        for (I32 x = 0; x < CHUNK_SIZE + 1; x++)
+        // Biomes and smoothly blended heights for the chunk including its boundary blocks
+        TerrainNoise::ColumnGrid columns;
+        m_terrainNoise->computeColumns( chunk.position, columns );
+
+        // Columns are visited in a fixed order, so the chunk gets the same numbers every time
+        ChunkRandom random( m_seed, chunk.getChunkCoords() );
+
+        for (I32 x = 0; x < TerrainNoise::NUM_COLUMNS; x++)
         {
-            for (I32 z = 0; z < CHUNK_SIZE + 1; z++)
+            for (I32 z = 0; z < TerrainNoise::NUM_COLUMNS; z++)
             {
-                // Smooth transition between biomes must be calculated here
-                I32 height = 0;
-                for (I32 i = x - BIOME_TRANSITION_WIDTH; i < x + BIOME_TRANSITION_WIDTH; i++)
-                {
-                    for (I32 j = z - BIOME_TRANSITION_WIDTH; j < z + BIOME_TRANSITION_WIDTH; j++)
-                    {
-                        auto& biome = _GetBiome( i, j, chunk.position );
-                        height += biome.getHeight( i, j, chunk.position );
-                    }
-                }
-                height /= NUM_SAMPLES;
-
-                auto& biome = _GetBiome( x, z, chunk.position );
-                biome.generateTerrainFor( chunk, x, height, z );
+                auto& column = columns[x + z * TerrainNoise::NUM_COLUMNS];
+                m_biomes[column.biome]->generateTerrainFor( chunk, x, column.height, z, random );
             }
         }
     }
 
 private:
     //----------------------------------------------------------------------
-    Biome& _GetBiome(I32 x, I32 z, const Math::Vec2Int& pos)
+    static NoiseParams _ReadNoiseParams(Core::Config::ConfigFile& terrain, const char* section)
     {
-        PerlinNoise noiseMap( m_seed, m_biomeParams );
-
-        F32 noiseValue = noiseMap.get(x, z, pos);
-        F32 steps = 1.0f / m_biomes.size();
-
-        // Every biome is equally likely
-        I32 index = I32(noiseValue / steps);
-        index = Math::Clamp(index, 0, m_biomes.size() - 1);
-        return *m_biomes[index].get();
+        NoiseParams params;
+        params.scale       = terrain[section]["scale"];
+        params.lacunarity  = terrain[section]["lacunarity"];
+        params.gain        = terrain[section]["gain"];
+        params.octaves     = terrain[section]["octaves"];
+        return params;
     }
 };
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+/**********************************************************************
+    class: ChunkRandom (chunk_random.h)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Counter-based random numbers for world generation. The n-th number
+    of a chunk is a hash of (world seed, chunk coordinates, n), so a
+    chunk always gets the same numbers no matter in which order or on
+    which thread chunks are generated. The hash is the SplitMix64
+    finalizer.
+    @Considerations:
+      - Not thread-safe, but cheap to create. Every generation of a
+        chunk creates its own instance.
+**********************************************************************/
+#include "Common/data_types.hpp"
+#include "Math/dxmath_wrapper.h"
+
+//**********************************************************************
+class ChunkRandom
+{
+public:
+    //----------------------------------------------------------------------
+    // @Params:
+    //  "seed": Seed of the world.
+    //  "chunkCoords": Chunk coordinates, not world coordinates.
+    //----------------------------------------------------------------------
+    ChunkRandom(I32 seed, const Math::Vec2Int& chunkCoords)
+        : m_key( _Mix( _Mix( static_cast<U32>( seed ) ) ^ (static_cast<U64>( static_cast<U32>( chunkCoords.x ) ) << 32 | static_cast<U32>( chunkCoords.y )) ) ) {}
+
+    // @Return: The next random 32 bit number of this chunk
+    U32 next() { return static_cast<U32>( at( m_counter++ ) >> 32 ); }
+
+    // @Return: Random integer between [min,max]. Same range as Math::Random::Int().
+    I32 Int(I32 min, I32 max)
+    {
+        U64 range = static_cast<U64>( static_cast<I64>( max ) - min + 1 );
+        return static_cast<I32>( min + static_cast<I64>( (next() * range) >> 32 ) );
+    }
+
+    // @Return: Random integer between [0,max]
+    I32 Int(I32 max) { return Int( 0, max ); }
+
+    //----------------------------------------------------------------------
+    // @Return: The "index"-th 64 bit number of this chunk. Does not advance the counter.
+    //----------------------------------------------------------------------
+    U64 at(U64 index) const { return _Mix( m_key + (index + 1) * GOLDEN_GAMMA ); }
+
+private:
+    static const U64 GOLDEN_GAMMA = 0x9E3779B97F4A7C15ull;
+
+    U64 m_key;
+    U64 m_counter = 0;
+
+    //----------------------------------------------------------------------
+    static U64 _Mix(U64 z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
\ No newline at end of file
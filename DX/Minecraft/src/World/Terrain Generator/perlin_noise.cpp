@@ -8,16 +8,53 @@
 PerlinNoise::PerlinNoise(I32 seed, const NoiseParams& params)
     : m_seed(seed), m_params(params)
 {
+    m_scale = m_params.scale < 0.0f ? 0.0001f : m_params.scale;
+
+    // Same accumulation as in stb_perlin_turbulence_noise3(), so every octave samples the same positions
+    F32 frequency = 1.0f;
+    F32 amplitude = 1.0f;
+    for (I32 i = 0; i < m_params.octaves; i++)
+    {
+        m_frequencies.push_back(frequency);
+        m_amplitudes.push_back(amplitude);
+        frequency *= m_params.lacunarity;
+        amplitude *= m_params.gain;
+    }
 }
 
 F32 PerlinNoise::get(I32 x, I32 y, const Math::Vec2Int& offset) const
 {
-    F32 scale = m_params.scale < 0.0f ? 0.0001f : m_params.scale;
+    F32 sampleX = (m_seed + x + offset.x) / m_scale;
+    F32 sampleY = (m_seed + y + offset.y) / m_scale;
+
+    return _Turbulence(sampleX, sampleY);
+}
 
-    F32 sampleX = (m_seed + x + offset.x) / scale;
-    F32 sampleY = (m_seed + y + offset.y) / scale;
+void PerlinNoise::getGrid(I32 x, I32 y, I32 width, I32 height, const Math::Vec2Int& offset, F32* out) const
+{
+    ArrayList<F32> samplesX(width);
+    for (I32 i = 0; i < width; i++)
+        samplesX[i] = (m_seed + x + i + offset.x) / m_scale;
 
-    F32 noiseValue = stb_perlin_turbulence_noise3(sampleX, sampleY, 0.0f, m_params.lacunarity, m_params.gain, m_params.octaves, 0, 0, 0);
+    for (I32 j = 0; j < height; j++)
+    {
+        F32 sampleY = (m_seed + y + j + offset.y) / m_scale;
+        for (I32 i = 0; i < width; i++)
+            out[i + j * width] = _Turbulence(samplesX[i], sampleY);
+    }
+}
+
+F32 PerlinNoise::_Turbulence(F32 sampleX, F32 sampleY) const
+{
+    F32 sum = 0.0f;
+    F32 noise = 0.0f;
+    for (I32 i = 0; i < m_params.octaves; i++)
+    {
+        if (i == 0 || m_frequencies[i] != m_frequencies[i - 1])
+            noise = stb_perlin_noise3(sampleX * m_frequencies[i], sampleY * m_frequencies[i], 0.0f, 0, 0, 0);
 
-    return noiseValue;
+        F32 r = noise * m_amplitudes[i];
+        sum += r < 0 ? -r : r;
+    }
+    return sum;
 }
\ No newline at end of file
@@ -12,6 +12,12 @@ struct NoiseParams
     I32 octaves;
 };
 
+//**********************************************************************
+// Turbulence noise (sum of absolute perlin octaves) in the xy-plane.
+// Returns exactly the values of stb_perlin_turbulence_noise3(), but
+// evaluates an octave only once if its frequency equals the previous
+// one (lacunarity of 1).
+//**********************************************************************
 class PerlinNoise
 {
 public:
@@ -20,7 +26,21 @@ public:
 
     F32 get(I32 x, I32 y, const Math::Vec2Int& offset) const;
 
+    //----------------------------------------------------------------------
+    // Evaluates the noise for a whole grid in one call.
+    // @Params:
+    //  "x", "y": First sample, same coordinates as in get().
+    //  "width", "height": Number of samples in x and y.
+    //  "out": Receives width * height values, x first, then y.
+    //----------------------------------------------------------------------
+    void getGrid(I32 x, I32 y, I32 width, I32 height, const Math::Vec2Int& offset, F32* out) const;
+
 private:
-    NoiseParams m_params;
-    I32         m_seed;
+    NoiseParams     m_params;
+    I32             m_seed;
+    F32             m_scale;
+    ArrayList<F32>  m_frequencies;
+    ArrayList<F32>  m_amplitudes;
+
+    F32 _Turbulence(F32 sampleX, F32 sampleY) const;
 };
\ No newline at end of file
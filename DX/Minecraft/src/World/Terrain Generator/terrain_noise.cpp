@@ -0,0 +1,97 @@
+#include "terrain_noise.h"
+/**********************************************************************
+    class: TerrainNoise (terrain_noise.cpp)
+
+    author: S. Hau
+    date: October 17, 2026
+**********************************************************************/
+
+#include "Math/math_utils.h"
+
+//**********************************************************************
+// PUBLIC
+//**********************************************************************
+
+//----------------------------------------------------------------------
+void TerrainNoise::addBiome( const NoiseParams& params, F32 elevation )
+{
+    m_biomes.push_back( BiomeNoise{ PerlinNoise( m_seed, params ), elevation } );
+}
+
+//----------------------------------------------------------------------
+void TerrainNoise::computeColumns( const Math::Vec2Int& chunkPosition, ColumnGrid& columns ) const
+{
+    // The blend window of column x covers the samples [x - BIOME_TRANSITION_WIDTH, x + BIOME_TRANSITION_WIDTH)
+    static const I32 WINDOW_SIZE = 2 * BIOME_TRANSITION_WIDTH;
+    static const I32 GRID_SIZE = NUM_COLUMNS + WINDOW_SIZE - 1;
+    static const I32 NUM_SAMPLES = (2 * BIOME_TRANSITION_WIDTH + 1) * (2 * BIOME_TRANSITION_WIDTH + 1);
+
+    std::array<F32, GRID_SIZE * GRID_SIZE> noise;
+    m_biomeNoise.getGrid( -BIOME_TRANSITION_WIDTH, -BIOME_TRANSITION_WIDTH, GRID_SIZE, GRID_SIZE, chunkPosition, noise.data() );
+
+    std::array<I32, GRID_SIZE * GRID_SIZE> biomes;
+    for (I32 i = 0; i < GRID_SIZE * GRID_SIZE; i++)
+        biomes[i] = _GetBiomeIndex( noise[i] );
+
+    // Only biomes present in the grid are evaluated, mostly just one
+    std::array<I32, GRID_SIZE * GRID_SIZE> heights;
+    for (I32 biome = 0; biome < getBiomeCount(); biome++)
+    {
+        if ( std::find( biomes.begin(), biomes.end(), biome ) == biomes.end() )
+            continue;
+
+        auto& biomeNoise = m_biomes[biome];
+        biomeNoise.noise.getGrid( -BIOME_TRANSITION_WIDTH, -BIOME_TRANSITION_WIDTH, GRID_SIZE, GRID_SIZE, chunkPosition, noise.data() );
+        for (I32 i = 0; i < GRID_SIZE * GRID_SIZE; i++)
+            if (biomes[i] == biome)
+                heights[i] = I32( noise[i] * biomeNoise.elevation );
+    }
+
+    // Summed area table, so every window sum takes 4 lookups
+    std::array<I32, (GRID_SIZE + 1) * (GRID_SIZE + 1)> sums;
+    auto sum = [&](I32 x, I32 z) -> I32& { return sums[x + z * (GRID_SIZE + 1)]; };
+    for (I32 i = 0; i <= GRID_SIZE; i++)
+        sum( i, 0 ) = sum( 0, i ) = 0;
+    for (I32 z = 0; z < GRID_SIZE; z++)
+        for (I32 x = 0; x < GRID_SIZE; x++)
+            sum( x + 1, z + 1 ) = heights[x + z * GRID_SIZE] + sum( x, z + 1 ) + sum( x + 1, z ) - sum( x, z );
+
+    for (I32 z = 0; z < NUM_COLUMNS; z++)
+    {
+        for (I32 x = 0; x < NUM_COLUMNS; x++)
+        {
+            I32 windowSum = sum( x + WINDOW_SIZE, z + WINDOW_SIZE ) - sum( x, z + WINDOW_SIZE ) - sum( x + WINDOW_SIZE, z ) + sum( x, z );
+
+            // Divided by more samples than the window contains, this flattens the terrain slightly
+            auto& column = columns[x + z * NUM_COLUMNS];
+            column.height = windowSum / NUM_SAMPLES;
+            column.biome = biomes[(x + BIOME_TRANSITION_WIDTH) + (z + BIOME_TRANSITION_WIDTH) * GRID_SIZE];
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+I32 TerrainNoise::getBiome( I32 x, I32 z, const Math::Vec2Int& chunkPosition ) const
+{
+    return _GetBiomeIndex( m_biomeNoise.get( x, z, chunkPosition ) );
+}
+
+//----------------------------------------------------------------------
+I32 TerrainNoise::getHeight( I32 biome, I32 x, I32 z, const Math::Vec2Int& chunkPosition ) const
+{
+    auto& biomeNoise = m_biomes[biome];
+    return I32( biomeNoise.noise.get( x, z, chunkPosition ) * biomeNoise.elevation );
+}
+
+//**********************************************************************
+// PRIVATE
+//**********************************************************************
+
+//----------------------------------------------------------------------
+I32 TerrainNoise::_GetBiomeIndex( F32 noiseValue ) const
+{
+    F32 steps = 1.0f / m_biomes.size();
+
+    I32 index = I32( noiseValue / steps );
+    return Math::Clamp( index, 0, getBiomeCount() - 1 );
+}
@@ -0,0 +1,74 @@
+#pragma once
+/**********************************************************************
+    class: TerrainNoise (terrain_noise.h)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Noise stage of the BasicTerrainGenerator. Selects a biome for every
+    column of a chunk and blends the biome heights in a window around
+    it, so biomes transition smoothly.
+    @Considerations:
+      - Every noise object is built once. A chunk evaluates each sample
+        of its blend windows once and shares it across all windows,
+        instead of 36 biome and height queries per column.
+      - Thread-safe, generation jobs share one instance.
+**********************************************************************/
+#include "perlin_noise.h"
+#include "../world_constants.h"
+#include <array>
+#include <algorithm>
+
+#define BIOME_TRANSITION_WIDTH 3
+
+//**********************************************************************
+class TerrainNoise
+{
+public:
+    // Columns of a chunk plus the border columns, otherwise the mesh will contain holes
+    static const I32 NUM_COLUMNS = CHUNK_SIZE + 1;
+
+    struct Column
+    {
+        I32 biome;
+        I32 height;
+    };
+    using ColumnGrid = std::array<Column, NUM_COLUMNS * NUM_COLUMNS>;
+
+    TerrainNoise(I32 seed, const NoiseParams& biomeParams) : m_seed(seed), m_biomeNoise(seed, biomeParams) {}
+
+    //----------------------------------------------------------------------
+    // Biomes are selected by index in the order they were added, every biome is equally likely.
+    // @Params:
+    //  "elevation": Height of the terrain at a noise value of 1.
+    //----------------------------------------------------------------------
+    void addBiome(const NoiseParams& params, F32 elevation);
+
+    //----------------------------------------------------------------------
+    // @Params:
+    //  "chunkPosition": Position of the chunk in world coordinates.
+    //  "columns": Receives biome and blended height of every column, indexed with x + z * NUM_COLUMNS.
+    //----------------------------------------------------------------------
+    void computeColumns(const Math::Vec2Int& chunkPosition, ColumnGrid& columns) const;
+
+    //----------------------------------------------------------------------
+    // Single samples without any sharing. Slow, computeColumns() is equal to blending these.
+    //----------------------------------------------------------------------
+    I32 getBiome(I32 x, I32 z, const Math::Vec2Int& chunkPosition) const;
+    I32 getHeight(I32 biome, I32 x, I32 z, const Math::Vec2Int& chunkPosition) const;
+
+    I32 getBiomeCount() const { return static_cast<I32>( m_biomes.size() ); }
+
+private:
+    struct BiomeNoise
+    {
+        PerlinNoise noise;
+        F32         elevation;
+    };
+
+    I32                     m_seed;
+    PerlinNoise             m_biomeNoise;
+    ArrayList<BiomeNoise>   m_biomes;
+
+    I32 _GetBiomeIndex(F32 noiseValue) const;
+};
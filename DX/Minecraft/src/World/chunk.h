@@ -1,7 +1,8 @@
 #pragma once
 #include "block.hpp"
-#include "PolyVoxCore/LargeVolume.h"
+#include "PolyVoxCore/RawVolume.h"
 #include "world_constants.h"
+#include "chunk_voxels.h"
 
 //**********************************************************************
 class Chunk
@@ -10,23 +11,37 @@ public:
     GameObject*                     go;
     Math::Vec2Int                   position;
     Math::AABB                      bounds;
-    PolyVox::LargeVolume<Block>*    volume;
+    PolyVox::RawVolume<Block>*      volume = nullptr; // Staging voxels, only valid while the chunk is being generated
+    ChunkVoxelsPtr                  voxels;           // Null until generated. Shared read-only with jobs, copied before an edit
+    U64                             lastVisibleFrame = 0;
+    I32                             pendingJobs = 0;  // Jobs which still reference this chunk, it can't be unloaded until they are done
+    bool                            modified = false; // Voxels differ from the ones in the region file
+    U8                              missingNeighbours = 0; // Bit i: Entry i of the ChunkNeighbourhood was not generated yet when the current mesh was built
 
-    Chunk(PolyVox::LargeVolume<Block>* vol, const Math::Vec2Int& tilePos)
-        : volume( vol ), position( tilePos * CHUNK_SIZE )
+    // "gameObject": Game object of an unloaded chunk which should be reused. A new one is created if null.
+    Chunk(const Math::Vec2Int& tilePos, GameObject* gameObject = nullptr)
+        : position( tilePos * CHUNK_SIZE )
     {
         Math::Vec3 posV3( (F32)position.x, -CHUNK_HEIGHT, (F32)position.y );
 
         bounds.getMin() = posV3;
         bounds.getMax() = bounds.getMin() + Math::Vec3( CHUNK_SIZE, 2 * CHUNK_HEIGHT, CHUNK_SIZE );
 
-        go = SCENE.createGameObject("CHUNK");
-        go->getTransform()->position = posV3;
-        go->addComponent<Components::MeshRenderer>();
+        go = gameObject;
+        if (not go)
+        {
+            go = SCENE.createGameObject("CHUNK");
+            go->addComponent<Components::MeshRenderer>();
+        }
+        go->getTransform()->setPosition( posV3 );
+        go->setActive( true );
     }
 
     void setActive(bool b) const { go->setActive( b ); }
-    void setVoxelAt(I32 x, I32 y, I32 z, Block block) { volume->setVoxelAt(position.x + x, y, position.y + z, block); }
+    Math::Vec2Int getChunkCoords() const { return Math::Vec2Int( position.x / CHUNK_SIZE, position.y / CHUNK_SIZE ); }
+    // Voxels outside of the chunk bounds are silently dropped. The volume also contains the row y == CHUNK_HEIGHT,
+    // but ChunkVoxels does not store it, so writing there would lose the voxel on the next remesh or reload.
+    void setVoxelAt(I32 x, I32 y, I32 z, Block block) { if (y < CHUNK_HEIGHT) volume->setVoxelAt(position.x + x, y, position.y + z, block); }
     void setVoxelAt(const Math::Vec3& v, Block block) { setVoxelAt((I32)v.x, (I32)v.y, (I32)v.z, block); }
 
     void drawBoundingBox()
@@ -0,0 +1,245 @@
+#include "chunk_voxels.h"
+/**********************************************************************
+    class: ChunkSection, ChunkVoxels (chunk_voxels.cpp)
+
+    author: S. Hau
+    date: October 17, 2026
+**********************************************************************/
+
+static_assert( sizeof( Block ) == 1, "ChunkSection: Palette lookups assume one byte per block." );
+static_assert( (2 * CHUNK_HEIGHT) % CHUNK_SECTION_HEIGHT == 0, "ChunkVoxels: Chunk height must be a multiple of the section height." );
+
+//**********************************************************************
+// ChunkSection
+//**********************************************************************
+
+//----------------------------------------------------------------------
+void ChunkSection::setVoxel( I32 x, I32 y, I32 z, Block block )
+{
+    if ( m_bitsPerIndex == 0 && m_palette[0] == block )
+        return;
+
+    U32 paletteIndex = static_cast<U32>( std::find( m_palette.begin(), m_palette.end(), block ) - m_palette.begin() );
+    if ( paletteIndex == m_palette.size() )
+    {
+        m_palette.push_back( block );
+
+        U32 bitsPerIndex = _BitsForPaletteSize( m_palette.size() );
+        if (bitsPerIndex != m_bitsPerIndex)
+            _Repack( bitsPerIndex );
+    }
+
+    _SetIndex( Index( x, y, z ), paletteIndex );
+}
+
+//----------------------------------------------------------------------
+void ChunkSection::assign( const Block* voxels )
+{
+    // Palette in order of first occurrence
+    I16 lookup[256];
+    std::fill( std::begin( lookup ), std::end( lookup ), (I16)-1 );
+
+    m_palette.clear();
+    for (I32 i = 0; i < NUM_VOXELS; i++)
+    {
+        U8 material = voxels[i].getMaterial();
+        if (lookup[material] < 0)
+        {
+            lookup[material] = static_cast<I16>( m_palette.size() );
+            m_palette.push_back( voxels[i] );
+        }
+    }
+
+    m_bitsPerIndex = _BitsForPaletteSize( m_palette.size() );
+    if (m_bitsPerIndex == 0)
+    {
+        m_indices.clear();
+        m_indices.shrink_to_fit();
+        return;
+    }
+
+    m_indices.assign( NUM_VOXELS * m_bitsPerIndex / 64, 0 );
+    for (U32 i = 0; i < NUM_VOXELS; i++)
+    {
+        U32 bit = i * m_bitsPerIndex;
+        m_indices[bit / 64] |= static_cast<U64>( lookup[voxels[i].getMaterial()] ) << (bit % 64);
+    }
+}
+
+//----------------------------------------------------------------------
+void ChunkSection::decode( Block* voxels ) const
+{
+    if (m_bitsPerIndex == 0)
+    {
+        std::fill( voxels, voxels + NUM_VOXELS, m_palette[0] );
+        return;
+    }
+
+    U64 mask = (1ull << m_bitsPerIndex) - 1;
+    for (U32 i = 0; i < NUM_VOXELS; i++)
+    {
+        U32 bit = i * m_bitsPerIndex;
+        voxels[i] = m_palette[(m_indices[bit / 64] >> (bit % 64)) & mask];
+    }
+}
+
+//----------------------------------------------------------------------
+void ChunkSection::compact()
+{
+    if (m_bitsPerIndex == 0)
+        return;
+
+    // Edits only ever add palette entries, so rebuild it from the voxels
+    ArrayList<Block> voxels( NUM_VOXELS );
+    decode( voxels.data() );
+    assign( voxels.data() );
+}
+
+//----------------------------------------------------------------------
+void ChunkSection::serialize( ArrayList<Byte>& out ) const
+{
+    U16 paletteSize = static_cast<U16>( m_palette.size() );
+    out.push_back( static_cast<Byte>( paletteSize & 0xFF ) );
+    out.push_back( static_cast<Byte>( paletteSize >> 8 ) );
+    for (auto block : m_palette)
+        out.push_back( block.getMaterial() );
+
+    out.push_back( static_cast<Byte>( m_bitsPerIndex ) );
+    auto indices = reinterpret_cast<const Byte*>( m_indices.data() );
+    out.insert( out.end(), indices, indices + m_indices.size() * sizeof( U64 ) );
+}
+
+//----------------------------------------------------------------------
+bool ChunkSection::deserialize( const Byte*& data, const Byte* end )
+{
+    if (end - data < 2)
+        return false;
+
+    U16 paletteSize = static_cast<U16>( data[0] | (data[1] << 8) );
+    data += 2;
+    if (paletteSize == 0 || paletteSize > 256 || end - data < paletteSize + 1)
+        return false;
+
+    m_palette.resize( paletteSize );
+    for (U32 i = 0; i < paletteSize; i++)
+        m_palette[i] = Block( *data++ );
+
+    m_bitsPerIndex = *data++;
+    if (m_bitsPerIndex != _BitsForPaletteSize( paletteSize ))
+        return false;
+
+    Size numBytes = NUM_VOXELS * m_bitsPerIndex / 8;
+    if (static_cast<Size>( end - data ) < numBytes)
+        return false;
+
+    m_indices.resize( numBytes / sizeof( U64 ) );
+    if (numBytes > 0)
+        memcpy( m_indices.data(), data, numBytes );
+    data += numBytes;
+
+    return true;
+}
+
+//**********************************************************************
+// PRIVATE
+//**********************************************************************
+
+//----------------------------------------------------------------------
+void ChunkSection::_Repack( U32 bitsPerIndex )
+{
+    ArrayList<U64> oldIndices = std::move( m_indices );
+    U32 oldBitsPerIndex = m_bitsPerIndex;
+
+    m_bitsPerIndex = bitsPerIndex;
+    m_indices.assign( NUM_VOXELS * bitsPerIndex / 64, 0 );
+
+    // A uniform section only references palette entry 0, so all new indices stay zero
+    if (oldBitsPerIndex == 0)
+        return;
+
+    U64 oldMask = (1ull << oldBitsPerIndex) - 1;
+    for (U32 i = 0; i < NUM_VOXELS; i++)
+    {
+        U32 oldBit = i * oldBitsPerIndex;
+        U64 paletteIndex = (oldIndices[oldBit / 64] >> (oldBit % 64)) & oldMask;
+
+        U32 bit = i * bitsPerIndex;
+        m_indices[bit / 64] |= paletteIndex << (bit % 64);
+    }
+}
+
+//----------------------------------------------------------------------
+void ChunkSection::_SetIndex( U32 voxel, U32 paletteIndex )
+{
+    U32 bit = voxel * m_bitsPerIndex;
+    U64 mask = ((1ull << m_bitsPerIndex) - 1) << (bit % 64);
+
+    U64& word = m_indices[bit / 64];
+    word = (word & ~mask) | (static_cast<U64>( paletteIndex ) << (bit % 64));
+}
+
+//----------------------------------------------------------------------
+U32 ChunkSection::_BitsForPaletteSize( Size paletteSize )
+{
+    if (paletteSize <= 1)   return 0;
+    if (paletteSize <= 2)   return 1;
+    if (paletteSize <= 4)   return 2;
+    if (paletteSize <= 16)  return 4;
+
+    ASSERT( paletteSize <= 256 );
+    return 8;
+}
+
+//**********************************************************************
+// ChunkVoxels
+//**********************************************************************
+
+//----------------------------------------------------------------------
+void ChunkVoxels::compact()
+{
+    for (auto& section : m_sections)
+        section.compact();
+}
+
+//----------------------------------------------------------------------
+Size ChunkVoxels::getMemoryUsage() const
+{
+    Size bytes = 0;
+    for (auto& section : m_sections)
+        bytes += section.getMemoryUsage();
+    return bytes;
+}
+
+//----------------------------------------------------------------------
+void ChunkVoxels::serialize( ArrayList<Byte>& out ) const
+{
+    out.push_back( static_cast<Byte>( CHUNK_SECTIONS ) );
+    for (auto& section : m_sections)
+        section.serialize( out );
+}
+
+//----------------------------------------------------------------------
+bool ChunkVoxels::deserialize( const Byte* data, Size size )
+{
+    const Byte* end = data + size;
+    if (size == 0 || *data++ != CHUNK_SECTIONS)
+        return false;
+
+    for (auto& section : m_sections)
+        if ( not section.deserialize( data, end ) )
+            return false;
+
+    return data == end;
+}
+
+//----------------------------------------------------------------------
+bool ChunkVoxels::operator==( const ChunkVoxels& other ) const
+{
+    // Palettes differ for equal voxels once blocks were removed by edits, so compare the voxels themselves
+    for (I32 y = -CHUNK_HEIGHT; y < CHUNK_HEIGHT; y++)
+        for (I32 z = 0; z < CHUNK_SIZE; z++)
+            for (I32 x = 0; x < CHUNK_SIZE; x++)
+                if (getVoxel( x, y, z ) != other.getVoxel( x, y, z ))
+                    return false;
+    return true;
+}
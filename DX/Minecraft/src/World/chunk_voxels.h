@@ -0,0 +1,201 @@
+#pragma once
+/**********************************************************************
+    class: ChunkSection, ChunkVoxels (chunk_voxels.h)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Voxel storage owned by a single chunk. A chunk is split into
+    sections of CHUNK_SIZE x CHUNK_SECTION_HEIGHT x CHUNK_SIZE voxels.
+    Every section keeps a small palette of the blocks it contains and
+    one bit-packed palette index per voxel.
+    @Considerations:
+      - A section containing only one block (e.g. all air or all stone)
+        stores no indices at all.
+      - Indices have 1, 2, 4 or 8 bits, so one never spans two words.
+      - Not thread-safe. The world shares the voxels of a chunk with
+        jobs read-only and copies them before an edit.
+**********************************************************************/
+#include "block.hpp"
+#include "world_constants.h"
+
+//**********************************************************************
+class ChunkSection
+{
+public:
+    static const I32 NUM_VOXELS = CHUNK_SIZE * CHUNK_SECTION_HEIGHT * CHUNK_SIZE;
+
+    // Uniform section filled with the given block. Block() is air.
+    ChunkSection(Block block = Block()) : m_palette{ block } {}
+
+    //----------------------------------------------------------------------
+    // Local coordinates, x and z in [0, CHUNK_SIZE), y in [0, CHUNK_SECTION_HEIGHT)
+    //----------------------------------------------------------------------
+    static I32 Index(I32 x, I32 y, I32 z) { return x + z * CHUNK_SIZE + y * CHUNK_SIZE * CHUNK_SIZE; }
+
+    //----------------------------------------------------------------------
+    Block getVoxel(I32 x, I32 y, I32 z) const
+    {
+        if (m_bitsPerIndex == 0)
+            return m_palette[0];
+
+        U32 bit = static_cast<U32>( Index( x, y, z ) ) * m_bitsPerIndex;
+        U64 index = (m_indices[bit / 64] >> (bit % 64)) & ((1ull << m_bitsPerIndex) - 1);
+        return m_palette[index];
+    }
+
+    //----------------------------------------------------------------------
+    // Sets a single voxel. Grows the palette and the index width if needed.
+    //----------------------------------------------------------------------
+    void setVoxel(I32 x, I32 y, I32 z, Block block);
+
+    //----------------------------------------------------------------------
+    // Replaces all voxels at once, which is much faster than setVoxel().
+    // @Params:
+    //  "voxels": NUM_VOXELS blocks in the order given by Index().
+    //----------------------------------------------------------------------
+    void assign(const Block* voxels);
+
+    //----------------------------------------------------------------------
+    // Writes all NUM_VOXELS voxels in the order given by Index().
+    //----------------------------------------------------------------------
+    void decode(Block* voxels) const;
+
+    //----------------------------------------------------------------------
+    // Removes blocks which are no longer used from the palette. Turns the
+    // section uniform if only one block is left.
+    //----------------------------------------------------------------------
+    void compact();
+
+    //----------------------------------------------------------------------
+    // Appends the palette and the packed indices as they are in memory.
+    //----------------------------------------------------------------------
+    void serialize(ArrayList<Byte>& out) const;
+
+    //----------------------------------------------------------------------
+    // Reads a section written by serialize() and advances "data".
+    // @Return: False if the data is truncated or invalid, the section is then undefined.
+    //----------------------------------------------------------------------
+    bool deserialize(const Byte*& data, const Byte* end);
+
+    //----------------------------------------------------------------------
+    bool    isUniform()         const { return m_bitsPerIndex == 0; }
+    U32     getPaletteSize()    const { return static_cast<U32>( m_palette.size() ); }
+    U32     getBitsPerIndex()   const { return m_bitsPerIndex; }
+    Size    getMemoryUsage()    const { return sizeof( ChunkSection ) + m_palette.capacity() * sizeof( Block ) + m_indices.capacity() * sizeof( U64 ); }
+
+private:
+    ArrayList<Block>    m_palette;
+    ArrayList<U64>      m_indices;          // Empty if uniform
+    U32                 m_bitsPerIndex = 0;
+
+    // Rewrites all indices with the given width. Palette indices stay the same.
+    void _Repack(U32 bitsPerIndex);
+    void _SetIndex(U32 voxel, U32 paletteIndex);
+
+    // @Return: Smallest index width which can address "paletteSize" entries
+    static U32 _BitsForPaletteSize(Size paletteSize);
+};
+
+//**********************************************************************
+class ChunkVoxels
+{
+public:
+    ChunkVoxels() = default;
+
+    //----------------------------------------------------------------------
+    // Local coordinates, x and z in [0, CHUNK_SIZE), y in [-CHUNK_HEIGHT, CHUNK_HEIGHT).
+    // Voxels outside are air and writing them is silently ignored.
+    //----------------------------------------------------------------------
+    Block getVoxel(I32 x, I32 y, I32 z) const
+    {
+        if ( not _IsInside( x, y, z ) )
+            return Block();
+
+        I32 sectionY = y + CHUNK_HEIGHT;
+        return m_sections[sectionY / CHUNK_SECTION_HEIGHT].getVoxel( x, sectionY % CHUNK_SECTION_HEIGHT, z );
+    }
+
+    void setVoxel(I32 x, I32 y, I32 z, Block block)
+    {
+        if ( not _IsInside( x, y, z ) )
+            return;
+
+        I32 sectionY = y + CHUNK_HEIGHT;
+        m_sections[sectionY / CHUNK_SECTION_HEIGHT].setVoxel( x, sectionY % CHUNK_SECTION_HEIGHT, z, block );
+    }
+
+    //----------------------------------------------------------------------
+    // Sections from bottom to top, section 0 starts at y = -CHUNK_HEIGHT
+    //----------------------------------------------------------------------
+    ChunkSection&       getSection(I32 index)       { return m_sections[index]; }
+    const ChunkSection& getSection(I32 index) const { return m_sections[index]; }
+
+    //----------------------------------------------------------------------
+    void compact();
+    Size getMemoryUsage() const;
+
+    //----------------------------------------------------------------------
+    // Binary representation of all sections, used to store chunks on disk (see RegionStorage)
+    //----------------------------------------------------------------------
+    void serialize(ArrayList<Byte>& out) const;
+    bool deserialize(const Byte* data, Size size);
+
+    bool operator==(const ChunkVoxels& other) const;
+    bool operator!=(const ChunkVoxels& other) const { return not (*this == other); }
+
+private:
+    std::array<ChunkSection, CHUNK_SECTIONS> m_sections;
+
+    static bool _IsInside(I32 x, I32 y, I32 z)
+    {
+        return x >= 0 && x < CHUNK_SIZE && z >= 0 && z < CHUNK_SIZE && y >= -CHUNK_HEIGHT && y < CHUNK_HEIGHT;
+    }
+};
+
+using ChunkVoxelsPtr = std::shared_ptr<ChunkVoxels>;
+
+// Voxels of a chunk and its neighbours in +x, +z and +x+z, which are needed for the faces at the border. Entries might be null.
+using ChunkNeighbourhood = std::array<std::shared_ptr<const ChunkVoxels>, 4>;
+
+//----------------------------------------------------------------------
+// Writes the voxels of a chunk plus the first row of its +x/+z neighbours
+// into a volume, which is what a chunk is meshed from. Voxels of missing
+// neighbours are air.
+// @Params:
+//  "originX", "originZ": World coordinates of the chunk corner.
+//  "volume": Anything with setVoxelAt(x, y, z, Block), e.g. a PolyVox::RawVolume.
+//----------------------------------------------------------------------
+template <typename TVolume>
+void UnpackChunkNeighbourhood(const ChunkNeighbourhood& neighbourhood, I32 originX, I32 originZ, TVolume& volume)
+{
+    // Own voxels, section by section
+    if (neighbourhood[0])
+    {
+        ArrayList<Block> sectionVoxels( ChunkSection::NUM_VOXELS );
+        for (I32 section = 0; section < CHUNK_SECTIONS; section++)
+        {
+            I32 sectionMinY = section * CHUNK_SECTION_HEIGHT - CHUNK_HEIGHT;
+            neighbourhood[0]->getSection( section ).decode( sectionVoxels.data() );
+
+            for (I32 y = 0; y < CHUNK_SECTION_HEIGHT; y++)
+                for (I32 z = 0; z < CHUNK_SIZE; z++)
+                    for (I32 x = 0; x < CHUNK_SIZE; x++)
+                        volume.setVoxelAt( originX + x, sectionMinY + y, originZ + z, sectionVoxels[ChunkSection::Index( x, y, z )] );
+        }
+    }
+
+    // The region includes one more row in +x and +z, which belongs to the neighbours
+    auto neighbourVoxel = [&]( I32 x, I32 y, I32 z ) {
+        I32 i = (x / CHUNK_SIZE) + 2 * (z / CHUNK_SIZE);
+        return neighbourhood[i] ? neighbourhood[i]->getVoxel( x % CHUNK_SIZE, y, z % CHUNK_SIZE ) : Block();
+    };
+    for (I32 y = -CHUNK_HEIGHT; y <= CHUNK_HEIGHT; y++)
+    {
+        for (I32 i = 0; i <= CHUNK_SIZE; i++)
+        {
+            volume.setVoxelAt( originX + CHUNK_SIZE, y, originZ + i, neighbourVoxel( CHUNK_SIZE, y, i ) );
+            volume.setVoxelAt( originX + i, y, originZ + CHUNK_SIZE, neighbourVoxel( i, y, CHUNK_SIZE ) );
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+/**********************************************************************
+    class: GreedyMesher (greedy_mesher.hpp)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Extracts the visible faces of a block volume. Coplanar faces of the
+    same material are merged into as few rectangles as possible, so a
+    flat 16x16 surface becomes a single quad instead of 256.
+    @Considerations:
+      - Same faces and coordinates as the execute() of the bundled
+        PolyVox::CubicSurfaceExtractorWithNormals: Voxels are centered on
+        integer coordinates, material 0 is air and every other material
+        is opaque. Only pairs of voxels (i, i + 1) with i in [0, size - 1)
+        are tested, so nothing is emitted against voxels outside of the
+        volume and the last layer is just a neighbour. The world passes
+        the chunk plus the first layer of its +x/+z neighbours, so a seam
+        face is emitted exactly once, by the chunk on its -x/-z side.
+      - The texture of a quad is tiled in the shader by projecting the
+        world position, so merged quads need no extra UVs.
+**********************************************************************/
+#include <DX.h>
+
+//----------------------------------------------------------------------
+struct VoxelQuad
+{
+    I32     axis;           // Axis of the normal (0 = x, 1 = y, 2 = z)
+    bool    positive;       // Normal points into positive axis direction
+    I32     position[3];    // Voxel with the smallest coordinates covered by the quad. The face lies on its "axis" side.
+    I32     width;          // Extent along (axis + 1) % 3
+    I32     height;         // Extent along (axis + 2) % 3
+    U8      material;
+};
+
+//**********************************************************************
+class GreedyMesher
+{
+public:
+    //----------------------------------------------------------------------
+    // @Params:
+    //  "materials": Dense volume of size[0] * size[1] * size[2] materials, x first, then y, then z.
+    //  "size": Size of the volume in voxels. Every dimension must be at least 2.
+    //  "quads": Receives the merged quads. Previous contents are kept.
+    //----------------------------------------------------------------------
+    static void Extract(const U8* materials, const I32 size[3], ArrayList<VoxelQuad>& quads)
+    {
+        const I32 stride[3] = { 1, size[0], size[0] * size[1] };
+
+        for (I32 axis = 0; axis < 3; axis++)
+        {
+            I32 u = (axis + 1) % 3;
+            I32 v = (axis + 2) % 3;
+            I32 sizeU = size[u] - 1;
+            I32 sizeV = size[v] - 1;
+
+            // Material of the face between a voxel and its neighbour in +axis. Negative if the face points into -axis.
+            ArrayList<I16> mask( sizeU * sizeV );
+
+            I32 voxel[3];
+            for (voxel[axis] = 0; voxel[axis] < size[axis] - 1; voxel[axis]++)
+            {
+                for (voxel[v] = 0; voxel[v] < sizeV; voxel[v]++)
+                {
+                    for (voxel[u] = 0; voxel[u] < sizeU; voxel[u]++)
+                    {
+                        I32 index = voxel[0] * stride[0] + voxel[1] * stride[1] + voxel[2] * stride[2];
+                        U8 back  = materials[index];
+                        U8 front = materials[index + stride[axis]];
+
+                        I16 face = 0;
+                        if (back > 0 && front == 0)
+                            face = back;
+                        else if (front > 0 && back == 0)
+                            face = -front;
+                        mask[voxel[u] + voxel[v] * sizeU] = face;
+                    }
+                }
+
+                // Grow every face first along u, then along v as long as the whole row matches
+                for (I32 j = 0; j < sizeV; j++)
+                {
+                    for (I32 i = 0; i < sizeU;)
+                    {
+                        I16 face = mask[i + j * sizeU];
+                        if (face == 0)
+                        {
+                            i++;
+                            continue;
+                        }
+
+                        I32 width = 1;
+                        while (i + width < sizeU && mask[i + width + j * sizeU] == face)
+                            width++;
+
+                        I32 height = 1;
+                        for (; j + height < sizeV; height++)
+                        {
+                            I16* row = &mask[i + (j + height) * sizeU];
+                            if ( std::any_of( row, row + width, [face](I16 other) { return other != face; } ) )
+                                break;
+                        }
+
+                        VoxelQuad quad;
+                        quad.axis       = axis;
+                        quad.positive   = face > 0;
+                        quad.position[axis] = voxel[axis];
+                        quad.position[u]    = i;
+                        quad.position[v]    = j;
+                        quad.width      = width;
+                        quad.height     = height;
+                        quad.material   = static_cast<U8>( face > 0 ? face : -face );
+                        quads.push_back( quad );
+
+                        for (I32 h = 0; h < height; h++)
+                            std::fill_n( &mask[i + (j + h) * sizeU], width, (I16)0 );
+                        i += width;
+                    }
+                }
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------
+    // Appends the 4 corners (relative to the volume origin) and 6 indices of the given quad.
+    // Triangles are wound like the ones from the PolyVox extractor.
+    //----------------------------------------------------------------------
+    static void AppendQuad(const VoxelQuad& quad, ArrayList<Math::Vec3>& vertices, ArrayList<U32>& indices)
+    {
+        I32 u = (quad.axis + 1) % 3;
+        I32 v = (quad.axis + 2) % 3;
+
+        F32 corner[3] = { quad.position[0] - 0.5f, quad.position[1] - 0.5f, quad.position[2] - 0.5f };
+        corner[quad.axis] += 1.0f;
+
+        U32 first = static_cast<U32>( vertices.size() );
+        for (I32 i = 0; i < 4; i++)
+        {
+            F32 p[3] = { corner[0], corner[1], corner[2] };
+            p[u] += (i & 1) ? (F32)quad.width : 0.0f;
+            p[v] += (i & 2) ? (F32)quad.height : 0.0f;
+            vertices.emplace_back( p[0], p[1], p[2] );
+        }
+
+        // Corners are (u0,v0), (u1,v0), (u0,v1), (u1,v1)
+        if (quad.positive)
+            indices.insert( indices.end(), { first, first + 1, first + 2, first + 1, first + 3, first + 2 } );
+        else
+            indices.insert( indices.end(), { first, first + 2, first + 1, first + 1, first + 2, first + 3 } );
+    }
+};
@@ -0,0 +1,173 @@
+#include "region_storage.h"
+/**********************************************************************
+    class: RegionStorage (region_storage.cpp)
+
+    author: S. Hau
+    date: October 17, 2026
+**********************************************************************/
+
+#include "OS/FileSystem/file.h"
+#include "OS/FileSystem/file_system.h"
+
+//**********************************************************************
+// PUBLIC
+//**********************************************************************
+
+//----------------------------------------------------------------------
+bool RegionStorage::load( const Math::Vec2Int& chunkCoords, ChunkVoxels& voxels )
+{
+    auto region = GetRegion( chunkCoords );
+    String path = getRegionPath( region.x, region.y );
+
+    ArrayList<Byte> compressed;
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        if ( not OS::FileSystem::exists( path.c_str() ) )
+            return false;
+
+        OS::BinaryFile file( OS::Path( path, false ), OS::EFileMode::READ );
+
+        TableEntry entry;
+        file.setReadCursor( _GetTableIndex( chunkCoords ) * sizeof( TableEntry ) );
+        if (file.read( &entry, sizeof( TableEntry ) ) != sizeof( TableEntry ) || entry.offset == 0)
+            return false;
+
+        compressed.resize( entry.size );
+        file.setReadCursor( entry.offset );
+        if (file.read( compressed.data(), entry.size ) != entry.size)
+            return false;
+    }
+
+    ArrayList<Byte> data;
+    if ( not Decompress( compressed.data(), compressed.size(), data ) )
+        return false;
+
+    return voxels.deserialize( data.data(), data.size() );
+}
+
+//----------------------------------------------------------------------
+void RegionStorage::save( const Math::Vec2Int& chunkCoords, const ChunkVoxels& voxels )
+{
+    // Compress outside of the lock, only the file access is serialized
+    ArrayList<Byte> data;
+    voxels.serialize( data );
+    ArrayList<Byte> compressed;
+    Compress( data, compressed );
+
+    auto region = GetRegion( chunkCoords );
+    String path = getRegionPath( region.x, region.y );
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+    if ( not OS::FileSystem::exists( path.c_str() ) )
+    {
+        // Empty offset table. Opening the file creates missing directories.
+        OS::BinaryFile file( OS::Path( path, false ), OS::EFileMode::READ_WRITE_OVERWRITE );
+        ArrayList<Byte> table( TABLE_SIZE, 0 );
+        file.write( table.data(), table.size() );
+    }
+
+    OS::BinaryFile file( OS::Path( path, false ), OS::EFileMode::READ_WRITE );
+
+    U32 tableOffset = _GetTableIndex( chunkCoords ) * sizeof( TableEntry );
+    TableEntry entry;
+    file.setReadCursor( tableOffset );
+    file.read( &entry, sizeof( TableEntry ) );
+
+    // Overwrite the old data if the chunk still fits, otherwise append it
+    if (entry.offset == 0 || compressed.size() > entry.size)
+        entry.offset = static_cast<U32>( file.getFileSize() );
+    entry.size = static_cast<U32>( compressed.size() );
+
+    file.setWriteCursor( entry.offset );
+    file.write( compressed.data(), compressed.size() );
+
+    file.setWriteCursor( tableOffset );
+    file.write( reinterpret_cast<const Byte*>( &entry ), sizeof( TableEntry ) );
+}
+
+//----------------------------------------------------------------------
+String RegionStorage::getRegionPath( I32 regionX, I32 regionZ ) const
+{
+    return m_directory + "/r." + TS( regionX ) + "." + TS( regionZ ) + ".region";
+}
+
+//----------------------------------------------------------------------
+Math::Vec2Int RegionStorage::GetRegion( const Math::Vec2Int& chunkCoords )
+{
+    // Round towards negative infinity, so chunk -1 lands in region -1
+    auto floorDiv = [](I32 a) { return (a >= 0) ? (a / REGION_SIZE) : ((a + 1) / REGION_SIZE - 1); };
+    return Math::Vec2Int( floorDiv( chunkCoords.x ), floorDiv( chunkCoords.y ) );
+}
+
+//----------------------------------------------------------------------
+void RegionStorage::Compress( const ArrayList<Byte>& in, ArrayList<Byte>& out )
+{
+    // PackBits: A control byte n < 128 is followed by n + 1 literal bytes,
+    // n > 128 repeats the next byte 257 - n times.
+    Size i = 0;
+    while (i < in.size())
+    {
+        Size run = 1;
+        while (i + run < in.size() && run < 128 && in[i + run] == in[i])
+            run++;
+
+        if (run >= 3)
+        {
+            out.push_back( static_cast<Byte>( 257 - run ) );
+            out.push_back( in[i] );
+            i += run;
+            continue;
+        }
+
+        // Literals up to the next run of at least 3 bytes
+        Size start = i;
+        while (i < in.size() && i - start < 128)
+        {
+            if (i + 2 < in.size() && in[i] == in[i + 1] && in[i] == in[i + 2])
+                break;
+            i++;
+        }
+        out.push_back( static_cast<Byte>( i - start - 1 ) );
+        out.insert( out.end(), in.begin() + start, in.begin() + i );
+    }
+}
+
+//----------------------------------------------------------------------
+bool RegionStorage::Decompress( const Byte* in, Size size, ArrayList<Byte>& out )
+{
+    const Byte* end = in + size;
+    while (in < end)
+    {
+        Byte control = *in++;
+        if (control < 128)
+        {
+            Size count = control + 1;
+            if (static_cast<Size>( end - in ) < count)
+                return false;
+
+            out.insert( out.end(), in, in + count );
+            in += count;
+        }
+        else if (control > 128)
+        {
+            if (in == end)
+                return false;
+
+            out.insert( out.end(), static_cast<Size>( 257 - control ), *in++ );
+        }
+    }
+    return true;
+}
+
+//**********************************************************************
+// PRIVATE
+//**********************************************************************
+
+//----------------------------------------------------------------------
+U32 RegionStorage::_GetTableIndex( const Math::Vec2Int& chunkCoords )
+{
+    auto region = GetRegion( chunkCoords );
+    U32 localX = static_cast<U32>( chunkCoords.x - region.x * REGION_SIZE );
+    U32 localZ = static_cast<U32>( chunkCoords.y - region.y * REGION_SIZE );
+    return localX + localZ * REGION_SIZE;
+}
@@ -0,0 +1,72 @@
+#pragma once
+/**********************************************************************
+    class: RegionStorage (region_storage.h)
+
+    author: S. Hau
+    date: October 17, 2026
+
+    Persists chunk voxels on disk. REGION_SIZE x REGION_SIZE chunks
+    share one region file, which starts with an offset table:
+        [U32 offset, U32 size] * REGION_SIZE * REGION_SIZE
+        [compressed chunk] [compressed chunk] ...
+    An offset of 0 means the chunk was never saved. Chunks are
+    serialized with ChunkVoxels::serialize() and run-length encoded.
+    @Considerations:
+      - A chunk which grew is appended to the end of the file, its old
+        space is not reused.
+      - Thread-safe. Generation jobs load chunks while the main thread
+        saves evicted chunks.
+**********************************************************************/
+#include "chunk_voxels.h"
+#include <mutex>
+
+#define REGION_SIZE 32
+
+//**********************************************************************
+class RegionStorage
+{
+public:
+    //----------------------------------------------------------------------
+    // @Params:
+    //  "directory": Physical directory for the region files. Created on the first save.
+    //----------------------------------------------------------------------
+    RegionStorage(const String& directory) : m_directory( directory ) {}
+
+    //----------------------------------------------------------------------
+    // @Params:
+    //  "chunkCoords": Chunk coordinates, not world coordinates.
+    // @Return: False if the chunk was never saved or its data is corrupt.
+    //----------------------------------------------------------------------
+    bool load(const Math::Vec2Int& chunkCoords, ChunkVoxels& voxels);
+    void save(const Math::Vec2Int& chunkCoords, const ChunkVoxels& voxels);
+
+    //----------------------------------------------------------------------
+    // @Return: Path of the region file containing the given region coordinates
+    //----------------------------------------------------------------------
+    String getRegionPath(I32 regionX, I32 regionZ) const;
+
+    // @Return: Region coordinates of the region containing the given chunk
+    static Math::Vec2Int GetRegion(const Math::Vec2Int& chunkCoords);
+
+    //----------------------------------------------------------------------
+    // Simple run-length encoding. Runs of equal bytes are common, because
+    // uniform sections and layers of the same block produce equal indices.
+    //----------------------------------------------------------------------
+    static void Compress(const ArrayList<Byte>& in, ArrayList<Byte>& out);
+    static bool Decompress(const Byte* in, Size size, ArrayList<Byte>& out);
+
+private:
+    String      m_directory;
+    std::mutex  m_mutex;
+
+    struct TableEntry
+    {
+        U32 offset = 0;
+        U32 size = 0;
+    };
+    static const U32 TABLE_SIZE = REGION_SIZE * REGION_SIZE * sizeof( TableEntry );
+
+    static U32 _GetTableIndex(const Math::Vec2Int& chunkCoords);
+
+    NULL_COPY_AND_ASSIGN(RegionStorage)
+};
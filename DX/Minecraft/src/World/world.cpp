@@ -1,17 +1,29 @@
 #include "world.h"
 #include "block_database.h"
+#include "greedy_mesher.hpp"
 
 #define CHUNK_COORD(x,y) Math::Vec2Int(static_cast<I32>(std::floorf((F32)(x) / CHUNK_SIZE)), static_cast<I32>(std::floorf((F32)(y) / CHUNK_SIZE)))
 
-MeshPtr CreateMeshForRendering(const PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal>& polyvoxMesh);
+ChunkMeshData   CreateMeshData(const PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal>& polyvoxMesh);
+ChunkMeshData   CreateMeshData(const ArrayList<VoxelQuad>& quads);
+MeshPtr         CreateMeshForRendering(const ChunkMeshData& meshData);
+
+//----------------------------------------------------------------------
+inline PolyVox::Region ConvertRegion(const Math::AABB& aabb)
+{
+    return PolyVox::Region( PolyVox::Vector3DInt32( (I32)aabb.getMin().x, (I32)aabb.getMin().y, (I32)aabb.getMin().z ),
+                            PolyVox::Vector3DInt32( (I32)aabb.getMax().x, (I32)aabb.getMax().y, (I32)aabb.getMax().z ) );
+}
 
 //----------------------------------------------------------------------
 I32         World::CHUNK_VIEW_DISTANCE = 4;
+I32         World::CHUNK_UNLOAD_DISTANCE = 6;
 MaterialPtr World::CHUNK_MATERIAL = nullptr;
+bool        World::GREEDY_MESHING = true;
 
 //----------------------------------------------------------------------
-World::World() : m_volData( PolyVox::Region( PolyVox::Vector3DInt32( INT_MIN, INT_MIN, INT_MIN ),
-                                             PolyVox::Vector3DInt32( INT_MAX, INT_MAX, INT_MAX ) ) )
+World::World()
+    : m_regionStorage( "world" )
 {
 
 
@@ -20,21 +32,41 @@ World::World() : m_volData( PolyVox::Region( PolyVox::Vector3DInt32( INT_MIN, IN
 //----------------------------------------------------------------------
 void World::shutdown()
 {
+    // Jobs still reference the world and their chunks, so wait for them
+    ArrayList<ChunkUpdateComplete> updates;
+    while (m_jobsInFlight > 0)
+    {
+        if ( m_chunkUpdateCompleteQueue.pop( updates ) )
+            m_jobsInFlight--;
+        else
+            std::this_thread::yield();
+    }
+
+    // Persist everything which changed since it was loaded
+    for (auto& pair : m_terrainChunks)
+    {
+        if (pair.second->voxels && pair.second->modified)
+            m_regionStorage.save( pair.first, *pair.second->voxels );
+    }
+
     m_chunkGenerationList.clear();
-    m_chunkUpdateCompleteList.clear();
     m_terrainChunks.clear();
+    m_unusedChunkObjects.clear();
     CHUNK_MATERIAL.reset();
-    m_volData.flushAll();
 }
 
 //----------------------------------------------------------------------
 void World::update( F32 delta )
 {
     // ORDER OF THIS FUNCTIONS IS IMPORTANT
+    m_frame++;
+
     _ExecuteBlockUpdates();
 
     _CalculateChunkVisibility();
 
+    _UnloadChunks();
+
     _PerformRayCasts();
 
     _ExecuteChunkBatchUpdates();
@@ -55,11 +87,13 @@ void World::update( F32 delta )
 //----------------------------------------------------------------------
 void World::_UpdateChunkInBatch( const Math::Vec2Int& coords )
 {
-    if ( m_terrainChunks.find( coords ) == m_terrainChunks.end() )
-        ASSERT( false ); // This should never happen
+    // Unloaded chunks and chunks which are not generated yet have nothing to remesh
+    auto it = m_terrainChunks.find( coords );
+    if (it == m_terrainChunks.end() || not it->second->voxels)
+        return;
 
     // Queue chunk for generating if not already in for it
-    auto chunk = m_terrainChunks[coords];
+    auto chunk = it->second;
     if ( std::find( m_chunkUpdateBatchList.begin(), m_chunkUpdateBatchList.end(), chunk ) == m_chunkUpdateBatchList.end() )
         m_chunkUpdateBatchList.emplace_front( chunk );
 }
@@ -67,67 +101,289 @@ void World::_UpdateChunkInBatch( const Math::Vec2Int& coords )
 //----------------------------------------------------------------------
 bool World::_RayCast( const Physics::Ray& ray, ChunkRayCastResult* result )
 {
-    auto cb = [&]( const PolyVox::LargeVolume<Block>::Sampler& sampler ) -> bool
+    // Same traversal as PolyVox::raycastWithDirection(): Voxels are centered on integer coordinates
+    // and the length of the direction is the maximum distance.
+    Math::Vec3 start = ray.getOrigin() + Math::Vec3( 0.5f );
+    Math::Vec3 end   = start + ray.getDirection();
+
+    I32 voxel[3]    = { (I32)std::floor( start.x ), (I32)std::floor( start.y ), (I32)std::floor( start.z ) };
+    I32 voxelEnd[3] = { (I32)std::floor( end.x ),   (I32)std::floor( end.y ),   (I32)std::floor( end.z ) };
+    I32 step[3];
+    F32 tMax[3];
+    F32 tDelta[3];
+    for (I32 axis = 0; axis < 3; axis++)
     {
-        auto voxel = sampler.getVoxel();
-        if ( voxel == AIR_BLOCK )
-            return true; // Continues raycast
+        F32 from = start[axis];
+        F32 to   = end[axis];
+        step[axis] = (from < to) ? 1 : ((from > to) ? -1 : 0);
 
-        result->block = voxel;
-        result->blockCenter = ConvertVector( sampler.getPosition() );
+        // Never step along an axis the ray does not move on
+        if (step[axis] == 0)
+        {
+            tMax[axis] = tDelta[axis] = std::numeric_limits<F32>::max();
+            continue;
+        }
 
-        // Since polyvox raycast does not deliever the exact hit-point but rather the block, it must be calculated separately
-        Math::Vec3 blockSize( BLOCK_SIZE * 0.5f );
-        Math::AABB blockBounds( result->blockCenter - blockSize, result->blockCenter + blockSize );
+        F32 minBound = std::floor( from );
+        tDelta[axis] = 1.0f / std::abs( to - from );
+        tMax[axis]   = ((step[axis] < 0) ? (from - minBound) : (minBound + 1.0f - from)) * tDelta[axis];
+    }
 
-        Physics::RayCastResult rayResult;
-        if ( ray.intersects( blockBounds, &rayResult ) )
-            result->hitPoint = rayResult.hitPoint;
+    for (;;)
+    {
+        Block block = _GetVoxel( voxel[0], voxel[1], voxel[2] );
+        if (block != AIR_BLOCK)
+        {
+            result->block = block;
+            result->blockCenter = Math::Vec3( (F32)voxel[0], (F32)voxel[1], (F32)voxel[2] );
 
-        return false; // Stops raycast
-    };
+            // Only the block is known, so the exact hit-point must be calculated separately
+            Math::Vec3 blockSize( BLOCK_SIZE * 0.5f );
+            Math::AABB blockBounds( result->blockCenter - blockSize, result->blockCenter + blockSize );
+
+            Physics::RayCastResult rayResult;
+            if ( ray.intersects( blockBounds, &rayResult ) )
+                result->hitPoint = rayResult.hitPoint;
 
-    PolyVox::Vector3DFloat start( ray.getOrigin().x, ray.getOrigin().y, ray.getOrigin().z );
-    PolyVox::Vector3DFloat dir( ray.getDirection().x, ray.getDirection().y, ray.getDirection().z );
+            return true;
+        }
 
-    auto polyVoxResult = PolyVox::raycastWithDirection( &m_volData, start, dir, cb );
-    return (polyVoxResult == PolyVox::RaycastResult::Interupted);
+        I32 axis = (tMax[0] <= tMax[1] && tMax[0] <= tMax[2]) ? 0 : ((tMax[1] <= tMax[2]) ? 1 : 2);
+        if (voxel[axis] == voxelEnd[axis])
+            return false;
+
+        tMax[axis]  += tDelta[axis];
+        voxel[axis] += step[axis];
+    }
 }
 
 //----------------------------------------------------------------------
-MeshPtr World::_GenerateMesh( const Math::AABB& region )
+Chunk* World::_GetGeneratedChunk( I32 x, I32 z ) const
 {
-    PolyVox::Region chunkDim( PolyVox::Vector3DInt32( (I32)region.getMin().x, (I32)region.getMin().y, (I32)region.getMin().z ),
-                              PolyVox::Vector3DInt32( (I32)region.getMax().x, (I32)region.getMax().y, (I32)region.getMax().z ) );
+    auto it = m_terrainChunks.find( Math::Vec2Int( x, z ) );
+    if (it == m_terrainChunks.end() || not it->second->voxels)
+        return nullptr;
+
+    return it->second.get();
+}
+
+//----------------------------------------------------------------------
+Block World::_GetVoxel( I32 x, I32 y, I32 z ) const
+{
+    auto chunkCoord = CHUNK_COORD( x, z );
+    auto chunk = _GetGeneratedChunk( chunkCoord.x, chunkCoord.y );
+    if (not chunk)
+        return AIR_BLOCK;
+
+    return chunk->voxels->getVoxel( x - chunk->position.x, y, z - chunk->position.y );
+}
+
+//----------------------------------------------------------------------
+void World::_SetVoxel( I32 x, I32 y, I32 z, Block block )
+{
+    auto chunkCoord = CHUNK_COORD( x, z );
+    auto chunk = _GetGeneratedChunk( chunkCoord.x, chunkCoord.y );
+    if (not chunk)
+        return; // The chunk generator would overwrite the block anyway
+
+    // A job might still mesh the current voxels
+    if (chunk->voxels.use_count() > 1)
+        chunk->voxels = std::make_shared<ChunkVoxels>( *chunk->voxels );
+
+    chunk->voxels->setVoxel( x - chunk->position.x, y, z - chunk->position.y, block );
+    chunk->modified = true;
+}
+
+//----------------------------------------------------------------------
+ChunkNeighbourhood World::_GetNeighbourhood( const Chunk& chunk ) const
+{
+    ChunkNeighbourhood neighbourhood;
+    auto coords = chunk.getChunkCoords();
+    for (I32 i = 0; i < 4; i++)
+    {
+        auto neighbour = _GetGeneratedChunk( coords.x + (i & 1), coords.y + (i >> 1) );
+        if (neighbour)
+            neighbourhood[i] = neighbour->voxels;
+    }
+    return neighbourhood;
+}
+
+//----------------------------------------------------------------------
+U8 World::_GetMissingNeighbours( const ChunkNeighbourhood& neighbourhood )
+{
+    U8 missingNeighbours = 0;
+    for (I32 i = 1; i < 4; i++)
+        if (not neighbourhood[i])
+            missingNeighbours |= (1 << i);
+    return missingNeighbours;
+}
+
+//----------------------------------------------------------------------
+void World::_RemeshMissingSeams( const Chunk& chunk, bool voxelsArrived )
+{
+    auto coords = chunk.getChunkCoords();
+
+    // Chunks in -x, -z and -x-z have this one as neighbour
+    if (voxelsArrived)
+    {
+        for (I32 i = 1; i < 4; i++)
+        {
+            auto other = _GetGeneratedChunk( coords.x - (i & 1), coords.y - (i >> 1) );
+            if (other && (other->missingNeighbours & (1 << i)))
+                _UpdateChunkInBatch( other->getChunkCoords() );
+        }
+    }
+
+    // Neighbours which arrived while the mesh of this chunk was built
+    for (I32 i = 1; i < 4; i++)
+        if ((chunk.missingNeighbours & (1 << i)) && _GetGeneratedChunk( coords.x + (i & 1), coords.y + (i >> 1) ))
+            _UpdateChunkInBatch( coords );
+}
+
+//----------------------------------------------------------------------
+void World::_PackVoxels( const ChunkVolume& volume, const Chunk& chunk, ChunkVoxels& voxels )
+{
+    ArrayList<Block> sectionVoxels( ChunkSection::NUM_VOXELS );
+    for (I32 section = 0; section < CHUNK_SECTIONS; section++)
+    {
+        I32 sectionMinY = section * CHUNK_SECTION_HEIGHT - CHUNK_HEIGHT;
+        for (I32 y = 0; y < CHUNK_SECTION_HEIGHT; y++)
+            for (I32 z = 0; z < CHUNK_SIZE; z++)
+                for (I32 x = 0; x < CHUNK_SIZE; x++)
+                    sectionVoxels[ChunkSection::Index( x, y, z )] = volume.getVoxelAt( chunk.position.x + x, sectionMinY + y, chunk.position.y + z );
+
+        voxels.getSection( section ).assign( sectionVoxels.data() );
+    }
+}
+
+//----------------------------------------------------------------------
+ChunkMeshData World::_GenerateMesh( ChunkVolume& volume, const Math::AABB& region )
+{
+    if (GREEDY_MESHING)
+    {
+        // The region includes its upper corner, same as for the PolyVox extractor
+        auto polyVoxRegion = ConvertRegion( region );
+        auto lower = polyVoxRegion.getLowerCorner();
+        auto upper = polyVoxRegion.getUpperCorner();
+        const I32 size[3] = { upper.getX() - lower.getX() + 1, upper.getY() - lower.getY() + 1, upper.getZ() - lower.getZ() + 1 };
+
+        ArrayList<U8> materials( size[0] * size[1] * size[2] );
+        for (I32 z = 0; z < size[2]; z++)
+            for (I32 y = 0; y < size[1]; y++)
+                for (I32 x = 0; x < size[0]; x++)
+                    materials[x + size[0] * (y + size[1] * z)] = volume.getVoxelAt( lower.getX() + x, lower.getY() + y, lower.getZ() + z ).getMaterial();
+
+        ArrayList<VoxelQuad> quads;
+        GreedyMesher::Extract( materials.data(), size, quads );
+        return CreateMeshData( quads );
+    }
 
     PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> mesh;
-    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::LargeVolume<Block>> surfaceExtractor( &m_volData, chunkDim, &mesh );
+    PolyVox::CubicSurfaceExtractorWithNormals<ChunkVolume> surfaceExtractor( &volume, ConvertRegion( region ), &mesh );
     surfaceExtractor.execute();
 
-   return CreateMeshForRendering( mesh );
+   return CreateMeshData( mesh );
 }
 
 //----------------------------------------------------------------------
-MeshPtr CreateMeshForRendering( const PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal>& polyvoxMesh )
+void World::_GenerateChunkAsync( const ChunkPtr& chunk )
 {
-    auto chunk = RESOURCES.createMesh();
+    // The chunk writes into its own volume, so any number of chunks can be generated in parallel
+    auto volume = std::make_shared<ChunkVolume>( ConvertRegion( chunk->bounds ) );
+    chunk->volume = volume.get();
+    chunk->pendingJobs++;
+
+    // A chunk read from the region file has no border row, that comes from its neighbours
+    auto neighbourhood = _GetNeighbourhood( *chunk );
+
+    m_jobsInFlight++;
+    ASYNC_JOB([=]() mutable {
+        PROFILE_ZONE( "World::GenerateChunk" );
+        MEM_SCOPE( Chunks );
+
+        // Chunks which were unloaded before are read back, only new ones are generated
+        auto voxels = std::make_shared<ChunkVoxels>();
+        bool loaded = m_regionStorage.load( chunk->getChunkCoords(), *voxels );
+        U8 missingNeighbours = 0;
+        if (loaded)
+        {
+            neighbourhood[0] = voxels;
+            UnpackChunkNeighbourhood( neighbourhood, chunk->position.x, chunk->position.y, *volume );
+            missingNeighbours = _GetMissingNeighbours( neighbourhood );
+        }
+        else
+        {
+            m_chunkCallback( *chunk.get() );
+
+            // Only the voxels inside the chunk are kept, blocks written into the border row are dropped
+            _PackVoxels( *volume, *chunk, *voxels );
+        }
+        neighbourhood = {};
+
+        auto meshData = _GenerateMesh( *volume, chunk->bounds );
+        m_chunkUpdateCompleteQueue.push( { { chunk, std::move( meshData ), voxels, not loaded, missingNeighbours } } );
+    });
+}
+
+//----------------------------------------------------------------------
+I32 World::_GetMaxJobsInFlight() const
+{
+    return std::max( 1, (I32)Locator::getThreadManager().getThreadPool().numThreads() );
+}
 
-    ArrayList<Math::Vec3> vertices;
-    ArrayList<Math::Vec3> normals;
-    ArrayList<Math::Vec2> materials;
+//----------------------------------------------------------------------
+ChunkMeshData CreateMeshData( const PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal>& polyvoxMesh )
+{
+    ChunkMeshData meshData;
     for ( auto& vertex : polyvoxMesh.getVertices() )
     {
-        vertices.emplace_back( vertex.getPosition().getX(), vertex.getPosition().getY(), vertex.getPosition().getZ() );
-        normals.emplace_back( vertex.getNormal().getX(), vertex.getNormal().getY(), vertex.getNormal().getZ() );
+        meshData.vertices.emplace_back( vertex.getPosition().getX(), vertex.getPosition().getY(), vertex.getPosition().getZ() );
+        meshData.normals.emplace_back( vertex.getNormal().getX(), vertex.getNormal().getY(), vertex.getNormal().getZ() );
 
         U8 material = static_cast<U8>( vertex.getMaterial() );
-        materials.emplace_back( BlockDatabase::Get().getBlockInfo( material ).texIndices );
+        meshData.uvs.emplace_back( BlockDatabase::Get().getBlockInfo( material ).texIndices );
     }
+    meshData.indices = polyvoxMesh.getIndices();
 
-    chunk->setVertices( vertices );
-    chunk->setIndices( polyvoxMesh.getIndices() );
-    chunk->setNormals( normals );
-    chunk->setUVs( materials );
+    return meshData;
+}
+
+//----------------------------------------------------------------------
+ChunkMeshData CreateMeshData( const ArrayList<VoxelQuad>& quads )
+{
+    ChunkMeshData meshData;
+    meshData.vertices.reserve( quads.size() * 4 );
+    meshData.normals.reserve( quads.size() * 4 );
+    meshData.uvs.reserve( quads.size() * 4 );
+    meshData.indices.reserve( quads.size() * 6 );
+
+    for (auto& quad : quads)
+    {
+        GreedyMesher::AppendQuad( quad, meshData.vertices, meshData.indices );
+
+        Math::Vec3 normal( 0, 0, 0 );
+        normal[quad.axis] = quad.positive ? 1.0f : -1.0f;
+        Math::Vec2 texIndices = BlockDatabase::Get().getBlockInfo( quad.material ).texIndices;
+        for (I32 i = 0; i < 4; i++)
+        {
+            meshData.normals.push_back( normal );
+            meshData.uvs.push_back( texIndices );
+        }
+    }
+
+    return meshData;
+}
+
+//----------------------------------------------------------------------
+// Only on the main thread, the ResourceManager is not thread-safe.
+//----------------------------------------------------------------------
+MeshPtr CreateMeshForRendering( const ChunkMeshData& meshData )
+{
+    auto chunk = RESOURCES.createMesh();
+    chunk->setVertices( meshData.vertices );
+    chunk->setIndices( meshData.indices );
+    chunk->setNormals( meshData.normals );
+    chunk->setUVs( meshData.uvs );
 
     return chunk;
 }
@@ -137,11 +393,11 @@ MeshPtr CreateMeshForRendering( const PolyVox::SurfaceMesh<PolyVox::PositionMate
 void World::_ExecuteBlockUpdates()
 {
     // Execute single block updates and determine which chunks were affected to regenerate them
-    if ( not m_blockUpdates.empty() && not m_generating )
+    if ( not m_blockUpdates.empty() )
     {
         for (auto& blockUpdate : m_blockUpdates)
         {
-            m_volData.setVoxelAt( blockUpdate.position, blockUpdate.block );
+            _SetVoxel( blockUpdate.position.getX(), blockUpdate.position.getY(), blockUpdate.position.getZ(), blockUpdate.block );
 
             // Queue corresponding chunk for update
             auto chunkCoord = CHUNK_COORD( blockUpdate.position.getX(), blockUpdate.position.getZ() );
@@ -177,8 +433,8 @@ void World::_CalculateChunkVisibility()
     // Calculate which chunks are visible
     auto transform = m_viewer->getGameObject()->getComponent<Components::Transform>();
 
-    I32 currentChunkCoordX = static_cast<I32>( std::floorf( transform->position.x / CHUNK_SIZE ) );
-    I32 currentChunkCoordY = static_cast<I32>( std::floorf( transform->position.z / CHUNK_SIZE) );
+    I32 currentChunkCoordX = static_cast<I32>( std::floorf( transform->getPosition().x / CHUNK_SIZE ) );
+    I32 currentChunkCoordY = static_cast<I32>( std::floorf( transform->getPosition().z / CHUNK_SIZE) );
 
     for (I32 ring = 0; ring < CHUNK_VIEW_DISTANCE; ring++)
     {
@@ -190,16 +446,25 @@ void World::_CalculateChunkVisibility()
                 {
                     Math::Vec2Int chunkCoords( currentChunkCoordX + x, currentChunkCoordY + y );
 
-                    if ( m_terrainChunks.find(chunkCoords) != m_terrainChunks.end() )
+                    auto it = m_terrainChunks.find( chunkCoords );
+                    if ( it != m_terrainChunks.end() )
                     {
                         // Chunk already exists, so just enable it
-                        m_terrainChunks[chunkCoords]->setActive( true );
-
+                        it->second->setActive( true );
+                        it->second->lastVisibleFrame = m_frame;
                     }
                     else
                     {
                         // Create new chunk and queue it for generating
-                        auto newChunk = std::make_shared<Chunk>( &m_volData, chunkCoords );
+                        GameObject* go = nullptr;
+                        if ( not m_unusedChunkObjects.empty() )
+                        {
+                            go = m_unusedChunkObjects.back();
+                            m_unusedChunkObjects.pop_back();
+                        }
+
+                        auto newChunk = std::make_shared<Chunk>( chunkCoords, go );
+                        newChunk->lastVisibleFrame = m_frame;
                         m_terrainChunks[chunkCoords] = newChunk;
                         m_chunkGenerationList.emplace_back( newChunk );
                     }
@@ -209,66 +474,129 @@ void World::_CalculateChunkVisibility()
     }
 }
 
+//----------------------------------------------------------------------
+void World::_UnloadChunks()
+{
+    I32 unloadDistance = std::max( CHUNK_UNLOAD_DISTANCE, CHUNK_VIEW_DISTANCE + 1 );
+
+    auto transform = m_viewer->getGameObject()->getComponent<Components::Transform>();
+    auto viewerCoords = CHUNK_COORD( transform->getPosition().x, transform->getPosition().z );
+
+    ArrayList<ChunkPtr> unloadCandidates;
+    for (auto& pair : m_terrainChunks)
+    {
+        I32 distance = std::max( std::abs( pair.first.x - viewerCoords.x ), std::abs( pair.first.y - viewerCoords.y ) );
+        if (distance >= unloadDistance && pair.second->pendingJobs == 0)
+            unloadCandidates.push_back( pair.second );
+    }
+
+    // Least recently visible chunks first. Only a few per frame, because each of them might be written to disk.
+    Size numUnloads = std::min( unloadCandidates.size(), (Size)MAX_CHUNK_UNLOADS_PER_FRAME );
+    std::partial_sort( unloadCandidates.begin(), unloadCandidates.begin() + numUnloads, unloadCandidates.end(), []( const ChunkPtr& a, const ChunkPtr& b ) {
+        return a->lastVisibleFrame < b->lastVisibleFrame;
+    } );
+
+    for (Size i = 0; i < numUnloads; i++)
+        _UnloadChunk( unloadCandidates[i] );
+}
+
+//----------------------------------------------------------------------
+void World::_UnloadChunk( const ChunkPtr& chunk )
+{
+    auto coords = chunk->getChunkCoords();
+    if (chunk->voxels && chunk->modified)
+        m_regionStorage.save( coords, *chunk->voxels );
+
+    // Chunks which were never generated might still wait for it
+    auto it = std::find( m_chunkGenerationList.begin(), m_chunkGenerationList.end(), chunk );
+    if (it != m_chunkGenerationList.end())
+        m_chunkGenerationList.erase( it );
+    m_chunkUpdateBatchList.remove( chunk );
+
+    // The game object is kept for the next chunk, but the mesh can be released now
+    chunk->go->getComponent<Components::MeshRenderer>()->setMesh( nullptr );
+    chunk->setActive( false );
+    m_unusedChunkObjects.push_back( chunk->go );
+
+    m_terrainChunks.erase( coords );
+}
+
 //----------------------------------------------------------------------
 void World::_PerformRayCasts()
 {
-    // Program rarely crashes when "m_generating" is uncommented, but otherwise raycasts can be delayed
-    // which causes a stuttering for the raycast physics system right now
-    if ( not m_raycastRequestQueue.empty() && not m_generating )
+    // Jobs never write the voxels of a chunk, so raycasts can be performed immediately
+    while ( not m_raycastRequestQueue.empty() )
     {
-        while ( not m_raycastRequestQueue.empty() )
-        {
-            auto& req = m_raycastRequestQueue.front();
+        auto& req = m_raycastRequestQueue.front();
 
-            ChunkRayCastResult result;
-            if ( _RayCast( req.ray, &result ) )
-                req.callback( result );
+        ChunkRayCastResult result;
+        if ( _RayCast( req.ray, &result ) )
+            req.callback( result );
 
-            m_raycastRequestQueue.pop();
-        }
+        m_raycastRequestQueue.pop();
     }
 }
 
 //----------------------------------------------------------------------
 void World::_ExecuteChunkBatchUpdates()
 {
-    if ( not m_chunkUpdateBatchList.empty() && not m_generating )
-    {
-        m_generating = true;
+    if ( m_chunkUpdateBatchList.empty() )
+        return;
 
-        auto chunkList = m_chunkUpdateBatchList;
-        ASYNC_JOB([=] {
-            std::list<ChunkUpdateComplete> updateCompleteList;
-            for (auto& chunk : chunkList)
-            {
-                auto mesh = _GenerateMesh( chunk->bounds );
-                updateCompleteList.push_back( { chunk, mesh } );
-            }
-            m_chunkUpdateCompleteList.insert( m_chunkUpdateCompleteList.end(), updateCompleteList.begin(), updateCompleteList.end() );
-            m_generating = false;
-        });
-        m_chunkUpdateBatchList.clear();
+    // Only references to the voxels are taken here. Edits afterwards copy them, so the job never sees a change.
+    ArrayList<ChunkUpdateComplete> updates;
+    ArrayList<ChunkNeighbourhood> neighbourhoods;
+    for (auto& chunk : m_chunkUpdateBatchList)
+    {
+        chunk->pendingJobs++;
+        neighbourhoods.push_back( _GetNeighbourhood( *chunk ) );
+        updates.push_back( { chunk, {}, nullptr, false, _GetMissingNeighbours( neighbourhoods.back() ) } );
     }
+    m_chunkUpdateBatchList.clear();
+
+    // All chunks are meshed in one job, so they will be replaced in the same frame
+    m_jobsInFlight++;
+    ASYNC_JOB([=]() mutable {
+        PROFILE_ZONE( "World::MeshChunks" );
+        MEM_SCOPE( Chunks );
+        for (Size i = 0; i < updates.size(); i++)
+        {
+            auto& chunk = *updates[i].chunk;
+            ChunkVolume volume( ConvertRegion( chunk.bounds ) );
+            UnpackChunkNeighbourhood( neighbourhoods[i], chunk.position.x, chunk.position.y, volume );
+            neighbourhoods[i] = {};
+
+            updates[i].meshData = _GenerateMesh( volume, chunk.bounds );
+        }
+        m_chunkUpdateCompleteQueue.push( std::move( updates ) );
+    });
 }
 
 //----------------------------------------------------------------------
 void World::_ExecuteChunkUpdates()
 {
-    // Generate new chunk if requested and not currently generating one
-    if ( not m_chunkGenerationList.empty() && not m_generating )
+    I32 maxJobsInFlight = _GetMaxJobsInFlight();
+    if ( m_chunkGenerationList.empty() || m_jobsInFlight >= maxJobsInFlight )
+        return;
+
+    // The viewer moves, so the priorities are recomputed every frame
+    auto transform = m_viewer->getGameObject()->getComponent<Components::Transform>();
+    Math::Vec2 viewerPos( transform->getPosition().x, transform->getPosition().z );
+    auto distanceToViewer = [&]( const ChunkPtr& chunk ) {
+        F32 dx = chunk->position.x + CHUNK_SIZE * 0.5f - viewerPos.x;
+        F32 dz = chunk->position.y + CHUNK_SIZE * 0.5f - viewerPos.y;
+        return dx * dx + dz * dz;
+    };
+    auto fartherAway = [&]( const ChunkPtr& a, const ChunkPtr& b ) { return distanceToViewer( a ) > distanceToViewer( b ); };
+    std::make_heap( m_chunkGenerationList.begin(), m_chunkGenerationList.end(), fartherAway );
+
+    // Generate the nearest chunks, but only as many as there are threads. Otherwise chunks
+    // requested now would wait behind chunks the player has already left behind.
+    while ( not m_chunkGenerationList.empty() && m_jobsInFlight < maxJobsInFlight )
     {
-        m_generating = true;
-
-        // Can only generate one chunk here, cause if the player changes chunks, those chunks must be rebuild immediately
-        auto nextChunk = m_chunkGenerationList.front();
-        ASYNC_JOB([=] {
-            m_chunkCallback( *nextChunk.get() );
-            auto mesh = _GenerateMesh( nextChunk->bounds );
-            m_chunkUpdateCompleteList.push_back({ nextChunk, mesh });
-            m_generating = false;
-        });
-
-        m_chunkGenerationList.pop_front();
+        std::pop_heap( m_chunkGenerationList.begin(), m_chunkGenerationList.end(), fartherAway );
+        _GenerateChunkAsync( m_chunkGenerationList.back() );
+        m_chunkGenerationList.pop_back();
     }
 }
 
@@ -276,13 +604,33 @@ void World::_ExecuteChunkUpdates()
 void World::_ApplyChunkUpdates()
 {
     // Update chunk with newly generated data
-    for (auto& chunkGen : m_chunkUpdateCompleteList)
+    ArrayList<ChunkUpdateComplete> updates;
+    while ( m_chunkUpdateCompleteQueue.pop( updates ) )
     {
-        auto mr = chunkGen.chunk->go->getComponent<Components::MeshRenderer>();
-        mr->setMesh( chunkGen.mesh );
-        mr->setMaterial( CHUNK_MATERIAL );
+        m_jobsInFlight--;
 
-        //chunkGen.chunk->drawBoundingBox();
+        for (auto& chunkGen : updates)
+        {
+            chunkGen.chunk->pendingJobs--;
+
+            // Newly generated chunks carry their voxels, which are needed for raycasts and block updates
+            bool voxelsArrived = (chunkGen.voxels != nullptr);
+            if (voxelsArrived)
+            {
+                chunkGen.chunk->voxels = std::move( chunkGen.voxels );
+                chunkGen.chunk->volume = nullptr;
+                chunkGen.chunk->modified = chunkGen.generated;
+            }
+
+            auto mr = chunkGen.chunk->go->getComponent<Components::MeshRenderer>();
+            mr->setMesh( CreateMeshForRendering( chunkGen.meshData ) );
+            mr->setMaterial( CHUNK_MATERIAL );
+
+            // The mesh of a chunk without one of its +x/+z neighbours lacks the faces of the seam
+            chunkGen.chunk->missingNeighbours = chunkGen.missingNeighbours;
+            _RemeshMissingSeams( *chunkGen.chunk, voxelsArrived );
+
+            //chunkGen.chunk->drawBoundingBox();
+        }
     }
-    m_chunkUpdateCompleteList.clear();
-}
\ No newline at end of file
+}
@@ -5,13 +5,24 @@
     author: S. Hau
     date: April 20, 2018
 
-    Represents the 3d voxel-world. Because PolyVox allows only accessing
-    the LargeVolume on one thread every request must be buffered...
+    Represents the 3d voxel-world. Every chunk owns its voxels as
+    palette compressed sections (see ChunkVoxels). Jobs generate and
+    mesh chunks in their own RawVolume, several of them in parallel, and
+    hand the results back through a lock-free queue.
+    @Considerations:
+      - Jobs only build the vertex data (see ChunkMeshData). Meshes are
+        created on the main thread, the ResourceManager is not thread-safe.
+      - Voxels of a chunk are only written on the main thread. A job
+        meshing a chunk holds a reference to its voxels, so an edit in
+        the meantime copies them first (copy-on-write).
+      - Chunks at least CHUNK_UNLOAD_DISTANCE away are written into
+        region files (see RegionStorage) and unloaded. They are read back
+        instead of generated again once the viewer returns.
 **********************************************************************/
-#include "PolyVoxCore/LargeVolume.h"
-#include "PolyVoxCore/Raycast.h"
 #include "Physics/ray.h"
+#include "Common/DataStructures/mpsc_queue.hpp"
 #include "chunk.h"
+#include "region_storage.h"
 #include <list>
 
 inline Math::Vec3               ConvertVector(const PolyVox::Vector3DFloat& v) { return Math::Vec3(v.getX(), v.getY(), v.getZ()); }
@@ -42,6 +53,16 @@ struct ChunkRayCastResult
     Block       block       = AIR_BLOCK;
 };
 
+//----------------------------------------------------------------------
+// Vertex data of a chunk, built by the jobs. The mesh is created from it on the main thread.
+struct ChunkMeshData
+{
+    ArrayList<Math::Vec3>   vertices;
+    ArrayList<Math::Vec3>   normals;
+    ArrayList<Math::Vec2>   uvs;        // Texture indices of the block
+    ArrayList<U32>          indices;
+};
+
 typedef std::function<void(const ChunkRayCastResult&)>  RaycastCallback;
 typedef std::function<void(Chunk&)>                     ChunkCallback;
 
@@ -50,7 +71,9 @@ class World
 {
 public:
     static I32          CHUNK_VIEW_DISTANCE;
+    static I32          CHUNK_UNLOAD_DISTANCE;  // Chunks at least this far away are saved and unloaded. Always larger than the view distance.
     static MaterialPtr  CHUNK_MATERIAL;
+    static bool         GREEDY_MESHING;     // Merge coplanar faces into larger quads instead of using the PolyVox extractor
 
     World();
     static World& Get() { static World world; return world; }
@@ -64,17 +87,19 @@ public:
 
     // Whenever the viewer reaches a point where a new chunk has to be generated,
     // this callback will be called and should initialize the data e.g. from a noise map.
-    // Be aware that this function is called on another thread.
+    // Be aware that this function is called on several threads at the same time.
     void setChunkCallback(const ChunkCallback& cb) { m_chunkCallback = cb; }
 
     // Set the viewer transform which determines where chunks will be generated
     void SetViewer(Components::Transform* viewer) { m_viewer = viewer; }
 
 private:
-    PolyVox::LargeVolume<Block>                 m_volData;              // The voxel volume
     std::unordered_map<Math::Vec2Int, ChunkPtr> m_terrainChunks;        // Stores the generated terrain chunks
-    std::list<ChunkPtr>                         m_chunkGenerationList;  // Contains chunks which should be generated for the first time
+    ArrayList<ChunkPtr>                         m_chunkGenerationList;  // Chunks which should be generated for the first time. Heap, nearest chunk to the viewer first
     Components::Transform*                      m_viewer;               // Viewer transform
+    RegionStorage                               m_regionStorage;        // Unloaded chunks are written to and loaded from here
+    ArrayList<GameObject*>                      m_unusedChunkObjects;   // Game objects of unloaded chunks. Destroying them during the scene tick is not allowed.
+    U64                                         m_frame = 0;
 
     // This list is similar to above, but is 1. prioritized e.g. gets executed before the list above AND 2. gets executed in a batch
     // This is required for destroying edge blocks, so several chunks have to be regenerated and replaced at the SAME TIME.
@@ -91,12 +116,18 @@ private:
     std::queue<RayCastRequest> m_raycastRequestQueue;  // Contains raycast requests
 
     //----------------------------------------------------------------------
+    using ChunkVolume = PolyVox::RawVolume<Block>;
     struct ChunkUpdateComplete
     {
-        ChunkPtr chunk;
-        MeshPtr  mesh;
+        ChunkPtr        chunk;
+        ChunkMeshData   meshData;
+        ChunkVoxelsPtr  voxels;             // Newly generated voxels of the chunk. Null for a remesh
+        bool            generated = false;  // Voxels come from the chunk callback and not from the region file
+        U8              missingNeighbours = 0; // See Chunk::missingNeighbours
     };
-    std::list<ChunkUpdateComplete> m_chunkUpdateCompleteList; // Stores the resulting mesh and the chunk to update
+
+    // Every entry is the result of one job and gets applied in the same frame (see m_chunkUpdateBatchList)
+    Common::MPSCQueue<ArrayList<ChunkUpdateComplete>> m_chunkUpdateCompleteQueue;
 
     //----------------------------------------------------------------------
     struct BlockUpdate
@@ -107,8 +138,8 @@ private:
     };
     std::vector<BlockUpdate> m_blockUpdates; // Stores single block updates
 
-    // True whenever a chunk is currently generating (cause the LargeVolume can be only used by one thread at a time)
-    bool m_generating = false;
+    // Amount of jobs which have not delivered their result yet. Only touched on the main thread.
+    I32 m_jobsInFlight = 0;
 
     // Will be called whenever a new chunk should be filled with data
     ChunkCallback m_chunkCallback;
@@ -117,14 +148,28 @@ private:
     void update(F32 delta);
     void shutdown();
 
-    // Create a mesh which contains the given region
-    MeshPtr _GenerateMesh(const Math::AABB& region);
+    // Builds the vertex data of the given region. Can be called from any thread.
+    ChunkMeshData   _GenerateMesh(ChunkVolume& volume, const Math::AABB& region);
     bool    _RayCast(const Physics::Ray& ray, ChunkRayCastResult* result);
+
+    // Voxel access in world coordinates. Voxels of chunks which are not generated yet are air.
+    Block   _GetVoxel(I32 x, I32 y, I32 z) const;
+    void    _SetVoxel(I32 x, I32 y, I32 z, Block block);
+    Chunk*  _GetGeneratedChunk(I32 x, I32 z) const;
+
+    ChunkNeighbourhood  _GetNeighbourhood(const Chunk& chunk) const;
+    static U8           _GetMissingNeighbours(const ChunkNeighbourhood& neighbourhood);
+    void                _RemeshMissingSeams(const Chunk& chunk, bool voxelsArrived);
+    static void         _PackVoxels(const ChunkVolume& volume, const Chunk& chunk, ChunkVoxels& voxels);
     void    _UpdateChunkInBatch(const Math::Vec2Int& coords);
+    void    _GenerateChunkAsync(const ChunkPtr& chunk);
+    I32     _GetMaxJobsInFlight() const;
+    void    _UnloadChunk(const ChunkPtr& chunk);
 
 
     inline void _ExecuteBlockUpdates();
     inline void _CalculateChunkVisibility();
+    inline void _UnloadChunks();
     inline void _PerformRayCasts();
     inline void _ExecuteChunkBatchUpdates();
     inline void _ExecuteChunkUpdates();
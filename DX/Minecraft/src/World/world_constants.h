@@ -2,5 +2,8 @@
 
 #define CHUNK_SIZE      16
 #define CHUNK_HEIGHT    64
+#define CHUNK_SECTION_HEIGHT    64                                          // Voxel storage is split into sections of this height
+#define CHUNK_SECTIONS          (2 * CHUNK_HEIGHT / CHUNK_SECTION_HEIGHT)   // Chunks span y from -CHUNK_HEIGHT to CHUNK_HEIGHT
 #define BLOCK_SIZE      1
-#define WATER_LEVEL     4.0f
\ No newline at end of file
+#define WATER_LEVEL     4.0f
+#define MAX_CHUNK_UNLOADS_PER_FRAME 8                                       // Every unloaded chunk might be written to disk
\ No newline at end of file
@@ -3,9 +3,20 @@
 #include "DX.h"
 #include "OS/PlatformTimer/platform_timer.h"
 #include "Memory/Allocators/pool_allocator.h"
+#include "Memory/Allocators/concurrent_pool_allocator.h"
 #include "Memory/Allocators/pool_list_allocator.h"
 #include "Memory/Allocators/stack_allocator.h"
 #include "Memory/Allocators/universal_allocator.h"
 #include "Memory/Allocators/universal_allocator_defragmented.h"
+#include "Memory/Allocators/tlsf_allocator.h"
+#include "Common/radix_sort.hpp"
+#include "OS/Threading/parallel.hpp"
+#include "Ext/JSON/json.hpp"
+#include "Graphics/i_shader.h"
+#include "Graphics/camera.h"
+#include "Math/frustum_culler.h"
+#include "Math/loose_octree.h"
+#include "Core/render_system.h"
+#include "GameplayLayer/Components/Rendering/particle_streams.h"
 
 using namespace Core;
\ No newline at end of file
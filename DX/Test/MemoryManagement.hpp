@@ -43,6 +43,57 @@ void TestMemory()
     }
 
 
+    {
+        LOG("MEASURE CONCURRENT POOL ALLOCATOR...");
+        const U32 NUM_JOBS = 8;
+        Memory::ConcurrentPoolAllocator concurrentPoolAllocator(sizeof(A), SIZE * NUM_JOBS);
+        {
+            AutoClock clock;
+
+            OS::JobHandle jobs[NUM_JOBS];
+            for (U32 j = 0; j < NUM_JOBS; j++)
+            {
+                jobs[j] = ASYNC_JOB([&concurrentPoolAllocator] {
+                    A* a4[SIZE];
+                    for (int i = 0; i < SIZE; i++)
+                        a4[i] = concurrentPoolAllocator.allocate<A>();
+                    for (int i = 0; i < SIZE; i++)
+                        concurrentPoolAllocator.deallocate(a4[i]);
+                    concurrentPoolAllocator.flushThreadCache();
+                });
+            }
+            for (U32 j = 0; j < NUM_JOBS; j++)
+                jobs[j].wait();
+        }
+    }
+
+    {
+        // Threads exiting without flushThreadCache() must not strand their cached chunks,
+        // and more threads than slots over time must still get a magazine each
+        const U32 NUM_CHUNKS = 1000;
+        Memory::ConcurrentPoolAllocator concurrentPoolAllocator(sizeof(A), NUM_CHUNKS);
+        for (U32 t = 0; t < 3 * CONCURRENT_POOL_ALLOCATOR_MAX_THREADS; t++)
+        {
+            std::thread thread([&concurrentPoolAllocator] {
+                A* a5[10];
+                for (auto& a : a5)
+                    a = concurrentPoolAllocator.allocate<A>();
+                for (auto a : a5)
+                    concurrentPoolAllocator.deallocate(a);
+            });
+            thread.join();
+        }
+
+        static A* a6[NUM_CHUNKS];
+        for (U32 i = 0; i < NUM_CHUNKS; i++)
+        {
+            a6[i] = concurrentPoolAllocator.allocate<A>();
+            ASSERT( a6[i] != nullptr );
+        }
+        for (U32 i = 0; i < NUM_CHUNKS; i++)
+            concurrentPoolAllocator.deallocate(a6[i]);
+    }
+
     {
         LOG("MEASURE STACK ALLOCATOR...");
         static A* a3[SIZE];
@@ -122,3 +173,411 @@ void TestMemory()
 
 
 }
+
+//----------------------------------------------------------------------
+// Allocates and frees random sizes and alignments and checks that no
+// allocation overlaps another one. Afterwards everything must be
+// coalesced into a single free block again.
+//----------------------------------------------------------------------
+void TestTLSFAllocator()
+{
+    const Size POOL_SIZE = 4 * 1024 * 1024;
+    Memory::TLSFAllocator allocator( POOL_SIZE );
+
+    const Size freeBytesAtStart = allocator.getFreeBytes();
+    const Size largestAtStart = allocator.getLargestFreeBlock();
+    ASSERT( largestAtStart > 0 && largestAtStart <= freeBytesAtStart );
+
+    struct Allocation { Byte* data; Size bytes; Byte pattern; };
+    ArrayList<Allocation> allocations;
+
+    srand( 42 );
+    for (I32 i = 0; i < 100000; i++)
+    {
+        if (allocations.size() < 512 && (rand() % 3 != 0 || allocations.empty()))
+        {
+            Size bytes = 1 + rand() % ((rand() % 8 == 0) ? 16384 : 256);
+            Size alignment = (Size)1 << (rand() % 8);
+            Byte* data = reinterpret_cast<Byte*>( allocator.allocateRaw( bytes, alignment ) );
+            ASSERT( data != nullptr && (reinterpret_cast<Size>( data ) & (alignment - 1)) == 0 );
+
+            Byte pattern = static_cast<Byte>( i );
+            memset( data, pattern, bytes );
+            allocations.push_back( { data, bytes, pattern } );
+        }
+        else
+        {
+            Size index = rand() % allocations.size();
+            Allocation allocation = allocations[index];
+            for (Size b = 0; b < allocation.bytes; b++)
+                ASSERT( allocation.data[b] == allocation.pattern && "TLSFAllocator: Allocations overlap." );
+
+            allocator.deallocate( allocation.data );
+            allocations[index] = allocations.back();
+            allocations.pop_back();
+        }
+
+        // The reported largest allocation must always succeed
+        if (i % 1000 == 0)
+        {
+            Size largest = allocator.getLargestFreeBlock();
+            void* data = allocator.allocateRaw( largest );
+            ASSERT( data != nullptr );
+            allocator.deallocate( data );
+        }
+    }
+
+    for (auto& allocation : allocations)
+        allocator.deallocate( allocation.data );
+
+    ASSERT( allocator.getFreeBytes() == freeBytesAtStart );
+    ASSERT( allocator.getLargestFreeBlock() == largestAtStart );
+
+    // Constructors and destructors are called for every object
+    static I32 sAlive = 0;
+    struct Counted { Counted() { sAlive++; } ~Counted() { sAlive--; } U64 value[3]; };
+
+    Counted* objects = allocator.allocate<Counted>( 10 );
+    ASSERT( sAlive == 10 );
+    allocator.deallocate( objects );
+    ASSERT( sAlive == 0 );
+    ASSERT( allocator.getLargestFreeBlock() == largestAtStart );
+}
+
+//----------------------------------------------------------------------
+// Replays a recorded allocation trace against the UniversalAllocator and
+// the TLSFAllocator. Reports the average and worst latency of every
+// operation and the fragmentation at the point of the most live
+// allocations (1 - largestFreeBlock / freeBytes).
+//----------------------------------------------------------------------
+struct AllocationTraceEvent
+{
+    U32 id;
+    U32 bytes;      // Zero: Free the allocation with the given id
+    U32 alignment;
+};
+
+ArrayList<AllocationTraceEvent> RecordAllocationTrace(U32 numEvents, U32 seed)
+{
+    // Mostly small short lived allocations, some mid sized and few large long living ones
+    std::mt19937 rng( seed );
+    ArrayList<AllocationTraceEvent> trace;
+    ArrayList<U32> live;
+    U32 nextID = 0;
+
+    trace.reserve( numEvents );
+    while (trace.size() < numEvents)
+    {
+        bool doAllocate = live.empty() || (rng() % 4096) > live.size();
+        if (doAllocate)
+        {
+            U32 category = rng() % 100;
+            U32 bytes = category < 70 ? 8 + rng() % 248 : category < 95 ? 256 + rng() % 8192 : 8192 + rng() % (128 * 1024);
+            U32 alignment = (rng() % 20 == 0) ? 64 : 8;
+            trace.push_back( { nextID, bytes, alignment } );
+            live.push_back( nextID++ );
+        }
+        else
+        {
+            U32 index = rng() % live.size();
+            trace.push_back( { live[index], 0, 0 } );
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+
+    for (U32 id : live)
+        trace.push_back( { id, 0, 0 } );
+
+    return trace;
+}
+
+template <typename TAllocator>
+void ReplayAllocationTrace(const char* name, TAllocator& allocator, const ArrayList<AllocationTraceEvent>& trace)
+{
+    ArrayList<void*> pointers( trace.size() );
+    U64 totalTicks = 0, maxAllocateTicks = 0, maxDeallocateTicks = 0;
+    Size live = 0, maxLive = 0;
+    F64 fragmentation = 0.0;
+
+    for (auto& event : trace)
+    {
+        U64 begin = OS::PlatformTimer::getTicks();
+        if (event.bytes > 0)
+            pointers[event.id] = allocator.allocateRaw( event.bytes, event.alignment );
+        else
+            allocator.deallocate( pointers[event.id] );
+        U64 ticks = OS::PlatformTimer::getTicks() - begin;
+
+        totalTicks += ticks;
+        if (event.bytes > 0)
+        {
+            maxAllocateTicks = std::max( maxAllocateTicks, ticks );
+            live++;
+        }
+        else
+        {
+            maxDeallocateTicks = std::max( maxDeallocateTicks, ticks );
+            live--;
+        }
+
+        if (live > maxLive)
+        {
+            maxLive = live;
+            fragmentation = 1.0 - (F64)allocator.getLargestFreeBlock() / allocator.getFreeBytes();
+        }
+    }
+
+    LOG( String( name ) + ": Avg: " + TS( OS::PlatformTimer::ticksToNanoSeconds( totalTicks ) / trace.size() ) + "ns"
+         " Max allocate: " + TS( OS::PlatformTimer::ticksToMicroSeconds( maxAllocateTicks ) ) + "us"
+         " Max deallocate: " + TS( OS::PlatformTimer::ticksToMicroSeconds( maxDeallocateTicks ) ) + "us"
+         " Fragmentation at " + TS( maxLive ) + " live allocations: " + TS( fragmentation * 100.0 ) + "%" );
+}
+
+void BenchmarkAllocatorTrace()
+{
+    const Size POOL_SIZE = 64 * 1024 * 1024;
+    auto trace = RecordAllocationTrace( 50000, 1337 );
+
+    {
+        Memory::UniversalAllocator universalAllocator( POOL_SIZE );
+        struct Adapter
+        {
+            Memory::UniversalAllocator& allocator;
+            void* allocateRaw(Size bytes, Size alignment)   { return allocator.allocateRaw( bytes, alignment ); }
+            void  deallocate(void* data)                    { allocator.deallocate( data ); }
+            Size  getLargestFreeBlock() const               { return allocator.getLargestFreeChunk(); }
+            Size  getFreeBytes() const                      { return allocator.getFreeBytes(); }
+        } adapter{ universalAllocator };
+        ReplayAllocationTrace( "UniversalAllocator", adapter, trace );
+    }
+
+    {
+        Memory::TLSFAllocator tlsfAllocator( POOL_SIZE );
+        ReplayAllocationTrace( "TLSFAllocator", tlsfAllocator, trace );
+    }
+}
+
+//----------------------------------------------------------------------
+// Fragments a UniversalAllocatorDefragmented and compacts it with small
+// budgeted steps, while allocating and deallocating in between steps.
+// All values must survive the relocations.
+//----------------------------------------------------------------------
+void TestIncrementalDefragmentation()
+{
+    const U32 NUM_ALLOCATIONS = 4000;
+    Memory::UniversalAllocatorDefragmented allocator( NUM_ALLOCATIONS * 64, NUM_ALLOCATIONS );
+
+    struct Allocation { Memory::UAPtr<U64> ptr; U64 count; U64 firstValue; };
+    ArrayList<Allocation> allocations;
+
+    auto allocate = [&](U64 value) {
+        U64 count = 1 + value % 4;
+        Memory::UAPtr<U64> ptr = allocator.allocate<U64>( count );
+        for (U64 i = 0; i < count; i++)
+            ptr.getRaw()[i] = value + i;
+        allocations.push_back( { ptr, count, value } );
+    };
+
+    {
+        AutoClock clock;
+        for (U64 i = 0; i < NUM_ALLOCATIONS; i++)
+            allocate( i * 1000 );
+    }
+
+    // Free every third allocation to create holes
+    for (Size i = allocations.size(); i-- > 0;)
+    {
+        if (i % 3 == 0)
+        {
+            allocator.deallocate( allocations[i].ptr );
+            allocations.erase( allocations.begin() + i );
+        }
+    }
+    ASSERT( allocator.canBeDefragmented() );
+
+    U32 numSteps = 0;
+    while ( allocator.defragmentStep( Memory::DefragmentationBudget::Bytes( 1024 ) ) )
+    {
+        // Gameplay keeps allocating between steps
+        if (++numSteps % 8 == 0)
+        {
+            allocator.deallocate( allocations[numSteps % allocations.size()].ptr );
+            allocations.erase( allocations.begin() + numSteps % allocations.size() );
+            allocate( numSteps * 1000 + 7 );
+        }
+    }
+    ASSERT( not allocator.canBeDefragmented() );
+    LOG( "Defragmented in " + TS( numSteps ) + " steps." );
+
+    for (auto& allocation : allocations)
+    {
+        for (U64 i = 0; i < allocation.count; i++)
+            ASSERT( allocation.ptr.getRaw()[i] == allocation.firstValue + i );
+        allocator.deallocate( allocation.ptr );
+    }
+
+    // A chunk whose alignment needs more than the hole in front of it can't be moved.
+    // Steps must stop right away instead of retrying it until the layout changes.
+    {
+        Memory::UniversalAllocatorDefragmented stuckAllocator( 1024, 8 );
+        Memory::UAPtr<Byte> small   = stuckAllocator.allocateRaw( 1 );
+        Memory::UAPtr<Byte> aligned = stuckAllocator.allocateRaw( 64, 128 );
+        Memory::UAPtr<U64>  last    = stuckAllocator.allocate<U64>();
+        *last.getRaw() = 42;
+
+        stuckAllocator.deallocate( small );
+        ASSERT( stuckAllocator.canBeDefragmented() );
+        ASSERT( not stuckAllocator.defragmentStep( Memory::DefragmentationBudget::Bytes( 1024 ) ) );
+        ASSERT( not stuckAllocator.canBeDefragmented() );
+
+        stuckAllocator.deallocate( aligned );
+        ASSERT( stuckAllocator.canBeDefragmented() );
+        while ( stuckAllocator.defragmentStep( Memory::DefragmentationBudget::Bytes( 1024 ) ) )
+            ;
+        ASSERT( not stuckAllocator.canBeDefragmented() );
+        ASSERT( *last.getRaw() == 42 );
+        stuckAllocator.deallocate( last );
+    }
+}
+
+//----------------------------------------------------------------------
+// Several jobs allocate from a FrameAllocator at once. Allocations must
+// not overlap and must survive exactly FRAME_ALLOCATOR_NUM_FRAMES frames.
+//----------------------------------------------------------------------
+void TestFrameAllocator()
+{
+    Core::MemoryManagement::FrameAllocator frameAllocator;
+    frameAllocator.init( 4 * 1024 * 1024 );
+
+    const U32 NUM_JOBS = 8;
+    const U32 ALLOCATIONS_PER_JOB = 2000;
+
+    const Size BIG_COUNT = FRAME_ALLOCATOR_REGION_SIZE / sizeof(U32);
+
+    // Every value must still be the one its job wrote in the given frame
+    auto checkAllocations = [&](const ArrayList<U32*>* allocations, U32 frame) {
+        for (U32 j = 0; j < NUM_JOBS; j++)
+        {
+            U32 value = frame * NUM_JOBS + j + 1;
+            for (Size i = 0; i < ALLOCATIONS_PER_JOB; i++)
+                for (U32 k = 0; k < 1 + i % 32; k++)
+                    ASSERT( allocations[j][i][k] == value );
+            for (Size k = 0; k < BIG_COUNT; k++)
+                ASSERT( allocations[j][ALLOCATIONS_PER_JOB][k] == value );
+        }
+    };
+
+    ArrayList<U32*> previousFrame[NUM_JOBS];
+    for (U32 frame = 0; frame < 4; frame++)
+    {
+        ArrayList<U32*> allocations[NUM_JOBS];
+        OS::JobHandle jobs[NUM_JOBS];
+        for (U32 j = 0; j < NUM_JOBS; j++)
+        {
+            jobs[j] = ASYNC_JOB([&, j] {
+                U32 value = frame * NUM_JOBS + j + 1;
+                for (U32 i = 0; i < ALLOCATIONS_PER_JOB; i++)
+                {
+                    U32 count = 1 + i % 32;
+                    U32* data = frameAllocator.allocate<U32>( count, value );
+                    ASSERT( data != nullptr && (reinterpret_cast<Size>( data ) & (alignof(U32) - 1)) == 0 );
+                    allocations[j].push_back( data );
+                }
+
+                // Bigger than a region, goes directly to the stack
+                allocations[j].push_back( frameAllocator.allocate<U32>( BIG_COUNT, value ) );
+            });
+        }
+        for (U32 j = 0; j < NUM_JOBS; j++)
+            jobs[j].wait();
+
+        // Allocations of different jobs don't overlap
+        checkAllocations( allocations, frame );
+
+        // Memory of the last frame is still alive and was not reused
+        if (frame > 0)
+            checkAllocations( previousFrame, frame - 1 );
+        for (U32 j = 0; j < NUM_JOBS; j++)
+            previousFrame[j] = allocations[j];
+
+        frameAllocator.endFrame();
+        ASSERT( frameAllocator.getFrame() == frame + 1 );
+    }
+
+    // STL containers can use the frame allocator as well
+    Core::MemoryManagement::FrameArrayList<I32> list( frameAllocator );
+    for (I32 i = 0; i < 1000; i++)
+        list.push_back( i );
+    ASSERT( list[999] == 999 );
+
+    frameAllocator.shutdown();
+
+    // A new allocator at the address of a destroyed one must not continue in the stale region of this thread
+    alignas(Core::MemoryManagement::FrameAllocator) Byte storage[sizeof( Core::MemoryManagement::FrameAllocator )];
+    auto oldAllocator = new (storage) Core::MemoryManagement::FrameAllocator();
+    oldAllocator->init( FRAME_ALLOCATOR_REGION_SIZE );
+    Byte* stale = reinterpret_cast<Byte*>( oldAllocator->allocateRaw( 1 ) );
+    oldAllocator->shutdown();
+    oldAllocator->~FrameAllocator();
+
+    auto newAllocator = new (storage) Core::MemoryManagement::FrameAllocator();
+    newAllocator->init( FRAME_ALLOCATOR_REGION_SIZE );
+    ASSERT( newAllocator->getFrame() == 0 );
+    ASSERT( newAllocator->allocateRaw( 1 ) != stale + 1 ); // A fresh region starts 16 byte aligned
+    newAllocator->shutdown();
+    newAllocator->~FrameAllocator();
+}
+
+//----------------------------------------------------------------------
+// Allocations inside a MEM_SCOPE are counted for that tag only and a
+// crossed budget is reported exactly once.
+//----------------------------------------------------------------------
+void TestMemoryTags()
+{
+    using namespace Core::MemoryManagement;
+
+    auto before = MemoryTracker::getTagStats( EMemoryTag::Debug );
+    MemoryTracker::setBudget( EMemoryTag::Debug, before.bytesAllocated + 1024 );
+    MemoryTracker::setCallstackSampleRate( 1 );
+
+    ArrayList<Byte*> allocations;
+    allocations.reserve( 4 );
+    {
+        MEM_SCOPE( Debug );
+        ASSERT( MemoryTracker::getCurrentTag() == EMemoryTag::Debug );
+        {
+            MEM_SCOPE( General );
+            ASSERT( MemoryTracker::getCurrentTag() == EMemoryTag::General );
+        }
+
+        for (I32 i = 0; i < 4; i++)
+            allocations.push_back( new Byte[512] );
+    }
+    ASSERT( MemoryTracker::getCurrentTag() == EMemoryTag::General );
+
+    auto during = MemoryTracker::getTagStats( EMemoryTag::Debug );
+    ASSERT( during.bytesAllocated - before.bytesAllocated == 4 * 512 );
+    ASSERT( during.numAllocations - before.numAllocations == 4 );
+    ASSERT( during.totalAllocations - before.totalAllocations == 4 );
+    ASSERT( during.peakBytesAllocated >= during.bytesAllocated );
+    ASSERT( MemoryTracker::consumeBudgetExceeded( EMemoryTag::Debug ) );
+    ASSERT( not MemoryTracker::consumeBudgetExceeded( EMemoryTag::Debug ) );
+
+    {
+        String report = MemoryTracker::getReport();
+        ASSERT( report.find( "Debug" ) != String::npos );
+        ASSERT( report.find( "Live sampled allocations" ) != String::npos );
+    }
+
+    // Frees are counted for the tag of the allocation, not the current one
+    for (auto allocation : allocations)
+        delete[] allocation;
+
+    auto after = MemoryTracker::getTagStats( EMemoryTag::Debug );
+    ASSERT( after.bytesAllocated == before.bytesAllocated );
+    ASSERT( after.numAllocations == before.numAllocations );
+
+    MemoryTracker::setCallstackSampleRate( 0 );
+    MemoryTracker::setBudget( EMemoryTag::Debug, 0 );
+}
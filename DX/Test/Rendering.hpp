@@ -0,0 +1,524 @@
+#pragma once
+
+//----------------------------------------------------------------------
+// Sorts synthetic draw lists of 1k to 100k draws. Compares the old
+// comparator sort, which chases material->shader on every comparison,
+// against the radix sort over precomputed 64-Bit keys used by
+// CommandBuffer::sortDrawCommands().
+//----------------------------------------------------------------------
+void BenchmarkDrawCommandSort()
+{
+    struct FakeShader   { I32 renderQueue; };
+    struct FakeMaterial { FakeShader* shader; };
+    struct FakeDraw     { FakeMaterial* material; F32 distance; };
+    struct SortItem     { U64 key; U32 index; };
+
+    const I32 NUM_SHADERS   = 16;
+    const I32 NUM_MATERIALS = 256;
+    const I32 NUM_RUNS      = 10;
+
+    srand( 1337 );
+
+    // Most shaders are opaque, some are transparent
+    ArrayList<FakeShader> shaders( NUM_SHADERS );
+    for (I32 i = 0; i < NUM_SHADERS; i++)
+        shaders[i].renderQueue = (i % 4 == 0) ? (I32)Graphics::RenderQueue::Transparent : (I32)Graphics::RenderQueue::Geometry;
+
+    ArrayList<FakeMaterial> materials( NUM_MATERIALS );
+    for (I32 i = 0; i < NUM_MATERIALS; i++)
+        materials[i].shader = &shaders[rand() % NUM_SHADERS];
+
+    for (U32 numDraws : { 1000, 5000, 10000, 50000, 100000 })
+    {
+        ArrayList<FakeDraw> draws( numDraws );
+        for (auto& draw : draws)
+            draw = { &materials[rand() % NUM_MATERIALS], (F32)(rand() % 10000) * 0.1f };
+
+        // Old path: comparator sort with pointer chasing, then sort transparent draws by distance
+        ArrayList<FakeDraw*> drawPtrs( numDraws );
+        F64 comparatorSeconds = 0.0;
+        for (I32 run = 0; run < NUM_RUNS; run++)
+        {
+            for (U32 i = 0; i < numDraws; i++)
+                drawPtrs[i] = &draws[i];
+
+            U64 begin = OS::PlatformTimer::getTicks();
+            std::sort( drawPtrs.begin(), drawPtrs.end(), [](FakeDraw* d1, FakeDraw* d2) {
+                return d1->material->shader->renderQueue < d2->material->shader->renderQueue;
+            } );
+            auto itTransparent = std::find_if( drawPtrs.begin(), drawPtrs.end(), [](FakeDraw* d) {
+                return d->material->shader->renderQueue >= (I32)Graphics::RenderQueue::BackToFrontBoundary;
+            } );
+            std::sort( itTransparent, drawPtrs.end(), [](FakeDraw* d1, FakeDraw* d2) {
+                return d1->distance > d2->distance;
+            } );
+            comparatorSeconds += OS::PlatformTimer::ticksToSeconds( OS::PlatformTimer::getTicks() - begin );
+        }
+
+        // New path: build the keys in one pass, then radix sort
+        ArrayList<SortItem> items( numDraws );
+        ArrayList<SortItem> temp( numDraws );
+        F64 radixSeconds = 0.0;
+        for (I32 run = 0; run < NUM_RUNS; run++)
+        {
+            U64 begin = OS::PlatformTimer::getTicks();
+            for (U32 i = 0; i < numDraws; i++)
+            {
+                U32 distanceBits;
+                memcpy( &distanceBits, &draws[i].distance, sizeof( distanceBits ) );
+
+                U64 queue = (U64)(draws[i].material->shader->renderQueue + 0x8000);
+                U64 key = (queue << 48) | (((U64)draws[i].material & 0xFFF) << 24);
+                if (draws[i].material->shader->renderQueue >= (I32)Graphics::RenderQueue::BackToFrontBoundary)
+                    key = (queue << 48) | (U64)(~distanceBits);
+                else
+                    key |= (distanceBits >> 16);
+
+                items[i] = { key, i };
+            }
+            Common::RadixSort64( items.data(), temp.data(), numDraws, [](const SortItem& item) { return item.key; } );
+            radixSeconds += OS::PlatformTimer::ticksToSeconds( OS::PlatformTimer::getTicks() - begin );
+        }
+
+        bool sorted = std::is_sorted( items.begin(), items.end(), [](const SortItem& a, const SortItem& b) { return a.key < b.key; } );
+        ASSERT( sorted );
+
+        LOG( "[" + TS(numDraws) + " Draws] std::sort: " + TS( comparatorSeconds * 1000.0 / NUM_RUNS ) + "ms"
+             " RadixSort: " + TS( radixSeconds * 1000.0 / NUM_RUNS ) + "ms" );
+    }
+}
+
+//----------------------------------------------------------------------
+// Compares the batched frustum culling against Camera::cull() for random
+// boxes. Translated boxes must give exactly the same result, rotated
+// boxes are enlarged to a world space AABB and may only be more
+// conservative. The simd, scalar and multithreaded path must always agree.
+//----------------------------------------------------------------------
+void TestFrustumCulling()
+{
+    const I32 NUM_BOXES = 10000;
+
+    OS::ThreadPool threadPool( 4 );
+
+    Graphics::Camera camera;
+    camera.setProjection( DirectX::XMMatrixPerspectiveFovLH( DirectX::XMConvertToRadians( 60.0f ), 16.0f / 9.0f, 0.1f, 100.0f ) );
+    camera.setModelMatrix( DirectX::XMMatrixRotationRollPitchYaw( 0.3f, 0.7f, 0.0f ) * DirectX::XMMatrixTranslation( 5.0f, 2.0f, -10.0f ) );
+
+    auto randomFloat = [](F32 min, F32 max) { return min + (max - min) * (rand() / (F32)RAND_MAX); };
+
+    srand( 42 );
+    for (bool rotated : { false, true })
+    {
+        Math::FrustumCuller culler;
+        ArrayList<bool> expected;
+        for (I32 i = 0; i < NUM_BOXES; i++)
+        {
+            Math::Vec3 min( randomFloat( -3.0f, 0.0f ), randomFloat( -3.0f, 0.0f ), randomFloat( -3.0f, 0.0f ) );
+            Math::Vec3 max( randomFloat( 0.0f, 3.0f ), randomFloat( 0.0f, 3.0f ), randomFloat( 0.0f, 3.0f ) );
+            Math::AABB bounds( min, max );
+
+            auto worldMatrix = DirectX::XMMatrixTranslation( randomFloat( -120.0f, 120.0f ), randomFloat( -120.0f, 120.0f ), randomFloat( -120.0f, 120.0f ) );
+            if (rotated)
+                worldMatrix = DirectX::XMMatrixRotationRollPitchYaw( randomFloat( 0.0f, 6.0f ), randomFloat( 0.0f, 6.0f ), randomFloat( 0.0f, 6.0f ) ) * worldMatrix;
+
+            culler.add( bounds, worldMatrix );
+            expected.push_back( camera.cull( bounds, worldMatrix ) );
+        }
+
+        culler.cullScalar( camera.getFrustumPlanes() );
+        ArrayList<bool> scalarResult;
+        for (I32 i = 0; i < NUM_BOXES; i++)
+            scalarResult.push_back( culler.isVisible( i ) );
+
+        culler.cull( camera.getFrustumPlanes(), &threadPool );
+        ArrayList<bool> parallelResult;
+        for (I32 i = 0; i < NUM_BOXES; i++)
+            parallelResult.push_back( culler.isVisible( i ) );
+
+        culler.cull( camera.getFrustumPlanes() );
+
+        I32 numVisible = 0;
+        for (I32 i = 0; i < NUM_BOXES; i++)
+        {
+            bool visible = culler.isVisible( i );
+            ASSERT( visible == scalarResult[i] );
+            ASSERT( visible == parallelResult[i] );
+
+            if (rotated)
+                ASSERT( visible || not expected[i] );
+            else
+                ASSERT( visible == expected[i] );
+
+            numVisible += visible ? 1 : 0;
+        }
+
+        LOG( String( rotated ? "[Rotated]" : "[Translated]" ) + " Visible: " + TS( numVisible ) + "/" + TS( NUM_BOXES ) );
+    }
+}
+
+//----------------------------------------------------------------------
+// Culls random boxes against four orthographic cascades in one pass.
+// Bit i of every mask must match the batched culling against cascade i.
+//----------------------------------------------------------------------
+void TestCascadeCulling()
+{
+    const I32 NUM_BOXES = 10000;
+    const U32 NUM_CASCADES = 4;
+
+    auto lightMatrix = DirectX::XMMatrixRotationRollPitchYaw( 0.8f, 0.4f, 0.0f );
+
+    ArrayList<Math::FrustumPlanes> cascadePlanes;
+    for (U32 cascade = 0; cascade < NUM_CASCADES; cascade++)
+    {
+        F32 size = 10.0f * (cascade + 1);
+        Graphics::Camera camera( -size, size, -size, size, -100.0f, 100.0f );
+        camera.setModelMatrix( lightMatrix * DirectX::XMMatrixTranslation( 0.0f, 0.0f, 15.0f * cascade ) );
+        cascadePlanes.push_back( camera.getFrustumPlanes() );
+    }
+
+    auto randomFloat = [](F32 min, F32 max) { return min + (max - min) * (rand() / (F32)RAND_MAX); };
+
+    srand( 42 );
+    Math::FrustumCuller culler;
+    ArrayList<U32> masks;
+    for (I32 i = 0; i < NUM_BOXES; i++)
+    {
+        Math::AABB bounds( Math::Vec3( -1.0f, -1.0f, -1.0f ), Math::Vec3( 1.0f, 1.0f, 1.0f ) );
+        auto worldMatrix = DirectX::XMMatrixRotationRollPitchYaw( randomFloat( 0.0f, 6.0f ), randomFloat( 0.0f, 6.0f ), randomFloat( 0.0f, 6.0f ) )
+                         * DirectX::XMMatrixTranslation( randomFloat( -60.0f, 60.0f ), randomFloat( -60.0f, 60.0f ), randomFloat( -60.0f, 60.0f ) );
+
+        culler.add( bounds, worldMatrix );
+
+        Math::Vec3 center, extent;
+        Math::TransformBounds( bounds, worldMatrix, center, extent );
+        masks.push_back( Math::CullFrustums( center, extent, cascadePlanes.data(), NUM_CASCADES ) );
+    }
+
+    for (U32 cascade = 0; cascade < NUM_CASCADES; cascade++)
+    {
+        culler.cull( cascadePlanes[cascade] );
+
+        I32 numVisible = 0;
+        for (I32 i = 0; i < NUM_BOXES; i++)
+        {
+            bool visible = (masks[i] & (1u << cascade)) != 0;
+            ASSERT( visible == culler.isVisible( i ) );
+            numVisible += visible ? 1 : 0;
+        }
+
+        LOG( "[Cascade " + TS( cascade ) + "] Visible: " + TS( numVisible ) + "/" + TS( NUM_BOXES ) );
+    }
+}
+
+//----------------------------------------------------------------------
+// Fills a loose octree with 100k mostly small boxes, moves and removes
+// some of them and compares every frustum query with a linear cull
+// over the same boxes. Reports the time of both.
+//----------------------------------------------------------------------
+void TestLooseOctree()
+{
+    const I32 NUM_BOXES = 100000;
+
+    Graphics::Camera camera;
+    camera.setProjection( DirectX::XMMatrixPerspectiveFovLH( DirectX::XMConvertToRadians( 60.0f ), 16.0f / 9.0f, 0.1f, 300.0f ) );
+
+    auto randomFloat = [](F32 min, F32 max) { return min + (max - min) * (rand() / (F32)RAND_MAX); };
+
+    srand( 42 );
+    Math::LooseOctree<I32> tree( Math::Vec3( 0.0f ), 2048.0f );
+    ArrayList<Math::Vec3> centers( NUM_BOXES ), extents( NUM_BOXES );
+    ArrayList<U32> handles( NUM_BOXES );
+    ArrayList<bool> alive( NUM_BOXES, true );
+    for (I32 i = 0; i < NUM_BOXES; i++)
+    {
+        centers[i] = Math::Vec3( randomFloat( -2500.0f, 2500.0f ), randomFloat( -50.0f, 50.0f ), randomFloat( -2500.0f, 2500.0f ) );
+        F32 size = (i % 100 == 0) ? randomFloat( 50.0f, 500.0f ) : randomFloat( 0.5f, 5.0f );
+        extents[i] = Math::Vec3( size, size, size );
+        handles[i] = tree.insert( centers[i], extents[i], i );
+    }
+
+    F64 linearSeconds = 0.0, treeSeconds = 0.0;
+    for (I32 run = 0; run < 10; run++)
+    {
+        // Move, remove and re-add some boxes
+        for (I32 k = 0; k < 1000; k++)
+        {
+            I32 i = rand() % NUM_BOXES;
+            if ( not alive[i] )
+            {
+                handles[i] = tree.insert( centers[i], extents[i], i );
+                alive[i] = true;
+            }
+            else if (k % 4 == 0)
+            {
+                tree.remove( handles[i] );
+                alive[i] = false;
+            }
+            else
+            {
+                centers[i] += Math::Vec3( randomFloat( -20.0f, 20.0f ), 0.0f, randomFloat( -20.0f, 20.0f ) );
+                tree.update( handles[i], centers[i], extents[i] );
+            }
+        }
+
+        camera.setModelMatrix( DirectX::XMMatrixRotationRollPitchYaw( 0.1f, randomFloat( 0.0f, 6.0f ), 0.0f ) * DirectX::XMMatrixTranslation( randomFloat( -2000.0f, 2000.0f ), 0.0f, randomFloat( -2000.0f, 2000.0f ) ) );
+
+        U64 begin = OS::PlatformTimer::getTicks();
+        ArrayList<bool> visibleLinear( NUM_BOXES );
+        for (I32 i = 0; i < NUM_BOXES; i++)
+            visibleLinear[i] = alive[i] && Math::CullFrustums( centers[i], extents[i], &camera.getFrustumPlanes(), 1 ) != 0;
+        linearSeconds += OS::PlatformTimer::ticksToSeconds( OS::PlatformTimer::getTicks() - begin );
+
+        begin = OS::PlatformTimer::getTicks();
+        ArrayList<I32> visible;
+        tree.queryFrustum( camera.getFrustumPlanes(), [&](I32 i) { visible.push_back( i ); } );
+        treeSeconds += OS::PlatformTimer::ticksToSeconds( OS::PlatformTimer::getTicks() - begin );
+
+        ArrayList<bool> visibleByTree( NUM_BOXES, false );
+        for (I32 i : visible)
+        {
+            ASSERT( not visibleByTree[i] );
+            visibleByTree[i] = true;
+        }
+
+        for (I32 i = 0; i < NUM_BOXES; i++)
+            ASSERT( visibleByTree[i] == visibleLinear[i] );
+    }
+
+    ASSERT( tree.size() == (U32)std::count( alive.begin(), alive.end(), true ) );
+    LOG( "[" + TS( NUM_BOXES ) + " Boxes] Linear: " + TS( linearSeconds * 100.0 ) + "ms Octree: " + TS( treeSeconds * 100.0 ) + "ms Nodes: " + TS( tree.getNodeCount() ) );
+}
+
+//----------------------------------------------------------------------
+// Moves the transforms of a chain root -> a -> b -> c and compares the
+// cached world matrix and its decomposition with the product of all
+// local matrices, computed from scratch every time. Also reparents with
+// and without keeping the world transform.
+//----------------------------------------------------------------------
+void TestTransformHierarchy()
+{
+    Components::Transform root, a, b, c;
+    a.setParent( &root, false );
+    b.setParent( &a, false );
+    c.setParent( &b, false );
+
+    auto localMatrix = [](const Components::Transform& t) {
+        return DirectX::XMMatrixAffineTransformation( DirectX::XMLoadFloat3( &t.getScale() ), DirectX::XMQuaternionIdentity(),
+                                                      DirectX::XMLoadFloat4( &t.getRotation() ), DirectX::XMLoadFloat3( &t.getPosition() ) );
+    };
+    auto expectedMatrix = [&](const Components::Transform& t) {
+        auto matrix = localMatrix( t );
+        for (auto parent = t.getParent(); parent; parent = parent->getParent())
+            matrix = DirectX::XMMatrixMultiply( matrix, localMatrix( *parent ) );
+        return matrix;
+    };
+    auto nearlyEqual = [](DirectX::FXMMATRIX m0, DirectX::CXMMATRIX m1) {
+        DirectX::XMFLOAT4X4 f0, f1;
+        DirectX::XMStoreFloat4x4( &f0, m0 );
+        DirectX::XMStoreFloat4x4( &f1, m1 );
+        for (I32 row = 0; row < 4; row++)
+            for (I32 col = 0; col < 4; col++)
+                if (std::abs( f0.m[row][col] - f1.m[row][col] ) > 1e-4f)
+                    return false;
+        return true;
+    };
+    auto checkChain = [&] {
+        for (auto t : { &root, &a, &b, &c })
+        {
+            ASSERT( nearlyEqual( t->getWorldMatrix(), expectedMatrix( *t ) ) );
+
+            // Uniform scales only, so the decomposition is exact
+            DirectX::XMVECTOR s, r, p;
+            DirectX::XMMatrixDecompose( &s, &r, &p, expectedMatrix( *t ) );
+            Math::Vec3 pos, scale;
+            Math::Quat rot;
+            t->getWorldTransform( &pos, &scale, &rot );
+            ASSERT( DirectX::XMVector3NearEqual( DirectX::XMLoadFloat3( &pos ), p, DirectX::XMVectorReplicate( 1e-4f ) ) );
+            ASSERT( DirectX::XMVector3NearEqual( DirectX::XMLoadFloat3( &scale ), s, DirectX::XMVectorReplicate( 1e-4f ) ) );
+            ASSERT( std::abs( DirectX::XMVectorGetX( DirectX::XMQuaternionDot( DirectX::XMLoadFloat4( &rot ), r ) ) ) > 0.9999f );
+            Math::Vec3 worldPosition = t->getWorldPosition();
+            ASSERT( DirectX::XMVector3NearEqual( DirectX::XMLoadFloat3( &worldPosition ), p, DirectX::XMVectorReplicate( 1e-4f ) ) );
+        }
+    };
+
+    srand( 1337 );
+    auto randomFloat = [](F32 min, F32 max) { return min + (max - min) * (rand() / (F32)RAND_MAX); };
+    checkChain();
+    for (I32 i = 0; i < 100; i++)
+    {
+        // Move a random ancestor, the whole chain below must follow
+        Components::Transform* transforms[] = { &root, &a, &b, &c };
+        auto t = transforms[rand() % 4];
+        U32 versionBefore = c.getWorldVersion();
+
+        t->setPosition( Math::Vec3( randomFloat( -10.0f, 10.0f ), randomFloat( -10.0f, 10.0f ), randomFloat( -10.0f, 10.0f ) ) );
+        t->setScale( Math::Vec3( randomFloat( 0.5f, 2.0f ) ) );
+        Math::Quat rotation;
+        DirectX::XMStoreFloat4( &rotation, DirectX::XMQuaternionRotationRollPitchYaw( randomFloat( 0.0f, 6.0f ), randomFloat( 0.0f, 6.0f ), randomFloat( 0.0f, 6.0f ) ) );
+        t->setRotation( rotation );
+
+        ASSERT( c.getWorldVersion() != versionBefore );
+        checkChain();
+
+        // Nothing changed, so the version stays the same
+        U32 version = c.getWorldVersion();
+        ASSERT( c.getWorldVersion() == version );
+    }
+
+    // Moving a transform leaves its ancestors alone
+    U32 versionA = a.getWorldVersion();
+    U32 versionB = b.getWorldVersion();
+    U32 versionC = c.getWorldVersion();
+    c.setPosition( c.getPosition() + Math::Vec3( 1.0f ) );
+    ASSERT( c.getWorldVersion() != versionC );
+    ASSERT( a.getWorldVersion() == versionA && b.getWorldVersion() == versionB );
+    checkChain();
+
+    // Reparenting c directly under the root keeps its world transform
+    auto worldBefore = c.getWorldMatrix();
+    c.setParent( &root, true );
+    ASSERT( c.getParent() == &root );
+    ASSERT( nearlyEqual( c.getWorldMatrix(), worldBefore ) );
+    checkChain();
+
+    // Without keeping, the local values stay and are now relative to a
+    c.setParent( &a, false );
+    ASSERT( nearlyEqual( c.getWorldMatrix(), DirectX::XMMatrixMultiply( localMatrix( c ), expectedMatrix( a ) ) ) );
+    checkChain();
+
+    c.setParent( nullptr, true );
+    ASSERT( nearlyEqual( c.getWorldMatrix(), localMatrix( c ) ) );
+}
+
+//----------------------------------------------------------------------
+// Records the current scene serially and with several thread pool sizes.
+// Every run must produce bit identical command buffers. Needs a running
+// engine with a loaded scene (cameras, lights with shadows, renderers).
+//----------------------------------------------------------------------
+void TestParallelRenderPreparation()
+{
+    auto& renderSystem = Core::RenderSystem::Instance();
+    for (U8 numThreads : { 1, 2, 4, 8 })
+    {
+        OS::ThreadPool threadPool( numThreads );
+        for (I32 run = 0; run < 10; run++)
+            ASSERT( renderSystem.validateParallelRecording( &threadPool ) );
+    }
+
+    LOG( "Recorded " + TS( renderSystem.record( nullptr ).size() ) + " command buffers, serial and parallel identical." );
+}
+
+//----------------------------------------------------------------------
+// Simulates one million particles headless and reports ns/particle for
+// aging, integration, view alignment and writing the instance data.
+// Compares the old array of structs loop against the ParticleStreams
+// and checks that both produce the same matrices.
+//----------------------------------------------------------------------
+void BenchmarkParticleSimulation()
+{
+    struct Particle
+    {
+        F32         startLifetime;
+        F32         remainingLifetime;
+        Math::Vec3  position;
+        Math::Vec3  scale;
+        Math::Quat  rotation;
+        Math::Vec3  spawnVelocity;
+        Math::Vec3  velocity;
+    };
+
+    const U32 NUM_PARTICLES = 1000000;
+    const I32 NUM_STEPS     = 10;
+    const F32 DELTA         = 1.0f / 60.0f;
+    const F32 GRAVITY       = 9.81f;
+    const Math::Quat ALIGNMENT = Math::Quat::FromEulerAngles( { 10.0f, 45.0f, 0.0f } );
+
+    srand( 7 );
+    auto randomFloat = [](F32 min, F32 max) { return min + (max - min) * (rand() / (F32)RAND_MAX); };
+
+    ArrayList<Particle> particles( NUM_PARTICLES );
+    Components::ParticleStreams streams;
+    streams.resize( NUM_PARTICLES );
+    for (U32 i = 0; i < NUM_PARTICLES; i++)
+    {
+        // Some particles die during the benchmark
+        F32 lifetime = randomFloat( 0.05f, 2.0f );
+        F32 scale = randomFloat( 0.5f, 2.0f );
+        Math::Vec3 position( randomFloat( -10.0f, 10.0f ), randomFloat( -10.0f, 10.0f ), randomFloat( -10.0f, 10.0f ) );
+        Math::Vec3 velocity( randomFloat( -1.0f, 1.0f ), randomFloat( 0.0f, 5.0f ), randomFloat( -1.0f, 1.0f ) );
+        Math::Quat rotation = Math::Quat::FromEulerAngles( { randomFloat( 0.0f, 360.0f ), randomFloat( 0.0f, 360.0f ), 0.0f } );
+
+        particles[i] = { lifetime, lifetime, position, Math::Vec3( scale ), rotation, velocity, velocity };
+        streams.spawn( i, lifetime, scale, rotation, position, Color::WHITE, velocity );
+    }
+
+    ArrayList<DirectX::XMMATRIX> aosMatrices( NUM_PARTICLES );
+    ArrayList<DirectX::XMMATRIX> soaMatrices( NUM_PARTICLES );
+    ArrayList<Math::Vec4> colors( NUM_PARTICLES );
+
+    // Old path: one particle after another
+    U32 aosCount = NUM_PARTICLES;
+    U64 aosTicks = 0;
+    U64 aosParticleSteps = 0;
+    for (I32 step = 0; step < NUM_STEPS; step++)
+    {
+        aosParticleSteps += aosCount;
+        U64 begin = OS::PlatformTimer::getTicks();
+        for (U32 i = 0; i < aosCount;)
+        {
+            particles[i].remainingLifetime -= DELTA;
+            if (particles[i].remainingLifetime < 0.0f)
+            {
+                particles[i] = particles[aosCount - 1];
+                --aosCount;
+                continue;
+            }
+
+            particles[i].velocity = particles[i].spawnVelocity;
+            particles[i].velocity -= Math::Vec3{ 0, GRAVITY * (particles[i].startLifetime - particles[i].remainingLifetime), 0 };
+            particles[i].position += particles[i].velocity * DELTA;
+            ++i;
+        }
+        for (U32 i = 0; i < aosCount; ++i)
+            particles[i].rotation *= ALIGNMENT;
+        for (U32 i = 0; i < aosCount; ++i)
+        {
+            DirectX::XMVECTOR s = DirectX::XMLoadFloat3( &particles[i].scale );
+            DirectX::XMVECTOR r = DirectX::XMLoadFloat4( &particles[i].rotation );
+            DirectX::XMVECTOR p = DirectX::XMLoadFloat3( &particles[i].position );
+            aosMatrices[i] = DirectX::XMMatrixAffineTransformation( s, DirectX::XMQuaternionIdentity(), r, p );
+        }
+        aosTicks += OS::PlatformTimer::getTicks() - begin;
+    }
+
+    // New path: four particles at a time on separate streams
+    U32 soaCount = NUM_PARTICLES;
+    U64 soaTicks = 0;
+    U64 soaParticleSteps = 0;
+    for (I32 step = 0; step < NUM_STEPS; step++)
+    {
+        soaParticleSteps += soaCount;
+        U64 begin = OS::PlatformTimer::getTicks();
+        soaCount = streams.age( soaCount, DELTA );
+        streams.resetVelocities( soaCount );
+        streams.integrate( soaCount, DELTA, GRAVITY );
+        streams.rotate( soaCount, ALIGNMENT );
+        streams.writeInstanceData( soaCount, soaMatrices.data(), colors.data() );
+        soaTicks += OS::PlatformTimer::getTicks() - begin;
+    }
+
+    ASSERT( aosCount == soaCount );
+    for (U32 i = 0; i < soaCount; i++)
+    {
+        for (I32 row = 0; row < 4; row++)
+        {
+            auto difference = DirectX::XMVectorAbs( DirectX::XMVectorSubtract( aosMatrices[i].r[row], soaMatrices[i].r[row] ) );
+            ASSERT( DirectX::XMVector4LessOrEqual( difference, DirectX::XMVectorReplicate( 1e-3f ) ) );
+        }
+    }
+
+    F64 aosNanoSeconds = OS::PlatformTimer::ticksToSeconds( aosTicks ) * 1e9 / aosParticleSteps;
+    F64 soaNanoSeconds = OS::PlatformTimer::ticksToSeconds( soaTicks ) * 1e9 / soaParticleSteps;
+    LOG( "[" + TS( NUM_PARTICLES ) + " Particles] AoS: " + TS( aosNanoSeconds ) + " ns/particle"
+         " SoA: " + TS( soaNanoSeconds ) + " ns/particle" );
+}
@@ -7,7 +7,7 @@ void TestThreading()
 
 
 #define SIZE 100
-    OS::JobPtr jobs[SIZE];
+    OS::JobHandle jobs[SIZE];
 
     for (int i = 0; i < SIZE; i++)
     {
@@ -18,11 +18,251 @@ void TestThreading()
 
     for (int i = 0; i < SIZE; i++)
     {
-        jobs[i]->wait();
+        jobs[i].wait();
     }
 
-    OS::JobPtr i = threadPool.addJob([] {
+    OS::JobHandle i = threadPool.addJob([] {
         LOG_WARN("A super awesome job");
     });
 
-}
\ No newline at end of file
+}
+
+//----------------------------------------------------------------------
+// Mimics the former job: allocated via make_shared, wraps a std::function
+// and holds its own mutex + condition variable while running. Used to
+// compare the pooled job records against the old per job overhead.
+//----------------------------------------------------------------------
+struct LegacyJob
+{
+    LegacyJob(const std::function<void()>& job) : job( job ) {}
+
+    void operator() ()
+    {
+        std::unique_lock<std::mutex> lock( mutex );
+        job();
+        done = true;
+        cv.notify_all();
+    }
+
+    std::function<void()>       job;
+    std::mutex                  mutex;
+    std::condition_variable     cv;
+    bool                        done = false;
+};
+
+//----------------------------------------------------------------------
+// Pushes millions of empty jobs through thread pools of increasing size.
+// Measures the pure scheduling overhead (contention on the job queue).
+//----------------------------------------------------------------------
+void BenchmarkJobThroughput()
+{
+    const U32 NUM_JOBS          = 2000000;
+    const U32 NUM_ROOT_JOBS     = 256;
+    const U32 NUM_CHILD_JOBS    = NUM_JOBS / NUM_ROOT_JOBS;
+
+    U8 maxThreads = std::min( (U8)(std::thread::hardware_concurrency()), (U8)(MAX_POSSIBLE_THREADS - 1) );
+    for (U8 numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+    {
+        OS::ThreadPool threadPool( numThreads );
+
+        // All jobs are added from the main thread
+        U64 begin = OS::PlatformTimer::getTicks();
+        for (U32 i = 0; i < NUM_JOBS; i++)
+            threadPool.addJob( [] {} );
+        threadPool.waitForThreads();
+        F64 seconds = OS::PlatformTimer::ticksToSeconds( OS::PlatformTimer::getTicks() - begin );
+        LOG( "[" + TS(numThreads) + " Threads] External: " + TS( (U64)(NUM_JOBS / seconds) ) + " jobs/s" );
+
+        // Same, but every job pays the allocation + locking of the former job objects on top
+        begin = OS::PlatformTimer::getTicks();
+        for (U32 i = 0; i < NUM_JOBS; i++)
+        {
+            auto legacyJob = std::make_shared<LegacyJob>( [] {} );
+            threadPool.addJob( [legacyJob] { (*legacyJob)(); } );
+        }
+        threadPool.waitForThreads();
+        seconds = OS::PlatformTimer::ticksToSeconds( OS::PlatformTimer::getTicks() - begin );
+        LOG( "[" + TS(numThreads) + " Threads] External (legacy jobs): " + TS( (U64)(NUM_JOBS / seconds) ) + " jobs/s" );
+
+        // Jobs spawn their children from within the pool
+        begin = OS::PlatformTimer::getTicks();
+        for (U32 i = 0; i < NUM_ROOT_JOBS; i++)
+        {
+            threadPool.addJob( [&threadPool, NUM_CHILD_JOBS] {
+                for (U32 j = 0; j < NUM_CHILD_JOBS; j++)
+                    threadPool.addJob( [] {} );
+            } );
+        }
+        threadPool.waitForThreads();
+        seconds = OS::PlatformTimer::ticksToSeconds( OS::PlatformTimer::getTicks() - begin );
+        LOG( "[" + TS(numThreads) + " Threads] Nested: " + TS( (U64)(NUM_JOBS / seconds) ) + " jobs/s" );
+    }
+}
+
+//----------------------------------------------------------------------
+// Records nested zones on the main thread and inside jobs, exports them
+// as chrome trace and verifies the result. Runs without the engine.
+//----------------------------------------------------------------------
+void TestZoneProfiler()
+{
+    using namespace Core::Profiling;
+
+    const U32 NUM_FRAMES    = 4;
+    const U32 NUM_JOBS      = 16;
+
+    OS::ThreadPool threadPool( 4 );
+
+    U32 firstFrame = ZoneProfiler::GetFrame() + 1;
+    for (U32 frame = 0; frame < NUM_FRAMES; frame++)
+    {
+        ZoneProfiler::NextFrame();
+        PROFILE_ZONE( "TestFrame" );
+        for (U32 i = 0; i < NUM_JOBS; i++)
+        {
+            threadPool.addJob( [] {
+                PROFILE_ZONE( "TestJob" );
+                PROFILE_ZONE( "TestJobNested" );
+            } );
+        }
+        threadPool.waitForThreads();
+    }
+    U32 lastFrame = ZoneProfiler::GetFrame();
+
+    OS::Path path( "zone_profiler_test.json", false );
+    ASSERT( ZoneProfiler::ExportChromeTrace( path, firstFrame, lastFrame ) );
+
+    String content;
+    {
+        OS::TextFile file( path, OS::EFileMode::READ );
+        content = file.readAll();
+        file.deleteFromDisk();
+    }
+
+    U32 numFrames = 0, numJobs = 0, numNested = 0;
+    auto trace = nlohmann::json::parse( content );
+    for (auto& event : trace["traceEvents"])
+    {
+        if (event["ph"] != "X")
+            continue;
+
+        String name = event["name"];
+        U32 depth   = event["args"]["depth"];
+        if (name == "TestFrame")            { numFrames++; ASSERT( depth == 0 ); }
+        else if (name == "TestJob")         { numJobs++;   ASSERT( depth == 0 ); }
+        else if (name == "TestJobNested")   { numNested++; ASSERT( depth == 1 ); }
+    }
+
+    ASSERT( numFrames == NUM_FRAMES );
+    ASSERT( numJobs == NUM_FRAMES * NUM_JOBS );
+    ASSERT( numNested == NUM_FRAMES * NUM_JOBS );
+
+    // Names with control characters and names longer than any fixed line buffer survive the export
+    {
+        String threadName = "Thread \"A\"\n\t\x01\\" + String( 1000, 'x' );
+        String zoneName = "Zone\r\n\x1f" + String( 1000, 'y' );
+
+        ThreadZones threadZones;
+        threadZones.threadName  = threadName;
+        threadZones.threadID    = 7;
+        threadZones.zones.push_back( { zoneName.c_str(), 100, 200, 3, 0 } );
+
+        auto escapedTrace = nlohmann::json::parse( ZoneProfiler::ToChromeTrace( { threadZones } ) );
+        auto& events = escapedTrace["traceEvents"];
+        ASSERT( events.size() == 2 );
+        ASSERT( events[0]["args"]["name"] == threadName );
+        ASSERT( events[1]["name"] == zoneName );
+        ASSERT( events[1]["args"]["frame"] == 3 );
+    }
+
+    // Buffers of exited threads must be reused instead of piling up
+    const U32 NUM_SHORT_THREADS = 64;
+    U32 firstShortFrame = ZoneProfiler::GetFrame() + 1;
+    Size numBuffersBefore = ZoneProfiler::Collect( firstShortFrame, firstShortFrame ).size();
+    for (U32 i = 0; i < NUM_SHORT_THREADS; i++)
+    {
+        ZoneProfiler::NextFrame();
+        std::thread thread( [] { PROFILE_ZONE( "TestShortThread" ); } );
+        thread.join();
+    }
+
+    // Every thread got the buffer of its predecessor, so only the zone of the last one is left
+    auto shortThreads = ZoneProfiler::Collect( firstShortFrame, ZoneProfiler::GetFrame() );
+    ASSERT( shortThreads.size() <= numBuffersBefore + 1 );
+
+    U32 numShortZones = 0;
+    for (auto& thread : shortThreads)
+        numShortZones += (U32)thread.zones.size();
+    ASSERT( numShortZones == 1 );
+}
+
+//----------------------------------------------------------------------
+// Runs a diamond shaped job graph several times and checks that no job
+// started before all of its predecessors were done.
+//----------------------------------------------------------------------
+void TestJobGraph()
+{
+    const U32 NUM_WIDE_JOBS = 100;
+
+    OS::ThreadPool threadPool( 4 );
+
+    std::atomic<U32> numCulled{ 0 }, numRecorded{ 0 }, numSorted{ 0 };
+
+    OS::JobGraph graph;
+    auto cull = graph.add( [&] { numCulled++; } );
+    auto sort = graph.add( [&] { ASSERT( numCulled == 1 ); numSorted++; }, { cull } );
+    auto submit = graph.add( [&] { ASSERT( numRecorded == NUM_WIDE_JOBS && numSorted == 1 ); } );
+    for (U32 i = 0; i < NUM_WIDE_JOBS; i++)
+    {
+        auto record = graph.add( [&] { ASSERT( numCulled == 1 ); numRecorded++; }, { cull } );
+        graph.addEdge( record, submit );
+    }
+    graph.addEdge( sort, submit );
+
+    for (U32 frame = 0; frame < 100; frame++)
+    {
+        numCulled = numRecorded = numSorted = 0;
+        threadPool.addJobGraph( graph ).wait();
+        ASSERT( numRecorded == NUM_WIDE_JOBS && numSorted == 1 );
+    }
+
+    // An empty graph is done immediately
+    OS::JobGraph emptyGraph;
+    threadPool.addJobGraph( emptyGraph ).wait();
+}
+
+//----------------------------------------------------------------------
+// Checks ParallelFor() and ParallelSort() against their serial results,
+// including parallel loops started from within a parallel loop.
+//----------------------------------------------------------------------
+void TestParallelPrimitives()
+{
+    const I64 NUM_ELEMENTS = 1000000;
+
+    OS::ThreadPool threadPool( 4 );
+
+    ArrayList<I64> values( NUM_ELEMENTS, 0 );
+    OS::ParallelFor( &threadPool, 0, NUM_ELEMENTS, [&](I64 i) { values[i] += i; }, 1024 );
+    for (I64 i = 0; i < NUM_ELEMENTS; i++)
+        ASSERT( values[i] == i );
+
+    std::atomic<I64> sum{ 0 };
+    OS::ParallelFor( &threadPool, 0, 64, [&](I64) {
+        OS::ParallelFor( &threadPool, 0, 1000, [&](I64 j) { sum += j; }, 16 );
+    } );
+    ASSERT( sum == 64 * 499500 );
+
+    srand( 42 );
+    ArrayList<U32> unsorted( NUM_ELEMENTS );
+    for (auto& val : unsorted)
+        val = (rand() << 16) ^ rand();
+
+    ArrayList<U32> expected = unsorted;
+    std::sort( expected.begin(), expected.end() );
+
+    U64 begin = OS::PlatformTimer::getTicks();
+    OS::ParallelSort( &threadPool, unsorted.begin(), unsorted.end() );
+    F64 ms = OS::PlatformTimer::ticksToMilliSeconds( OS::PlatformTimer::getTicks() - begin );
+    ASSERT( unsorted == expected );
+
+    LOG( "ParallelSort: " + TS( NUM_ELEMENTS ) + " elements in " + TS( ms ) + "ms" );
+}
@@ -0,0 +1,448 @@
+#pragma once
+
+#include "../Minecraft/src/World/greedy_mesher.hpp"
+#include "../Minecraft/src/World/region_storage.h"
+#include "../Minecraft/src/World/Terrain Generator/terrain_noise.h"
+#include "../Minecraft/src/World/Terrain Generator/chunk_random.h"
+#include "../Minecraft/src/ext/stb_perlin.hpp"
+#include "PolyVoxCore/RawVolume.h"
+
+//----------------------------------------------------------------------
+// Meshes chunk sized volumes (flat terrain, hills with caves, noise)
+// with the greedy mesher and the PolyVox extractor. Every merged quad
+// is split back into unit faces, which must match the PolyVox faces
+// exactly: No face missing, none twice and the same material.
+//----------------------------------------------------------------------
+void TestGreedyMeshing()
+{
+    const I32 SIZE[3] = { 17, 129, 17 }; // Chunk plus the neighbour layer, see World::_GenerateMesh()
+    const I32 NUM_VOXELS = SIZE[0] * SIZE[1] * SIZE[2];
+
+    auto flatTerrain = [&](I32 x, I32 y, I32 z) -> U8 { return y < 64 ? (y < 60 ? 4 : 1) : 0; };
+    auto hills = [&](I32 x, I32 y, I32 z) -> U8 {
+        I32 height = 60 + (I32)(4.0f * std::sin( x * 0.4f ) + 3.0f * std::cos( z * 0.3f ));
+        bool cave = (x - 8) * (x - 8) + (y - 50) * (y - 50) * 4 + (z - 8) * (z - 8) < 30;
+        return (y > height || cave) ? 0 : (y == height ? 6 : (y > height - 3 ? 1 : 4));
+    };
+    auto noise = [&](I32 x, I32 y, I32 z) -> U8 { return (rand() % 3 == 0) ? 0 : (U8)(1 + rand() % 3); };
+
+    srand( 1337 );
+    I32 volumeIndex = 0;
+    for (auto generate : ArrayList<std::function<U8(I32, I32, I32)>>{ flatTerrain, hills, noise })
+    {
+        // The region includes its upper corner, same as in World::_GenerateMesh()
+        PolyVox::Region region( PolyVox::Vector3DInt32( 0, 0, 0 ), PolyVox::Vector3DInt32( SIZE[0] - 1, SIZE[1] - 1, SIZE[2] - 1 ) );
+        PolyVox::RawVolume<Block> volume( region );
+
+        ArrayList<U8> materials( NUM_VOXELS );
+        for (I32 z = 0; z < SIZE[2]; z++)
+        {
+            for (I32 y = 0; y < SIZE[1]; y++)
+            {
+                for (I32 x = 0; x < SIZE[0]; x++)
+                {
+                    U8 material = generate( x, y, z );
+                    materials[x + SIZE[0] * (y + SIZE[1] * z)] = material;
+                    volume.setVoxelAt( x, y, z, Block( material ) );
+                }
+            }
+        }
+
+        ArrayList<VoxelQuad> greedyQuads;
+        GreedyMesher::Extract( materials.data(), SIZE, greedyQuads );
+
+        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+        PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::RawVolume<Block>> extractor( &volume, region, &polyVoxMesh );
+        extractor.execute();
+
+        // Material of every unit face, per axis and normal direction. 0 means no face.
+        auto faceIndex = [&](I32 axis, bool positive, const I32 p[3]) {
+            return ((axis * 2 + (positive ? 1 : 0)) * NUM_VOXELS) + p[0] + SIZE[0] * (p[1] + SIZE[1] * p[2]);
+        };
+
+        // PolyVox adds 4 vertices per face. The face lies half a voxel above the lower
+        // voxel of its pair along the axis, the corners half a voxel around it.
+        const auto& polyVoxVertices = polyVoxMesh.getVertices();
+        ASSERT( polyVoxVertices.size() % 4 == 0 );
+        ArrayList<U8> polyVoxFaces( 6 * NUM_VOXELS, 0 );
+        for (Size first = 0; first < polyVoxVertices.size(); first += 4)
+        {
+            const auto& normal = polyVoxVertices[first].getNormal();
+            const F32 normalAxes[3] = { normal.getX(), normal.getY(), normal.getZ() };
+            I32 axis = normalAxes[0] != 0.0f ? 0 : (normalAxes[1] != 0.0f ? 1 : 2);
+
+            const auto& firstPosition = polyVoxVertices[first].getPosition();
+            F32 minCorner[3] = { firstPosition.getX(), firstPosition.getY(), firstPosition.getZ() };
+            for (Size i = first + 1; i < first + 4; i++)
+            {
+                const auto& position = polyVoxVertices[i].getPosition();
+                minCorner[0] = std::min( minCorner[0], position.getX() );
+                minCorner[1] = std::min( minCorner[1], position.getY() );
+                minCorner[2] = std::min( minCorner[2], position.getZ() );
+            }
+
+            I32 p[3];
+            for (I32 i = 0; i < 3; i++)
+                p[i] = static_cast<I32>( std::round( minCorner[i] + (i == axis ? -0.5f : 0.5f) ) );
+
+            auto& face = polyVoxFaces[faceIndex( axis, normalAxes[axis] > 0.0f, p )];
+            ASSERT( face == 0 );
+            face = static_cast<U8>( polyVoxVertices[first].getMaterial() );
+        }
+
+        ArrayList<U8> greedyFaces( 6 * NUM_VOXELS, 0 );
+        for (auto& quad : greedyQuads)
+        {
+            I32 u = (quad.axis + 1) % 3;
+            I32 v = (quad.axis + 2) % 3;
+            for (I32 j = 0; j < quad.height; j++)
+            {
+                for (I32 i = 0; i < quad.width; i++)
+                {
+                    I32 p[3] = { quad.position[0], quad.position[1], quad.position[2] };
+                    p[u] += i;
+                    p[v] += j;
+
+                    auto& face = greedyFaces[faceIndex( quad.axis, quad.positive, p )];
+                    ASSERT( face == 0 ); // Quads must not overlap
+                    face = quad.material;
+                }
+            }
+        }
+        ASSERT( greedyFaces == polyVoxFaces );
+
+        // Two triangles per quad for the renderer
+        ArrayList<Math::Vec3> vertices;
+        ArrayList<U32> indices;
+        for (auto& quad : greedyQuads)
+            GreedyMesher::AppendQuad( quad, vertices, indices );
+        ASSERT( vertices.size() == greedyQuads.size() * 4 && indices.size() == greedyQuads.size() * 6 );
+
+        LOG( "[Volume " + TS( volumeIndex++ ) + "] PolyVox: " + TS( polyVoxVertices.size() ) + " vertices Greedy: " + TS( greedyQuads.size() * 4 ) + " vertices" );
+    }
+}
+
+//----------------------------------------------------------------------
+// Hilly terrain with some ore, continuous across chunk borders.
+//----------------------------------------------------------------------
+static ChunkVoxelsPtr GenerateTestVoxels(const Math::Vec2Int& coords)
+{
+    auto voxels = std::make_shared<ChunkVoxels>();
+    ArrayList<Block> sectionVoxels( ChunkSection::NUM_VOXELS );
+    for (I32 section = 0; section < CHUNK_SECTIONS; section++)
+    {
+        for (I32 y = 0; y < CHUNK_SECTION_HEIGHT; y++)
+        {
+            for (I32 z = 0; z < CHUNK_SIZE; z++)
+            {
+                for (I32 x = 0; x < CHUNK_SIZE; x++)
+                {
+                    I32 worldX = coords.x * CHUNK_SIZE + x;
+                    I32 worldY = section * CHUNK_SECTION_HEIGHT - CHUNK_HEIGHT + y;
+                    I32 worldZ = coords.y * CHUNK_SIZE + z;
+                    I32 height = (I32)(6.0f * std::sin( worldX * 0.1f ) + 4.0f * std::cos( worldZ * 0.13f ));
+
+                    U8 material = 0;
+                    if (worldY <= height)
+                        material = (worldY < height - 3) ? ((worldX * 31 + worldY * 17 + worldZ * 7) % 23 == 0 ? 3 : 4) : 1;
+                    sectionVoxels[ChunkSection::Index( x, y, z )] = Block( material );
+                }
+            }
+        }
+        voxels->getSection( section ).assign( sectionVoxels.data() );
+    }
+    return voxels;
+}
+
+//----------------------------------------------------------------------
+// Generates chunks around the origin (so across region borders and
+// negative coordinates), evicts them into region files and reloads
+// them. Afterwards some chunks are edited and saved again, which
+// either fits in place or gets appended to the region file.
+//----------------------------------------------------------------------
+void TestChunkPersistence()
+{
+    const String DIRECTORY = "chunk_persistence_test";
+    const I32 MIN_COORD = -40;
+    const I32 MAX_COORD = 40;
+    const I32 STEP = 7;
+
+    ArrayList<std::pair<Math::Vec2Int, ChunkVoxelsPtr>> expected;
+    {
+        RegionStorage storage( DIRECTORY );
+        for (I32 z = MIN_COORD; z <= MAX_COORD; z += STEP)
+        {
+            for (I32 x = MIN_COORD; x <= MAX_COORD; x += STEP)
+            {
+                Math::Vec2Int coords( x, z );
+                expected.emplace_back( coords, GenerateTestVoxels( coords ) );
+                storage.save( coords, *expected.back().second );
+            }
+        }
+    }
+
+    // Edits: Clearing a section shrinks the chunk, random blocks make it grow
+    srand( 1337 );
+    RegionStorage storage( DIRECTORY );
+    I32 numEdits = 0;
+    for (auto& pair : expected)
+    {
+        if (numEdits++ % 3 != 0)
+            continue;
+
+        if (numEdits % 2 == 0)
+            pair.second->getSection( 0 ) = ChunkSection();
+        else
+            for (I32 i = 0; i < 2000; i++)
+                pair.second->setVoxel( rand() % CHUNK_SIZE, rand() % (2 * CHUNK_HEIGHT) - CHUNK_HEIGHT, rand() % CHUNK_SIZE, Block( (U8)(rand() % 12) ) );
+
+        storage.save( pair.first, *pair.second );
+    }
+
+    for (auto& pair : expected)
+    {
+        ChunkVoxels loaded;
+        ASSERT( storage.load( pair.first, loaded ) );
+        ASSERT( loaded == *pair.second );
+    }
+
+    // Never saved chunks, also in an existing region file
+    ChunkVoxels missing;
+    ASSERT( not storage.load( Math::Vec2Int( MIN_COORD + 1, MIN_COORD ), missing ) );
+    ASSERT( not storage.load( Math::Vec2Int( 1000, 1000 ), missing ) );
+
+    Size uncompressedBytes = expected.size() * sizeof( Block ) * CHUNK_SIZE * CHUNK_SIZE * 2 * CHUNK_HEIGHT;
+    Size fileBytes = 0;
+    for (I32 regionZ = -2; regionZ <= 1; regionZ++)
+    {
+        for (I32 regionX = -2; regionX <= 1; regionX++)
+        {
+            String path = storage.getRegionPath( regionX, regionZ );
+            if ( not OS::FileSystem::exists( path.c_str() ) )
+                continue;
+
+            OS::BinaryFile file( OS::Path( path, false ), OS::EFileMode::READ );
+            fileBytes += file.getFileSize();
+            file.deleteFromDisk();
+        }
+    }
+
+    LOG( "[" + TS( expected.size() ) + " Chunks] Raw: " + TS( uncompressedBytes / 1024 ) + "KB Region files: " + TS( fileBytes / 1024 ) + "KB" );
+}
+
+//----------------------------------------------------------------------
+// A chunk read back from its region file must get the same mesh as
+// before it was unloaded. The faces along its +x/+z border depend on
+// the first row of the neighbours, meshing it without them leaves
+// holes in the seams.
+//----------------------------------------------------------------------
+void TestReloadedChunkMesh()
+{
+    const String DIRECTORY = "chunk_mesh_test";
+    const Math::Vec2Int COORDS( -1, 0 );
+    const I32 SIZE[3] = { CHUNK_SIZE + 1, 2 * CHUNK_HEIGHT + 1, CHUNK_SIZE + 1 };
+
+    // Same steps as World::_GenerateChunkAsync() and World::_GenerateMesh() with GREEDY_MESHING
+    auto mesh = [&](const ChunkNeighbourhood& neighbourhood) {
+        I32 originX = COORDS.x * CHUNK_SIZE;
+        I32 originZ = COORDS.y * CHUNK_SIZE;
+        PolyVox::Region region( PolyVox::Vector3DInt32( originX, -CHUNK_HEIGHT, originZ ), PolyVox::Vector3DInt32( originX + CHUNK_SIZE, CHUNK_HEIGHT, originZ + CHUNK_SIZE ) );
+        PolyVox::RawVolume<Block> volume( region );
+        UnpackChunkNeighbourhood( neighbourhood, originX, originZ, volume );
+
+        ArrayList<U8> materials( SIZE[0] * SIZE[1] * SIZE[2] );
+        for (I32 z = 0; z < SIZE[2]; z++)
+            for (I32 y = 0; y < SIZE[1]; y++)
+                for (I32 x = 0; x < SIZE[0]; x++)
+                    materials[x + SIZE[0] * (y + SIZE[1] * z)] = volume.getVoxelAt( originX + x, y - CHUNK_HEIGHT, originZ + z ).getMaterial();
+
+        ArrayList<VoxelQuad> quads;
+        GreedyMesher::Extract( materials.data(), SIZE, quads );
+        return quads;
+    };
+    auto equal = [](const ArrayList<VoxelQuad>& a, const ArrayList<VoxelQuad>& b) {
+        return a.size() == b.size() && std::equal( a.begin(), a.end(), b.begin(), [](const VoxelQuad& q0, const VoxelQuad& q1) {
+            return q0.axis == q1.axis && q0.positive == q1.positive && q0.width == q1.width && q0.height == q1.height && q0.material == q1.material
+                && std::equal( std::begin( q0.position ), std::end( q0.position ), std::begin( q1.position ) );
+        } );
+    };
+
+    ChunkNeighbourhood neighbourhood;
+    for (I32 i = 0; i < 4; i++)
+        neighbourhood[i] = GenerateTestVoxels( Math::Vec2Int( COORDS.x + (i & 1), COORDS.y + (i >> 1) ) );
+    auto expected = mesh( neighbourhood );
+
+    {
+        RegionStorage storage( DIRECTORY );
+        storage.save( COORDS, *neighbourhood[0] );
+    }
+
+    RegionStorage storage( DIRECTORY );
+    auto loaded = std::make_shared<ChunkVoxels>();
+    ASSERT( storage.load( COORDS, *loaded ) );
+    neighbourhood[0] = loaded;
+    ASSERT( equal( mesh( neighbourhood ), expected ) );
+
+    // Without its neighbours the seams differ
+    ASSERT( not equal( mesh( ChunkNeighbourhood{ { loaded } } ), expected ) );
+
+    OS::BinaryFile file( OS::Path( storage.getRegionPath( -1, 0 ), false ), OS::EFileMode::READ );
+    file.deleteFromDisk();
+
+    LOG( "[" + TS( expected.size() ) + " Quads] Reloaded chunk gets the same mesh" );
+}
+
+//----------------------------------------------------------------------
+// Worldgen benchmark for the noise stage of the BasicTerrainGenerator
+// with the parameters from res/terrain.ini. The reference is the old
+// generator: A new noise per query and a biome and height query for
+// every sample of every blend window. Both must produce exactly the
+// same biomes and heights.
+//----------------------------------------------------------------------
+void BenchmarkTerrainNoise()
+{
+    const I32 SEED = 1337;
+    const I32 MIN_COORD = -12;
+    const I32 MAX_COORD = 12;
+    const I32 NUM_SAMPLES = (2 * BIOME_TRANSITION_WIDTH + 1) * (2 * BIOME_TRANSITION_WIDTH + 1);
+
+    NoiseParams biomeParams{ 1000.0f, 1.0f, 0.7f, 4 };
+    struct BiomeParams { NoiseParams params; F32 elevation; };
+    ArrayList<BiomeParams> biomes{ { { 200.0f, 1.0f, 0.3f, 4 }, 50.0f },     // Forest
+                                   { { 200.0f, 1.0f, 0.3f, 4 }, 25.0f },     // Desert
+                                   { { 50.0f,  2.0f, 0.4f, 4 }, 120.0f } };  // Hills
+
+    auto referenceNoise = [&](const NoiseParams& params, I32 x, I32 z, const Math::Vec2Int& pos) {
+        F32 scale = params.scale < 0.0f ? 0.0001f : params.scale;
+        return stb_perlin_turbulence_noise3( (SEED + x + pos.x) / scale, (SEED + z + pos.y) / scale, 0.0f, params.lacunarity, params.gain, params.octaves, 0, 0, 0 );
+    };
+    auto referenceBiome = [&](I32 x, I32 z, const Math::Vec2Int& pos) {
+        I32 index = I32( referenceNoise( biomeParams, x, z, pos ) / (1.0f / biomes.size()) );
+        return Math::Clamp( index, 0, biomes.size() - 1 );
+    };
+
+    ArrayList<Math::Vec2Int> positions;
+    for (I32 z = MIN_COORD; z < MAX_COORD; z++)
+        for (I32 x = MIN_COORD; x < MAX_COORD; x++)
+            positions.emplace_back( x * CHUNK_SIZE, z * CHUNK_SIZE );
+
+    ArrayList<TerrainNoise::ColumnGrid> expected( positions.size() );
+    I64 begin = OS::PlatformTimer::getTicks();
+    for (Size chunk = 0; chunk < positions.size(); chunk++)
+    {
+        auto& pos = positions[chunk];
+        for (I32 x = 0; x < TerrainNoise::NUM_COLUMNS; x++)
+        {
+            for (I32 z = 0; z < TerrainNoise::NUM_COLUMNS; z++)
+            {
+                I32 height = 0;
+                for (I32 i = x - BIOME_TRANSITION_WIDTH; i < x + BIOME_TRANSITION_WIDTH; i++)
+                {
+                    for (I32 j = z - BIOME_TRANSITION_WIDTH; j < z + BIOME_TRANSITION_WIDTH; j++)
+                    {
+                        auto& biome = biomes[referenceBiome( i, j, pos )];
+                        height += I32( referenceNoise( biome.params, i, j, pos ) * biome.elevation );
+                    }
+                }
+
+                auto& column = expected[chunk][x + z * TerrainNoise::NUM_COLUMNS];
+                column.height = height / NUM_SAMPLES;
+                column.biome = referenceBiome( x, z, pos );
+            }
+        }
+    }
+    F64 referenceSeconds = OS::PlatformTimer::ticksToSeconds( OS::PlatformTimer::getTicks() - begin );
+
+    begin = OS::PlatformTimer::getTicks();
+    TerrainNoise terrainNoise( SEED, biomeParams );
+    for (auto& biome : biomes)
+        terrainNoise.addBiome( biome.params, biome.elevation );
+
+    ArrayList<TerrainNoise::ColumnGrid> columns( positions.size() );
+    for (Size chunk = 0; chunk < positions.size(); chunk++)
+        terrainNoise.computeColumns( positions[chunk], columns[chunk] );
+    F64 batchedSeconds = OS::PlatformTimer::ticksToSeconds( OS::PlatformTimer::getTicks() - begin );
+
+    // The area must contain biome transitions, otherwise the blending is not covered
+    ArrayList<bool> biomeUsed( biomes.size(), false );
+    for (Size chunk = 0; chunk < positions.size(); chunk++)
+    {
+        for (I32 i = 0; i < TerrainNoise::NUM_COLUMNS * TerrainNoise::NUM_COLUMNS; i++)
+        {
+            ASSERT( columns[chunk][i].biome == expected[chunk][i].biome );
+            ASSERT( columns[chunk][i].height == expected[chunk][i].height );
+            biomeUsed[columns[chunk][i].biome] = true;
+        }
+    }
+    ASSERT( std::count( biomeUsed.begin(), biomeUsed.end(), true ) > 1 );
+
+    // Single samples match the reference aswell
+    ASSERT( terrainNoise.getBiome( 5, -2, positions[0] ) == referenceBiome( 5, -2, positions[0] ) );
+    ASSERT( terrainNoise.getHeight( 2, 5, -2, positions[0] ) == I32( referenceNoise( biomes[2].params, 5, -2, positions[0] ) * biomes[2].elevation ) );
+
+    LOG( "[" + TS( positions.size() ) + " Chunks] Reference: " + TS( positions.size() / referenceSeconds ) + " chunks/s Batched: " + TS( positions.size() / batchedSeconds ) + " chunks/s" );
+}
+
+//----------------------------------------------------------------------
+// Random numbers of a chunk must not depend on the order or thread in
+// which chunks are generated. Chunks are drawn once sequentially and
+// once interleaved from several threads in reverse order.
+//----------------------------------------------------------------------
+void TestChunkRandom()
+{
+    const I32 SEED = 1337;
+    const I32 NUM_CHUNKS_PER_AXIS = 16;
+    const I32 NUMBERS_PER_CHUNK = 1000;
+    const I32 NUM_THREADS = 4;
+
+    auto coordsOf = [&](I32 chunk) { return Math::Vec2Int( chunk % NUM_CHUNKS_PER_AXIS - NUM_CHUNKS_PER_AXIS / 2, chunk / NUM_CHUNKS_PER_AXIS - NUM_CHUNKS_PER_AXIS / 2 ); };
+    auto draw = [&](I32 chunk) {
+        ChunkRandom random( SEED, coordsOf( chunk ) );
+        ArrayList<U32> numbers( NUMBERS_PER_CHUNK );
+        for (auto& number : numbers)
+            number = random.next();
+        return numbers;
+    };
+
+    const I32 NUM_CHUNKS = NUM_CHUNKS_PER_AXIS * NUM_CHUNKS_PER_AXIS;
+    ArrayList<ArrayList<U32>> sequential( NUM_CHUNKS );
+    for (I32 chunk = 0; chunk < NUM_CHUNKS; chunk++)
+        sequential[chunk] = draw( chunk );
+
+    ArrayList<ArrayList<U32>> parallel( NUM_CHUNKS );
+    ArrayList<std::thread> threads;
+    for (I32 t = 0; t < NUM_THREADS; t++)
+        threads.emplace_back( [&, t] {
+            for (I32 chunk = NUM_CHUNKS - 1 - t; chunk >= 0; chunk -= NUM_THREADS)
+                parallel[chunk] = draw( chunk );
+        } );
+    for (auto& thread : threads)
+        thread.join();
+    ASSERT( parallel == sequential );
+
+    // Neighbours, mirrored chunks and other seeds get other numbers
+    ASSERT( sequential[0] != sequential[1] );
+    ASSERT( sequential[1] != sequential[NUM_CHUNKS_PER_AXIS] );
+    ChunkRandom otherSeed( SEED + 1, coordsOf( 0 ) );
+    ASSERT( otherSeed.next() != sequential[0][0] );
+
+    // Random access yields the same stream
+    ChunkRandom random( SEED, coordsOf( 0 ) );
+    for (U64 i = 0; i < 10; i++)
+        ASSERT( static_cast<U32>( random.at( i ) >> 32 ) == sequential[0][i] );
+
+    // Both bounds are inclusive and every value is about equally likely
+    const I32 NUM_DRAWS = 100000;
+    ArrayList<I32> histogram( 4, 0 );
+    for (I32 i = 0; i < NUM_DRAWS; i++)
+    {
+        I32 value = random.Int( 4, 7 );
+        ASSERT( value >= 4 && value <= 7 );
+        histogram[value - 4]++;
+    }
+    for (I32 count : histogram)
+        ASSERT( std::abs( count - NUM_DRAWS / 4 ) < NUM_DRAWS / 100 );
+    ASSERT( random.Int( 5, 5 ) == 5 );
+
+    LOG( "[" + TS( NUM_CHUNKS ) + " Chunks] Random numbers are independent of generation order" );
+}
@@ -3,6 +3,8 @@
 #include "MemoryManagement.hpp"
 #include "FileStuff.hpp"
 #include "Threading.hpp"
+#include "Rendering.hpp"
+#include "Voxels.hpp"
 
 #include "Common/enum_class_operators.hpp"
 